@@ -30,6 +30,7 @@
 
 #include "a_star_grid_2d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/variant/typed_array.h"
 
 static real_t heuristic_euclidean(const Vector2i &p_from, const Vector2i &p_to) {
@@ -59,6 +60,48 @@ static real_t heuristic_chebyshev(const Vector2i &p_from, const Vector2i &p_to)
 
 static real_t (*heuristics[AStarGrid2D::HEURISTIC_MAX])(const Vector2i &, const Vector2i &) = { heuristic_euclidean, heuristic_manhattan, heuristic_octile, heuristic_chebyshev };
 
+AStarGrid2D::SolveStateLease::SolveStateLease(AStarGrid2D *p_grid) {
+	grid = p_grid;
+	MutexLock lock(grid->solve_state_pool_mutex);
+	if (grid->solve_state_pool.is_empty()) {
+		state = memnew(SolveState);
+	} else {
+		state = grid->solve_state_pool[grid->solve_state_pool.size() - 1];
+		grid->solve_state_pool.resize(grid->solve_state_pool.size() - 1);
+	}
+}
+
+AStarGrid2D::SolveStateLease::~SolveStateLease() {
+	MutexLock lock(grid->solve_state_pool_mutex);
+	grid->solve_state_pool.push_back(state);
+}
+
+void AStarGrid2D::_free_solve_states() {
+	MutexLock lock(solve_state_pool_mutex);
+	for (SolveState *state : solve_state_pool) {
+		memdelete(state);
+	}
+	solve_state_pool.clear();
+}
+
+void AStarGrid2D::SolveState::begin(uint32_t p_point_count) {
+	if (point_states.size() != p_point_count) {
+		point_states.clear();
+		point_states.resize(p_point_count);
+		pass = 0;
+	}
+
+	pass++;
+	if (pass == 0) {
+		// The pass wrapped around, forget the old states so they can't be taken for the new ones.
+		for (PointState &point_state : point_states) {
+			point_state.open_pass = 0;
+			point_state.closed_pass = 0;
+		}
+		pass = 1;
+	}
+}
+
 void AStarGrid2D::set_region(const Rect2i &p_region) {
 	ERR_FAIL_COND(p_region.size.x < 0 || p_region.size.y < 0);
 	if (p_region != region) {
@@ -122,6 +165,7 @@ AStarGrid2D::CellShape AStarGrid2D::get_cell_shape() const {
 
 void AStarGrid2D::update() {
 	points.clear();
+	_free_solve_states();
 
 	const int32_t end_x = region.get_end().x;
 	const int32_t end_y = region.get_end().y;
@@ -150,6 +194,7 @@ void AStarGrid2D::update() {
 	}
 
 	dirty = false;
+	jump_distances_dirty.set();
 }
 
 bool AStarGrid2D::is_in_bounds(int32_t p_x, int32_t p_y) const {
@@ -175,6 +220,7 @@ bool AStarGrid2D::is_jumping_enabled() const {
 void AStarGrid2D::set_diagonal_mode(DiagonalMode p_diagonal_mode) {
 	ERR_FAIL_INDEX((int)p_diagonal_mode, (int)DIAGONAL_MODE_MAX);
 	diagonal_mode = p_diagonal_mode;
+	jump_distances_dirty.set();
 }
 
 AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
@@ -203,6 +249,7 @@ void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set if point is disabled. Point %s out of bounds %s.", p_id, region));
 	_get_point_unchecked(p_id)->solid = p_solid;
+	jump_distances_dirty.set();
 }
 
 bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
@@ -236,6 +283,7 @@ void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
 			_get_point_unchecked(x, y)->solid = p_solid;
 		}
 	}
+	jump_distances_dirty.set();
 }
 
 void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weight_scale) {
@@ -253,92 +301,159 @@ void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weig
 	}
 }
 
-AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
+// Returns true when a straight move in the direction reaches a point that has a forced neighbor, so it must be visited.
+bool AStarGrid2D::_is_straight_jump_point(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const {
+	switch (diagonal_mode) {
+		case DIAGONAL_MODE_ALWAYS:
+		case DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE: {
+			if (p_dx != 0) {
+				return (_is_walkable(p_x + p_dx, p_y + 1) && !_is_walkable(p_x, p_y + 1)) || (_is_walkable(p_x + p_dx, p_y - 1) && !_is_walkable(p_x, p_y - 1));
+			}
+			return (_is_walkable(p_x + 1, p_y + p_dy) && !_is_walkable(p_x + 1, p_y)) || (_is_walkable(p_x - 1, p_y + p_dy) && !_is_walkable(p_x - 1, p_y));
+		}
+		case DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES: {
+			if (p_dx != 0) {
+				return (_is_walkable(p_x, p_y + 1) && !_is_walkable(p_x - p_dx, p_y + 1)) || (_is_walkable(p_x, p_y - 1) && !_is_walkable(p_x - p_dx, p_y - 1));
+			}
+			return (_is_walkable(p_x + 1, p_y) && !_is_walkable(p_x + 1, p_y - p_dy)) || (_is_walkable(p_x - 1, p_y) && !_is_walkable(p_x - 1, p_y - p_dy));
+		}
+		default: { // DIAGONAL_MODE_NEVER
+			if (p_dx != 0) {
+				return (_is_walkable(p_x, p_y - 1) && !_is_walkable(p_x - p_dx, p_y - 1)) || (_is_walkable(p_x, p_y + 1) && !_is_walkable(p_x - p_dx, p_y + 1));
+			}
+			return (_is_walkable(p_x - 1, p_y) && !_is_walkable(p_x - 1, p_y - p_dy)) || (_is_walkable(p_x + 1, p_y) && !_is_walkable(p_x + 1, p_y - p_dy));
+		}
+	}
+}
+
+void AStarGrid2D::_update_jump_distance(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) {
+	const JumpDirection direction = _get_jump_direction(p_dx, p_dy);
+	int32_t &jump_distance = _get_point_unchecked(p_x, p_y)->jump_distances[direction];
+
+	if (!_is_walkable(p_x + p_dx, p_y + p_dy)) {
+		jump_distance = 0;
+	} else if (_is_straight_jump_point(p_x + p_dx, p_y + p_dy, p_dx, p_dy)) {
+		jump_distance = 1;
+	} else {
+		const int32_t next_jump_distance = _get_point_unchecked(p_x + p_dx, p_y + p_dy)->jump_distances[direction];
+		jump_distance = next_jump_distance > 0 ? next_jump_distance + 1 : next_jump_distance - 1;
+	}
+}
+
+// JPS+, each line is scanned once per direction from its far end, so the straight scans of the queries are lookups.
+void AStarGrid2D::_update_jump_distances() {
+	const int32_t end_x = region.get_end().x;
+	const int32_t end_y = region.get_end().y;
+
+	for (int32_t y = region.position.y; y < end_y; y++) {
+		for (int32_t x = end_x - 1; x >= region.position.x; x--) {
+			_update_jump_distance(x, y, 1, 0);
+		}
+		for (int32_t x = region.position.x; x < end_x; x++) {
+			_update_jump_distance(x, y, -1, 0);
+		}
+	}
+	for (int32_t x = region.position.x; x < end_x; x++) {
+		for (int32_t y = end_y - 1; y >= region.position.y; y--) {
+			_update_jump_distance(x, y, 0, 1);
+		}
+		for (int32_t y = region.position.y; y < end_y; y++) {
+			_update_jump_distance(x, y, 0, -1);
+		}
+	}
+}
+
+void AStarGrid2D::_ensure_jump_distances() {
+	if (!jumping_enabled || !jump_distances_dirty.is_set()) {
+		return;
+	}
+
+	MutexLock lock(jump_distances_mutex);
+	if (jump_distances_dirty.is_set()) {
+		_update_jump_distances();
+		jump_distances_dirty.clear();
+	}
+}
+
+AStarGrid2D::Point *AStarGrid2D::_jump_straight(Point *p_from, int32_t p_dx, int32_t p_dy, const Point *p_end) {
+	const int32_t jump_distance = p_from->jump_distances[_get_jump_direction(p_dx, p_dy)];
+
+	// The end point can be on the line before the jump point or the wall.
+	const int32_t to_end = p_dx != 0 ? (p_end->id.x - p_from->id.x) * p_dx : (p_end->id.y - p_from->id.y) * p_dy;
+	const bool end_on_line = p_dx != 0 ? p_end->id.y == p_from->id.y : p_end->id.x == p_from->id.x;
+	if (end_on_line && to_end > 0 && to_end <= ABS(jump_distance)) {
+		return const_cast<Point *>(p_end);
+	}
+
+	if (jump_distance > 0) {
+		return _get_point_unchecked(p_from->id.x + p_dx * jump_distance, p_from->id.y + p_dy * jump_distance);
+	}
+	return nullptr;
+}
+
+AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to, const Point *p_end) {
 	if (!p_to || p_to->solid) {
 		return nullptr;
 	}
-	if (p_to == end) {
+	if (p_to == p_end) {
 		return p_to;
 	}
 
-	int32_t from_x = p_from->id.x;
-	int32_t from_y = p_from->id.y;
+	const int32_t dx = p_to->id.x - p_from->id.x;
+	const int32_t dy = p_to->id.y - p_from->id.y;
 
-	int32_t to_x = p_to->id.x;
-	int32_t to_y = p_to->id.y;
-
-	int32_t dx = to_x - from_x;
-	int32_t dy = to_y - from_y;
+	if (dx == 0 || dy == 0) {
+		if (diagonal_mode != DIAGONAL_MODE_NEVER || dx != 0) {
+			return _jump_straight(p_from, dx, dy, p_end);
+		}
 
-	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
-		if (dx != 0 && dy != 0) {
-			if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
+		// Without diagonals, the vertical moves also look for the horizontal jump points.
+		while (true) {
+			const int32_t to_x = p_to->id.x;
+			const int32_t to_y = p_to->id.y;
+			if (p_to == p_end || _is_straight_jump_point(to_x, to_y, dx, dy)) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
+			if (_jump_straight(p_to, 1, 0, p_end) != nullptr || _jump_straight(p_to, -1, 0, p_end) != nullptr) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
-				return p_to;
-			}
-		} else {
-			if (dx != 0) {
-				if ((_is_walkable(to_x + dx, to_y + 1) && !_is_walkable(to_x, to_y + 1)) || (_is_walkable(to_x + dx, to_y - 1) && !_is_walkable(to_x, to_y - 1))) {
-					return p_to;
-				}
-			} else {
-				if ((_is_walkable(to_x + 1, to_y + dy) && !_is_walkable(to_x + 1, to_y)) || (_is_walkable(to_x - 1, to_y + dy) && !_is_walkable(to_x - 1, to_y))) {
-					return p_to;
-				}
+			if (!_is_walkable(to_x + dx, to_y + dy)) {
+				return nullptr;
 			}
+			p_to = _get_point_unchecked(to_x + dx, to_y + dy);
 		}
-		if (_is_walkable(to_x + dx, to_y + dy) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || (_is_walkable(to_x + dx, to_y) || _is_walkable(to_x, to_y + dy)))) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
+	}
+
+	while (true) {
+		const int32_t to_x = p_to->id.x;
+		const int32_t to_y = p_to->id.y;
+		if (p_to == p_end) {
+			return p_to;
 		}
-	} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
-		if (dx != 0 && dy != 0) {
+
+		if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
 			if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
 				return p_to;
 			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
-				return p_to;
-			}
-		} else {
-			if (dx != 0) {
-				if ((_is_walkable(to_x, to_y + 1) && !_is_walkable(to_x - dx, to_y + 1)) || (_is_walkable(to_x, to_y - 1) && !_is_walkable(to_x - dx, to_y - 1))) {
-					return p_to;
-				}
-			} else {
-				if ((_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy)) || (_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy))) {
-					return p_to;
-				}
-			}
+		} else if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
+			return p_to;
 		}
-		if (_is_walkable(to_x + dx, to_y + dy) && _is_walkable(to_x + dx, to_y) && _is_walkable(to_x, to_y + dy)) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
+
+		if (_jump_straight(p_to, dx, 0, p_end) != nullptr || _jump_straight(p_to, 0, dy, p_end) != nullptr) {
+			return p_to;
 		}
-	} else { // DIAGONAL_MODE_NEVER
-		if (dx != 0) {
-			if ((_is_walkable(to_x, to_y - 1) && !_is_walkable(to_x - dx, to_y - 1)) || (_is_walkable(to_x, to_y + 1) && !_is_walkable(to_x - dx, to_y + 1))) {
-				return p_to;
-			}
-		} else if (dy != 0) {
-			if ((_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy)) || (_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy))) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x + 1, to_y)) != nullptr) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x - 1, to_y)) != nullptr) {
-				return p_to;
-			}
+
+		if (!_is_walkable(to_x + dx, to_y + dy)) {
+			return nullptr;
+		}
+		if (diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE && !_is_walkable(to_x + dx, to_y) && !_is_walkable(to_x, to_y + dy)) {
+			return nullptr;
+		}
+		if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES && (!_is_walkable(to_x + dx, to_y) || !_is_walkable(to_x, to_y + dy))) {
+			return nullptr;
 		}
-		return _jump(p_to, _get_point(to_x + dx, to_y + dy));
+		p_to = _get_point_unchecked(to_x + dx, to_y + dy);
 	}
-	return nullptr;
 }
 
 void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
@@ -445,27 +560,31 @@ void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
 	}
 }
 
-bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
-	pass++;
-
+bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, SolveState &r_state) {
 	if (p_end_point->solid) {
 		return false;
 	}
 
+	r_state.begin(region.size.x * region.size.y);
+	const uint32_t pass = r_state.pass;
+
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	LocalVector<PointState *> open_list;
+	SortArray<PointState *, SortPoints> sorter;
+	LocalVector<Point *> nbors;
 
-	p_begin_point->g_score = 0;
-	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	open_list.push_back(p_begin_point);
-	end = p_end_point;
+	PointState *begin_state = _get_point_state(r_state, p_begin_point);
+	begin_state->g_score = 0;
+	begin_state->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	begin_state->prev_point = nullptr;
+	begin_state->open_pass = pass;
+	open_list.push_back(begin_state);
 
 	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point.
+		PointState *p = open_list[0]; // The currently processed point.
 
-		if (p == p_end_point) {
+		if (p->point == p_end_point) {
 			found_route = true;
 			break;
 		}
@@ -474,26 +593,31 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 		open_list.remove_at(open_list.size() - 1);
 		p->closed_pass = pass; // Mark the point as closed.
 
-		LocalVector<Point *> nbors;
-		_get_nbors(p, nbors);
+		nbors.clear();
+		_get_nbors(p->point, nbors);
 
-		for (Point *e : nbors) {
+		for (Point *e_point : nbors) {
 			real_t weight_scale = 1.0;
 
 			if (jumping_enabled) {
 				// TODO: Make it works with weight_scale.
-				e = _jump(p, e);
-				if (!e || e->closed_pass == pass) {
+				e_point = _jump(p->point, e_point, p_end_point);
+				if (!e_point) {
 					continue;
 				}
 			} else {
-				if (e->solid || e->closed_pass == pass) {
+				if (e_point->solid) {
 					continue;
 				}
-				weight_scale = e->weight_scale;
+				weight_scale = e_point->weight_scale;
+			}
+
+			PointState *e = _get_point_state(r_state, e_point);
+			if (e->closed_pass == pass) {
+				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * weight_scale;
+			real_t tentative_g_score = p->g_score + _compute_cost(p->point->id, e_point->id) * weight_scale;
 			bool new_point = false;
 
 			if (e->open_pass != pass) { // The point wasn't inside the open list.
@@ -506,7 +630,7 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 
 			e->prev_point = p;
 			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
+			e->f_score = e->g_score + _estimate_cost(e_point->id, p_end_point->id);
 
 			if (new_point) { // The position of the new points is already known.
 				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
@@ -537,6 +661,7 @@ real_t AStarGrid2D::_compute_cost(const Vector2i &p_from_id, const Vector2i &p_t
 
 void AStarGrid2D::clear() {
 	points.clear();
+	_free_solve_states();
 	region = Rect2i();
 }
 
@@ -551,6 +676,12 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), Vector<Vector2>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), Vector<Vector2>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
 
+	_ensure_jump_distances();
+	SolveStateLease solve_state(this);
+	return _get_point_path(p_from_id, p_to_id, *solve_state.state);
+}
+
+Vector<Vector2> AStarGrid2D::_get_point_path(const Vector2i &p_from_id, const Vector2i &p_to_id, SolveState &r_state) {
 	Point *a = _get_point(p_from_id.x, p_from_id.y);
 	Point *b = _get_point(p_to_id.x, p_to_id.y);
 
@@ -563,14 +694,14 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	bool found_route = _solve(begin_point, end_point, r_state);
 	if (!found_route) {
 		return Vector<Vector2>();
 	}
 
-	Point *p = end_point;
+	PointState *p = _get_point_state(r_state, end_point);
 	int32_t pc = 1;
-	while (p != begin_point) {
+	while (p->point != begin_point) {
 		pc++;
 		p = p->prev_point;
 	}
@@ -581,19 +712,59 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	{
 		Vector2 *w = path.ptrw();
 
-		p = end_point;
+		p = _get_point_state(r_state, end_point);
 		int32_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->pos;
+		while (p->point != begin_point) {
+			w[idx--] = p->point->pos;
 			p = p->prev_point;
 		}
 
-		w[0] = p->pos;
+		w[0] = p->point->pos;
 	}
 
 	return path;
 }
 
+void AStarGrid2D::_solve_batch_path(uint32_t p_index, PathBatch *p_batch) {
+	SolveStateLease solve_state(this);
+	p_batch->paths[p_index] = _get_point_path(p_batch->from_ids[p_index], p_batch->to_ids[p_index], *solve_state.state);
+}
+
+TypedArray<PackedVector2Array> AStarGrid2D::get_point_paths(const TypedArray<Vector2i> &p_from_ids, const TypedArray<Vector2i> &p_to_ids) {
+	ERR_FAIL_COND_V_MSG(dirty, TypedArray<PackedVector2Array>(), "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), TypedArray<PackedVector2Array>(), "The from and to id arrays must have the same size.");
+
+	PathBatch batch;
+	batch.from_ids.resize(p_from_ids.size());
+	batch.to_ids.resize(p_to_ids.size());
+	batch.paths.resize(p_from_ids.size());
+	for (uint32_t i = 0; i < batch.from_ids.size(); i++) {
+		batch.from_ids[i] = p_from_ids[i];
+		batch.to_ids[i] = p_to_ids[i];
+		ERR_FAIL_COND_V_MSG(!is_in_boundsv(batch.from_ids[i]), TypedArray<PackedVector2Array>(), vformat("Can't get id path. Point %s out of bounds %s.", batch.from_ids[i], region));
+		ERR_FAIL_COND_V_MSG(!is_in_boundsv(batch.to_ids[i]), TypedArray<PackedVector2Array>(), vformat("Can't get id path. Point %s out of bounds %s.", batch.to_ids[i], region));
+	}
+
+	_ensure_jump_distances();
+
+	// Script overrides of the costs can't be called from several threads.
+	if (batch.paths.size() > 1 && !GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) && !GDVIRTUAL_IS_OVERRIDDEN(_compute_cost)) {
+		WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AStarGrid2D::_solve_batch_path, &batch, batch.paths.size(), -1, true, "AStarGrid2DPaths");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+	} else {
+		for (uint32_t i = 0; i < batch.paths.size(); i++) {
+			_solve_batch_path(i, &batch);
+		}
+	}
+
+	TypedArray<PackedVector2Array> paths;
+	paths.resize(batch.paths.size());
+	for (uint32_t i = 0; i < batch.paths.size(); i++) {
+		paths[i] = batch.paths[i];
+	}
+	return paths;
+}
+
 TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const Vector2i &p_to_id) {
 	ERR_FAIL_COND_V_MSG(dirty, TypedArray<Vector2i>(), "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
@@ -611,14 +782,16 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	_ensure_jump_distances();
+	SolveStateLease solve_state(this);
+	bool found_route = _solve(begin_point, end_point, *solve_state.state);
 	if (!found_route) {
 		return TypedArray<Vector2i>();
 	}
 
-	Point *p = end_point;
+	PointState *p = _get_point_state(*solve_state.state, end_point);
 	int32_t pc = 1;
-	while (p != begin_point) {
+	while (p->point != begin_point) {
 		pc++;
 		p = p->prev_point;
 	}
@@ -627,19 +800,23 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 	path.resize(pc);
 
 	{
-		p = end_point;
+		p = _get_point_state(*solve_state.state, end_point);
 		int32_t idx = pc - 1;
-		while (p != begin_point) {
-			path[idx--] = p->id;
+		while (p->point != begin_point) {
+			path[idx--] = p->point->id;
 			p = p->prev_point;
 		}
 
-		path[0] = p->id;
+		path[0] = p->point->id;
 	}
 
 	return path;
 }
 
+AStarGrid2D::~AStarGrid2D() {
+	_free_solve_states();
+}
+
 void AStarGrid2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_region", "region"), &AStarGrid2D::set_region);
 	ClassDB::bind_method(D_METHOD("get_region"), &AStarGrid2D::get_region);
@@ -674,6 +851,7 @@ void AStarGrid2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_point_position", "id"), &AStarGrid2D::get_point_position);
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStarGrid2D::get_point_path);
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStarGrid2D::get_id_path);
+	ClassDB::bind_method(D_METHOD("get_point_paths", "from_ids", "to_ids"), &AStarGrid2D::get_point_paths);
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "to_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
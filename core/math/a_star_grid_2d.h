@@ -33,8 +33,10 @@
 
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
 #include "core/templates/list.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class AStarGrid2D : public RefCounted {
 	GDCLASS(AStarGrid2D, RefCounted);
@@ -82,12 +84,9 @@ private:
 		Vector2 pos;
 		real_t weight_scale = 1.0;
 
-		// Used for pathfinding.
-		Point *prev_point = nullptr;
-		real_t g_score = 0;
-		real_t f_score = 0;
-		uint64_t open_pass = 0;
-		uint64_t closed_pass = 0;
+		// Used for jumping, indexed by `JumpDirection`. The number of cells to the next jump point in that direction,
+		// or, when not positive, minus the number of walkable cells before a wall or the region edge.
+		int32_t jump_distances[4] = {};
 
 		Point() {}
 
@@ -95,8 +94,38 @@ private:
 				id(p_id), pos(p_pos) {}
 	};
 
+	// Used for pathfinding, kept per query so several queries can be solved at the same time.
+	struct PointState {
+		Point *point = nullptr;
+		PointState *prev_point = nullptr;
+		real_t g_score = 0;
+		real_t f_score = 0;
+		uint32_t open_pass = 0;
+		uint32_t closed_pass = 0;
+	};
+
+	struct SolveState {
+		LocalVector<PointState> point_states;
+		uint32_t pass = 0;
+
+		void begin(uint32_t p_point_count);
+	};
+
+	// Solve states of the queries that ran at the same time, reused by the next ones.
+	// They are sized for the grid, so they are freed when it is updated, cleared or freed.
+	LocalVector<SolveState *> solve_state_pool;
+	BinaryMutex solve_state_pool_mutex;
+
+	struct SolveStateLease {
+		AStarGrid2D *grid = nullptr;
+		SolveState *state = nullptr;
+
+		SolveStateLease(AStarGrid2D *p_grid);
+		~SolveStateLease();
+	};
+
 	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
+		_FORCE_INLINE_ bool operator()(const PointState *A, const PointState *B) const { // Returns true when the Point A is worse than Point B.
 			if (A->f_score > B->f_score) {
 				return true;
 			} else if (A->f_score < B->f_score) {
@@ -108,9 +137,23 @@ private:
 	};
 
 	LocalVector<LocalVector<Point>> points;
-	Point *end = nullptr;
 
-	uint64_t pass = 1;
+	enum JumpDirection {
+		JUMP_DIRECTION_RIGHT,
+		JUMP_DIRECTION_DOWN,
+		JUMP_DIRECTION_LEFT,
+		JUMP_DIRECTION_UP,
+	};
+
+	// The jump distances are computed again before the next query when the solid points or the diagonal mode changed.
+	SafeFlag jump_distances_dirty;
+	Mutex jump_distances_mutex;
+
+	struct PathBatch {
+		LocalVector<Vector2i> from_ids;
+		LocalVector<Vector2i> to_ids;
+		LocalVector<Vector<Vector2>> paths;
+	};
 
 private: // Internal routines.
 	_FORCE_INLINE_ bool _is_walkable(int32_t p_x, int32_t p_y) const {
@@ -139,9 +182,30 @@ private: // Internal routines.
 		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
 	}
 
+	_FORCE_INLINE_ PointState *_get_point_state(SolveState &r_state, Point *p_point) const {
+		PointState *point_state = &r_state.point_states[(p_point->id.y - region.position.y) * region.size.x + p_point->id.x - region.position.x];
+		point_state->point = p_point;
+		return point_state;
+	}
+
+	static _FORCE_INLINE_ JumpDirection _get_jump_direction(int32_t p_dx, int32_t p_dy) {
+		if (p_dx != 0) {
+			return p_dx > 0 ? JUMP_DIRECTION_RIGHT : JUMP_DIRECTION_LEFT;
+		}
+		return p_dy > 0 ? JUMP_DIRECTION_DOWN : JUMP_DIRECTION_UP;
+	}
+
 	void _get_nbors(Point *p_point, LocalVector<Point *> &r_nbors);
-	Point *_jump(Point *p_from, Point *p_to);
-	bool _solve(Point *p_begin_point, Point *p_end_point);
+	bool _is_straight_jump_point(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const;
+	void _update_jump_distance(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy);
+	void _update_jump_distances();
+	void _ensure_jump_distances();
+	Point *_jump_straight(Point *p_from, int32_t p_dx, int32_t p_dy, const Point *p_end);
+	Point *_jump(Point *p_from, Point *p_to, const Point *p_end);
+	bool _solve(Point *p_begin_point, Point *p_end_point, SolveState &r_state);
+	Vector<Vector2> _get_point_path(const Vector2i &p_from_id, const Vector2i &p_to_id, SolveState &r_state);
+	void _solve_batch_path(uint32_t p_index, PathBatch *p_batch);
+	void _free_solve_states();
 
 protected:
 	static void _bind_methods();
@@ -200,6 +264,9 @@ public:
 	Vector2 get_point_position(const Vector2i &p_id) const;
 	Vector<Vector2> get_point_path(const Vector2i &p_from, const Vector2i &p_to);
 	TypedArray<Vector2i> get_id_path(const Vector2i &p_from, const Vector2i &p_to);
+	TypedArray<PackedVector2Array> get_point_paths(const TypedArray<Vector2i> &p_from_ids, const TypedArray<Vector2i> &p_to_ids);
+
+	~AStarGrid2D();
 };
 
 VARIANT_ENUM_CAST(AStarGrid2D::DiagonalMode);
@@ -52,6 +52,7 @@
 // and pairable_mask is either 0 if static, or set to all if non static
 
 #include "bvh_tree.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -88,6 +89,21 @@ public:
 		tree.params_set_pairing_expansion(p_value);
 	}
 
+	// SIMD culling is on by default where the platform supports it, this is mainly for comparison.
+	void params_set_simd_culling(bool p_enable) {
+		BVH_LOCKED_FUNCTION
+		tree._simd_culling = p_enable;
+	}
+
+	// Pair detection of the changed items can be split across the WorkerThreadPool.
+	// Only the tree queries run in parallel. Leavers and pair callbacks are still processed on the calling
+	// thread, in the same order as the serial path, so the resulting pairs are the same.
+	void params_set_parallel_pairing(bool p_enable, uint32_t p_min_changed_items = 128) {
+		BVH_LOCKED_FUNCTION
+		_parallel_pairing = p_enable;
+		_parallel_pairing_min_items = MAX(p_min_changed_items, 1u);
+	}
+
 	void set_pair_callback(PairCallback p_callback, void *p_userdata) {
 		BVH_LOCKED_FUNCTION
 		pair_callback = p_callback;
@@ -345,9 +361,12 @@ public:
 	}
 
 	// cull tests
-	int cull_aabb(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
-		BVH_LOCKED_FUNCTION
+	// The culls that are given a list to store their hits don't use the one of the tree, nor lock it,
+	// so several can run at the same time, as long as the tree isn't modified.
+	int cull_aabb(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr, LocalVector<uint32_t, uint32_t, true> *r_hits = nullptr) {
+		BVHLockedFunction _lock_guard(&_mutex, BVH_THREAD_SAFE && _thread_safe && !r_hits);
 		typename BVHTREE_CLASS::CullParams params;
+		params.hits = r_hits;
 
 		params.result_count_overall = 0;
 		params.result_max = p_result_max;
@@ -362,9 +381,10 @@ public:
 		return params.result_count_overall;
 	}
 
-	int cull_segment(const POINT &p_from, const POINT &p_to, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
-		BVH_LOCKED_FUNCTION
+	int cull_segment(const POINT &p_from, const POINT &p_to, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr, LocalVector<uint32_t, uint32_t, true> *r_hits = nullptr) {
+		BVHLockedFunction _lock_guard(&_mutex, BVH_THREAD_SAFE && _thread_safe && !r_hits);
 		typename BVHTREE_CLASS::CullParams params;
+		params.hits = r_hits;
 
 		params.result_count_overall = 0;
 		params.result_max = p_result_max;
@@ -430,6 +450,11 @@ public:
 private:
 	// do this after moving etc.
 	void _check_for_collisions(bool p_full_check = false) {
+		if (_changed_item_hits.size() > changed_items.size() * 2) {
+			// Don't hold on to the hit lists of a burst of changed items once it's over.
+			_changed_item_hits.reset();
+		}
+
 		if (!changed_items.size()) {
 			// noop
 			return;
@@ -444,26 +469,43 @@ private:
 		params.result_array = nullptr;
 		params.subindex_array = nullptr;
 
-		for (const BVHHandle &h : changed_items) {
+		// The tree queries don't depend on the pairing state, so they can all be done upfront in parallel,
+		// and then merged here in order.
+		bool parallel = _parallel_pairing && changed_items.size() >= _parallel_pairing_min_items && WorkerThreadPool::get_singleton()->get_thread_count() > 1;
+		if (parallel) {
+			if (_changed_item_hits.size() < changed_items.size()) {
+				_changed_item_hits.resize(changed_items.size());
+			}
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_cull_changed_item_threaded, nullptr, changed_items.size(), -1, true, SNAME("BVHPairing"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		}
+
+		for (uint32_t i = 0; i < changed_items.size(); i++) {
+			const BVHHandle &h = changed_items[i];
+
 			// use the expanded aabb for pairing
 			const BOUNDS &expanded_aabb = tree._pairs[h.id()].expanded_aabb;
 			BVHABB_CLASS abb;
 			abb.from(expanded_aabb);
 
-			tree.item_fill_cullparams(h, params);
-
 			// find all the existing paired aabbs that are no longer
 			// paired, and send callbacks
 			_find_leavers(h, abb, p_full_check);
 
 			uint32_t changed_item_ref_id = h.id();
 
-			params.abb = abb;
+			const LocalVector<uint32_t, uint32_t, true> *hits = &tree._cull_hits;
+			if (parallel) {
+				hits = &_changed_item_hits[i];
+			} else {
+				tree.item_fill_cullparams(h, params);
+				params.abb = abb;
 
-			params.result_count_overall = 0; // might not be needed
-			tree.cull_aabb(params, false);
+				params.result_count_overall = 0; // might not be needed
+				tree.cull_aabb(params, false);
+			}
 
-			for (const uint32_t ref_id : tree._cull_hits) {
+			for (const uint32_t ref_id : *hits) {
 				// don't collide against ourself
 				if (ref_id == changed_item_ref_id) {
 					continue;
@@ -480,6 +522,21 @@ private:
 		_reset();
 	}
 
+	void _cull_changed_item_threaded(uint32_t p_index, void *p_userdata) {
+		const BVHHandle &h = changed_items[p_index];
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+		params.hits = &_changed_item_hits[p_index];
+
+		tree.item_fill_cullparams(h, params);
+		params.abb.from(tree._pairs[h.id()].expanded_aabb);
+		tree.cull_aabb(params, false);
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -773,6 +830,11 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// for parallel pairing, the cull hits of each changed item
+	bool _parallel_pairing = false;
+	uint32_t _parallel_pairing_min_items = 128;
+	LocalVector<LocalVector<uint32_t, uint32_t, true>> _changed_item_hits;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
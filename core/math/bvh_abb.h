@@ -31,6 +31,18 @@
 #ifndef BVH_ABB_H
 #define BVH_ABB_H
 
+// SIMD versions of the hottest tests are used where available.
+// They rely on the float layout of the ABB, so they are not used with doubles.
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BVH_ABB_SIMD_SSE2
+#include <emmintrin.h>
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#define BVH_ABB_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif // REAL_T_IS_DOUBLE
+
 // special optimized version of axis aligned bounding box
 template <class BOUNDS = AABB, class POINT = Vector3>
 struct BVH_ABB {
@@ -57,6 +69,28 @@ struct BVH_ABB {
 	POINT min;
 	POINT neg_max;
 
+	// Tests many ABBs against the same pre-swizzled tester, with SIMD where available.
+	class SwizzledTester;
+	// Same for intersects_segment() and intersects_convex_optimized(), with SIMD in 3D.
+	class SegmentTester;
+	class ConvexTester;
+
+	// Pre-swizzled tester for intersects(), i.e. swizzled.intersects_swizzled(o) == intersects(o).
+	BVH_ABB get_swizzled() const {
+		BVH_ABB swizzled;
+		swizzled.min = -neg_max;
+		swizzled.neg_max = -min;
+		return swizzled;
+	}
+
+	// Pre-swizzled tester for intersects_point().
+	static BVH_ABB get_swizzled_point(const POINT &p_pt) {
+		BVH_ABB swizzled;
+		swizzled.min = p_pt;
+		swizzled.neg_max = -p_pt;
+		return swizzled;
+	}
+
 	bool operator==(const BVH_ABB &o) const { return (min == o.min) && (neg_max == o.neg_max); }
 	bool operator!=(const BVH_ABB &o) const { return (*this == o) == false; }
 
@@ -289,4 +323,365 @@ struct BVH_ABB {
 	}
 };
 
+// Tests many ABBs against the same pre-swizzled tester (see intersects_swizzled()).
+// With the negated max, an ABB passes when each of its components is less or equal
+// than the matching component of the tester, which is a single SIMD comparison
+// of the whole ABB (6 floats in 3D, 4 in 2D). Falls back to scalar code otherwise.
+template <class BOUNDS, class POINT>
+class BVH_ABB<BOUNDS, POINT>::SwizzledTester {
+	BVH_ABB abb;
+#if defined(BVH_ABB_SIMD_SSE2) || defined(BVH_ABB_SIMD_NEON)
+	static constexpr bool SIMD = sizeof(BVH_ABB) == 6 * sizeof(float) || sizeof(BVH_ABB) == 4 * sizeof(float);
+	static constexpr bool SIMD_3D = sizeof(BVH_ABB) == 6 * sizeof(float);
+#ifdef BVH_ABB_SIMD_SSE2
+	__m128 lo;
+	__m128 hi;
+#else
+	float32x4_t lo;
+	float32x4_t hi;
+#endif
+#else
+	static constexpr bool SIMD = false;
+#endif
+
+public:
+	bool simd_enabled = true;
+
+	_FORCE_INLINE_ void set(const BVH_ABB &p_swizzled) {
+		abb = p_swizzled;
+#ifdef BVH_ABB_SIMD_SSE2
+		if constexpr (SIMD) {
+			const float *f = (const float *)&abb;
+			lo = _mm_loadu_ps(f);
+			// In 3D the two loads overlap, which is harmless for the comparison.
+			hi = SIMD_3D ? _mm_loadu_ps(f + 2) : lo;
+		}
+#elif defined(BVH_ABB_SIMD_NEON)
+		if constexpr (SIMD) {
+			const float *f = (const float *)&abb;
+			lo = vld1q_f32(f);
+			hi = SIMD_3D ? vld1q_f32(f + 2) : lo;
+		}
+#endif
+	}
+
+	// Same result as abb.intersects_swizzled(p_o).
+	_FORCE_INLINE_ bool test(const BVH_ABB &p_o) const {
+#ifdef BVH_ABB_SIMD_SSE2
+		if constexpr (SIMD) {
+			if (likely(simd_enabled)) {
+				const float *f = (const float *)&p_o;
+				__m128 miss = _mm_cmplt_ps(lo, _mm_loadu_ps(f));
+				if constexpr (SIMD_3D) {
+					miss = _mm_or_ps(miss, _mm_cmplt_ps(hi, _mm_loadu_ps(f + 2)));
+				}
+				return _mm_movemask_ps(miss) == 0;
+			}
+		}
+#elif defined(BVH_ABB_SIMD_NEON)
+		if constexpr (SIMD) {
+			if (likely(simd_enabled)) {
+				const float *f = (const float *)&p_o;
+				uint32x4_t miss = vcltq_f32(lo, vld1q_f32(f));
+				if constexpr (SIMD_3D) {
+					miss = vorrq_u32(miss, vcltq_f32(hi, vld1q_f32(f + 2)));
+				}
+				return vmaxvq_u32(miss) == 0;
+			}
+		}
+#endif
+		return abb.intersects_swizzled(p_o);
+	}
+
+	// Tests p_count consecutive ABBs, writing the indices of those that pass to r_indices.
+	// Returns how many passed.
+	_FORCE_INLINE_ uint32_t test_batch(const BVH_ABB *p_abbs, uint32_t p_count, uint32_t *r_indices) const {
+		uint32_t count = 0;
+		for (uint32_t n = 0; n < p_count; n++) {
+			// Branchless, so the loop doesn't mispredict on random hits.
+			r_indices[count] = n;
+			count += test(p_abbs[n]) ? 1 : 0;
+		}
+		return count;
+	}
+};
+
+// Tests many ABBs against the same segment, with the same results as intersects_segment().
+// The SIMD version follows the scalar slab test lane by lane (with divisions rather than
+// reciprocals, and the ABB converted the same way as to()), so it doesn't differ on the edges.
+// It's only used in 3D; in 2D the segment test of the bounds is used as is.
+template <class BOUNDS, class POINT>
+class BVH_ABB<BOUNDS, POINT>::SegmentTester {
+	Segment segment;
+#if defined(BVH_ABB_SIMD_SSE2) || defined(BVH_ABB_SIMD_NEON)
+	static constexpr bool SIMD = sizeof(BVH_ABB) == 6 * sizeof(float);
+#ifdef BVH_ABB_SIMD_SSE2
+	__m128 from;
+	__m128 length;
+	__m128 forward; // Lanes where the segment goes towards the end of the axis.
+	__m128 seg_begin;
+	__m128 seg_end;
+	__m128 valid; // The x, y and z lanes where the segment has a length.
+#else
+	float32x4_t from;
+	float32x4_t length;
+	uint32x4_t forward;
+	float32x4_t seg_begin;
+	float32x4_t seg_end;
+	uint32x4_t valid;
+#endif
+#else
+	static constexpr bool SIMD = false;
+#endif
+
+public:
+	bool simd_enabled = true;
+
+	_FORCE_INLINE_ void set(const Segment &p_segment) {
+		segment = p_segment;
+#ifdef BVH_ABB_SIMD_SSE2
+		if constexpr (SIMD) {
+			const float *f = (const float *)&segment.from;
+			const float *t = (const float *)&segment.to;
+			from = _mm_setr_ps(f[0], f[1], f[2], 0.0f);
+			const __m128 to = _mm_setr_ps(t[0], t[1], t[2], 0.0f);
+			length = _mm_sub_ps(to, from);
+			forward = _mm_cmplt_ps(from, to);
+			seg_begin = _mm_or_ps(_mm_and_ps(forward, from), _mm_andnot_ps(forward, to));
+			seg_end = _mm_or_ps(_mm_and_ps(forward, to), _mm_andnot_ps(forward, from));
+			valid = _mm_and_ps(_mm_cmpneq_ps(length, _mm_setzero_ps()), _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0)));
+		}
+#elif defined(BVH_ABB_SIMD_NEON)
+		if constexpr (SIMD) {
+			const float *f = (const float *)&segment.from;
+			const float *t = (const float *)&segment.to;
+			const float from_lanes[4] = { f[0], f[1], f[2], 0.0f };
+			const float to_lanes[4] = { t[0], t[1], t[2], 0.0f };
+			const uint32_t xyz_lanes[4] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0 };
+			from = vld1q_f32(from_lanes);
+			const float32x4_t to = vld1q_f32(to_lanes);
+			length = vsubq_f32(to, from);
+			forward = vcltq_f32(from, to);
+			seg_begin = vbslq_f32(forward, from, to);
+			seg_end = vbslq_f32(forward, to, from);
+			valid = vandq_u32(vmvnq_u32(vceqq_f32(length, vdupq_n_f32(0.0f))), vld1q_u32(xyz_lanes));
+		}
+#endif
+	}
+
+	_FORCE_INLINE_ bool test(const BVH_ABB &p_o) const {
+#ifdef BVH_ABB_SIMD_SSE2
+		if constexpr (SIMD) {
+			if (likely(simd_enabled)) {
+				const float *f = (const float *)&p_o;
+				const __m128 zero = _mm_setzero_ps();
+				const __m128 one = _mm_set1_ps(1.0f);
+				// Lane 3 of both is unused.
+				const __m128 begin = _mm_loadu_ps(f);
+				__m128 neg_max = _mm_loadu_ps(f + 2);
+				neg_max = _mm_shuffle_ps(neg_max, neg_max, _MM_SHUFFLE(0, 3, 2, 1));
+				const __m128 end = _mm_add_ps(begin, _mm_sub_ps(_mm_xor_ps(neg_max, _mm_set1_ps(-0.0f)), begin));
+
+				const __m128 miss = _mm_or_ps(_mm_cmpgt_ps(seg_begin, end), _mm_cmplt_ps(seg_end, begin));
+				if (_mm_movemask_ps(miss) & 7) {
+					return false;
+				}
+
+				// Where the segment enters and leaves each slab, clamped to the segment.
+				const __m128 entry_bound = _mm_or_ps(_mm_and_ps(forward, begin), _mm_andnot_ps(forward, end));
+				const __m128 exit_bound = _mm_or_ps(_mm_and_ps(forward, end), _mm_andnot_ps(forward, begin));
+				__m128 enter = _mm_and_ps(_mm_max_ps(_mm_div_ps(_mm_sub_ps(entry_bound, from), length), zero), valid);
+				__m128 leave = _mm_or_ps(_mm_and_ps(valid, _mm_min_ps(_mm_div_ps(_mm_sub_ps(exit_bound, from), length), one)), _mm_andnot_ps(valid, one));
+
+				enter = _mm_max_ps(enter, _mm_shuffle_ps(enter, enter, _MM_SHUFFLE(2, 3, 0, 1)));
+				enter = _mm_max_ps(enter, _mm_shuffle_ps(enter, enter, _MM_SHUFFLE(1, 0, 3, 2)));
+				leave = _mm_min_ps(leave, _mm_shuffle_ps(leave, leave, _MM_SHUFFLE(2, 3, 0, 1)));
+				leave = _mm_min_ps(leave, _mm_shuffle_ps(leave, leave, _MM_SHUFFLE(1, 0, 3, 2)));
+				return !(_mm_cvtss_f32(leave) < _mm_cvtss_f32(enter));
+			}
+		}
+#elif defined(BVH_ABB_SIMD_NEON)
+		if constexpr (SIMD) {
+			if (likely(simd_enabled)) {
+				const float *f = (const float *)&p_o;
+				const float32x4_t zero = vdupq_n_f32(0.0f);
+				const float32x4_t one = vdupq_n_f32(1.0f);
+				// Lane 3 of both is unused.
+				const float32x4_t begin = vld1q_f32(f);
+				const float32x4_t neg_max = vextq_f32(vld1q_f32(f + 2), vld1q_f32(f + 2), 1);
+				const float32x4_t end = vaddq_f32(begin, vsubq_f32(vnegq_f32(neg_max), begin));
+
+				const uint32x4_t miss = vorrq_u32(vcgtq_f32(seg_begin, end), vcltq_f32(seg_end, begin));
+				if (vgetq_lane_u32(miss, 0) | vgetq_lane_u32(miss, 1) | vgetq_lane_u32(miss, 2)) {
+					return false;
+				}
+
+				// Where the segment enters and leaves each slab, clamped to the segment.
+				const float32x4_t entry_bound = vbslq_f32(forward, begin, end);
+				const float32x4_t exit_bound = vbslq_f32(forward, end, begin);
+				const float32x4_t enter = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vmaxnmq_f32(vdivq_f32(vsubq_f32(entry_bound, from), length), zero)), valid));
+				const float32x4_t leave = vbslq_f32(valid, vminnmq_f32(vdivq_f32(vsubq_f32(exit_bound, from), length), one), one);
+				return !(vminvq_f32(leave) < vmaxvq_f32(enter));
+			}
+		}
+#endif
+		return p_o.intersects_segment(segment);
+	}
+
+	// Tests p_count consecutive ABBs, writing the indices of those that pass to r_indices.
+	// Returns how many passed.
+	_FORCE_INLINE_ uint32_t test_batch(const BVH_ABB *p_abbs, uint32_t p_count, uint32_t *r_indices) const {
+		uint32_t count = 0;
+		for (uint32_t n = 0; n < p_count; n++) {
+			r_indices[count] = n;
+			count += test(p_abbs[n]) ? 1 : 0;
+		}
+		return count;
+	}
+};
+
+// Tests many ABBs against the planes of a convex hull that cut a node, with the same
+// results as intersects_convex_optimized(). The SIMD version tests 4 planes at a time,
+// computing each support point and its distance the same way as the scalar code.
+// It's only used in 3D.
+template <class BOUNDS, class POINT>
+class BVH_ABB<BOUNDS, POINT>::ConvexTester {
+	const ConvexHull *hull = nullptr;
+	const uint32_t *plane_ids = nullptr;
+	uint32_t num_planes = 0;
+#if defined(BVH_ABB_SIMD_SSE2) || defined(BVH_ABB_SIMD_NEON)
+	static constexpr bool SIMD = sizeof(BVH_ABB) == 6 * sizeof(float);
+#else
+	static constexpr bool SIMD = false;
+#endif
+	// Groups of 4 planes, as normal x, y and z, and d, each 4 wide.
+	// Unused lanes hold planes nothing can be over.
+	float *groups = nullptr;
+	uint32_t num_groups = 0;
+
+public:
+	bool simd_enabled = true;
+
+	// Size of the storage for the plane groups, which the caller allocates on the stack.
+	static uint32_t get_storage_size(uint32_t p_max_planes) {
+		return sizeof(float) * 16 * ((p_max_planes + 3) / 4);
+	}
+
+	ConvexTester(const ConvexHull &p_hull, void *p_storage) {
+		hull = &p_hull;
+		groups = (float *)p_storage;
+	}
+
+	// Sets the planes to test, which must be at most as many as the storage was allocated for.
+	_FORCE_INLINE_ void set_planes(const uint32_t *p_plane_ids, uint32_t p_num_planes) {
+		plane_ids = p_plane_ids;
+		num_planes = p_num_planes;
+		if constexpr (SIMD) {
+			num_groups = (p_num_planes + 3) / 4;
+			for (uint32_t i = 0; i < num_groups * 4; i++) {
+				float *group = groups + (i / 4) * 16;
+				const uint32_t lane = i % 4;
+				if (i < p_num_planes) {
+					const Plane &p = hull->planes[p_plane_ids[i]];
+					group[lane] = p.normal.x;
+					group[4 + lane] = p.normal.y;
+					group[8 + lane] = p.normal.z;
+					group[12 + lane] = p.d;
+				} else {
+					group[lane] = 0.0f;
+					group[4 + lane] = 0.0f;
+					group[8 + lane] = 0.0f;
+					group[12 + lane] = FLT_MAX;
+				}
+			}
+		}
+	}
+
+	_FORCE_INLINE_ bool test(const BVH_ABB &p_o) const {
+#if defined(BVH_ABB_SIMD_SSE2) || defined(BVH_ABB_SIMD_NEON)
+		if constexpr (SIMD) {
+			if (likely(simd_enabled)) {
+				const Vector3 size = p_o.calculate_size();
+				const Vector3 half_extents = size * 0.5;
+				const Vector3 ofs = p_o.min + half_extents;
+#ifdef BVH_ABB_SIMD_SSE2
+				const __m128 zero = _mm_setzero_ps();
+				const __m128 ofs_x = _mm_set1_ps(ofs.x);
+				const __m128 ofs_y = _mm_set1_ps(ofs.y);
+				const __m128 ofs_z = _mm_set1_ps(ofs.z);
+				const __m128 half_x = _mm_set1_ps(half_extents.x);
+				const __m128 half_y = _mm_set1_ps(half_extents.y);
+				const __m128 half_z = _mm_set1_ps(half_extents.z);
+				const __m128 neg_half_x = _mm_set1_ps(-half_extents.x);
+				const __m128 neg_half_y = _mm_set1_ps(-half_extents.y);
+				const __m128 neg_half_z = _mm_set1_ps(-half_extents.z);
+
+				for (uint32_t g = 0; g < num_groups; g++) {
+					const float *group = groups + g * 16;
+					const __m128 normal_x = _mm_loadu_ps(group);
+					const __m128 normal_y = _mm_loadu_ps(group + 4);
+					const __m128 normal_z = _mm_loadu_ps(group + 8);
+
+					// The corner furthest behind each plane.
+					__m128 positive = _mm_cmpgt_ps(normal_x, zero);
+					const __m128 point_x = _mm_add_ps(_mm_or_ps(_mm_and_ps(positive, neg_half_x), _mm_andnot_ps(positive, half_x)), ofs_x);
+					positive = _mm_cmpgt_ps(normal_y, zero);
+					const __m128 point_y = _mm_add_ps(_mm_or_ps(_mm_and_ps(positive, neg_half_y), _mm_andnot_ps(positive, half_y)), ofs_y);
+					positive = _mm_cmpgt_ps(normal_z, zero);
+					const __m128 point_z = _mm_add_ps(_mm_or_ps(_mm_and_ps(positive, neg_half_z), _mm_andnot_ps(positive, half_z)), ofs_z);
+
+					const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(normal_x, point_x), _mm_mul_ps(normal_y, point_y)), _mm_mul_ps(normal_z, point_z));
+					if (_mm_movemask_ps(_mm_cmpgt_ps(distance, _mm_loadu_ps(group + 12)))) {
+						return false;
+					}
+				}
+				return true;
+#else
+				const float32x4_t zero = vdupq_n_f32(0.0f);
+				const float32x4_t ofs_x = vdupq_n_f32(ofs.x);
+				const float32x4_t ofs_y = vdupq_n_f32(ofs.y);
+				const float32x4_t ofs_z = vdupq_n_f32(ofs.z);
+				const float32x4_t half_x = vdupq_n_f32(half_extents.x);
+				const float32x4_t half_y = vdupq_n_f32(half_extents.y);
+				const float32x4_t half_z = vdupq_n_f32(half_extents.z);
+				const float32x4_t neg_half_x = vdupq_n_f32(-half_extents.x);
+				const float32x4_t neg_half_y = vdupq_n_f32(-half_extents.y);
+				const float32x4_t neg_half_z = vdupq_n_f32(-half_extents.z);
+
+				for (uint32_t g = 0; g < num_groups; g++) {
+					const float *group = groups + g * 16;
+					const float32x4_t normal_x = vld1q_f32(group);
+					const float32x4_t normal_y = vld1q_f32(group + 4);
+					const float32x4_t normal_z = vld1q_f32(group + 8);
+
+					// The corner furthest behind each plane.
+					const float32x4_t point_x = vaddq_f32(vbslq_f32(vcgtq_f32(normal_x, zero), neg_half_x, half_x), ofs_x);
+					const float32x4_t point_y = vaddq_f32(vbslq_f32(vcgtq_f32(normal_y, zero), neg_half_y, half_y), ofs_y);
+					const float32x4_t point_z = vaddq_f32(vbslq_f32(vcgtq_f32(normal_z, zero), neg_half_z, half_z), ofs_z);
+
+					const float32x4_t distance = vaddq_f32(vaddq_f32(vmulq_f32(normal_x, point_x), vmulq_f32(normal_y, point_y)), vmulq_f32(normal_z, point_z));
+					if (vmaxvq_u32(vcgtq_f32(distance, vld1q_f32(group + 12))) != 0) {
+						return false;
+					}
+				}
+				return true;
+#endif
+			}
+		}
+#endif
+		return p_o.intersects_convex_optimized(*hull, plane_ids, num_planes);
+	}
+
+	// Tests p_count consecutive ABBs, writing the indices of those that pass to r_indices.
+	// Returns how many passed.
+	_FORCE_INLINE_ uint32_t test_batch(const BVH_ABB *p_abbs, uint32_t p_count, uint32_t *r_indices) const {
+		uint32_t count = 0;
+		for (uint32_t n = 0; n < p_count; n++) {
+			r_indices[count] = n;
+			count += test(p_abbs[n]) ? 1 : 0;
+		}
+		return count;
+	}
+};
+
 #endif // BVH_ABB_H
@@ -386,6 +386,12 @@ bool DynamicBVH::update(const ID &p_id, const AABB &p_box) {
 	return true;
 }
 
+AABB DynamicBVH::get_aabb(const ID &p_id) const {
+	ERR_FAIL_COND_V(!p_id.is_valid(), AABB());
+	const Volume &volume = p_id.node->volume;
+	return AABB(volume.min, volume.max - volume.min);
+}
+
 void DynamicBVH::remove(const ID &p_id) {
 	ERR_FAIL_COND(!p_id.is_valid());
 	Node *leaf = p_id.node;
@@ -103,7 +103,13 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (do_post) {
-			p_task->group->done_semaphore.post();
+			if (p_task->group->graph) {
+				// Nobody waits for groups belonging to a graph, so this thread also acts as the waiting user.
+				_release_task_graph_node(p_task->group->graph, p_task->group->graph_node);
+				p_task->group->finished.increment();
+			} else {
+				p_task->group->done_semaphore.post();
+			}
 			p_task->group->completed.set_to(true);
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
@@ -130,17 +136,24 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			p_task->callable.call();
 		}
 
-		task_mutex.lock();
-		p_task->completed = true;
-		p_task->pool_thread_index = -1;
-		if (p_task->waiting_user) {
-			p_task->done_semaphore.post(p_task->waiting_user);
-		}
-		// Let awaiters know.
-		for (uint32_t i = 0; i < threads.size(); i++) {
-			if (threads[i].awaited_task == p_task) {
-				threads[i].cond_var.notify_one();
-				threads[i].signaled = true;
+		if (p_task->graph) {
+			_release_task_graph_node(p_task->graph, p_task->graph_node);
+			// Like group tasks, these are not awaited individually, so they get rid of themselves.
+			task_mutex.lock();
+			task_allocator.free(p_task);
+		} else {
+			task_mutex.lock();
+			p_task->completed = true;
+			p_task->pool_thread_index = -1;
+			if (p_task->waiting_user) {
+				p_task->done_semaphore.post(p_task->waiting_user);
+			}
+			// Let awaiters know.
+			for (uint32_t i = 0; i < threads.size(); i++) {
+				if (threads[i].awaited_task == p_task) {
+					threads[i].cond_var.notify_one();
+					threads[i].signaled = true;
+				}
 			}
 		}
 	}
@@ -167,9 +180,14 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
+	bool work_stealing = singleton->scheduler_mode == SCHEDULER_MODE_WORK_STEALING;
 	while (true) {
 		Task *task_to_process = nullptr;
-		{
+		if (work_stealing) {
+			// Fast path, not touching the pool mutex.
+			task_to_process = singleton->_pop_or_steal_task(thread_data);
+		}
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 			if (singleton->exit_threads) {
 				return;
@@ -179,6 +197,9 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 			if (singleton->task_queue.first()) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
+			} else if (work_stealing && (task_to_process = singleton->_pop_or_steal_task(thread_data))) {
+				// Posting always happens with the mutex locked, so checking again here
+				// ensures no task is left behind before going to sleep.
 			} else {
 				thread_data->cond_var.wait(lock);
 				DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
@@ -211,7 +232,10 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
-		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
+		if (p_high_priority && scheduler_mode == SCHEDULER_MODE_WORK_STEALING) {
+			_push_local_task(caller_pool_thread, p_tasks[i]);
+			to_process++;
+		} else if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
 			task_queue.add_last(&p_tasks[i]->task_elem);
 			if (!p_high_priority) {
 				low_priority_threads_used++;
@@ -305,6 +329,75 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+void WorkerThreadPool::_push_local_task(ThreadData *p_caller_pool_thread, Task *p_task) {
+	// Pool threads push onto their own deque, which needs no locking.
+	if (p_caller_pool_thread && p_caller_pool_thread->local_tasks.push(p_task)) {
+		return;
+	}
+
+	// Other threads (or a full deque) go through the injection list of some pool thread,
+	// rotating to spread the load. Its owner will move them to its deque when it runs out of work.
+	ThreadData *target = p_caller_pool_thread;
+	if (!target) {
+		target = &threads[inject_index];
+		inject_index = (inject_index + 1) % threads.size();
+	}
+	MutexLock lock(target->injected_tasks_mutex);
+	target->injected_tasks.add_last(&p_task->task_elem);
+}
+
+bool WorkerThreadPool::_take_injected_task(ThreadData &p_from, ThreadData *p_to, Task *&r_task) {
+	MutexLock lock(p_from.injected_tasks_mutex);
+	if (!p_from.injected_tasks.first()) {
+		return false;
+	}
+
+	r_task = p_from.injected_tasks.first()->self();
+	p_from.injected_tasks.remove(p_from.injected_tasks.first());
+
+	if (&p_from == p_to) {
+		// Own list: move the rest to the deque, so they can be stolen without locking.
+		while (p_from.injected_tasks.first()) {
+			Task *task = p_from.injected_tasks.first()->self();
+			if (!p_to->local_tasks.push(task)) {
+				break;
+			}
+			p_from.injected_tasks.remove(p_from.injected_tasks.first());
+		}
+	}
+	return true;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_pop_or_steal_task(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+
+	if (p_thread_data->local_tasks.pop(task)) {
+		return task;
+	}
+	if (_take_injected_task(*p_thread_data, p_thread_data, task)) {
+		return task;
+	}
+
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thread_data->index + i) % thread_count];
+		// Stealing may fail because of contention, so keep trying while there seems to be something.
+		while (!victim.local_tasks.is_empty()) {
+			if (victim.local_tasks.steal(task)) {
+				return task;
+			}
+		}
+	}
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thread_data->index + i) % thread_count];
+		if (_take_injected_task(victim, p_thread_data, task)) {
+			return task;
+		}
+	}
+
+	return nullptr;
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
@@ -400,7 +493,7 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 					// This thread was awaken also for some reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
 					if (!exit_threads && was_signaled) {
-						uint32_t to_process = task_queue.first() ? 1 : 0;
+						uint32_t to_process = task_queue.first() || (scheduler_mode == SCHEDULER_MODE_WORK_STEALING && !caller_pool_thread->local_tasks.is_empty()) ? 1 : 0;
 						uint32_t to_promote = caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 						if (to_process || to_promote) {
 							// This thread must be left alone since it won't loop again.
@@ -428,7 +521,11 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 						}
 					}
 
-					if (singleton->task_queue.first()) {
+					if (scheduler_mode == SCHEDULER_MODE_WORK_STEALING) {
+						task_to_process = _pop_or_steal_task(caller_pool_thread);
+					}
+
+					if (!task_to_process && singleton->task_queue.first()) {
 						task_to_process = task_queue.first()->self();
 						task_queue.remove(task_queue.first());
 					}
@@ -582,6 +679,242 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 #endif
 }
 
+void WorkerThreadPool::_post_task_graph_node(TaskGraphRun *p_graph, uint32_t p_node) {
+	const TaskGraph::Node &node = p_graph->nodes[p_node];
+
+	if (node.elements == 0) {
+		// Empty group, nothing to run.
+		if (node.template_userdata) {
+			memdelete(node.template_userdata);
+		}
+		_release_task_graph_node(p_graph, p_node);
+		return;
+	}
+
+	task_mutex.lock();
+
+	if (node.elements < 0) {
+		Task *task = task_allocator.alloc();
+		// Not awaitable, but it needs an ID so waits from it on older tasks are rejected like for any task.
+		task->self = last_task++;
+		task->callable = node.callable;
+		task->native_func = node.native_func;
+		task->native_func_userdata = node.native_func_userdata;
+		task->template_userdata = node.template_userdata;
+		task->description = node.description;
+		task->graph = p_graph;
+		task->graph_node = p_node;
+
+		_post_tasks_and_unlock(&task, 1, p_graph->high_priority);
+	} else {
+		int task_count = node.tasks < 0 ? MAX(1u, threads.size()) : MAX(node.tasks, 1);
+
+		Group *group = group_allocator.alloc();
+		group->max = node.elements;
+		group->tasks_used = task_count;
+		group->graph = p_graph;
+		group->graph_node = p_node;
+
+		Task **tasks_posted = (Task **)alloca(sizeof(Task *) * task_count);
+		for (int i = 0; i < task_count; i++) {
+			Task *task = task_allocator.alloc();
+			task->native_group_func = node.native_group_func;
+			task->native_func_userdata = node.native_func_userdata;
+			task->description = node.description;
+			task->group = group;
+			task->callable = node.callable;
+			task->template_userdata = node.template_userdata;
+			tasks_posted[i] = task;
+		}
+
+		_post_tasks_and_unlock(tasks_posted, task_count, p_graph->high_priority);
+	}
+}
+
+void WorkerThreadPool::_release_task_graph_node(TaskGraphRun *p_graph, uint32_t p_node) {
+	for (uint32_t successor : p_graph->nodes[p_node].successors) {
+		if (p_graph->pending_predecessors[successor].decrement() == 0) {
+			_post_task_graph_node(p_graph, successor);
+		}
+	}
+
+	if (p_graph->pending_nodes.decrement() == 0) {
+		p_graph->completed.set();
+		p_graph->done_semaphore.post();
+		_finish_task_graph_user(p_graph);
+	}
+}
+
+void WorkerThreadPool::_finish_task_graph_user(TaskGraphRun *p_graph) {
+	// The waiter may wake up as soon as the semaphore is posted, while the posting
+	// thread is still using it, so whichever of both is done last frees the graph.
+	if (p_graph->finished.increment() == 2) {
+		memdelete(p_graph);
+	}
+}
+
+WorkerThreadPool::TaskGraphID WorkerThreadPool::submit_task_graph(TaskGraph &p_graph, bool p_high_priority) {
+	uint32_t node_count = p_graph.nodes.size();
+
+	// Validate the graph is acyclic (Kahn's algorithm), so it's guaranteed to complete.
+	{
+		LocalVector<uint32_t> in_degree;
+		LocalVector<uint32_t> ready;
+		in_degree.resize(node_count);
+		for (uint32_t i = 0; i < node_count; i++) {
+			in_degree[i] = p_graph.nodes[i].predecessor_count;
+			if (in_degree[i] == 0) {
+				ready.push_back(i);
+			}
+		}
+		uint32_t visited = 0;
+		while (ready.size()) {
+			uint32_t node = ready[ready.size() - 1];
+			ready.resize(ready.size() - 1);
+			visited++;
+			for (uint32_t successor : p_graph.nodes[node].successors) {
+				if (--in_degree[successor] == 0) {
+					ready.push_back(successor);
+				}
+			}
+		}
+		ERR_FAIL_COND_V_MSG(visited != node_count, INVALID_TASK_ID, "Task graph has circular dependencies.");
+	}
+
+	TaskGraphRun *graph = memnew(TaskGraphRun);
+	graph->nodes = p_graph.nodes;
+	graph->pending_predecessors.resize(node_count);
+	for (uint32_t i = 0; i < node_count; i++) {
+		graph->pending_predecessors[i].set(graph->nodes[i].predecessor_count);
+	}
+	graph->pending_nodes.set(node_count);
+	graph->high_priority = p_high_priority;
+
+	// Ownership of template userdata is now on the submitted graph.
+	p_graph.nodes.clear();
+
+	task_mutex.lock();
+	TaskGraphID id = last_task++;
+	graph->self = id;
+	task_graphs.insert(id, graph);
+	task_mutex.unlock();
+
+	if (node_count == 0) {
+		graph->completed.set();
+		graph->done_semaphore.post();
+		_finish_task_graph_user(graph);
+		return id;
+	}
+
+	// Nodes may start completing (and even the whole graph) while roots are still being posted,
+	// so only immutable data is read here.
+	for (uint32_t i = 0; i < node_count; i++) {
+		if (graph->nodes[i].predecessor_count == 0) {
+			_post_task_graph_node(graph, i);
+		}
+	}
+
+	return id;
+}
+
+bool WorkerThreadPool::is_task_graph_completed(TaskGraphID p_graph) const {
+	MutexLock lock(task_mutex);
+	TaskGraphRun *const *graphp = task_graphs.getptr(p_graph);
+	ERR_FAIL_NULL_V_MSG(graphp, false, "Invalid Task Graph ID.");
+	return (*graphp)->completed.is_set();
+}
+
+void WorkerThreadPool::wait_for_task_graph_completion(TaskGraphID p_graph) {
+	TaskGraphRun *graph = nullptr;
+	{
+		MutexLock lock(task_mutex);
+		TaskGraphRun **graphp = task_graphs.getptr(p_graph);
+		ERR_FAIL_NULL_MSG(graphp, "Invalid Task Graph ID.");
+		graph = *graphp;
+	}
+
+	if (flushing_cmd_queue) {
+		flushing_cmd_queue->unlock();
+	}
+	graph->done_semaphore.wait();
+	if (flushing_cmd_queue) {
+		flushing_cmd_queue->lock();
+	}
+
+	{
+		MutexLock lock(task_mutex);
+		task_graphs.erase(p_graph);
+	}
+	_finish_task_graph_user(graph);
+}
+
+uint32_t WorkerThreadPool::TaskGraph::_add_node(const Node &p_node, const uint32_t *p_predecessors, uint32_t p_predecessor_count) {
+	NodeID id = nodes.size();
+	nodes.push_back(p_node);
+	for (uint32_t i = 0; i < p_predecessor_count; i++) {
+		add_dependency(id, p_predecessors[i]);
+	}
+	return id;
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_native_task(void (*p_func)(void *), void *p_userdata, const LocalVector<NodeID> &p_predecessors, const String &p_description) {
+	Node node;
+	node.native_func = p_func;
+	node.native_func_userdata = p_userdata;
+	node.description = p_description;
+	return _add_node(node, p_predecessors.ptr(), p_predecessors.size());
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_task(const Callable &p_action, const LocalVector<NodeID> &p_predecessors, const String &p_description) {
+	Node node;
+	node.callable = p_action;
+	node.description = p_description;
+	return _add_node(node, p_predecessors.ptr(), p_predecessors.size());
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, const LocalVector<NodeID> &p_predecessors, const String &p_description) {
+	Node node;
+	node.native_group_func = p_func;
+	node.native_func_userdata = p_userdata;
+	node.elements = MAX(p_elements, 0);
+	node.tasks = p_tasks;
+	node.description = p_description;
+	return _add_node(node, p_predecessors.ptr(), p_predecessors.size());
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_group_task(const Callable &p_action, int p_elements, int p_tasks, const LocalVector<NodeID> &p_predecessors, const String &p_description) {
+	Node node;
+	node.callable = p_action;
+	node.elements = MAX(p_elements, 0);
+	node.tasks = p_tasks;
+	node.description = p_description;
+	return _add_node(node, p_predecessors.ptr(), p_predecessors.size());
+}
+
+void WorkerThreadPool::TaskGraph::add_dependency(NodeID p_node, NodeID p_predecessor) {
+	ERR_FAIL_UNSIGNED_INDEX(p_node, nodes.size());
+	ERR_FAIL_UNSIGNED_INDEX(p_predecessor, nodes.size());
+	ERR_FAIL_COND_MSG(p_node == p_predecessor, "A task graph node can't depend on itself.");
+	if (nodes[p_predecessor].successors.find(p_node) != -1) {
+		return;
+	}
+	nodes[p_predecessor].successors.push_back(p_node);
+	nodes[p_node].predecessor_count++;
+}
+
+void WorkerThreadPool::TaskGraph::clear() {
+	for (Node &node : nodes) {
+		if (node.template_userdata) {
+			memdelete(node.template_userdata);
+		}
+	}
+	nodes.clear();
+}
+
+WorkerThreadPool::TaskGraph::~TaskGraph() {
+	clear();
+}
+
 int WorkerThreadPool::get_thread_index() {
 	Thread::ID tid = Thread::get_caller_id();
 	return singleton->thread_ids.has(tid) ? singleton->thread_ids[tid] : -1;
@@ -597,13 +930,16 @@ void WorkerThreadPool::thread_exit_command_queue_mt_flush() {
 	flushing_cmd_queue = nullptr;
 }
 
-void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio) {
+void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio, SchedulerMode p_scheduler_mode) {
 	ERR_FAIL_COND(threads.size() > 0);
 	if (p_thread_count < 0) {
 		p_thread_count = OS::get_singleton()->get_default_thread_pool_size();
 	}
 
 	max_low_priority_threads = CLAMP(p_thread_count * p_low_priority_task_ratio, 1, p_thread_count - 1);
+	low_priority_threads_used = 0;
+	scheduler_mode = p_scheduler_mode;
+	exit_threads = false;
 
 	threads.resize(p_thread_count);
 
@@ -644,9 +980,13 @@ void WorkerThreadPool::finish() {
 		for (KeyValue<TaskID, Task *> &E : tasks) {
 			task_allocator.free(E.value);
 		}
+		tasks.clear();
 	}
 
 	threads.clear();
+	thread_ids.clear();
+	notify_index = 0;
+	inject_index = 0;
 }
 
 void WorkerThreadPool::_bind_methods() {
@@ -40,6 +40,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
 
 class CommandQueueMT;
 
@@ -52,9 +53,16 @@ public:
 
 	typedef int64_t TaskID;
 	typedef int64_t GroupID;
+	typedef int64_t TaskGraphID;
+
+	enum SchedulerMode {
+		SCHEDULER_MODE_SHARED_QUEUE, // All tasks go through a single queue guarded by the pool mutex.
+		SCHEDULER_MODE_WORK_STEALING, // High priority tasks go to per-thread deques; idle threads steal from others.
+	};
 
 private:
 	struct Task;
+	struct TaskGraphRun;
 
 	struct BaseTemplateUserdata {
 		virtual void callback() {}
@@ -62,6 +70,96 @@ private:
 		virtual ~BaseTemplateUserdata() {}
 	};
 
+	template <class C, class M, class U>
+	struct TaskUserData : public BaseTemplateUserdata {
+		C *instance;
+		M method;
+		U userdata;
+		virtual void callback() override {
+			(instance->*method)(userdata);
+		}
+	};
+
+	template <class C, class M, class U>
+	struct GroupUserData : public BaseTemplateUserdata {
+		C *instance;
+		M method;
+		U userdata;
+		virtual void callback_indexed(uint32_t p_index) override {
+			(instance->*method)(p_index, userdata);
+		}
+	};
+
+public:
+	// Describes a set of tasks and group tasks with dependencies between them, to be submitted at once
+	// with submit_task_graph(). Each node is posted as soon as all its predecessors are complete,
+	// so independent chains progress without the caller having to wait between phases.
+	// Build it from a single thread; it can be discarded once submitted.
+	class TaskGraph {
+		friend class WorkerThreadPool;
+
+		struct Node {
+			Callable callable;
+			void (*native_func)(void *) = nullptr;
+			void (*native_group_func)(void *, uint32_t) = nullptr;
+			void *native_func_userdata = nullptr;
+			BaseTemplateUserdata *template_userdata = nullptr;
+			String description;
+			int elements = -1; // Negative for single tasks.
+			int tasks = -1;
+			uint32_t predecessor_count = 0;
+			LocalVector<uint32_t> successors;
+		};
+
+		LocalVector<Node> nodes;
+
+		uint32_t _add_node(const Node &p_node, const uint32_t *p_predecessors, uint32_t p_predecessor_count);
+
+	public:
+		typedef uint32_t NodeID;
+
+		// Predecessors must be nodes already added to this graph. Use add_dependency() for anything else.
+		NodeID add_native_task(void (*p_func)(void *), void *p_userdata, const LocalVector<NodeID> &p_predecessors = LocalVector<NodeID>(), const String &p_description = String());
+		NodeID add_task(const Callable &p_action, const LocalVector<NodeID> &p_predecessors = LocalVector<NodeID>(), const String &p_description = String());
+		template <class C, class M, class U>
+		NodeID add_template_task(C *p_instance, M p_method, U p_userdata, const LocalVector<NodeID> &p_predecessors = LocalVector<NodeID>(), const String &p_description = String()) {
+			typedef TaskUserData<C, M, U> TUD;
+			TUD *ud = memnew(TUD);
+			ud->instance = p_instance;
+			ud->method = p_method;
+			ud->userdata = p_userdata;
+			Node node;
+			node.template_userdata = ud;
+			node.description = p_description;
+			return _add_node(node, p_predecessors.ptr(), p_predecessors.size());
+		}
+
+		NodeID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, const LocalVector<NodeID> &p_predecessors = LocalVector<NodeID>(), const String &p_description = String());
+		NodeID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, const LocalVector<NodeID> &p_predecessors = LocalVector<NodeID>(), const String &p_description = String());
+		template <class C, class M, class U>
+		NodeID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, const LocalVector<NodeID> &p_predecessors = LocalVector<NodeID>(), const String &p_description = String()) {
+			typedef GroupUserData<C, M, U> GroupUD;
+			GroupUD *ud = memnew(GroupUD);
+			ud->instance = p_instance;
+			ud->method = p_method;
+			ud->userdata = p_userdata;
+			Node node;
+			node.template_userdata = ud;
+			node.elements = MAX(p_elements, 0);
+			node.tasks = p_tasks;
+			node.description = p_description;
+			return _add_node(node, p_predecessors.ptr(), p_predecessors.size());
+		}
+
+		void add_dependency(NodeID p_node, NodeID p_predecessor);
+
+		_FORCE_INLINE_ uint32_t get_node_count() const { return nodes.size(); }
+		void clear();
+
+		~TaskGraph();
+	};
+
+private:
 	struct Group {
 		GroupID self = -1;
 		SafeNumeric<uint32_t> index;
@@ -71,6 +169,8 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		TaskGraphRun *graph = nullptr;
+		uint32_t graph_node = 0;
 	};
 
 	struct Task {
@@ -89,14 +189,29 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		TaskGraphRun *graph = nullptr;
+		uint32_t graph_node = 0;
 
 		void free_template_userdata();
 		Task() :
 				task_elem(this) {}
 	};
 
+	// A submitted TaskGraph.
+	struct TaskGraphRun {
+		TaskGraphID self = -1;
+		LocalVector<TaskGraph::Node> nodes;
+		LocalVector<SafeNumeric<uint32_t>> pending_predecessors;
+		SafeNumeric<uint32_t> pending_nodes;
+		bool high_priority = false;
+		Semaphore done_semaphore;
+		SafeFlag completed;
+		SafeNumeric<uint32_t> finished; // The last node and the waiter are both users; the last one to finish frees the graph.
+	};
+
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t LOCAL_TASKS_CAPACITY = 1024;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -114,10 +229,16 @@ private:
 		Task *current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable. Special value for idle-waiting.
 		ConditionVariable cond_var;
+
+		// Work-stealing mode only.
+		WorkStealingDeque<Task *, LOCAL_TASKS_CAPACITY> local_tasks; // Pushed only by this thread, stolen by anyone.
+		BinaryMutex injected_tasks_mutex;
+		SelfList<Task>::List injected_tasks; // Posted from threads outside the pool, or overflow of local_tasks.
 	};
 
 	TightLocalVector<ThreadData> threads;
 	bool exit_threads = false;
+	SchedulerMode scheduler_mode = SCHEDULER_MODE_SHARED_QUEUE;
 
 	HashMap<Thread::ID, int> thread_ids;
 	HashMap<
@@ -134,10 +255,12 @@ private:
 			HashMapComparatorDefault<GroupID>,
 			PagedAllocator<HashMapElement<GroupID, Group *>, false, GROUPS_PAGE_SIZE>>
 			groups;
+	HashMap<TaskGraphID, TaskGraphRun *> task_graphs;
 
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
+	uint32_t inject_index = 0; // For rotating across threads when posting from outside the pool.
 
 	uint64_t last_task = 1;
 
@@ -150,6 +273,14 @@ private:
 
 	bool _try_promote_low_priority_task();
 
+	void _push_local_task(ThreadData *p_caller_pool_thread, Task *p_task);
+	bool _take_injected_task(ThreadData &p_from, ThreadData *p_to, Task *&r_task);
+	Task *_pop_or_steal_task(ThreadData *p_thread_data);
+
+	void _post_task_graph_node(TaskGraphRun *p_graph, uint32_t p_node);
+	void _release_task_graph_node(TaskGraphRun *p_graph, uint32_t p_node);
+	void _finish_task_graph_user(TaskGraphRun *p_graph);
+
 	static WorkerThreadPool *singleton;
 
 	static thread_local CommandQueueMT *flushing_cmd_queue;
@@ -157,26 +288,6 @@ private:
 	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
 	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
 
-	template <class C, class M, class U>
-	struct TaskUserData : public BaseTemplateUserdata {
-		C *instance;
-		M method;
-		U userdata;
-		virtual void callback() override {
-			(instance->*method)(userdata);
-		}
-	};
-
-	template <class C, class M, class U>
-	struct GroupUserData : public BaseTemplateUserdata {
-		C *instance;
-		M method;
-		U userdata;
-		virtual void callback_indexed(uint32_t p_index) override {
-			(instance->*method)(p_index, userdata);
-		}
-	};
-
 protected:
 	static void _bind_methods();
 
@@ -211,7 +322,13 @@ public:
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
+	TaskGraphID submit_task_graph(TaskGraph &p_graph, bool p_high_priority = false);
+	bool is_task_graph_completed(TaskGraphID p_graph) const;
+	// Waits until every sink node (and hence every node) of the graph is complete.
+	void wait_for_task_graph_completion(TaskGraphID p_graph);
+
 	_FORCE_INLINE_ int get_thread_count() const { return threads.size(); }
+	_FORCE_INLINE_ SchedulerMode get_scheduler_mode() const { return scheduler_mode; }
 
 	static WorkerThreadPool *get_singleton() { return singleton; }
 	static int get_thread_index();
@@ -219,7 +336,7 @@ public:
 	static void thread_enter_command_queue_mt_flush(CommandQueueMT *p_queue);
 	static void thread_exit_command_queue_mt_flush();
 
-	void init(int p_thread_count = -1, float p_low_priority_task_ratio = 0.3);
+	void init(int p_thread_count = -1, float p_low_priority_task_ratio = 0.3, SchedulerMode p_scheduler_mode = SCHEDULER_MODE_SHARED_QUEUE);
 	void finish();
 	WorkerThreadPool();
 	~WorkerThreadPool();
@@ -0,0 +1,361 @@
+/**************************************************************************/
+/*  small_allocator.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "small_allocator.h"
+
+#include "core/os/spin_lock.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+static constexpr uint32_t SPAN_BITS = 16;
+static constexpr size_t SPAN_SIZE = size_t(1) << SPAN_BITS;
+
+// Spans are found through a two level page map covering 48 bit addresses.
+static constexpr uint32_t ADDRESS_BITS = 48;
+static constexpr uint32_t LEAF_BITS = 16;
+static constexpr uint32_t ROOT_BITS = ADDRESS_BITS - SPAN_BITS - LEAF_BITS;
+
+static constexpr size_t CLASS_SIZES[SmallAllocator::CLASS_COUNT] = { 16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512 };
+
+// Size class for each multiple of 16 bytes up to MAX_SIZE.
+struct SmallAllocatorClassTable {
+	uint8_t classes[SmallAllocator::MAX_SIZE / 16 + 1] = {};
+
+	constexpr SmallAllocatorClassTable() {
+		uint32_t size_class = 0;
+		for (uint32_t i = 0; i <= SmallAllocator::MAX_SIZE / 16; i++) {
+			while (CLASS_SIZES[size_class] < i * 16) {
+				size_class++;
+			}
+			classes[i] = size_class;
+		}
+	}
+};
+
+static constexpr SmallAllocatorClassTable class_table;
+
+// Everything below is constant initialized, so the allocator works before
+// static constructors run, and after static destructors ran.
+struct alignas(64) SmallAllocatorCentralList {
+	SpinLock lock;
+	void *free_head = nullptr;
+	uint64_t free_count = 0;
+	uint8_t *span_cursor = nullptr;
+	uint8_t *span_end = nullptr;
+	uint64_t span_count = 0;
+};
+
+static SmallAllocatorCentralList central_lists[SmallAllocator::CLASS_COUNT];
+
+// Leaves hold the size class plus one of each span, or zero if it's not a span.
+static std::atomic<uint8_t *> page_map[1 << ROOT_BITS];
+static SpinLock page_map_lock;
+
+struct SmallAllocatorFreeList {
+	void *head = nullptr;
+	uint32_t count = 0;
+};
+
+struct SmallAllocatorThreadCache {
+	SmallAllocatorFreeList lists[SmallAllocator::CLASS_COUNT];
+	bool destroyed = false;
+
+	~SmallAllocatorThreadCache();
+};
+
+// Frees that happen after the cache of the thread was destroyed go straight to the central lists.
+static thread_local SmallAllocatorThreadCache thread_cache;
+
+static _FORCE_INLINE_ uint32_t _get_class(size_t p_bytes) {
+	return class_table.classes[(p_bytes + 15) >> 4];
+}
+
+// Number of blocks moved between a thread cache and the central list at once.
+static _FORCE_INLINE_ uint32_t _get_batch_size(uint32_t p_class) {
+	return CLAMP(uint32_t(4096 / CLASS_SIZES[p_class]), 8u, 64u);
+}
+
+static _FORCE_INLINE_ void *&_next(void *p_block) {
+	return *static_cast<void **>(p_block);
+}
+
+static uint32_t _get_span_class(const void *p_memory) {
+	const uint64_t address = uint64_t(uintptr_t(p_memory));
+	if (address >> ADDRESS_BITS) {
+		return 0;
+	}
+	const uint64_t span = address >> SPAN_BITS;
+	const uint8_t *leaf = page_map[span >> LEAF_BITS].load(std::memory_order_acquire);
+	return leaf ? leaf[span & ((1 << LEAF_BITS) - 1)] : 0;
+}
+
+static uint8_t *_allocate_span(uint32_t p_class) {
+	void *span = nullptr;
+#ifdef _WIN32
+	span = _aligned_malloc(SPAN_SIZE, SPAN_SIZE);
+#else
+	if (posix_memalign(&span, SPAN_SIZE, SPAN_SIZE) != 0) {
+		span = nullptr;
+	}
+#endif
+	if (span == nullptr) {
+		return nullptr;
+	}
+
+	const uint64_t address = uint64_t(uintptr_t(span));
+	uint8_t *leaf = nullptr;
+	if (!(address >> ADDRESS_BITS)) {
+		const uint64_t index = address >> SPAN_BITS;
+		page_map_lock.lock();
+		leaf = page_map[index >> LEAF_BITS].load(std::memory_order_relaxed);
+		if (leaf == nullptr) {
+			leaf = static_cast<uint8_t *>(calloc(1 << LEAF_BITS, 1));
+			page_map[index >> LEAF_BITS].store(leaf, std::memory_order_release);
+		}
+		if (leaf != nullptr) {
+			leaf[index & ((1 << LEAF_BITS) - 1)] = p_class + 1;
+		}
+		page_map_lock.unlock();
+	}
+
+	if (leaf == nullptr) {
+		// Outside of the page map, or out of memory.
+#ifdef _WIN32
+		_aligned_free(span);
+#else
+		::free(span);
+#endif
+		return nullptr;
+	}
+	return static_cast<uint8_t *>(span);
+}
+
+// Moves up to p_count blocks from the central list into r_list, carving new ones from spans if needed.
+static void _refill(uint32_t p_class, SmallAllocatorFreeList &r_list, uint32_t p_count) {
+	SmallAllocatorCentralList &central = central_lists[p_class];
+	const size_t size = CLASS_SIZES[p_class];
+
+	central.lock.lock();
+	uint32_t count = 0;
+	while (count < p_count && central.free_head) {
+		void *block = central.free_head;
+		central.free_head = _next(block);
+		_next(block) = r_list.head;
+		r_list.head = block;
+		count++;
+	}
+	central.free_count -= count;
+
+	while (count < p_count) {
+		if (central.span_cursor + size > central.span_end) {
+			uint8_t *span = _allocate_span(p_class);
+			if (span == nullptr) {
+				break;
+			}
+			// The rest of the previous span is too small for a block, and is lost.
+			central.span_cursor = span;
+			central.span_end = span + SPAN_SIZE;
+			central.span_count++;
+		}
+		void *block = central.span_cursor;
+		central.span_cursor += size;
+		_next(block) = r_list.head;
+		r_list.head = block;
+		count++;
+	}
+	central.lock.unlock();
+
+	r_list.count += count;
+}
+
+// Moves the first p_count blocks of r_list to the central list.
+static void _release(uint32_t p_class, SmallAllocatorFreeList &r_list, uint32_t p_count) {
+	void *head = r_list.head;
+	void *tail = head;
+	for (uint32_t i = 1; i < p_count; i++) {
+		tail = _next(tail);
+	}
+	r_list.head = _next(tail);
+	r_list.count -= p_count;
+
+	SmallAllocatorCentralList &central = central_lists[p_class];
+	central.lock.lock();
+	_next(tail) = central.free_head;
+	central.free_head = head;
+	central.free_count += p_count;
+	central.lock.unlock();
+}
+
+SmallAllocatorThreadCache::~SmallAllocatorThreadCache() {
+	for (uint32_t i = 0; i < SmallAllocator::CLASS_COUNT; i++) {
+		if (lists[i].count) {
+			_release(i, lists[i], lists[i].count);
+		}
+	}
+	destroyed = true;
+}
+
+void *SmallAllocator::alloc(size_t p_bytes) {
+	if (p_bytes > MAX_SIZE) {
+		return ::malloc(p_bytes);
+	}
+
+	const uint32_t size_class = _get_class(p_bytes);
+	SmallAllocatorThreadCache &cache = thread_cache;
+	SmallAllocatorFreeList single;
+	SmallAllocatorFreeList &list = likely(!cache.destroyed) ? cache.lists[size_class] : single;
+
+	if (unlikely(list.head == nullptr)) {
+		_refill(size_class, list, likely(!cache.destroyed) ? _get_batch_size(size_class) : 1);
+		if (list.head == nullptr) {
+			return ::malloc(CLASS_SIZES[size_class]);
+		}
+	}
+
+	void *block = list.head;
+	list.head = _next(block);
+	list.count--;
+	return block;
+}
+
+void SmallAllocator::free(void *p_memory) {
+	if (p_memory == nullptr) {
+		return;
+	}
+
+	const uint32_t span_class = _get_span_class(p_memory);
+	if (span_class == 0) {
+		::free(p_memory);
+		return;
+	}
+
+	const uint32_t size_class = span_class - 1;
+	SmallAllocatorThreadCache &cache = thread_cache;
+	if (unlikely(cache.destroyed)) {
+		SmallAllocatorFreeList single;
+		single.head = p_memory;
+		single.count = 1;
+		_next(p_memory) = nullptr;
+		_release(size_class, single, 1);
+		return;
+	}
+
+	SmallAllocatorFreeList &list = cache.lists[size_class];
+	_next(p_memory) = list.head;
+	list.head = p_memory;
+	list.count++;
+
+	const uint32_t batch_size = _get_batch_size(size_class);
+	if (unlikely(list.count > batch_size * 2)) {
+		_release(size_class, list, batch_size);
+	}
+}
+
+void *SmallAllocator::realloc(void *p_memory, size_t p_bytes) {
+	if (p_memory == nullptr) {
+		return alloc(p_bytes);
+	}
+
+	const uint32_t span_class = _get_span_class(p_memory);
+	if (span_class == 0) {
+		return ::realloc(p_memory, p_bytes);
+	}
+	if (p_bytes == 0) {
+		free(p_memory);
+		return nullptr;
+	}
+
+	const uint32_t size_class = span_class - 1;
+	if (p_bytes <= MAX_SIZE && _get_class(p_bytes) == size_class) {
+		return p_memory;
+	}
+
+	void *memory = alloc(p_bytes);
+	if (memory == nullptr) {
+		return nullptr;
+	}
+	memcpy(memory, p_memory, MIN(CLASS_SIZES[size_class], p_bytes));
+	free(p_memory);
+	return memory;
+}
+
+bool SmallAllocator::owns(const void *p_memory) {
+	return _get_span_class(p_memory) != 0;
+}
+
+size_t SmallAllocator::get_class_size(uint32_t p_class) {
+	return p_class < CLASS_COUNT ? CLASS_SIZES[p_class] : 0;
+}
+
+uint64_t SmallAllocator::get_class_reserved_bytes(uint32_t p_class) {
+	if (p_class >= CLASS_COUNT) {
+		return 0;
+	}
+	SmallAllocatorCentralList &central = central_lists[p_class];
+	central.lock.lock();
+	const uint64_t reserved = central.span_count * SPAN_SIZE;
+	central.lock.unlock();
+	return reserved;
+}
+
+uint64_t SmallAllocator::get_class_free_bytes(uint32_t p_class) {
+	if (p_class >= CLASS_COUNT) {
+		return 0;
+	}
+	SmallAllocatorCentralList &central = central_lists[p_class];
+	central.lock.lock();
+	const uint64_t free_bytes = central.free_count * CLASS_SIZES[p_class] + (central.span_end - central.span_cursor);
+	central.lock.unlock();
+	return free_bytes;
+}
+
+uint64_t SmallAllocator::get_reserved_bytes() {
+	uint64_t reserved = 0;
+	for (uint32_t i = 0; i < CLASS_COUNT; i++) {
+		reserved += get_class_reserved_bytes(i);
+	}
+	return reserved;
+}
+
+double SmallAllocator::get_fragmentation() {
+	uint64_t reserved = 0;
+	uint64_t free_bytes = 0;
+	for (uint32_t i = 0; i < CLASS_COUNT; i++) {
+		reserved += get_class_reserved_bytes(i);
+		free_bytes += get_class_free_bytes(i);
+	}
+	return reserved ? 100.0 * double(free_bytes) / double(reserved) : 0.0;
+}
@@ -0,0 +1,75 @@
+/**************************************************************************/
+/*  small_allocator.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SMALL_ALLOCATOR_H
+#define SMALL_ALLOCATOR_H
+
+#include "core/typedefs.h"
+
+#include <stddef.h>
+
+// Thread caching allocator for small blocks, used behind Memory::alloc_static()
+// when building with `small_allocator=yes`.
+//
+// Blocks up to MAX_SIZE bytes are rounded up to one of CLASS_COUNT size classes,
+// and carved from 64 KiB spans that only hold blocks of one class. Each thread
+// keeps a free list per class, refilled from and released to a central list per
+// class in batches, so most allocations and frees don't take any lock. Blocks
+// freed by another thread than the one that allocated them go to the freeing
+// thread's cache, and reach the central list (and other threads) from there.
+//
+// A page map from span address to size class lets free() and realloc() tell
+// which blocks belong to the allocator without any header. Larger blocks, and
+// blocks that don't belong to the allocator, are passed to the system allocator.
+// Spans are never returned to the system, their free blocks are reused instead.
+class SmallAllocator {
+public:
+	static constexpr uint32_t CLASS_COUNT = 16;
+	static constexpr size_t MAX_SIZE = 512;
+
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	static void free(void *p_memory);
+
+	// Returns true if p_memory is a block from this allocator, and not from the system one.
+	static bool owns(const void *p_memory);
+
+	static size_t get_class_size(uint32_t p_class);
+	// Bytes of the spans reserved for a size class, and how many of them are
+	// free in the central list. Blocks in thread caches count as used.
+	static uint64_t get_class_reserved_bytes(uint32_t p_class);
+	static uint64_t get_class_free_bytes(uint32_t p_class);
+
+	static uint64_t get_reserved_bytes();
+	// Percentage of the reserved bytes that are not in use.
+	static double get_fragmentation();
+};
+
+#endif // SMALL_ALLOCATOR_H
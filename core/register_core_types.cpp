@@ -310,6 +310,7 @@ void register_core_settings() {
 
 	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "threading/worker_pool/scheduler_mode", PROPERTY_HINT_ENUM, "Shared Queue,Work Stealing"), 0);
 }
 
 void register_core_singletons() {
@@ -48,7 +48,9 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		STRING_TABLE_SHARD_BITS = 6,
+		STRING_TABLE_SHARDS = 1 << STRING_TABLE_SHARD_BITS,
 	};
 
 	struct _Data {
@@ -69,6 +71,17 @@ class StringName {
 
 	static _Data *_table[STRING_TABLE_LEN];
 
+	// Each shard guards a contiguous range of buckets, so threads interning
+	// or releasing unrelated names don't contend on the same lock.
+	struct alignas(64) _TableShard {
+		Mutex mutex;
+	};
+	static _TableShard _table_shards[STRING_TABLE_SHARDS];
+
+	static _FORCE_INLINE_ Mutex &_get_table_mutex(uint32_t p_idx) {
+		return _table_shards[p_idx >> (STRING_TABLE_BITS - STRING_TABLE_SHARD_BITS)].mutex;
+	}
+
 	_Data *_data = nullptr;
 
 	union _HashUnion {
@@ -80,7 +93,7 @@ class StringName {
 	friend void register_core_types();
 	friend void unregister_core_types();
 	friend class Main;
-	static Mutex mutex;
+	static Mutex mutex; // Only for assign_static_unique_class_name(), the table uses the shard locks.
 	static void setup();
 	static void cleanup();
 	static bool configured;
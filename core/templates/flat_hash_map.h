@@ -0,0 +1,650 @@
+/**************************************************************************/
+/*  flat_hash_map.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#include <string.h>
+
+// Control bytes are probed a group at a time with SIMD where available.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLAT_HASH_MAP_SSE2
+#include <emmintrin.h>
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#define FLAT_HASH_MAP_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**
+ * A flat HashMap implementation, in the style of Swiss tables.
+ *
+ * Keys and values are stored inplace in a single array of slots, next to an
+ * array with one control byte per slot. A control byte is either empty,
+ * deleted, or holds 7 bits of the hash of the key in that slot. Lookups load
+ * 16 control bytes at once and compare them all against the hash bits, so the
+ * keys are only compared for likely matches and most misses never touch the
+ * slots at all.
+ *
+ * Unlike HashMap, there is no insertion order: iterating visits the slots in
+ * memory order, and inserting may move every element (invalidating iterators
+ * and pointers to values) when the table grows. Erasing leaves other elements
+ * in place, so it's safe to remove() the current element while iterating.
+ *
+ * The assignment operator copy the pairs from one map to the other.
+ */
+
+struct FlatHashMapGroup {
+	static constexpr uint32_t WIDTH = 16;
+
+	static constexpr uint8_t CTRL_EMPTY = 0x80;
+	static constexpr uint8_t CTRL_DELETED = 0xFE;
+
+	// Group masks have one set bit per matching control byte. NEON has no
+	// movemask, so there every control byte maps to 4 bits instead of 1.
+#ifdef FLAT_HASH_MAP_NEON
+	static constexpr uint32_t MASK_SHIFT = 2;
+#else
+	static constexpr uint32_t MASK_SHIFT = 0;
+#endif
+
+	static _FORCE_INLINE_ uint32_t count_trailing_zeros(uint64_t p_mask) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctzll(p_mask);
+#elif defined(_MSC_VER) && defined(_WIN64)
+		unsigned long index;
+		_BitScanForward64(&index, p_mask);
+		return index;
+#else
+		uint32_t count = 0;
+		while (!(p_mask & 1)) {
+			p_mask >>= 1;
+			count++;
+		}
+		return count;
+#endif
+	}
+
+	static _FORCE_INLINE_ uint32_t count_leading_zeros(uint64_t p_mask) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_clzll(p_mask);
+#elif defined(_MSC_VER) && defined(_WIN64)
+		unsigned long index;
+		_BitScanReverse64(&index, p_mask);
+		return 63 - index;
+#else
+		uint32_t count = 0;
+		while (!(p_mask & (uint64_t(1) << 63))) {
+			p_mask <<= 1;
+			count++;
+		}
+		return count;
+#endif
+	}
+
+	// Index in the group of the lowest match, p_mask must not be zero.
+	static _FORCE_INLINE_ uint32_t first(uint64_t p_mask) {
+		return count_trailing_zeros(p_mask) >> MASK_SHIFT;
+	}
+
+	// Number of non matching control bytes at the start of the group.
+	static _FORCE_INLINE_ uint32_t leading_misses(uint64_t p_mask) {
+		return p_mask ? first(p_mask) : WIDTH;
+	}
+
+	// Number of non matching control bytes at the end of the group.
+	static _FORCE_INLINE_ uint32_t trailing_misses(uint64_t p_mask) {
+		return p_mask ? (count_leading_zeros(p_mask) - (64 - (WIDTH << MASK_SHIFT))) >> MASK_SHIFT : WIDTH;
+	}
+
+	static _FORCE_INLINE_ uint64_t match(const uint8_t *p_ctrl, uint8_t p_h2) {
+#if defined(FLAT_HASH_MAP_SSE2)
+		const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+		return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)p_h2)));
+#elif defined(FLAT_HASH_MAP_NEON)
+		const uint8x16_t eq = vceqq_u8(vld1q_u8(p_ctrl), vdupq_n_u8(p_h2));
+		return _neon_mask(eq);
+#else
+		uint64_t mask = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			mask |= uint64_t(p_ctrl[i] == p_h2) << i;
+		}
+		return mask;
+#endif
+	}
+
+	static _FORCE_INLINE_ uint64_t match_empty(const uint8_t *p_ctrl) {
+		return match(p_ctrl, CTRL_EMPTY);
+	}
+
+	// Both empty and deleted control bytes have the high bit set, full ones don't.
+	static _FORCE_INLINE_ uint64_t match_empty_or_deleted(const uint8_t *p_ctrl) {
+#if defined(FLAT_HASH_MAP_SSE2)
+		return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl)));
+#elif defined(FLAT_HASH_MAP_NEON)
+		const uint8x16_t high = vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(p_ctrl)), vdupq_n_s8(0));
+		return _neon_mask(high);
+#else
+		uint64_t mask = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			mask |= uint64_t(p_ctrl[i] >> 7) << i;
+		}
+		return mask;
+#endif
+	}
+
+#ifdef FLAT_HASH_MAP_NEON
+	// Narrows each 0xFF/0x00 byte to a nibble, and keeps one bit per nibble.
+	static _FORCE_INLINE_ uint64_t _neon_mask(uint8x16_t p_bytes) {
+		const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(p_bytes), 4);
+		return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull;
+	}
+#endif
+};
+
+template <class TKey, class TValue,
+		class Hasher = HashMapHasherDefault,
+		class Comparator = HashMapComparatorDefault<TKey>>
+class FlatHashMap {
+public:
+	static constexpr uint32_t MIN_CAPACITY = FlatHashMapGroup::WIDTH; // Must be a power of two.
+
+private:
+	typedef FlatHashMapGroup Group;
+	typedef KeyValue<TKey, TValue> Slot;
+
+	// Keeps the control bytes and the slots in two separate arrays, so a group of
+	// control bytes is a single load. The control array has a copy of its first
+	// group appended, so groups can be loaded at any position without wrapping.
+	uint8_t *ctrl = nullptr;
+	Slot *slots = nullptr;
+
+	uint32_t capacity = 0;
+	uint32_t num_elements = 0;
+	uint32_t growth_left = 0; // Empty slots that can be used before rehashing, deleted ones don't count.
+
+	static _FORCE_INLINE_ uint32_t _get_max_load(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8;
+	}
+
+	// The low bits of the hash pick the first group to probe. The control byte
+	// uses the top bits of the hash mixed with a multiplication, so keys that
+	// land in the same group are still likely to have different control bytes.
+	static _FORCE_INLINE_ uint8_t _get_h2(uint32_t p_hash) {
+		return (uint8_t)((p_hash * 0x9E3779B1u) >> 25);
+	}
+
+	_FORCE_INLINE_ void _set_ctrl(uint32_t p_pos, uint8_t p_value) {
+		ctrl[p_pos] = p_value;
+		if (p_pos < Group::WIDTH) {
+			ctrl[capacity + p_pos] = p_value;
+		}
+	}
+
+	// Probes groups with triangular offsets, which visit every group once
+	// for power of two capacities.
+	bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (num_elements == 0) {
+			return false; // Failed lookups, no elements
+		}
+
+		const uint32_t mask = capacity - 1;
+		const uint32_t hash = Hasher::hash(p_key);
+		const uint8_t h2 = _get_h2(hash);
+		uint32_t pos = hash & mask;
+		uint32_t step = 0;
+
+		while (true) {
+			const uint8_t *group = ctrl + pos;
+			uint64_t matches = Group::match(group, h2);
+			while (matches) {
+				const uint32_t index = (pos + Group::first(matches)) & mask;
+				if (likely(Comparator::compare(slots[index].key, p_key))) {
+					r_pos = index;
+					return true;
+				}
+				matches &= matches - 1;
+			}
+
+			if (Group::match_empty(group)) {
+				return false;
+			}
+
+			step += Group::WIDTH;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	// First empty or deleted slot in the probe sequence of p_hash.
+	uint32_t _find_insert_pos(uint32_t p_hash) const {
+		const uint32_t mask = capacity - 1;
+		uint32_t pos = p_hash & mask;
+		uint32_t step = 0;
+
+		while (true) {
+			const uint64_t free = Group::match_empty_or_deleted(ctrl + pos);
+			if (free) {
+				return (pos + Group::first(free)) & mask;
+			}
+
+			step += Group::WIDTH;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	void _allocate(uint32_t p_capacity) {
+		capacity = p_capacity;
+		ctrl = static_cast<uint8_t *>(Memory::alloc_static(capacity + Group::WIDTH));
+		slots = static_cast<Slot *>(Memory::alloc_static(sizeof(Slot) * capacity));
+		memset(ctrl, Group::CTRL_EMPTY, capacity + Group::WIDTH);
+		growth_left = _get_max_load(capacity);
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		uint8_t *old_ctrl = ctrl;
+		Slot *old_slots = slots;
+		const uint32_t old_capacity = capacity;
+
+		_allocate(p_new_capacity);
+
+		if (old_ctrl == nullptr) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			if (old_ctrl[i] & Group::CTRL_EMPTY) {
+				continue; // Empty or deleted.
+			}
+
+			const uint32_t hash = Hasher::hash(old_slots[i].key);
+			const uint32_t pos = _find_insert_pos(hash);
+			_set_ctrl(pos, _get_h2(hash));
+			memnew_placement(&slots[pos], Slot(old_slots[i]));
+			old_slots[i].~Slot();
+		}
+		growth_left -= num_elements;
+
+		Memory::free_static(old_ctrl);
+		Memory::free_static(old_slots);
+	}
+
+	_FORCE_INLINE_ uint32_t _insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			slots[pos].value = p_value;
+			return pos;
+		}
+
+		if (ctrl == nullptr) {
+			_allocate(MAX(capacity, MIN_CAPACITY));
+		}
+
+		const uint32_t hash = Hasher::hash(p_key);
+		pos = _find_insert_pos(hash);
+
+		// Reusing a deleted slot doesn't make probe sequences longer.
+		if (ctrl[pos] == Group::CTRL_EMPTY) {
+			if (unlikely(growth_left == 0)) {
+				// Only grow if the table is really full, otherwise enough of it is
+				// deleted slots that rehashing at the same capacity cleans them.
+				const uint32_t new_capacity = uint64_t(num_elements) * 32 > uint64_t(capacity) * 25 ? capacity * 2 : capacity;
+				_resize_and_rehash(new_capacity);
+				pos = _find_insert_pos(hash);
+			}
+			growth_left--;
+		}
+
+		_set_ctrl(pos, _get_h2(hash));
+		memnew_placement(&slots[pos], Slot(p_key, p_value));
+		num_elements++;
+		return pos;
+	}
+
+	void _erase_pos(uint32_t p_pos) {
+		const uint32_t mask = capacity - 1;
+
+		// If the slot was never part of a full group, no probe sequence went past
+		// it, so it can become empty again instead of a tombstone.
+		const uint64_t empty_after = Group::match_empty(ctrl + p_pos);
+		const uint64_t empty_before = Group::match_empty(ctrl + ((p_pos - Group::WIDTH) & mask));
+		const bool was_never_full = empty_after && empty_before &&
+				Group::leading_misses(empty_after) + Group::trailing_misses(empty_before) < Group::WIDTH;
+
+		if (was_never_full) {
+			_set_ctrl(p_pos, Group::CTRL_EMPTY);
+			growth_left++;
+		} else {
+			_set_ctrl(p_pos, Group::CTRL_DELETED);
+		}
+
+		slots[p_pos].~Slot();
+		num_elements--;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (ctrl == nullptr) {
+			return;
+		}
+		if (num_elements != 0) {
+			for (uint32_t i = 0; i < capacity; i++) {
+				if (!(ctrl[i] & Group::CTRL_EMPTY)) {
+					slots[i].~Slot();
+				}
+			}
+		}
+
+		memset(ctrl, Group::CTRL_EMPTY, capacity + Group::WIDTH);
+		growth_left = _get_max_load(capacity);
+		num_elements = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return slots[pos].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return slots[pos].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &slots[pos].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &slots[pos].value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _pos = 0;
+		return _lookup_pos(p_key, _pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (!exists) {
+			return false;
+		}
+
+		_erase_pos(pos);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		uint32_t new_capacity = MAX(capacity, MIN_CAPACITY);
+		while (_get_max_load(new_capacity) < p_new_capacity) {
+			ERR_FAIL_COND_MSG(new_capacity >= (1u << 31), "FlatHashMap capacity overflow.");
+			new_capacity *= 2;
+		}
+
+		if (ctrl == nullptr) {
+			capacity = new_capacity;
+			return; // Unallocated yet.
+		}
+		if (new_capacity != capacity) {
+			_resize_and_rehash(new_capacity);
+		}
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return *slot;
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return slot; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			if (ctrl != ctrl_end) {
+				do {
+					ctrl++;
+					slot++;
+				} while (ctrl != ctrl_end && (*ctrl & FlatHashMapGroup::CTRL_EMPTY));
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return ctrl == b.ctrl; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return ctrl != b.ctrl; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return ctrl != ctrl_end;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const uint8_t *p_ctrl, const uint8_t *p_ctrl_end, const KeyValue<TKey, TValue> *p_slot) {
+			ctrl = p_ctrl;
+			ctrl_end = p_ctrl_end;
+			slot = p_slot;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		const uint8_t *ctrl = nullptr;
+		const uint8_t *ctrl_end = nullptr;
+		const KeyValue<TKey, TValue> *slot = nullptr;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return *slot;
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return slot; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			if (ctrl != ctrl_end) {
+				do {
+					ctrl++;
+					slot++;
+				} while (ctrl != ctrl_end && (*ctrl & FlatHashMapGroup::CTRL_EMPTY));
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return ctrl == b.ctrl; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return ctrl != b.ctrl; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return ctrl != ctrl_end;
+		}
+
+		_FORCE_INLINE_ Iterator(const uint8_t *p_ctrl, const uint8_t *p_ctrl_end, KeyValue<TKey, TValue> *p_slot) {
+			ctrl = p_ctrl;
+			ctrl_end = p_ctrl_end;
+			slot = p_slot;
+		}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return ConstIterator(ctrl, ctrl_end, slot);
+		}
+
+	private:
+		const uint8_t *ctrl = nullptr;
+		const uint8_t *ctrl_end = nullptr;
+		KeyValue<TKey, TValue> *slot = nullptr;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		if (ctrl == nullptr) {
+			return Iterator();
+		}
+		Iterator it(ctrl, ctrl + capacity, slots);
+		if (*ctrl & Group::CTRL_EMPTY) {
+			++it;
+		}
+		return it;
+	}
+	_FORCE_INLINE_ Iterator end() {
+		if (ctrl == nullptr) {
+			return Iterator();
+		}
+		return Iterator(ctrl + capacity, ctrl + capacity, slots + capacity);
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return Iterator(ctrl + pos, ctrl + capacity, slots + pos);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			_erase_pos(p_iter.operator->() - slots);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		if (ctrl == nullptr) {
+			return ConstIterator();
+		}
+		ConstIterator it(ctrl, ctrl + capacity, slots);
+		if (*ctrl & Group::CTRL_EMPTY) {
+			++it;
+		}
+		return it;
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		if (ctrl == nullptr) {
+			return ConstIterator();
+		}
+		return ConstIterator(ctrl + capacity, ctrl + capacity, slots + capacity);
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return ConstIterator(ctrl + pos, ctrl + capacity, slots + pos);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND(!exists);
+		return slots[pos].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			pos = _insert(p_key, TValue());
+		}
+		return slots[pos].value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		const uint32_t pos = _insert(p_key, p_value);
+		return Iterator(ctrl + pos, ctrl + capacity, slots + pos);
+	}
+
+	/* Constructors */
+
+	FlatHashMap(const FlatHashMap &p_other) {
+		reserve(p_other.num_elements);
+
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const FlatHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		clear();
+		reserve(p_other.num_elements);
+
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	FlatHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	FlatHashMap() {}
+
+	~FlatHashMap() {
+		clear();
+
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(slots);
+		}
+	}
+};
+
+#endif // FLAT_HASH_MAP_H
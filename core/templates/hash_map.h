@@ -157,6 +157,19 @@ private:
 		}
 	}
 
+	// The element pointers and the hashes share a single allocation, the
+	// pointers go first so both arrays are aligned.
+	void _allocate_index(uint32_t p_capacity) {
+		uint8_t *index = static_cast<uint8_t *>(Memory::alloc_static((sizeof(HashMapElement<TKey, TValue> *) + sizeof(uint32_t)) * p_capacity));
+		elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(index);
+		hashes = reinterpret_cast<uint32_t *>(index + sizeof(HashMapElement<TKey, TValue> *) * p_capacity);
+
+		for (uint32_t i = 0; i < p_capacity; i++) {
+			hashes[i] = EMPTY_HASH;
+			elements[i] = nullptr;
+		}
+	}
+
 	void _resize_and_rehash(uint32_t p_new_capacity_index) {
 		uint32_t old_capacity = hash_table_size_primes[capacity_index];
 
@@ -169,13 +182,7 @@ private:
 		uint32_t *old_hashes = hashes;
 
 		num_elements = 0;
-		hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
-		elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(Memory::alloc_static(sizeof(HashMapElement<TKey, TValue> *) * capacity));
-
-		for (uint32_t i = 0; i < capacity; i++) {
-			hashes[i] = 0;
-			elements[i] = nullptr;
-		}
+		_allocate_index(capacity);
 
 		if (old_capacity == 0) {
 			// Nothing to do.
@@ -191,21 +198,13 @@ private:
 		}
 
 		Memory::free_static(old_elements);
-		Memory::free_static(old_hashes);
 	}
 
 	_FORCE_INLINE_ HashMapElement<TKey, TValue> *_insert(const TKey &p_key, const TValue &p_value, bool p_front_insert = false) {
 		uint32_t capacity = hash_table_size_primes[capacity_index];
 		if (unlikely(elements == nullptr)) {
 			// Allocate on demand to save memory.
-
-			hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
-			elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(Memory::alloc_static(sizeof(HashMapElement<TKey, TValue> *) * capacity));
-
-			for (uint32_t i = 0; i < capacity; i++) {
-				hashes[i] = EMPTY_HASH;
-				elements[i] = nullptr;
-			}
+			_allocate_index(capacity);
 		}
 
 		uint32_t pos = 0;
@@ -616,8 +615,7 @@ public:
 		clear();
 
 		if (elements != nullptr) {
-			Memory::free_static(elements);
-			Memory::free_static(hashes);
+			Memory::free_static(elements); // Also frees the hashes.
 		}
 	}
 };
@@ -36,10 +36,12 @@
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
 
+#include <atomic>
 #include <stdio.h>
 #include <typeinfo>
 
@@ -69,46 +71,82 @@ public:
 
 template <class T, bool THREAD_SAFE = false>
 class RID_Alloc : public RID_AllocBase {
-	T **chunks = nullptr;
+	// The chunk and validator arrays are only written under the lock, and published
+	// with release stores, so when THREAD_SAFE get_or_null() and owns() can read them
+	// without locking. Growing the arrays can't free the previous ones while a reader
+	// may still be using them, so they are kept in retired_arrays until destruction.
+	std::atomic<T **> chunks = { nullptr };
 	uint32_t **free_list_chunks = nullptr;
-	uint32_t **validator_chunks = nullptr;
+	std::atomic<std::atomic<uint32_t> **> validator_chunks = { nullptr };
+	LocalVector<void *> retired_arrays;
 
 	uint32_t elements_in_chunk;
-	uint32_t max_alloc = 0;
+	uint32_t chunk_capacity = 0;
+	std::atomic<uint32_t> max_alloc = { 0 };
 	uint32_t alloc_count = 0;
 
 	const char *description = nullptr;
 
 	mutable SpinLock spin_lock;
 
+	_FORCE_INLINE_ void _release_array(void *p_array) {
+		if (!p_array) {
+			return;
+		}
+		if (THREAD_SAFE) {
+			retired_arrays.push_back(p_array);
+		} else {
+			memfree(p_array);
+		}
+	}
+
 	_FORCE_INLINE_ RID _allocate_rid() {
 		if (THREAD_SAFE) {
 			spin_lock.lock();
 		}
 
-		if (alloc_count == max_alloc) {
+		T **chunk_array = chunks.load(std::memory_order_relaxed);
+		std::atomic<uint32_t> **validator_array = validator_chunks.load(std::memory_order_relaxed);
+		uint32_t alloc_limit = max_alloc.load(std::memory_order_relaxed);
+
+		if (alloc_count == alloc_limit) {
 			//allocate a new chunk
-			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
+			uint32_t chunk_count = alloc_limit / elements_in_chunk;
 
-			//grow chunks
-			chunks = (T **)memrealloc(chunks, sizeof(T *) * (chunk_count + 1));
-			chunks[chunk_count] = (T *)memalloc(sizeof(T) * elements_in_chunk); //but don't initialize
+			if (chunk_count == chunk_capacity) {
+				//grow chunk arrays, into new ones so lock-free readers can keep using the old ones
+				chunk_capacity = chunk_capacity == 0 ? 1 : chunk_capacity * 2;
+
+				T **new_chunk_array = (T **)memalloc(sizeof(T *) * chunk_capacity);
+				std::atomic<uint32_t> **new_validator_array = (std::atomic<uint32_t> **)memalloc(sizeof(std::atomic<uint32_t> *) * chunk_capacity);
+				for (uint32_t i = 0; i < chunk_count; i++) {
+					new_chunk_array[i] = chunk_array[i];
+					new_validator_array[i] = validator_array[i];
+				}
+				_release_array(chunk_array);
+				_release_array(validator_array);
+				chunk_array = new_chunk_array;
+				validator_array = new_validator_array;
 
-			//grow validators
-			validator_chunks = (uint32_t **)memrealloc(validator_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			validator_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
-			//grow free lists
-			free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
+				//free lists are only used under the lock
+				free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * chunk_capacity);
+			}
+
+			chunk_array[chunk_count] = (T *)memalloc(sizeof(T) * elements_in_chunk); //but don't initialize
+			validator_array[chunk_count] = (std::atomic<uint32_t> *)memalloc(sizeof(std::atomic<uint32_t>) * elements_in_chunk);
 			free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
 
 			//initialize
 			for (uint32_t i = 0; i < elements_in_chunk; i++) {
 				// Don't initialize chunk.
-				validator_chunks[chunk_count][i] = 0xFFFFFFFF;
+				memnew_placement(&validator_array[chunk_count][i], std::atomic<uint32_t>(0xFFFFFFFF));
 				free_list_chunks[chunk_count][i] = alloc_count + i;
 			}
 
-			max_alloc += elements_in_chunk;
+			//publish the arrays before the indices that use them
+			chunks.store(chunk_array, std::memory_order_release);
+			validator_chunks.store(validator_array, std::memory_order_release);
+			max_alloc.store(alloc_limit + elements_in_chunk, std::memory_order_release);
 		}
 
 		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
@@ -122,9 +160,7 @@ class RID_Alloc : public RID_AllocBase {
 		id <<= 32;
 		id |= free_index;
 
-		validator_chunks[free_chunk][free_element] = validator;
-
-		validator_chunks[free_chunk][free_element] |= 0x80000000; //mark uninitialized bit
+		validator_array[free_chunk][free_element].store(validator | 0x80000000, std::memory_order_release); //mark uninitialized bit
 
 		alloc_count++;
 
@@ -156,58 +192,71 @@ public:
 		if (p_rid == RID()) {
 			return nullptr;
 		}
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
 
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
+		uint32_t validator = uint32_t(id >> 32);
+
+		if (unlikely(p_initialize)) {
 			if (THREAD_SAFE) {
-				spin_lock.unlock();
+				spin_lock.lock();
 			}
-			return nullptr;
-		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
+			if (unlikely(idx >= max_alloc.load(std::memory_order_relaxed))) {
+				if (THREAD_SAFE) {
+					spin_lock.unlock();
+				}
+				return nullptr;
+			}
 
-		uint32_t validator = uint32_t(id >> 32);
+			uint32_t idx_chunk = idx / elements_in_chunk;
+			uint32_t idx_element = idx % elements_in_chunk;
 
-		if (unlikely(p_initialize)) {
-			if (unlikely(!(validator_chunks[idx_chunk][idx_element] & 0x80000000))) {
+			std::atomic<uint32_t> &slot_validator = validator_chunks.load(std::memory_order_relaxed)[idx_chunk][idx_element];
+			uint32_t current = slot_validator.load(std::memory_order_relaxed);
+
+			if (unlikely(!(current & 0x80000000))) {
 				if (THREAD_SAFE) {
 					spin_lock.unlock();
 				}
 				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
 			}
 
-			if (unlikely((validator_chunks[idx_chunk][idx_element] & 0x7FFFFFFF) != validator)) {
+			if (unlikely((current & 0x7FFFFFFF) != validator)) {
 				if (THREAD_SAFE) {
 					spin_lock.unlock();
 				}
 				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
 			}
 
-			validator_chunks[idx_chunk][idx_element] &= 0x7FFFFFFF; //initialized
+			slot_validator.store(current & 0x7FFFFFFF, std::memory_order_release); //initialized
+
+			T *ptr = &chunks.load(std::memory_order_relaxed)[idx_chunk][idx_element];
 
-		} else if (unlikely(validator_chunks[idx_chunk][idx_element] != validator)) {
 			if (THREAD_SAFE) {
 				spin_lock.unlock();
 			}
-			if ((validator_chunks[idx_chunk][idx_element] & 0x80000000) && validator_chunks[idx_chunk][idx_element] != 0xFFFFFFFF) {
-				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
-			}
+
+			return ptr;
+		}
+
+		// Lookups don't lock, see the comment on the arrays above.
+		if (unlikely(idx >= max_alloc.load(std::memory_order_acquire))) {
 			return nullptr;
 		}
 
-		T *ptr = &chunks[idx_chunk][idx_element];
+		uint32_t idx_chunk = idx / elements_in_chunk;
+		uint32_t idx_element = idx % elements_in_chunk;
 
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
+		uint32_t current = validator_chunks.load(std::memory_order_acquire)[idx_chunk][idx_element].load(std::memory_order_acquire);
+		if (unlikely(current != validator)) {
+			if ((current & 0x80000000) && current != 0xFFFFFFFF) {
+				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
+			}
+			return nullptr;
 		}
 
-		return ptr;
+		return &chunks.load(std::memory_order_acquire)[idx_chunk][idx_element];
 	}
 	void initialize_rid(RID p_rid) {
 		T *mem = get_or_null(p_rid, true);
@@ -221,16 +270,9 @@ public:
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		if (unlikely(idx >= max_alloc.load(std::memory_order_acquire))) {
 			return false;
 		}
 
@@ -239,13 +281,8 @@ public:
 
 		uint32_t validator = uint32_t(id >> 32);
 
-		bool owned = (validator != 0x7FFFFFFF) && (validator_chunks[idx_chunk][idx_element] & 0x7FFFFFFF) == validator;
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-
-		return owned;
+		uint32_t current = validator_chunks.load(std::memory_order_acquire)[idx_chunk][idx_element].load(std::memory_order_acquire);
+		return (validator != 0x7FFFFFFF) && (current & 0x7FFFFFFF) == validator;
 	}
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
@@ -255,7 +292,7 @@ public:
 
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
+		if (unlikely(idx >= max_alloc.load(std::memory_order_relaxed))) {
 			if (THREAD_SAFE) {
 				spin_lock.unlock();
 			}
@@ -266,20 +303,22 @@ public:
 		uint32_t idx_element = idx % elements_in_chunk;
 
 		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(validator_chunks[idx_chunk][idx_element] & 0x80000000)) {
+		std::atomic<uint32_t> &slot_validator = validator_chunks.load(std::memory_order_relaxed)[idx_chunk][idx_element];
+		uint32_t current = slot_validator.load(std::memory_order_relaxed);
+		if (unlikely(current & 0x80000000)) {
 			if (THREAD_SAFE) {
 				spin_lock.unlock();
 			}
 			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
-		} else if (unlikely(validator_chunks[idx_chunk][idx_element] != validator)) {
+		} else if (unlikely(current != validator)) {
 			if (THREAD_SAFE) {
 				spin_lock.unlock();
 			}
 			ERR_FAIL();
 		}
 
-		chunks[idx_chunk][idx_element].~T();
-		validator_chunks[idx_chunk][idx_element] = 0xFFFFFFFF; // go invalid
+		chunks.load(std::memory_order_relaxed)[idx_chunk][idx_element].~T();
+		slot_validator.store(0xFFFFFFFF, std::memory_order_release); // go invalid
 
 		alloc_count--;
 		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
@@ -296,8 +335,10 @@ public:
 		if (THREAD_SAFE) {
 			spin_lock.lock();
 		}
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+		uint32_t alloc_limit = max_alloc.load(std::memory_order_relaxed);
+		std::atomic<uint32_t> **validator_array = validator_chunks.load(std::memory_order_relaxed);
+		for (size_t i = 0; i < alloc_limit; i++) {
+			uint64_t validator = validator_array[i / elements_in_chunk][i % elements_in_chunk].load(std::memory_order_relaxed);
 			if (validator != 0xFFFFFFFF) {
 				p_owned->push_back(_make_from_id((validator << 32) | i));
 			}
@@ -313,8 +354,10 @@ public:
 			spin_lock.lock();
 		}
 		uint32_t idx = 0;
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+		uint32_t alloc_limit = max_alloc.load(std::memory_order_relaxed);
+		std::atomic<uint32_t> **validator_array = validator_chunks.load(std::memory_order_relaxed);
+		for (size_t i = 0; i < alloc_limit; i++) {
+			uint64_t validator = validator_array[i / elements_in_chunk][i % elements_in_chunk].load(std::memory_order_relaxed);
 			if (validator != 0xFFFFFFFF) {
 				p_rid_buffer[idx] = _make_from_id((validator << 32) | i);
 				idx++;
@@ -334,32 +377,40 @@ public:
 	}
 
 	~RID_Alloc() {
+		T **chunk_array = chunks.load(std::memory_order_relaxed);
+		std::atomic<uint32_t> **validator_array = validator_chunks.load(std::memory_order_relaxed);
+		uint32_t alloc_limit = max_alloc.load(std::memory_order_relaxed);
+
 		if (alloc_count) {
 			print_error(vformat("ERROR: %d RID allocations of type '%s' were leaked at exit.",
 					alloc_count, description ? description : typeid(T).name()));
 
-			for (size_t i = 0; i < max_alloc; i++) {
-				uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+			for (size_t i = 0; i < alloc_limit; i++) {
+				uint64_t validator = validator_array[i / elements_in_chunk][i % elements_in_chunk].load(std::memory_order_relaxed);
 				if (validator & 0x80000000) {
 					continue; //uninitialized
 				}
 				if (validator != 0xFFFFFFFF) {
-					chunks[i / elements_in_chunk][i % elements_in_chunk].~T();
+					chunk_array[i / elements_in_chunk][i % elements_in_chunk].~T();
 				}
 			}
 		}
 
-		uint32_t chunk_count = max_alloc / elements_in_chunk;
+		uint32_t chunk_count = alloc_limit / elements_in_chunk;
 		for (uint32_t i = 0; i < chunk_count; i++) {
-			memfree(chunks[i]);
-			memfree(validator_chunks[i]);
+			memfree(chunk_array[i]);
+			memfree(validator_array[i]);
 			memfree(free_list_chunks[i]);
 		}
 
-		if (chunks) {
-			memfree(chunks);
+		if (chunk_array) {
+			memfree(chunk_array);
 			memfree(free_list_chunks);
-			memfree(validator_chunks);
+			memfree(validator_array);
+		}
+
+		for (void *array : retired_arrays) {
+			memfree(array);
 		}
 	}
 };
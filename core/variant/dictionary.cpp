@@ -39,10 +39,52 @@
 #include "core/variant/type_info.h"
 #include "core/variant/variant_internal.h"
 
+// Most dictionaries only hold a few entries, so the first elements are taken
+// from a single chunk allocated along with the first one, instead of one heap
+// allocation each. Elements never move, so pointers to values stay valid.
+class DictionaryElementAllocator {
+	typedef HashMapElement<Variant, Variant> Element;
+
+	static constexpr uint32_t CHUNK_SIZE = 8;
+
+	Element *chunk = nullptr;
+	uint32_t chunk_used = 0; // Bit mask of the chunk slots in use.
+
+public:
+	template <class... Args>
+	_FORCE_INLINE_ Element *new_allocation(const Args &&...p_args) {
+		if (unlikely(chunk == nullptr)) {
+			chunk = static_cast<Element *>(Memory::alloc_static(sizeof(Element) * CHUNK_SIZE));
+		}
+		for (uint32_t i = 0; i < CHUNK_SIZE; i++) {
+			if (!(chunk_used & (1 << i))) {
+				chunk_used |= 1 << i;
+				return memnew_placement(&chunk[i], Element(p_args...));
+			}
+		}
+		return memnew(Element(p_args...));
+	}
+
+	_FORCE_INLINE_ void delete_allocation(Element *p_allocation) {
+		if (p_allocation >= chunk && p_allocation < chunk + CHUNK_SIZE) {
+			p_allocation->~Element();
+			chunk_used &= ~(1 << (p_allocation - chunk));
+		} else {
+			memdelete(p_allocation);
+		}
+	}
+
+	~DictionaryElementAllocator() {
+		if (chunk) {
+			Memory::free_static(chunk);
+		}
+	}
+};
+
 struct DictionaryPrivate {
 	SafeRefCount refcount;
 	Variant *read_only = nullptr; // If enabled, a pointer is used to a temporary value that is used to return read-only values.
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> variant_map;
+	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator, DictionaryElementAllocator> variant_map;
 };
 
 void Dictionary::get_key_list(List<Variant> *p_keys) const {
@@ -112,7 +154,7 @@ const Variant &Dictionary::operator[](const Variant &p_key) const {
 }
 
 const Variant *Dictionary::getptr(const Variant &p_key) const {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(p_key));
+	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator, DictionaryElementAllocator>::ConstIterator E(_p->variant_map.find(p_key));
 	if (!E) {
 		return nullptr;
 	}
@@ -120,7 +162,7 @@ const Variant *Dictionary::getptr(const Variant &p_key) const {
 }
 
 Variant *Dictionary::getptr(const Variant &p_key) {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E(_p->variant_map.find(p_key));
+	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator, DictionaryElementAllocator>::Iterator E(_p->variant_map.find(p_key));
 	if (!E) {
 		return nullptr;
 	}
@@ -133,7 +175,7 @@ Variant *Dictionary::getptr(const Variant &p_key) {
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(p_key));
+	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator, DictionaryElementAllocator>::ConstIterator E(_p->variant_map.find(p_key));
 
 	if (!E) {
 		return Variant();
@@ -218,7 +260,7 @@ bool Dictionary::recursive_equal(const Dictionary &p_dictionary, int recursion_c
 	}
 	recursion_count++;
 	for (const KeyValue<Variant, Variant> &this_E : _p->variant_map) {
-		HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator other_E(p_dictionary._p->variant_map.find(this_E.key));
+		HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator, DictionaryElementAllocator>::ConstIterator other_E(p_dictionary._p->variant_map.find(this_E.key));
 		if (!other_E || !this_E.value.hash_compare(other_E->value, recursion_count, false)) {
 			return false;
 		}
@@ -330,7 +372,7 @@ const Variant *Dictionary::next(const Variant *p_key) const {
 		}
 		return nullptr;
 	}
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E = _p->variant_map.find(*p_key);
+	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator, DictionaryElementAllocator>::Iterator E = _p->variant_map.find(*p_key);
 
 	if (!E) {
 		return nullptr;
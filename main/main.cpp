@@ -1718,7 +1718,8 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		} else {
 			int worker_threads = GLOBAL_GET("threading/worker_pool/max_threads");
 			float low_priority_ratio = GLOBAL_GET("threading/worker_pool/low_priority_thread_ratio");
-			WorkerThreadPool::get_singleton()->init(worker_threads, low_priority_ratio);
+			WorkerThreadPool::SchedulerMode scheduler_mode = WorkerThreadPool::SchedulerMode(int(GLOBAL_GET("threading/worker_pool/scheduler_mode")));
+			WorkerThreadPool::get_singleton()->init(worker_threads, low_priority_ratio, scheduler_mode);
 		}
 #else
 		WorkerThreadPool::get_singleton()->init(0, 0);
@@ -31,6 +31,7 @@
 #include "performance.h"
 
 #include "core/os/os.h"
+#include "core/os/small_allocator.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
@@ -84,6 +85,8 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_ALLOCATOR_RESERVED);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_ALLOCATOR_FRAGMENTATION);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -132,6 +135,8 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"navigation/edges_merged",
 		"navigation/edges_connected",
 		"navigation/edges_free",
+		"memory/small_allocator_reserved",
+		"memory/small_allocator_fragmentation",
 
 	};
 
@@ -206,6 +211,12 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+#ifdef SMALL_ALLOCATOR_ENABLED
+		case MEMORY_SMALL_ALLOCATOR_RESERVED:
+			return SmallAllocator::get_reserved_bytes();
+		case MEMORY_SMALL_ALLOCATOR_FRAGMENTATION:
+			return SmallAllocator::get_fragmentation();
+#endif
 
 		default: {
 		}
@@ -251,6 +262,8 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
@@ -308,6 +321,12 @@ TypedArray<StringName> Performance::get_custom_monitor_names() {
 	return return_array;
 }
 
+#ifdef SMALL_ALLOCATOR_ENABLED
+uint64_t Performance::_get_small_allocator_class_usage(uint32_t p_class) {
+	return SmallAllocator::get_class_reserved_bytes(p_class) - SmallAllocator::get_class_free_bytes(p_class);
+}
+#endif
+
 uint64_t Performance::get_monitor_modification_time() {
 	return _monitor_modification_time;
 }
@@ -318,6 +337,15 @@ Performance::Performance() {
 	_navigation_process_time = 0;
 	_monitor_modification_time = 0;
 	singleton = this;
+
+#ifdef SMALL_ALLOCATOR_ENABLED
+	// Bytes in use per size class, there are too many classes for builtin monitors.
+	for (uint32_t i = 0; i < SmallAllocator::CLASS_COUNT; i++) {
+		Vector<Variant> args;
+		args.push_back(i);
+		_monitor_map.insert(vformat("small_allocator/class_%d", (int)SmallAllocator::get_class_size(i)), MonitorCall(callable_mp_static(&Performance::_get_small_allocator_class_usage), args));
+	}
+#endif
 }
 
 Performance::MonitorCall::MonitorCall(Callable p_callable, Vector<Variant> p_arguments) {
@@ -47,6 +47,9 @@ class Performance : public Object {
 	static void _bind_methods();
 
 	int _get_node_count() const;
+#ifdef SMALL_ALLOCATOR_ENABLED
+	static uint64_t _get_small_allocator_class_usage(uint32_t p_class);
+#endif
 
 	double _process_time;
 	double _physics_process_time;
@@ -100,6 +103,8 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		MEMORY_SMALL_ALLOCATOR_RESERVED,
+		MEMORY_SMALL_ALLOCATOR_FRAGMENTATION,
 		MONITOR_MAX
 	};
 
@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_buffer.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -740,6 +741,24 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
+
+	if (!compiled_bytecode.is_empty()) {
+		// Exported with compiled bytecode, parsing is only needed if this build can't use it.
+		Error err = GDScriptBytecodeBuffer::load_script(this, compiled_bytecode);
+		if (err == OK) {
+			can_run = ScriptServer::is_scripting_enabled() || is_tool();
+			if (can_run) {
+				err = _static_init();
+				if (err) {
+					return err;
+				}
+			}
+			reloading = false;
+			return OK;
+		}
+		compiled_bytecode.clear();
+	}
+
 	GDScriptParser parser;
 	Error err;
 	if (!binary_tokens.is_empty()) {
@@ -1058,6 +1077,12 @@ Error GDScript::load_source_code(const String &p_path) {
 
 void GDScript::set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens) {
 	binary_tokens = p_binary_tokens;
+	compiled_bytecode.clear();
+}
+
+void GDScript::set_compiled_bytecode_source(const Vector<uint8_t> &p_buffer) {
+	compiled_bytecode = p_buffer;
+	binary_tokens = GDScriptBytecodeBuffer::extract_binary_tokens(p_buffer);
 }
 
 const Vector<uint8_t> &GDScript::get_binary_tokens_source() const {
@@ -2215,6 +2240,25 @@ void GDScriptLanguage::profiling_stop() {
 #endif
 }
 
+#ifdef DEBUG_ENABLED
+void GDScriptLanguage::opcode_profiling_start() {
+	MutexLock lock(mutex);
+
+	if (!opcode_profile_data) {
+		opcode_profile_data = memnew(GDScriptFunction::OpcodeProfile);
+	} else {
+		memset(opcode_profile_data, 0, sizeof(GDScriptFunction::OpcodeProfile));
+	}
+	opcode_profile = opcode_profile_data;
+}
+
+void GDScriptLanguage::opcode_profiling_stop() {
+	MutexLock lock(mutex);
+
+	opcode_profile = nullptr;
+}
+#endif
+
 int GDScriptLanguage::profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) {
 	int current = 0;
 #ifdef DEBUG_ENABLED
@@ -2765,6 +2809,11 @@ GDScriptLanguage::GDScriptLanguage() {
 }
 
 GDScriptLanguage::~GDScriptLanguage() {
+#ifdef DEBUG_ENABLED
+	if (opcode_profile_data) {
+		memdelete(opcode_profile_data);
+	}
+#endif
 	singleton = nullptr;
 }
 
@@ -85,6 +85,7 @@ class GDScript : public Script {
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
 	friend class GDScriptCompiler;
+	friend class GDScriptBytecodeBuffer;
 	friend class GDScriptDocGen;
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
@@ -177,6 +178,7 @@ private:
 	//exported members
 	String source;
 	Vector<uint8_t> binary_tokens;
+	Vector<uint8_t> compiled_bytecode; // Exported bytecode, `binary_tokens` holds its fallback.
 	String path;
 	bool path_valid = false; // False if using default path.
 	StringName local_name; // Inner class identifier or `class_name`.
@@ -299,6 +301,7 @@ public:
 	Error load_source_code(const String &p_path);
 
 	void set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens);
+	void set_compiled_bytecode_source(const Vector<uint8_t> &p_buffer);
 	const Vector<uint8_t> &get_binary_tokens_source() const;
 	Vector<uint8_t> get_as_binary_tokens() const;
 
@@ -447,6 +450,12 @@ class GDScriptLanguage : public ScriptLanguage {
 	bool profile_native_calls;
 	uint64_t script_frame_time;
 
+#ifdef DEBUG_ENABLED
+	// Allocated on first use and only freed with the language, since running functions keep a pointer to it.
+	GDScriptFunction::OpcodeProfile *opcode_profile_data = nullptr;
+	GDScriptFunction::OpcodeProfile *opcode_profile = nullptr; // Only set while profiling opcodes.
+#endif
+
 	HashMap<String, ObjectID> orphan_subclasses;
 
 public:
@@ -598,6 +607,12 @@ public:
 	virtual int profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) override;
 	virtual int profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_info_max) override;
 
+#ifdef DEBUG_ENABLED
+	void opcode_profiling_start();
+	void opcode_profiling_stop();
+	const GDScriptFunction::OpcodeProfile *get_opcode_profile() const { return opcode_profile_data; }
+#endif
+
 	/* LOADER FUNCTIONS */
 
 	virtual void get_recognized_extensions(List<String> *p_extensions) const override;
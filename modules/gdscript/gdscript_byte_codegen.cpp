@@ -137,6 +137,16 @@ void GDScriptByteCodeGenerator::pop_temporary() {
 	ERR_FAIL_COND(used_temporaries.is_empty());
 	int slot_idx = used_temporaries.back()->get();
 	const StackSlot &slot = temporaries[slot_idx];
+
+	// `temp = a op b; target = temp` where the temporary dies here: the operator can write to the target directly.
+	// Validated evaluators write the raw storage of their return type, so the target must be known to hold that type.
+	if (last_opcode_pos >= 0 && last_opcode_pos == typed_assign_pos && last_opcode_pos + 3 == opcodes.size() && slot.bytecode_indices.size() >= 2) {
+		int uses = slot.bytecode_indices.size();
+		if (slot.bytecode_indices[uses - 1] == last_opcode_pos + 2 && slot.bytecode_indices[uses - 2] == prev_opcode_pos + 3 && (uses < 3 || slot.bytecode_indices[uses - 3] < prev_opcode_pos)) {
+			add_fusion_candidate_if_pair(GDScriptFunction::OPCODE_OPERATOR_VALIDATED, GDScriptFunction::OPCODE_ASSIGN, 5);
+		}
+	}
+
 	if (slot.type == Variant::NIL) {
 		// Avoid keeping in the stack long-lived references to objects,
 		// which may prevent RefCounted objects from being freed.
@@ -152,6 +162,7 @@ void GDScriptByteCodeGenerator::start_parameters() {
 	if (function->_default_arg_count > 0) {
 		append(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
 		function->default_arguments.push_back(opcodes.size());
+		jump_targets.insert(opcodes.size());
 	}
 }
 
@@ -178,6 +189,53 @@ void GDScriptByteCodeGenerator::write_start(GDScript *p_script, const StringName
 	function->_argument_count = 0;
 }
 
+void GDScriptByteCodeGenerator::add_fusion_candidate_if_pair(GDScriptFunction::Opcode p_first, GDScriptFunction::Opcode p_second, int p_first_size) {
+	if (prev_opcode_pos < 0 || prev_opcode_pos + p_first_size != last_opcode_pos) {
+		return;
+	}
+	if (opcodes[prev_opcode_pos] != p_first || opcodes[last_opcode_pos] != p_second) {
+		return;
+	}
+	fusion_candidates.push_back(prev_opcode_pos);
+}
+
+void GDScriptByteCodeGenerator::apply_peephole_fusions() {
+	int *code = opcodes.ptrw();
+
+	for (const int &pos : fusion_candidates) {
+		// Only validated operators are fused for now, see `gdscript-opcode-profile` for finding other candidates.
+		if (code[pos] != GDScriptFunction::OPCODE_OPERATOR_VALIDATED) {
+			continue;
+		}
+		int next = pos + 5;
+		if (jump_targets.has(next)) {
+			// Something jumps to the second instruction, so it must stay reachable on its own.
+			continue;
+		}
+		int result = code[pos + 3];
+
+		switch (code[next]) {
+			case GDScriptFunction::OPCODE_ASSIGN: {
+				int target = code[next + 1];
+				// Evaluators may reset the result type before reading the operands, so don't fuse if they alias.
+				if (code[next + 2] != result || target == code[pos + 1] || target == code[pos + 2]) {
+					break;
+				}
+				code[pos] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN;
+				code[pos + 3] = target;
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+				if (code[next + 1] != result) {
+					break;
+				}
+				code[pos] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+			} break;
+			default:
+				break;
+		}
+	}
+}
+
 GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 #ifdef DEBUG_ENABLED
 	if (!used_temporaries.is_empty()) {
@@ -196,6 +254,8 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		}
 	}
 
+	apply_peephole_fusions();
+
 	if (constant_map.size()) {
 		function->_constant_count = constant_map.size();
 		function->constants.resize(constant_map.size());
@@ -383,6 +443,11 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_methods_count = 0;
 	}
 
+	if (call_cache_count) {
+		function->_call_caches_ptr = memnew_arr(GDScriptFunction::CallCache, call_cache_count);
+		function->_call_caches_count = call_cache_count;
+	}
+
 	if (lambdas_map.size()) {
 		function->lambdas.resize(lambdas_map.size());
 		function->_lambdas_ptr = function->lambdas.ptrw();
@@ -561,6 +626,7 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 		append(Address());
 		append(p_target);
 		append(op_func);
+		validated_operator_return_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
@@ -573,6 +639,9 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	append(Address());
 	append(p_target);
 	append(p_operator);
+#ifdef TOOLS_ENABLED
+	function->operator_signature_positions.push_back(opcodes.size());
+#endif
 	append(0); // Signature storage.
 	append(0); // Return type storage.
 	constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*(opcodes.ptr()));
@@ -600,6 +669,7 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		append(p_right_operand);
 		append(p_target);
 		append(op_func);
+		validated_operator_return_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
@@ -612,6 +682,9 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	append(p_right_operand);
 	append(p_target);
 	append(p_operator);
+#ifdef TOOLS_ENABLED
+	function->operator_signature_positions.push_back(opcodes.size());
+#endif
 	append(0); // Signature storage.
 	append(0); // Return type storage.
 	constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*(opcodes.ptr()));
@@ -665,6 +738,7 @@ void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_ope
 	append(p_left_operand);
 	logic_op_jump_pos1.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
+	add_fusion_candidate_if_pair(GDScriptFunction::OPCODE_OPERATOR_VALIDATED, GDScriptFunction::OPCODE_JUMP_IF_NOT, 5);
 }
 
 void GDScriptByteCodeGenerator::write_and_right_operand(const Address &p_right_operand) {
@@ -672,6 +746,7 @@ void GDScriptByteCodeGenerator::write_and_right_operand(const Address &p_right_o
 	append(p_right_operand);
 	logic_op_jump_pos2.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
+	add_fusion_candidate_if_pair(GDScriptFunction::OPCODE_OPERATOR_VALIDATED, GDScriptFunction::OPCODE_JUMP_IF_NOT, 5);
 }
 
 void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
@@ -681,6 +756,7 @@ void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
 	// Jump away from the fail condition.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
 	append(opcodes.size() + 3);
+	jump_targets.insert(opcodes.size() + 2);
 	// Here it means one of operands is false.
 	patch_jump(logic_op_jump_pos1.back()->get());
 	patch_jump(logic_op_jump_pos2.back()->get());
@@ -711,6 +787,7 @@ void GDScriptByteCodeGenerator::write_end_or(const Address &p_target) {
 	// Jump away from the success condition.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
 	append(opcodes.size() + 3);
+	jump_targets.insert(opcodes.size() + 2);
 	// Here it means one of operands is true.
 	patch_jump(logic_op_jump_pos1.back()->get());
 	patch_jump(logic_op_jump_pos2.back()->get());
@@ -729,6 +806,7 @@ void GDScriptByteCodeGenerator::write_ternary_condition(const Address &p_conditi
 	append(p_condition);
 	ternary_jump_fail_pos.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
+	add_fusion_candidate_if_pair(GDScriptFunction::OPCODE_OPERATOR_VALIDATED, GDScriptFunction::OPCODE_JUMP_IF_NOT, 5);
 }
 
 void GDScriptByteCodeGenerator::write_ternary_true_expr(const Address &p_expr) {
@@ -756,9 +834,29 @@ void GDScriptByteCodeGenerator::write_end_ternary() {
 	ternary_result.pop_back();
 }
 
+// Element type of an `Array[T]` address when `T` is a builtin type, `NIL` otherwise.
+static Variant::Type _get_typed_array_builtin_element(const GDScriptCodeGenerator::Address &p_array) {
+	if (!IS_BUILTIN_TYPE(p_array, Variant::ARRAY) || !p_array.type.has_container_element_type(0)) {
+		return Variant::NIL;
+	}
+	const GDScriptDataType element_type = p_array.type.get_container_element_type(0);
+	if (!element_type.has_type || element_type.kind != GDScriptDataType::BUILTIN) {
+		return Variant::NIL;
+	}
+	return element_type.builtin_type;
+}
+
 void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_target)) {
-		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type) &&
+		Variant::Type array_element_type = _get_typed_array_builtin_element(p_target);
+		if (array_element_type != Variant::NIL && IS_BUILTIN_TYPE(p_index, Variant::INT) && IS_BUILTIN_TYPE(p_source, array_element_type)) {
+			// Element type is known, so the value can be stored without validating it again.
+			append_opcode(GDScriptFunction::OPCODE_SET_INDEXED_TYPED_ARRAY);
+			append(p_target);
+			append(p_index);
+			append(p_source);
+			return;
+		} else if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type) &&
 				IS_BUILTIN_TYPE(p_source, Variant::get_indexed_element_type(p_target.type.builtin_type))) {
 			// Use indexed setter instead.
 			Variant::ValidatedIndexedSetter setter = Variant::get_member_validated_indexed_setter(p_target.type.builtin_type);
@@ -787,7 +885,13 @@ void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address
 
 void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_source)) {
-		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
+		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && _get_typed_array_builtin_element(p_source) != Variant::NIL) {
+			append_opcode(GDScriptFunction::OPCODE_GET_INDEXED_TYPED_ARRAY);
+			append(p_source);
+			append(p_index);
+			append(p_target);
+			return;
+		} else if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
 			// Use indexed getter instead.
 			Variant::ValidatedIndexedGetter getter = Variant::get_member_validated_indexed_getter(p_source.type.builtin_type);
 			append_opcode(GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED);
@@ -939,6 +1043,9 @@ void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Addr
 		append(p_source);
 		append(p_target.type.builtin_type);
 	} else {
+		if (last_opcode_pos >= 0 && opcodes[last_opcode_pos] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED && HAS_BUILTIN_TYPE(p_target) && p_target.type.builtin_type == validated_operator_return_type) {
+			typed_assign_pos = opcodes.size();
+		}
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN);
 		append(p_target);
 		append(p_source);
@@ -962,6 +1069,7 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 		write_assign(p_dst, p_src);
 	}
 	function->default_arguments.push_back(opcodes.size());
+	jump_targets.insert(opcodes.size());
 }
 
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
@@ -1032,6 +1140,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(call_cache_count++); // Inline cache for the call site.
 	ct.cleanup();
 }
 
@@ -1057,6 +1166,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(call_cache_count++); // Inline cache for the call site.
 	ct.cleanup();
 }
 
@@ -1265,6 +1375,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(call_cache_count++); // Inline cache for the call site.
 	ct.cleanup();
 }
 
@@ -1278,6 +1389,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(call_cache_count++); // Inline cache for the call site.
 	ct.cleanup();
 }
 
@@ -1291,6 +1403,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(call_cache_count++); // Inline cache for the call site.
 	ct.cleanup();
 }
 
@@ -1412,6 +1525,7 @@ void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
 	append(p_condition);
 	if_jmp_addrs.push_back(opcodes.size());
 	append(0); // Jump destination, will be patched.
+	add_fusion_candidate_if_pair(GDScriptFunction::OPCODE_OPERATOR_VALIDATED, GDScriptFunction::OPCODE_JUMP_IF_NOT, 5);
 }
 
 void GDScriptByteCodeGenerator::write_else() {
@@ -1566,10 +1680,12 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 	append(0); // End of loop address, will be patched.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
 	append(opcodes.size() + 6); // Skip over 'continue' code.
+	jump_targets.insert(opcodes.size() + 5);
 
 	// Next iteration.
 	int continue_addr = opcodes.size();
 	continue_addrs.push_back(continue_addr);
+	jump_targets.insert(continue_addr);
 	append_opcode(iterate_opcode);
 	append(counter);
 	append(container);
@@ -1612,6 +1728,7 @@ void GDScriptByteCodeGenerator::write_endfor() {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	jump_targets.insert(opcodes.size());
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
@@ -1620,6 +1737,7 @@ void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	append(p_condition);
 	while_jmp_addrs.push_back(opcodes.size());
 	append(0); // End of loop address, will be patched.
+	add_fusion_candidate_if_pair(GDScriptFunction::OPCODE_OPERATOR_VALIDATED, GDScriptFunction::OPCODE_JUMP_IF_NOT, 5);
 }
 
 void GDScriptByteCodeGenerator::write_endwhile() {
@@ -35,6 +35,9 @@
 #include "gdscript_function.h"
 #include "gdscript_utility_functions.h"
 
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+
 class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	struct StackSlot {
 		Variant::Type type = Variant::NIL;
@@ -97,6 +100,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int call_cache_count = 0;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -157,6 +161,19 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	List<List<int>> current_breaks_to_patch;
 
+	// Peephole optimization. Pairs of instructions that may be fused are recorded while
+	// generating and rewritten in `write_end()`, once every address is resolved.
+	// Fusing never changes the code size, so jump targets stay valid.
+	int last_opcode_pos = -1;
+	int prev_opcode_pos = -1;
+	int typed_assign_pos = -1; // `ASSIGN` whose target has the same type as the validated operator right before it.
+	Variant::Type validated_operator_return_type = Variant::NIL; // Of the last opcode, NIL unless it's a validated operator.
+	HashSet<int> jump_targets;
+	LocalVector<int> fusion_candidates;
+
+	void add_fusion_candidate_if_pair(GDScriptFunction::Opcode p_first, GDScriptFunction::Opcode p_second, int p_first_size);
+	void apply_peephole_fusions();
+
 	void add_stack_identifier(const StringName &p_id, int p_stackpos) {
 		if (locals.size() > max_locals) {
 			max_locals = locals.size();
@@ -370,10 +387,16 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	}
 
 	void append_opcode(GDScriptFunction::Opcode p_code) {
+		prev_opcode_pos = last_opcode_pos;
+		last_opcode_pos = opcodes.size();
+		validated_operator_return_type = Variant::NIL;
 		opcodes.push_back(p_code);
 	}
 
 	void append_opcode_and_argcount(GDScriptFunction::Opcode p_code, int p_argument_count) {
+		prev_opcode_pos = last_opcode_pos;
+		last_opcode_pos = opcodes.size();
+		validated_operator_return_type = Variant::NIL;
 		opcodes.push_back(p_code);
 		opcodes.push_back(p_argument_count);
 		instr_args_max = MAX(instr_args_max, p_argument_count);
@@ -445,6 +468,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		jump_targets.insert(opcodes.size());
 	}
 
 public:
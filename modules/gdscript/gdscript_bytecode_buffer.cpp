@@ -0,0 +1,1546 @@
+/**************************************************************************/
+/*  gdscript_bytecode_buffer.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_buffer.h"
+
+#include "gdscript_cache.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/debugger/engine_debugger.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/version.h"
+#include "scene/resources/packed_scene.h"
+
+static constexpr int MAX_VALUE_DEPTH = 64;
+
+// Debug builds compile asserts and breakpoints into the bytecode, which release builds must not run.
+#ifdef DEBUG_ENABLED
+static constexpr uint32_t DEBUG_CODE = 1;
+#else
+static constexpr uint32_t DEBUG_CODE = 0;
+#endif
+
+struct GDScriptBytecodeBuffer::Writer {
+	Vector<uint8_t> data;
+	String error;
+
+	void fail(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+	}
+
+	bool failed() const {
+		return !error.is_empty();
+	}
+
+	void put_u8(uint8_t p_value) {
+		data.push_back(p_value);
+	}
+
+	void put_u32(uint32_t p_value) {
+		int pos = data.size();
+		data.resize(pos + 4);
+		encode_uint32(p_value, &data.write[pos]);
+	}
+
+	void put_i32(int32_t p_value) {
+		put_u32((uint32_t)p_value);
+	}
+
+	void put_string(const String &p_string) {
+		CharString utf8 = p_string.utf8();
+		put_u32(utf8.length());
+		int pos = data.size();
+		data.resize(pos + utf8.length());
+		memcpy(data.ptrw() + pos, utf8.get_data(), utf8.length());
+	}
+
+	void put_plain_variant(const Variant &p_value) {
+		int len = 0;
+		Error err = encode_variant(p_value, nullptr, len, false);
+		if (err != OK) {
+			fail(vformat(R"(can't encode constant of type "%s")", Variant::get_type_name(p_value.get_type())));
+			return;
+		}
+		int pos = data.size();
+		data.resize(pos + len);
+		encode_variant(p_value, &data.write[pos], len, false);
+	}
+};
+
+struct GDScriptBytecodeBuffer::Reader {
+	const uint8_t *ptr = nullptr;
+	int size = 0;
+	int pos = 0;
+	bool failed = false;
+
+	bool has(int p_bytes) {
+		if (failed || p_bytes < 0 || p_bytes > size - pos) {
+			failed = true;
+			return false;
+		}
+		return true;
+	}
+
+	uint8_t get_u8() {
+		if (!has(1)) {
+			return 0;
+		}
+		return ptr[pos++];
+	}
+
+	uint32_t get_u32() {
+		if (!has(4)) {
+			return 0;
+		}
+		uint32_t value = decode_uint32(ptr + pos);
+		pos += 4;
+		return value;
+	}
+
+	int32_t get_i32() {
+		return (int32_t)get_u32();
+	}
+
+	// Element counts. Every element takes at least one byte, which bounds allocations on corrupt data.
+	int get_count() {
+		uint32_t count = get_u32();
+		if (failed || count > (uint32_t)(size - pos)) {
+			failed = true;
+			return 0;
+		}
+		return (int)count;
+	}
+
+	String get_string() {
+		int len = (int)get_u32();
+		if (!has(len)) {
+			return String();
+		}
+		String string = String::utf8((const char *)ptr + pos, len);
+		pos += len;
+		return string;
+	}
+
+	StringName get_string_name() {
+		return StringName(get_string());
+	}
+
+	Variant get_plain_variant() {
+		if (failed) {
+			return Variant();
+		}
+		Variant value;
+		int len = 0;
+		Error err = decode_variant(value, ptr + pos, size - pos, &len, false);
+		if (err != OK) {
+			failed = true;
+			return Variant();
+		}
+		pos += len;
+		return value;
+	}
+};
+
+bool GDScriptBytecodeBuffer::is_compiled_buffer(const Vector<uint8_t> &p_buffer) {
+	if (p_buffer.size() < HEADER_SIZE) {
+		return false;
+	}
+	const uint8_t *buf = p_buffer.ptr();
+	if (buf[0] != 'G' || buf[1] != 'D' || buf[2] != 'B' || buf[3] != 'C') {
+		return false;
+	}
+	uint64_t tokens_size = decode_uint32(&buf[28]);
+	uint64_t data_size = decode_uint32(&buf[32]);
+	return HEADER_SIZE + tokens_size + data_size == (uint64_t)p_buffer.size();
+}
+
+bool GDScriptBytecodeBuffer::_is_compatible(const Vector<uint8_t> &p_buffer) {
+	// Bytecode refers to opcodes, types and operators by their value, and reserves room for pointers.
+	const uint8_t *buf = p_buffer.ptr();
+	return decode_uint32(&buf[4]) == FORMAT_VERSION &&
+			decode_uint32(&buf[8]) == VERSION_HEX &&
+			decode_uint32(&buf[12]) == GDScriptFunction::OPCODE_END &&
+			decode_uint32(&buf[16]) == Variant::VARIANT_MAX &&
+			decode_uint32(&buf[20]) == Variant::OP_MAX &&
+			decode_uint32(&buf[24]) == sizeof(void *) &&
+			decode_uint32(&buf[36]) == DEBUG_CODE;
+}
+
+Vector<uint8_t> GDScriptBytecodeBuffer::extract_binary_tokens(const Vector<uint8_t> &p_buffer) {
+	if (!is_compiled_buffer(p_buffer)) {
+		return p_buffer;
+	}
+	int tokens_size = decode_uint32(&p_buffer.ptr()[28]);
+	return p_buffer.slice(HEADER_SIZE, HEADER_SIZE + tokens_size);
+}
+
+/* Saving */
+
+#ifdef TOOLS_ENABLED
+
+// Reverse lookup of the pointers a compiled function can hold, so they can be saved by name.
+struct GDScriptBytecodeBuffer::Symbols {
+	struct Operator {
+		Variant::Operator op = Variant::OP_MAX;
+		Variant::Type left = Variant::NIL;
+		Variant::Type right = Variant::NIL;
+	};
+
+	struct Member {
+		Variant::Type type = Variant::NIL;
+		StringName name;
+	};
+
+	struct Constructor {
+		Variant::Type type = Variant::NIL;
+		int index = 0;
+	};
+
+	RBMap<Variant::ValidatedOperatorEvaluator, Operator> operators;
+	RBMap<Variant::ValidatedSetter, Member> setters;
+	RBMap<Variant::ValidatedGetter, Member> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, Member> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, Constructor> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+
+	template <typename K, typename V>
+	static const V *lookup(const RBMap<K, V> &p_map, const K &p_key) {
+		const typename RBMap<K, V>::Element *E = p_map.find(p_key);
+		return E ? &E->value() : nullptr;
+	}
+
+	Symbols() {
+		for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+			Variant::Type type = (Variant::Type)i;
+
+			for (int op = 0; op < Variant::OP_MAX; op++) {
+				for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, type, (Variant::Type)j);
+					if (evaluator && !operators.has(evaluator)) {
+						operators.insert(evaluator, { (Variant::Operator)op, type, (Variant::Type)j });
+					}
+				}
+			}
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &member : members) {
+				Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member);
+				if (setter && !setters.has(setter)) {
+					setters.insert(setter, { type, member });
+				}
+				Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member);
+				if (getter && !getters.has(getter)) {
+					getters.insert(getter, { type, member });
+				}
+			}
+
+			if (Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type)) {
+				keyed_setters.insert(keyed_setter, type);
+			}
+			if (Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type)) {
+				keyed_getters.insert(keyed_getter, type);
+			}
+			if (Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type)) {
+				indexed_setters.insert(indexed_setter, type);
+			}
+			if (Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type)) {
+				indexed_getters.insert(indexed_getter, type);
+			}
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &method : methods) {
+				Variant::ValidatedBuiltInMethod builtin_method = Variant::get_validated_builtin_method(type, method);
+				if (builtin_method && !builtin_methods.has(builtin_method)) {
+					builtin_methods.insert(builtin_method, { type, method });
+				}
+			}
+
+			for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+				Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j);
+				if (constructor && !constructors.has(constructor)) {
+					constructors.insert(constructor, { type, j });
+				}
+			}
+		}
+
+		List<StringName> utility_functions;
+		Variant::get_utility_function_list(&utility_functions);
+		for (const StringName &function : utility_functions) {
+			if (Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(function)) {
+				utilities.insert(utility, function);
+			}
+		}
+
+		List<StringName> gds_functions;
+		GDScriptUtilityFunctions::get_function_list(&gds_functions);
+		for (const StringName &function : gds_functions) {
+			if (GDScriptUtilityFunctions::FunctionPtr utility = GDScriptUtilityFunctions::get_function(function)) {
+				gds_utilities.insert(utility, function);
+			}
+		}
+	}
+};
+
+void GDScriptBytecodeBuffer::_write_object(Writer &p_writer, const Object *p_object) {
+	if (p_object == nullptr) {
+		p_writer.put_u8(OBJECT_NULL);
+		return;
+	}
+
+	if (const GDScript *script = Object::cast_to<GDScript>(p_object)) {
+		if (script->path.is_empty() || script->path.contains("::")) {
+			p_writer.fail("references a built-in script");
+			return;
+		}
+		p_writer.put_u8(OBJECT_GDSCRIPT);
+		p_writer.put_string(script->path);
+		p_writer.put_string(script->fully_qualified_name);
+	} else if (const GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(p_object)) {
+		p_writer.put_u8(OBJECT_NATIVE_CLASS);
+		p_writer.put_string(native_class->get_name());
+	} else if (const Resource *resource = Object::cast_to<Resource>(p_object)) {
+		if (resource->get_path().is_empty() || resource->is_built_in()) {
+			p_writer.fail(vformat(R"(references a built-in resource of type "%s")", resource->get_class()));
+			return;
+		}
+		p_writer.put_u8(OBJECT_RESOURCE);
+		p_writer.put_string(resource->get_path());
+	} else {
+		p_writer.fail(vformat(R"(references an object of type "%s")", p_object->get_class()));
+	}
+}
+
+void GDScriptBytecodeBuffer::_write_value(Writer &p_writer, const Variant &p_value, int p_depth) {
+	if (p_depth > MAX_VALUE_DEPTH) {
+		p_writer.fail("has constants nested too deeply");
+		return;
+	}
+
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			bool was_freed = false;
+			Object *object = p_value.get_validated_object_with_check(was_freed);
+			if (was_freed) {
+				p_writer.fail("references a freed object");
+				return;
+			}
+			p_writer.put_u8(VALUE_OBJECT);
+			_write_object(p_writer, object);
+		} break;
+		case Variant::ARRAY: {
+			// Arrays keep their type and read-only state, which `encode_variant()` doesn't store.
+			Array array = p_value;
+			p_writer.put_u8(VALUE_ARRAY);
+			p_writer.put_u8(array.is_read_only());
+			p_writer.put_u32(array.get_typed_builtin());
+			p_writer.put_string(array.get_typed_class_name());
+			_write_object(p_writer, array.get_typed_script().get_validated_object());
+			p_writer.put_u32(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				_write_value(p_writer, array[i], p_depth + 1);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dictionary = p_value;
+			p_writer.put_u8(VALUE_DICTIONARY);
+			p_writer.put_u8(dictionary.is_read_only());
+			p_writer.put_u32(dictionary.size());
+			List<Variant> keys;
+			dictionary.get_key_list(&keys);
+			for (const Variant &key : keys) {
+				_write_value(p_writer, key, p_depth + 1);
+				_write_value(p_writer, dictionary[key], p_depth + 1);
+			}
+		} break;
+		case Variant::RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL: {
+			p_writer.fail(vformat(R"(has a constant of type "%s")", Variant::get_type_name(p_value.get_type())));
+		} break;
+		default: {
+			p_writer.put_u8(VALUE_PLAIN);
+			p_writer.put_plain_variant(p_value);
+		} break;
+	}
+}
+
+void GDScriptBytecodeBuffer::_write_data_type(Writer &p_writer, const GDScriptDataType &p_type) {
+	p_writer.put_u8(p_type.has_type);
+	p_writer.put_u8(p_type.kind);
+	p_writer.put_u32(p_type.builtin_type);
+	p_writer.put_string(p_type.native_type);
+	_write_object(p_writer, p_type.script_type);
+	p_writer.put_u32(p_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		_write_data_type(p_writer, element_type);
+	}
+}
+
+void GDScriptBytecodeBuffer::_write_property_info(Writer &p_writer, const PropertyInfo &p_info) {
+	p_writer.put_u32(p_info.type);
+	p_writer.put_string(p_info.name);
+	p_writer.put_string(p_info.class_name);
+	p_writer.put_u32(p_info.hint);
+	p_writer.put_string(p_info.hint_string);
+	p_writer.put_u32(p_info.usage);
+}
+
+void GDScriptBytecodeBuffer::_write_method_info(Writer &p_writer, const MethodInfo &p_info) {
+	p_writer.put_string(p_info.name);
+	p_writer.put_u32(p_info.flags);
+	_write_property_info(p_writer, p_info.return_val);
+	p_writer.put_u32(p_info.arguments.size());
+	for (const PropertyInfo &argument : p_info.arguments) {
+		_write_property_info(p_writer, argument);
+	}
+	p_writer.put_u32(p_info.default_arguments.size());
+	for (const Variant &default_argument : p_info.default_arguments) {
+		_write_value(p_writer, default_argument);
+	}
+}
+
+void GDScriptBytecodeBuffer::_write_member_info(Writer &p_writer, const StringName &p_name, const GDScript::MemberInfo &p_info) {
+	p_writer.put_string(p_name);
+	p_writer.put_i32(p_info.index);
+	p_writer.put_string(p_info.setter);
+	p_writer.put_string(p_info.getter);
+	_write_data_type(p_writer, p_info.data_type);
+	_write_property_info(p_writer, p_info.property_info);
+}
+
+void GDScriptBytecodeBuffer::_write_function(Writer &p_writer, const Symbols &p_symbols, const GDScriptFunction *p_function) {
+	p_writer.put_string(p_function->name);
+	p_writer.put_u8(p_function->_static);
+	_write_value(p_writer, p_function->rpc_config);
+	p_writer.put_i32(p_function->_initial_line);
+	p_writer.put_i32(p_function->_argument_count);
+	p_writer.put_i32(p_function->_default_arg_count);
+	p_writer.put_i32(p_function->_stack_size);
+	p_writer.put_i32(p_function->_instruction_args_size);
+	p_writer.put_i32(p_function->_call_caches_count);
+
+	p_writer.put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		_write_data_type(p_writer, argument_type);
+	}
+	_write_data_type(p_writer, p_function->return_type);
+	_write_method_info(p_writer, p_function->method_info);
+
+	const GDScript::LambdaInfo *lambda_info = p_function->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(p_function));
+	p_writer.put_u8(lambda_info != nullptr);
+	if (lambda_info) {
+		p_writer.put_i32(lambda_info->capture_count);
+		p_writer.put_u8(lambda_info->use_self);
+	}
+
+	// The VM caches the operand types and evaluator of untyped operators inside the bytecode, don't save those.
+	Vector<int> code = p_function->code;
+	constexpr int pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+	for (int position : p_function->operator_signature_positions) {
+		for (int i = 0; i < 2 + pointer_size; i++) {
+			code.write[position + i] = 0;
+		}
+	}
+	p_writer.put_u32(code.size());
+	for (int word : code) {
+		p_writer.put_i32(word);
+	}
+
+	p_writer.put_u32(p_function->default_arguments.size());
+	for (int address : p_function->default_arguments) {
+		p_writer.put_i32(address);
+	}
+
+	p_writer.put_u32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		p_writer.put_i32(E.key);
+		p_writer.put_u32(E.value);
+	}
+
+	p_writer.put_u32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		_write_value(p_writer, constant);
+	}
+
+	p_writer.put_u32(p_function->global_names.size());
+	for (const StringName &global_name : p_function->global_names) {
+		p_writer.put_string(global_name);
+	}
+
+	p_writer.put_u32(p_function->operator_funcs.size());
+	for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+		const Symbols::Operator *op = Symbols::lookup(p_symbols.operators, evaluator);
+		if (!op) {
+			p_writer.fail("uses an unknown operator evaluator");
+			return;
+		}
+		p_writer.put_u32(op->op);
+		p_writer.put_u32(op->left);
+		p_writer.put_u32(op->right);
+	}
+
+#define WRITE_MEMBER_SYMBOLS(m_list, m_symbols)                                  \
+	p_writer.put_u32(p_function->m_list.size());                                 \
+	for (const auto &E : p_function->m_list) {                                   \
+		const Symbols::Member *member = Symbols::lookup(p_symbols.m_symbols, E); \
+		if (!member) {                                                           \
+			p_writer.fail("uses an unknown " #m_list " function");               \
+			return;                                                              \
+		}                                                                        \
+		p_writer.put_u32(member->type);                                          \
+		p_writer.put_string(member->name);                                       \
+	}
+
+#define WRITE_TYPE_SYMBOLS(m_list, m_symbols)                                \
+	p_writer.put_u32(p_function->m_list.size());                             \
+	for (const auto &E : p_function->m_list) {                               \
+		const Variant::Type *type = Symbols::lookup(p_symbols.m_symbols, E); \
+		if (!type) {                                                         \
+			p_writer.fail("uses an unknown " #m_list " function");           \
+			return;                                                          \
+		}                                                                    \
+		p_writer.put_u32(*type);                                             \
+	}
+
+#define WRITE_NAME_SYMBOLS(m_list, m_symbols)                             \
+	p_writer.put_u32(p_function->m_list.size());                          \
+	for (const auto &E : p_function->m_list) {                            \
+		const StringName *name = Symbols::lookup(p_symbols.m_symbols, E); \
+		if (!name) {                                                      \
+			p_writer.fail("uses an unknown " #m_list " function");        \
+			return;                                                       \
+		}                                                                 \
+		p_writer.put_string(*name);                                       \
+	}
+
+	WRITE_MEMBER_SYMBOLS(setters, setters);
+	WRITE_MEMBER_SYMBOLS(getters, getters);
+	WRITE_TYPE_SYMBOLS(keyed_setters, keyed_setters);
+	WRITE_TYPE_SYMBOLS(keyed_getters, keyed_getters);
+	WRITE_TYPE_SYMBOLS(indexed_setters, indexed_setters);
+	WRITE_TYPE_SYMBOLS(indexed_getters, indexed_getters);
+	WRITE_MEMBER_SYMBOLS(builtin_methods, builtin_methods);
+
+	p_writer.put_u32(p_function->constructors.size());
+	for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+		const Symbols::Constructor *symbol = Symbols::lookup(p_symbols.constructors, constructor);
+		if (!symbol) {
+			p_writer.fail("uses an unknown constructor");
+			return;
+		}
+		p_writer.put_u32(symbol->type);
+		p_writer.put_i32(symbol->index);
+	}
+
+	WRITE_NAME_SYMBOLS(utilities, utilities);
+	WRITE_NAME_SYMBOLS(gds_utilities, gds_utilities);
+
+#undef WRITE_MEMBER_SYMBOLS
+#undef WRITE_TYPE_SYMBOLS
+#undef WRITE_NAME_SYMBOLS
+
+	p_writer.put_u32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		// Extension and compatibility methods can't be found again by name.
+		if (ClassDB::get_method(method->get_instance_class(), method->get_name()) != method) {
+			p_writer.fail(vformat(R"(calls "%s.%s", which can't be looked up by name)", method->get_instance_class(), method->get_name()));
+			return;
+		}
+		p_writer.put_string(method->get_instance_class());
+		p_writer.put_string(method->get_name());
+	}
+
+	p_writer.put_u32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		_write_function(p_writer, p_symbols, lambda);
+	}
+}
+
+void GDScriptBytecodeBuffer::_write_class_tree(Writer &p_writer, const GDScript *p_script) {
+	p_writer.put_string(p_script->fully_qualified_name);
+	p_writer.put_string(p_script->local_name);
+	p_writer.put_string(p_script->global_name);
+	p_writer.put_string(p_script->simplified_icon_path);
+
+	p_writer.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_writer.put_string(E.key);
+		_write_class_tree(p_writer, E.value.ptr());
+	}
+}
+
+void GDScriptBytecodeBuffer::_write_class(Writer &p_writer, const Symbols &p_symbols, const GDScript *p_script) {
+	if (!p_script->valid || p_script->native.is_null()) {
+		p_writer.fail(vformat(R"(class "%s" is not compiled)", p_script->fully_qualified_name));
+		return;
+	}
+
+	p_writer.put_u8(p_script->tool);
+	p_writer.put_string(p_script->native->get_name());
+	p_writer.put_u8(p_script->base.is_valid());
+	if (p_script->base.is_valid()) {
+		_write_object(p_writer, p_script->base.ptr());
+	}
+
+	p_writer.put_u32(p_script->member_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+		_write_member_info(p_writer, E.key, E.value);
+	}
+	p_writer.put_u32(p_script->members.size());
+	for (const StringName &member : p_script->members) {
+		p_writer.put_string(member);
+	}
+	p_writer.put_u32(p_script->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+		_write_member_info(p_writer, E.key, E.value);
+	}
+
+	p_writer.put_u32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		p_writer.put_string(E.key);
+		_write_value(p_writer, E.value);
+	}
+
+	p_writer.put_u32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		p_writer.put_string(E.key);
+		_write_method_info(p_writer, E.value);
+	}
+
+	_write_value(p_writer, p_script->rpc_config);
+
+	int function_count = p_script->member_functions.size();
+	function_count += p_script->implicit_initializer ? 1 : 0;
+	function_count += p_script->implicit_ready ? 1 : 0;
+	function_count += p_script->static_initializer ? 1 : 0;
+	p_writer.put_u32(function_count);
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		p_writer.put_u8(FUNCTION_MEMBER);
+		_write_function(p_writer, p_symbols, E.value);
+	}
+	if (p_script->implicit_initializer) {
+		p_writer.put_u8(FUNCTION_IMPLICIT_INITIALIZER);
+		_write_function(p_writer, p_symbols, p_script->implicit_initializer);
+	}
+	if (p_script->implicit_ready) {
+		p_writer.put_u8(FUNCTION_IMPLICIT_READY);
+		_write_function(p_writer, p_symbols, p_script->implicit_ready);
+	}
+	if (p_script->static_initializer) {
+		p_writer.put_u8(FUNCTION_STATIC_INITIALIZER);
+		_write_function(p_writer, p_symbols, p_script->static_initializer);
+	}
+
+	p_writer.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_writer.put_string(E.key);
+		_write_class(p_writer, p_symbols, E.value.ptr());
+	}
+}
+
+Vector<uint8_t> GDScriptBytecodeBuffer::serialize(const GDScript *p_script, const Vector<uint8_t> &p_binary_tokens) {
+	ERR_FAIL_NULL_V(p_script, Vector<uint8_t>());
+
+	Symbols symbols;
+	Writer writer;
+
+	uint32_t flags = 0;
+	if (GDScriptCache::has_static_script(p_script->fully_qualified_name)) {
+		flags |= FLAG_KEEP_STATIC_DATA;
+	}
+	writer.put_u32(flags);
+	_write_class_tree(writer, p_script);
+	_write_class(writer, symbols, p_script);
+
+	if (writer.failed()) {
+		WARN_PRINT(vformat(R"(Can't save compiled bytecode of "%s": it %s. Binary tokens are used instead.)", p_script->path, writer.error));
+		return Vector<uint8_t>();
+	}
+
+	Vector<uint8_t> buffer;
+	buffer.resize(HEADER_SIZE);
+	uint8_t *buf = buffer.ptrw();
+	buf[0] = 'G';
+	buf[1] = 'D';
+	buf[2] = 'B';
+	buf[3] = 'C';
+	encode_uint32(FORMAT_VERSION, &buf[4]);
+	encode_uint32(VERSION_HEX, &buf[8]);
+	encode_uint32(GDScriptFunction::OPCODE_END, &buf[12]);
+	encode_uint32(Variant::VARIANT_MAX, &buf[16]);
+	encode_uint32(Variant::OP_MAX, &buf[20]);
+	encode_uint32(sizeof(void *), &buf[24]);
+	encode_uint32(p_binary_tokens.size(), &buf[28]);
+	encode_uint32(writer.data.size(), &buf[32]);
+	encode_uint32(DEBUG_CODE, &buf[36]);
+
+	buffer.append_array(p_binary_tokens);
+	buffer.append_array(writer.data);
+	return buffer;
+}
+
+#endif // TOOLS_ENABLED
+
+/* Loading */
+
+Variant GDScriptBytecodeBuffer::_read_object(Reader &p_reader, GDScript *p_root) {
+	switch (p_reader.get_u8()) {
+		case OBJECT_NULL: {
+			return Variant((Object *)nullptr);
+		}
+		case OBJECT_GDSCRIPT: {
+			String path = p_reader.get_string();
+			String fqcn = p_reader.get_string();
+			if (p_reader.failed) {
+				return Variant();
+			}
+
+			GDScript *script = nullptr;
+			if (path == p_root->path) {
+				script = p_root->find_class(fqcn);
+			} else {
+				// Other scripts only need to exist for now, `GDScriptCache::finish_compiling()` loads them fully.
+				Error err = OK;
+				Ref<GDScript> other = GDScriptCache::get_shallow_script(path, err, p_root->path);
+				if (err == OK && other.is_valid()) {
+					script = other->find_class(fqcn);
+				}
+			}
+			if (!script) {
+				p_reader.failed = true;
+				return Variant();
+			}
+			return Ref<GDScript>(script);
+		}
+		case OBJECT_NATIVE_CLASS: {
+			StringName name = p_reader.get_string_name();
+			const HashMap<StringName, int>::ConstIterator E = GDScriptLanguage::get_singleton()->get_global_map().find(name);
+			if (p_reader.failed || !E) {
+				p_reader.failed = true;
+				return Variant();
+			}
+			return GDScriptLanguage::get_singleton()->get_global_array()[E->value];
+		}
+		case OBJECT_RESOURCE: {
+			String path = p_reader.get_string();
+			if (p_reader.failed) {
+				return Variant();
+			}
+
+			// Same as preloading, scenes are loaded through the cache to allow cyclic references.
+			Ref<Resource> resource;
+			if (ResourceLoader::get_resource_type(path) == "PackedScene") {
+				Error err = OK;
+				Ref<PackedScene> scene = GDScriptCache::get_packed_scene(path, err, p_root->path);
+				if (err == OK) {
+					resource = scene;
+				}
+			} else {
+				resource = ResourceLoader::load(path);
+			}
+			if (resource.is_null()) {
+				p_reader.failed = true;
+				return Variant();
+			}
+			return resource;
+		}
+		default: {
+			p_reader.failed = true;
+			return Variant();
+		}
+	}
+}
+
+Variant GDScriptBytecodeBuffer::_read_value(Reader &p_reader, GDScript *p_root, int p_depth) {
+	if (p_depth > MAX_VALUE_DEPTH) {
+		p_reader.failed = true;
+		return Variant();
+	}
+
+	switch (p_reader.get_u8()) {
+		case VALUE_PLAIN: {
+			return p_reader.get_plain_variant();
+		}
+		case VALUE_ARRAY: {
+			bool read_only = p_reader.get_u8();
+			uint32_t typed_builtin = p_reader.get_u32();
+			StringName typed_class_name = p_reader.get_string_name();
+			Variant typed_script = _read_object(p_reader, p_root);
+			int size = p_reader.get_count();
+			if (p_reader.failed || typed_builtin >= Variant::VARIANT_MAX) {
+				p_reader.failed = true;
+				return Variant();
+			}
+
+			Array array;
+			if (typed_builtin != Variant::NIL) {
+				array.set_typed(typed_builtin, typed_class_name, typed_script);
+			}
+			array.resize(size);
+			for (int i = 0; i < size; i++) {
+				array[i] = _read_value(p_reader, p_root, p_depth + 1);
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			return array;
+		}
+		case VALUE_DICTIONARY: {
+			bool read_only = p_reader.get_u8();
+			int size = p_reader.get_count();
+
+			Dictionary dictionary;
+			for (int i = 0; i < size && !p_reader.failed; i++) {
+				Variant key = _read_value(p_reader, p_root, p_depth + 1);
+				dictionary[key] = _read_value(p_reader, p_root, p_depth + 1);
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			return dictionary;
+		}
+		case VALUE_OBJECT: {
+			return _read_object(p_reader, p_root);
+		}
+		default: {
+			p_reader.failed = true;
+			return Variant();
+		}
+	}
+}
+
+GDScriptDataType GDScriptBytecodeBuffer::_read_data_type(Reader &p_reader, GDScript *p_root, int p_depth) {
+	GDScriptDataType type;
+	type.has_type = p_reader.get_u8();
+	uint8_t kind = p_reader.get_u8();
+	uint32_t builtin_type = p_reader.get_u32();
+	type.native_type = p_reader.get_string_name();
+	Ref<Script> script = _read_object(p_reader, p_root);
+	if (kind > GDScriptDataType::GDSCRIPT || builtin_type >= Variant::VARIANT_MAX || p_depth > MAX_VALUE_DEPTH) {
+		p_reader.failed = true;
+	}
+	if (p_reader.failed) {
+		return GDScriptDataType();
+	}
+
+	type.kind = (GDScriptDataType::Kind)kind;
+	type.builtin_type = (Variant::Type)builtin_type;
+	if (script.is_valid()) {
+		type.script_type = script.ptr();
+		// Like the compiler, only keep classes of other files alive, to avoid cyclic references.
+		GDScript *gdscript = Object::cast_to<GDScript>(script.ptr());
+		if (!gdscript || !p_root->has_class(gdscript)) {
+			type.script_type_ref = script;
+		}
+	}
+
+	int element_count = p_reader.get_count();
+	for (int i = 0; i < element_count; i++) {
+		type.container_element_types.push_back(_read_data_type(p_reader, p_root, p_depth + 1));
+	}
+	return type;
+}
+
+PropertyInfo GDScriptBytecodeBuffer::_read_property_info(Reader &p_reader) {
+	PropertyInfo info;
+	info.type = (Variant::Type)p_reader.get_u32();
+	info.name = p_reader.get_string();
+	info.class_name = p_reader.get_string_name();
+	info.hint = (PropertyHint)p_reader.get_u32();
+	info.hint_string = p_reader.get_string();
+	info.usage = p_reader.get_u32();
+	if (info.type >= Variant::VARIANT_MAX) {
+		p_reader.failed = true;
+	}
+	return info;
+}
+
+MethodInfo GDScriptBytecodeBuffer::_read_method_info(Reader &p_reader, GDScript *p_root) {
+	MethodInfo info;
+	info.name = p_reader.get_string();
+	info.flags = p_reader.get_u32();
+	info.return_val = _read_property_info(p_reader);
+	int argument_count = p_reader.get_count();
+	for (int i = 0; i < argument_count; i++) {
+		info.arguments.push_back(_read_property_info(p_reader));
+	}
+	int default_argument_count = p_reader.get_count();
+	for (int i = 0; i < default_argument_count; i++) {
+		info.default_arguments.push_back(_read_value(p_reader, p_root));
+	}
+	return info;
+}
+
+void GDScriptBytecodeBuffer::_read_member_info(Reader &p_reader, GDScript *p_root, HashMap<StringName, GDScript::MemberInfo> &r_members) {
+	StringName name = p_reader.get_string_name();
+	GDScript::MemberInfo info;
+	info.index = p_reader.get_i32();
+	info.setter = p_reader.get_string_name();
+	info.getter = p_reader.get_string_name();
+	info.data_type = _read_data_type(p_reader, p_root);
+	info.property_info = _read_property_info(p_reader);
+	if (!p_reader.failed) {
+		r_members[name] = info;
+	}
+}
+
+GDScriptFunction *GDScriptBytecodeBuffer::_read_function(Reader &p_reader, GDScript *p_root, GDScript *p_script) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->name = p_reader.get_string_name();
+	function->source = p_script->get_script_path();
+	function->_static = p_reader.get_u8();
+	function->rpc_config = _read_value(p_reader, p_root);
+	function->_initial_line = p_reader.get_i32();
+	function->_argument_count = p_reader.get_i32();
+	function->_default_arg_count = p_reader.get_i32();
+	function->_stack_size = p_reader.get_i32();
+	function->_instruction_args_size = p_reader.get_i32();
+	int call_cache_count = p_reader.get_i32();
+
+	int argument_type_count = p_reader.get_count();
+	for (int i = 0; i < argument_type_count; i++) {
+		function->argument_types.push_back(_read_data_type(p_reader, p_root));
+	}
+	function->return_type = _read_data_type(p_reader, p_root);
+	function->method_info = _read_method_info(p_reader, p_root);
+
+	bool is_lambda = p_reader.get_u8();
+	if (is_lambda) {
+		GDScript::LambdaInfo info;
+		info.capture_count = p_reader.get_i32();
+		info.use_self = p_reader.get_u8();
+		p_script->lambda_info.insert(function, info);
+	}
+
+	int code_size = p_reader.get_count();
+	function->code.resize(code_size);
+	for (int i = 0; i < code_size; i++) {
+		function->code.write[i] = p_reader.get_i32();
+	}
+
+	int default_argument_count = p_reader.get_count();
+	function->default_arguments.resize(default_argument_count);
+	for (int i = 0; i < default_argument_count; i++) {
+		function->default_arguments.write[i] = p_reader.get_i32();
+	}
+
+	int temporary_slot_count = p_reader.get_count();
+	for (int i = 0; i < temporary_slot_count; i++) {
+		int slot = p_reader.get_i32();
+		uint32_t type = p_reader.get_u32();
+		if (type >= Variant::VARIANT_MAX) {
+			p_reader.failed = true;
+			break;
+		}
+		function->temporary_slots[slot] = (Variant::Type)type;
+	}
+
+	int constant_count = p_reader.get_count();
+	function->constants.resize(constant_count);
+	for (int i = 0; i < constant_count; i++) {
+		function->constants.write[i] = _read_value(p_reader, p_root);
+	}
+
+	int global_name_count = p_reader.get_count();
+	function->global_names.resize(global_name_count);
+	for (int i = 0; i < global_name_count; i++) {
+		function->global_names.write[i] = p_reader.get_string_name();
+	}
+
+	// Pointers are looked up again by name, any that no longer exists makes the whole script fall back to tokens.
+
+	int operator_count = p_reader.get_count();
+	for (int i = 0; i < operator_count && !p_reader.failed; i++) {
+		uint32_t op = p_reader.get_u32();
+		uint32_t left = p_reader.get_u32();
+		uint32_t right = p_reader.get_u32();
+		Variant::ValidatedOperatorEvaluator evaluator = nullptr;
+		if (op < Variant::OP_MAX && left < Variant::VARIANT_MAX && right < Variant::VARIANT_MAX) {
+			evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, (Variant::Type)left, (Variant::Type)right);
+		}
+		p_reader.failed = p_reader.failed || !evaluator;
+		function->operator_funcs.push_back(evaluator);
+#ifdef DEBUG_ENABLED
+		function->operator_names.push_back(op < Variant::OP_MAX ? Variant::get_operator_name((Variant::Operator)op) : String());
+#endif
+	}
+
+#define READ_MEMBER_SYMBOLS(m_list, m_lookup, m_debug_names)            \
+	{                                                                   \
+		int count = p_reader.get_count();                               \
+		for (int i = 0; i < count && !p_reader.failed; i++) {           \
+			uint32_t type = p_reader.get_u32();                         \
+			StringName name = p_reader.get_string_name();               \
+			if (type >= Variant::VARIANT_MAX) {                         \
+				p_reader.failed = true;                                 \
+				break;                                                  \
+			}                                                           \
+			auto symbol = Variant::m_lookup((Variant::Type)type, name); \
+			p_reader.failed = p_reader.failed || !symbol;               \
+			function->m_list.push_back(symbol);                         \
+			DEBUG_NAME(m_debug_names, name);                            \
+		}                                                               \
+	}
+
+#define READ_TYPE_SYMBOLS(m_list, m_lookup)                       \
+	{                                                             \
+		int count = p_reader.get_count();                         \
+		for (int i = 0; i < count && !p_reader.failed; i++) {     \
+			uint32_t type = p_reader.get_u32();                   \
+			if (type >= Variant::VARIANT_MAX) {                   \
+				p_reader.failed = true;                           \
+				break;                                            \
+			}                                                     \
+			auto symbol = Variant::m_lookup((Variant::Type)type); \
+			p_reader.failed = p_reader.failed || !symbol;         \
+			function->m_list.push_back(symbol);                   \
+		}                                                         \
+	}
+
+#ifdef DEBUG_ENABLED
+#define DEBUG_NAME(m_debug_names, m_name) function->m_debug_names.push_back(m_name)
+#else
+#define DEBUG_NAME(m_debug_names, m_name)
+#endif
+
+	READ_MEMBER_SYMBOLS(setters, get_member_validated_setter, setter_names);
+	READ_MEMBER_SYMBOLS(getters, get_member_validated_getter, getter_names);
+	READ_TYPE_SYMBOLS(keyed_setters, get_member_validated_keyed_setter);
+	READ_TYPE_SYMBOLS(keyed_getters, get_member_validated_keyed_getter);
+	READ_TYPE_SYMBOLS(indexed_setters, get_member_validated_indexed_setter);
+	READ_TYPE_SYMBOLS(indexed_getters, get_member_validated_indexed_getter);
+	READ_MEMBER_SYMBOLS(builtin_methods, get_validated_builtin_method, builtin_methods_names);
+
+	int constructor_count = p_reader.get_count();
+	for (int i = 0; i < constructor_count && !p_reader.failed; i++) {
+		uint32_t type = p_reader.get_u32();
+		int index = p_reader.get_i32();
+		if (type >= Variant::VARIANT_MAX || index < 0 || index >= Variant::get_constructor_count((Variant::Type)type)) {
+			p_reader.failed = true;
+			break;
+		}
+		function->constructors.push_back(Variant::get_validated_constructor((Variant::Type)type, index));
+		DEBUG_NAME(constructors_names, Variant::get_type_name((Variant::Type)type));
+	}
+
+	int utility_count = p_reader.get_count();
+	for (int i = 0; i < utility_count && !p_reader.failed; i++) {
+		StringName name = p_reader.get_string_name();
+		Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(name);
+		p_reader.failed = p_reader.failed || !utility;
+		function->utilities.push_back(utility);
+		DEBUG_NAME(utilities_names, name);
+	}
+
+	int gds_utility_count = p_reader.get_count();
+	for (int i = 0; i < gds_utility_count && !p_reader.failed; i++) {
+		StringName name = p_reader.get_string_name();
+		GDScriptUtilityFunctions::FunctionPtr utility = GDScriptUtilityFunctions::get_function(name);
+		p_reader.failed = p_reader.failed || !utility;
+		function->gds_utilities.push_back(utility);
+		DEBUG_NAME(gds_utilities_names, name);
+	}
+
+#undef READ_MEMBER_SYMBOLS
+#undef READ_TYPE_SYMBOLS
+#undef DEBUG_NAME
+
+	int method_count = p_reader.get_count();
+	for (int i = 0; i < method_count && !p_reader.failed; i++) {
+		StringName class_name = p_reader.get_string_name();
+		StringName method_name = p_reader.get_string_name();
+		MethodBind *method = ClassDB::get_method(class_name, method_name);
+		p_reader.failed = p_reader.failed || !method;
+		function->methods.push_back(method);
+	}
+
+	int lambda_count = p_reader.get_count();
+	for (int i = 0; i < lambda_count && !p_reader.failed; i++) {
+		GDScriptFunction *lambda = _read_function(p_reader, p_root, p_script);
+		if (lambda) {
+			function->lambdas.push_back(lambda);
+		}
+	}
+
+	if (p_reader.failed || function->code.is_empty() || call_cache_count < 0) {
+		p_reader.failed = true;
+		p_script->lambda_info.erase(function);
+		memdelete(function);
+		return nullptr;
+	}
+
+	// Same setup as `GDScriptByteCodeGenerator::write_end()`.
+	function->_code_ptr = function->code.ptrw();
+	function->_code_size = function->code.size();
+	function->_default_arg_ptr = function->default_arguments.is_empty() ? nullptr : function->default_arguments.ptr();
+	function->_constant_count = function->constants.size();
+	function->_constants_ptr = function->constants.is_empty() ? nullptr : function->constants.ptrw();
+	function->_global_names_count = function->global_names.size();
+	function->_global_names_ptr = function->global_names.is_empty() ? nullptr : function->global_names.ptr();
+	function->_operator_funcs_count = function->operator_funcs.size();
+	function->_operator_funcs_ptr = function->operator_funcs.is_empty() ? nullptr : function->operator_funcs.ptr();
+	function->_setters_count = function->setters.size();
+	function->_setters_ptr = function->setters.is_empty() ? nullptr : function->setters.ptr();
+	function->_getters_count = function->getters.size();
+	function->_getters_ptr = function->getters.is_empty() ? nullptr : function->getters.ptr();
+	function->_keyed_setters_count = function->keyed_setters.size();
+	function->_keyed_setters_ptr = function->keyed_setters.is_empty() ? nullptr : function->keyed_setters.ptr();
+	function->_keyed_getters_count = function->keyed_getters.size();
+	function->_keyed_getters_ptr = function->keyed_getters.is_empty() ? nullptr : function->keyed_getters.ptr();
+	function->_indexed_setters_count = function->indexed_setters.size();
+	function->_indexed_setters_ptr = function->indexed_setters.is_empty() ? nullptr : function->indexed_setters.ptr();
+	function->_indexed_getters_count = function->indexed_getters.size();
+	function->_indexed_getters_ptr = function->indexed_getters.is_empty() ? nullptr : function->indexed_getters.ptr();
+	function->_builtin_methods_count = function->builtin_methods.size();
+	function->_builtin_methods_ptr = function->builtin_methods.is_empty() ? nullptr : function->builtin_methods.ptr();
+	function->_constructors_count = function->constructors.size();
+	function->_constructors_ptr = function->constructors.is_empty() ? nullptr : function->constructors.ptr();
+	function->_utilities_count = function->utilities.size();
+	function->_utilities_ptr = function->utilities.is_empty() ? nullptr : function->utilities.ptr();
+	function->_gds_utilities_count = function->gds_utilities.size();
+	function->_gds_utilities_ptr = function->gds_utilities.is_empty() ? nullptr : function->gds_utilities.ptr();
+	function->_methods_count = function->methods.size();
+	function->_methods_ptr = function->methods.is_empty() ? nullptr : function->methods.ptrw();
+	function->_lambdas_count = function->lambdas.size();
+	function->_lambdas_ptr = function->lambdas.is_empty() ? nullptr : function->lambdas.ptrw();
+	if (call_cache_count > 0) {
+		function->_call_caches_ptr = memnew_arr(GDScriptFunction::CallCache, call_cache_count);
+		function->_call_caches_count = call_cache_count;
+	}
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+
+	if (EngineDebugger::is_active()) {
+		String signature = function->source;
+		signature += "::" + itos(function->_initial_line);
+		if (p_script->local_name != StringName()) {
+			signature += "::" + String(p_script->local_name) + "." + String(function->name);
+		} else {
+			signature += "::" + String(function->name);
+		}
+		if (is_lambda) {
+			signature += "(lambda)";
+		}
+		function->profile.signature = signature;
+	}
+#endif
+
+	return function;
+}
+
+void GDScriptBytecodeBuffer::_read_class_tree(Reader &p_reader, GDScript *p_script) {
+	p_script->fully_qualified_name = p_reader.get_string();
+	p_script->local_name = p_reader.get_string_name();
+	p_script->global_name = p_reader.get_string_name();
+	p_script->simplified_icon_path = p_reader.get_string();
+
+	HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+	p_script->subclasses.clear();
+
+	int subclass_count = p_reader.get_count();
+	for (int i = 0; i < subclass_count && !p_reader.failed; i++) {
+		StringName name = p_reader.get_string_name();
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			// Peek the fully qualified name, which starts the record of the subclass.
+			int pos = p_reader.pos;
+			String fqcn = p_reader.get_string();
+			p_reader.pos = pos;
+			subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fqcn);
+		}
+
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		p_script->subclasses.insert(name, subclass);
+
+		_read_class_tree(p_reader, subclass.ptr());
+	}
+}
+
+void GDScriptBytecodeBuffer::_clear_class(GDScript *p_script) {
+	// Same as `GDScriptCompiler::_prepare_compilation()`, for scripts that are loaded again.
+	p_script->clearing = true;
+	p_script->valid = false;
+
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->_base = nullptr;
+	p_script->members.clear();
+
+	HashMap<StringName, Variant> constants;
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		constants.insert(E.key, E.value);
+	}
+	p_script->constants.clear();
+	constants.clear();
+	HashMap<StringName, GDScriptFunction *> member_functions;
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		member_functions.insert(E.key, E.value);
+	}
+	p_script->member_functions.clear();
+	for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
+		memdelete(E.value);
+	}
+
+	if (p_script->implicit_initializer) {
+		memdelete(p_script->implicit_initializer);
+	}
+	if (p_script->implicit_ready) {
+		memdelete(p_script->implicit_ready);
+	}
+	if (p_script->static_initializer) {
+		memdelete(p_script->static_initializer);
+	}
+
+	p_script->member_functions.clear();
+	p_script->member_indices.clear();
+	p_script->static_variables_indices.clear();
+	p_script->static_variables.clear();
+	p_script->_signals.clear();
+	p_script->initializer = nullptr;
+	p_script->implicit_initializer = nullptr;
+	p_script->implicit_ready = nullptr;
+	p_script->static_initializer = nullptr;
+	p_script->rpc_config.clear();
+	p_script->lambda_info.clear();
+
+	p_script->clearing = false;
+
+	for (KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		_clear_class(E.value.ptr());
+	}
+}
+
+// Everything `_read_class_tree()` and `_read_class()` replace, kept until the compiled data is known to load.
+struct GDScriptBytecodeBuffer::ClassState {
+	GDScript *script = nullptr;
+	GDScript *owner = nullptr;
+	bool valid = false;
+	bool tool = false;
+
+	String fully_qualified_name;
+	StringName local_name;
+	StringName global_name;
+	String simplified_icon_path;
+
+	Ref<GDScriptNativeClass> native;
+	Ref<GDScript> base;
+	HashMap<StringName, GDScript::MemberInfo> member_indices;
+	HashSet<StringName> members;
+	HashMap<StringName, GDScript::MemberInfo> static_variables_indices;
+	Vector<Variant> static_variables;
+	HashMap<StringName, Variant> constants;
+	HashMap<StringName, GDScriptFunction *> member_functions;
+	HashMap<StringName, Ref<GDScript>> subclasses;
+	HashMap<StringName, MethodInfo> signals;
+	Dictionary rpc_config;
+	HashMap<GDScriptFunction *, GDScript::LambdaInfo> lambda_info;
+
+	GDScriptFunction *initializer = nullptr;
+	GDScriptFunction *implicit_initializer = nullptr;
+	GDScriptFunction *implicit_ready = nullptr;
+	GDScriptFunction *static_initializer = nullptr;
+};
+
+void GDScriptBytecodeBuffer::_take_class_state(GDScript *p_script, List<ClassState> &r_states) {
+	// Leaves the script empty, like `_clear_class()` does, but without freeing anything.
+	ClassState &state = r_states.push_back(ClassState())->get();
+	state.script = p_script;
+	state.owner = p_script->_owner;
+	state.valid = p_script->valid;
+	state.tool = p_script->tool;
+	state.fully_qualified_name = p_script->fully_qualified_name;
+	state.local_name = p_script->local_name;
+	state.global_name = p_script->global_name;
+	state.simplified_icon_path = p_script->simplified_icon_path;
+	state.native = p_script->native;
+	state.base = p_script->base;
+	state.member_indices = p_script->member_indices;
+	state.members = p_script->members;
+	state.static_variables_indices = p_script->static_variables_indices;
+	state.static_variables = p_script->static_variables;
+	state.constants = p_script->constants;
+	state.member_functions = p_script->member_functions;
+	state.subclasses = p_script->subclasses;
+	state.signals = p_script->_signals;
+	state.rpc_config = p_script->rpc_config;
+	state.lambda_info = p_script->lambda_info;
+	state.initializer = p_script->initializer;
+	state.implicit_initializer = p_script->implicit_initializer;
+	state.implicit_ready = p_script->implicit_ready;
+	state.static_initializer = p_script->static_initializer;
+
+	p_script->valid = false;
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->_base = nullptr;
+	p_script->member_indices.clear();
+	p_script->members.clear();
+	p_script->static_variables_indices.clear();
+	p_script->static_variables.clear();
+	p_script->constants.clear();
+	p_script->member_functions.clear();
+	p_script->_signals.clear();
+	p_script->rpc_config.clear();
+	p_script->lambda_info.clear();
+	p_script->initializer = nullptr;
+	p_script->implicit_initializer = nullptr;
+	p_script->implicit_ready = nullptr;
+	p_script->static_initializer = nullptr;
+
+	// The subclasses stay in place, `_read_class_tree()` reuses them.
+	for (KeyValue<StringName, Ref<GDScript>> &E : state.subclasses) {
+		_take_class_state(E.value.ptr(), r_states);
+	}
+}
+
+void GDScriptBytecodeBuffer::_restore_class_state(ClassState &p_state) {
+	GDScript *script = p_state.script;
+	script->_owner = p_state.owner;
+	script->valid = p_state.valid;
+	script->tool = p_state.tool;
+	script->fully_qualified_name = p_state.fully_qualified_name;
+	script->local_name = p_state.local_name;
+	script->global_name = p_state.global_name;
+	script->simplified_icon_path = p_state.simplified_icon_path;
+	script->native = p_state.native;
+	script->base = p_state.base;
+	script->_base = p_state.base.ptr();
+	script->member_indices = p_state.member_indices;
+	script->members = p_state.members;
+	script->static_variables_indices = p_state.static_variables_indices;
+	script->static_variables = p_state.static_variables;
+	script->constants = p_state.constants;
+	script->member_functions = p_state.member_functions;
+	script->subclasses = p_state.subclasses;
+	script->_signals = p_state.signals;
+	script->rpc_config = p_state.rpc_config;
+	script->lambda_info = p_state.lambda_info;
+	script->initializer = p_state.initializer;
+	script->implicit_initializer = p_state.implicit_initializer;
+	script->implicit_ready = p_state.implicit_ready;
+	script->static_initializer = p_state.static_initializer;
+}
+
+void GDScriptBytecodeBuffer::_free_class_state(ClassState &p_state) {
+	p_state.script->clearing = true;
+	p_state.constants.clear();
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_state.member_functions) {
+		memdelete(E.value);
+	}
+	p_state.member_functions.clear();
+	if (p_state.implicit_initializer) {
+		memdelete(p_state.implicit_initializer);
+	}
+	if (p_state.implicit_ready) {
+		memdelete(p_state.implicit_ready);
+	}
+	if (p_state.static_initializer) {
+		memdelete(p_state.static_initializer);
+	}
+	p_state.script->clearing = false;
+}
+
+void GDScriptBytecodeBuffer::_read_class(Reader &p_reader, GDScript *p_root, GDScript *p_script) {
+	p_script->tool = p_reader.get_u8();
+
+	StringName native_name = p_reader.get_string_name();
+	const HashMap<StringName, int>::ConstIterator native_index = GDScriptLanguage::get_singleton()->get_global_map().find(native_name);
+	if (p_reader.failed || !native_index) {
+		p_reader.failed = true;
+		return;
+	}
+	p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[native_index->value];
+	if (p_script->native.is_null()) {
+		p_reader.failed = true;
+		return;
+	}
+
+	if (p_reader.get_u8()) {
+		Ref<GDScript> base = _read_object(p_reader, p_root);
+		if (base.is_null()) {
+			p_reader.failed = true;
+			return;
+		}
+		p_script->base = base;
+		p_script->_base = base.ptr();
+	}
+
+	int member_count = p_reader.get_count();
+	for (int i = 0; i < member_count && !p_reader.failed; i++) {
+		_read_member_info(p_reader, p_root, p_script->member_indices);
+	}
+	int own_member_count = p_reader.get_count();
+	for (int i = 0; i < own_member_count && !p_reader.failed; i++) {
+		p_script->members.insert(p_reader.get_string_name());
+	}
+	int static_variable_count = p_reader.get_count();
+	for (int i = 0; i < static_variable_count && !p_reader.failed; i++) {
+		_read_member_info(p_reader, p_root, p_script->static_variables_indices);
+	}
+	p_script->static_variables.resize(p_script->static_variables_indices.size());
+
+	int constant_count = p_reader.get_count();
+	for (int i = 0; i < constant_count && !p_reader.failed; i++) {
+		StringName name = p_reader.get_string_name();
+		p_script->constants.insert(name, _read_value(p_reader, p_root));
+	}
+
+	int signal_count = p_reader.get_count();
+	for (int i = 0; i < signal_count && !p_reader.failed; i++) {
+		StringName name = p_reader.get_string_name();
+		p_script->_signals[name] = _read_method_info(p_reader, p_root);
+	}
+
+	p_script->rpc_config = _read_value(p_reader, p_root);
+
+	int function_count = p_reader.get_count();
+	for (int i = 0; i < function_count && !p_reader.failed; i++) {
+		uint8_t role = p_reader.get_u8();
+		GDScriptFunction *function = _read_function(p_reader, p_root, p_script);
+		if (!function) {
+			return;
+		}
+
+		switch (role) {
+			case FUNCTION_MEMBER: {
+				p_script->member_functions[function->name] = function;
+				if (function->name == GDScriptLanguage::get_singleton()->strings._init) {
+					p_script->initializer = function;
+				}
+			} break;
+			case FUNCTION_IMPLICIT_INITIALIZER: {
+				p_script->implicit_initializer = function;
+			} break;
+			case FUNCTION_IMPLICIT_READY: {
+				p_script->implicit_ready = function;
+			} break;
+			case FUNCTION_STATIC_INITIALIZER: {
+				p_script->static_initializer = function;
+			} break;
+			default: {
+				memdelete(function);
+				p_reader.failed = true;
+			} break;
+		}
+	}
+
+	int subclass_count = p_reader.get_count();
+	for (int i = 0; i < subclass_count && !p_reader.failed; i++) {
+		StringName name = p_reader.get_string_name();
+		Ref<GDScript> *subclass = p_script->subclasses.getptr(name);
+		if (!subclass) {
+			p_reader.failed = true;
+			return;
+		}
+		_read_class(p_reader, p_root, subclass->ptr());
+	}
+
+	p_script->valid = !p_reader.failed;
+}
+
+Error GDScriptBytecodeBuffer::make_scripts(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_COND_V(!is_compiled_buffer(p_buffer), ERR_INVALID_DATA);
+	if (!_is_compatible(p_buffer)) {
+		return ERR_UNAVAILABLE;
+	}
+
+	Reader reader;
+	reader.ptr = p_buffer.ptr() + HEADER_SIZE + decode_uint32(&p_buffer.ptr()[28]);
+	reader.size = decode_uint32(&p_buffer.ptr()[32]);
+	reader.get_u32(); // Flags.
+	_read_class_tree(reader, p_script);
+
+	return reader.failed ? ERR_FILE_CORRUPT : OK;
+}
+
+Error GDScriptBytecodeBuffer::load_script(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_COND_V(!is_compiled_buffer(p_buffer), ERR_INVALID_DATA);
+	if (!_is_compatible(p_buffer)) {
+		print_verbose(vformat(R"(GDScript: Compiled bytecode of "%s" was made by a different engine build, compiling it instead.)", p_script->path));
+		return ERR_UNAVAILABLE;
+	}
+
+	Reader reader;
+	reader.ptr = p_buffer.ptr() + HEADER_SIZE + decode_uint32(&p_buffer.ptr()[28]);
+	reader.size = decode_uint32(&p_buffer.ptr()[32]);
+	uint32_t flags = reader.get_u32();
+
+	// The previous data is only freed once the compiled data has loaded, so that a failure leaves the
+	// script untouched for compiling the binary tokens instead.
+	List<ClassState> old_states;
+	_take_class_state(p_script, old_states);
+
+	p_script->_owner = nullptr;
+	_read_class_tree(reader, p_script);
+	if (!reader.failed) {
+		_read_class(reader, p_script, p_script);
+	}
+
+	if (reader.failed) {
+		_clear_class(p_script);
+		for (ClassState &state : old_states) {
+			_restore_class_state(state);
+		}
+		print_verbose(vformat(R"(GDScript: Compiled bytecode of "%s" can't be used by this build, compiling it instead.)", p_script->path));
+		return ERR_FILE_CORRUPT;
+	}
+
+	for (ClassState &state : old_states) {
+		_free_class_state(state);
+	}
+
+	if (flags & FLAG_KEEP_STATIC_DATA) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	return GDScriptCache::finish_compiling(p_script->path);
+}
@@ -0,0 +1,123 @@
+/**************************************************************************/
+/*  gdscript_bytecode_buffer.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_BUFFER_H
+#define GDSCRIPT_BYTECODE_BUFFER_H
+
+#include "gdscript.h"
+
+// Compiled scripts in a binary form, written by the "Compiled bytecode" export mode.
+// Holds the class tree, the member tables and the bytecode of every function, so loading needs
+// neither the parser nor the analyzer. Engine pointers referenced by the bytecode (operator
+// evaluators, method binds, utility functions...) are stored by name and looked up again on load.
+// The binary tokens of the script are embedded as well, and used instead of the compiled data when
+// it was made by a different engine build (including a debug build for a release one, or the other
+// way around) or references something that doesn't exist in this one.
+class GDScriptBytecodeBuffer {
+	struct Writer;
+	struct Reader;
+	struct Symbols;
+	struct ClassState;
+
+	enum {
+		HEADER_SIZE = 40,
+		FLAG_KEEP_STATIC_DATA = 1,
+	};
+
+	enum ValueKind {
+		VALUE_PLAIN,
+		VALUE_ARRAY,
+		VALUE_DICTIONARY,
+		VALUE_OBJECT,
+	};
+
+	enum ObjectKind {
+		OBJECT_NULL,
+		OBJECT_GDSCRIPT,
+		OBJECT_NATIVE_CLASS,
+		OBJECT_RESOURCE,
+	};
+
+	enum FunctionRole {
+		FUNCTION_MEMBER,
+		FUNCTION_IMPLICIT_INITIALIZER,
+		FUNCTION_IMPLICIT_READY,
+		FUNCTION_STATIC_INITIALIZER,
+	};
+
+	static bool _is_compatible(const Vector<uint8_t> &p_buffer);
+
+#ifdef TOOLS_ENABLED
+	static void _write_object(Writer &p_writer, const Object *p_object);
+	static void _write_value(Writer &p_writer, const Variant &p_value, int p_depth = 0);
+	static void _write_data_type(Writer &p_writer, const GDScriptDataType &p_type);
+	static void _write_property_info(Writer &p_writer, const PropertyInfo &p_info);
+	static void _write_method_info(Writer &p_writer, const MethodInfo &p_info);
+	static void _write_member_info(Writer &p_writer, const StringName &p_name, const GDScript::MemberInfo &p_info);
+	static void _write_function(Writer &p_writer, const Symbols &p_symbols, const GDScriptFunction *p_function);
+	static void _write_class_tree(Writer &p_writer, const GDScript *p_script);
+	static void _write_class(Writer &p_writer, const Symbols &p_symbols, const GDScript *p_script);
+#endif
+
+	static Variant _read_object(Reader &p_reader, GDScript *p_root);
+	static Variant _read_value(Reader &p_reader, GDScript *p_root, int p_depth = 0);
+	static GDScriptDataType _read_data_type(Reader &p_reader, GDScript *p_root, int p_depth = 0);
+	static PropertyInfo _read_property_info(Reader &p_reader);
+	static MethodInfo _read_method_info(Reader &p_reader, GDScript *p_root);
+	static void _read_member_info(Reader &p_reader, GDScript *p_root, HashMap<StringName, GDScript::MemberInfo> &r_members);
+	static GDScriptFunction *_read_function(Reader &p_reader, GDScript *p_root, GDScript *p_script);
+	static void _read_class_tree(Reader &p_reader, GDScript *p_script);
+	static void _read_class(Reader &p_reader, GDScript *p_root, GDScript *p_script);
+	static void _clear_class(GDScript *p_script);
+	static void _take_class_state(GDScript *p_script, List<ClassState> &r_states);
+	static void _restore_class_state(ClassState &p_state);
+	static void _free_class_state(ClassState &p_state);
+
+public:
+	enum {
+		FORMAT_VERSION = 1,
+	};
+
+	static bool is_compiled_buffer(const Vector<uint8_t> &p_buffer);
+	static Vector<uint8_t> extract_binary_tokens(const Vector<uint8_t> &p_buffer);
+
+	// Creates the inner class scripts, like `GDScriptCompiler::make_scripts()` does.
+	static Error make_scripts(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+	// Fills the script with the compiled data, as a replacement of parsing and compiling it.
+	// On failure the script and its inner classes are left as they were.
+	static Error load_script(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+
+#ifdef TOOLS_ENABLED
+	// Returns an empty buffer if the script references something that can't be stored.
+	static Vector<uint8_t> serialize(const GDScript *p_script, const Vector<uint8_t> &p_binary_tokens);
+#endif
+};
+
+#endif // GDSCRIPT_BYTECODE_BUFFER_H
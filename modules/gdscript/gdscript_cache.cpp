@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_buffer.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
@@ -71,7 +72,7 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 				status = PARSED;
 				String remapped_path = ResourceLoader::path_remap(path);
 				if (remapped_path.get_extension().to_lower() == "gdc") {
-					result = parser->parse_binary(GDScriptCache::get_binary_tokens(remapped_path), path);
+					result = parser->parse_binary(GDScriptBytecodeBuffer::extract_binary_tokens(GDScriptCache::get_binary_tokens(remapped_path)), path);
 				} else {
 					result = parser->parse(GDScriptCache::get_source_code(remapped_path), path, false);
 				}
@@ -276,12 +277,18 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 	Ref<GDScript> script;
 	script.instantiate();
 	script->set_path(p_path, true);
+	bool is_compiled = false;
 	if (remapped_path.get_extension().to_lower() == "gdc") {
 		Vector<uint8_t> buffer = get_binary_tokens(remapped_path);
 		if (buffer.is_empty()) {
 			r_error = ERR_FILE_CANT_READ;
 		}
-		script->set_binary_tokens_source(buffer);
+		if (GDScriptBytecodeBuffer::is_compiled_buffer(buffer)) {
+			script->set_compiled_bytecode_source(buffer);
+			is_compiled = GDScriptBytecodeBuffer::make_scripts(script.ptr(), buffer) == OK;
+		} else {
+			script->set_binary_tokens_source(buffer);
+		}
 	} else {
 		r_error = script->load_source_code(remapped_path);
 	}
@@ -290,9 +297,11 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	if (!is_compiled) {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -330,7 +339,11 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 				r_error = ERR_FILE_CANT_READ;
 				return script;
 			}
-			script->set_binary_tokens_source(buffer);
+			if (GDScriptBytecodeBuffer::is_compiled_buffer(buffer)) {
+				script->set_compiled_bytecode_source(buffer);
+			} else {
+				script->set_binary_tokens_source(buffer);
+			}
 		} else {
 			r_error = script->load_source_code(p_path);
 			if (r_error) {
@@ -396,6 +409,11 @@ void GDScriptCache::add_static_script(Ref<GDScript> p_script) {
 	singleton->static_gdscript_cache[p_script->get_fully_qualified_name()] = p_script;
 }
 
+bool GDScriptCache::has_static_script(const String &p_fqcn) {
+	MutexLock lock(singleton->mutex);
+	return singleton->static_gdscript_cache.has(p_fqcn);
+}
+
 void GDScriptCache::remove_static_script(const String &p_fqcn) {
 	singleton->static_gdscript_cache.erase(p_fqcn);
 }
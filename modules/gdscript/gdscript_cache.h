@@ -105,6 +105,7 @@ public:
 	static Ref<GDScript> get_cached_script(const String &p_path);
 	static Error finish_compiling(const String &p_owner);
 	static void add_static_script(Ref<GDScript> p_script);
+	static bool has_static_script(const String &p_fqcn);
 	static void remove_static_script(const String &p_fqcn);
 
 	static Ref<PackedScene> get_packed_scene(const String &p_path, Error &r_error, const String &p_owner = "");
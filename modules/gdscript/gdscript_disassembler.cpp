@@ -141,6 +141,34 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_VALIDATED_ASSIGN: {
+				text += "validated operator assign ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+
+				incr += 8;
+			} break;
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				text += "validated operator jump-if-not ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += " to ";
+				text += itos(_code_ptr[ip + 7]);
+
+				incr += 8;
+			} break;
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -259,6 +287,27 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_SET_INDEXED_TYPED_ARRAY: {
+				text += "set indexed typed array ";
+				text += DADDR(1);
+				text += "[";
+				text += DADDR(2);
+				text += "] = ";
+				text += DADDR(3);
+
+				incr += 4;
+			} break;
+			case OPCODE_GET_INDEXED_TYPED_ARRAY: {
+				text += "get indexed typed array ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += "[";
+				text += DADDR(2);
+				text += "]";
+
+				incr += 4;
+			} break;
 			case OPCODE_SET_NAMED: {
 				text += "set_named ";
 				text += DADDR(1);
@@ -590,7 +639,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -1128,4 +1177,163 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 	}
 }
 
+const char *GDScriptFunction::get_opcode_name(Opcode p_opcode) {
+	static const char *names[] = {
+		"OPCODE_OPERATOR",
+		"OPCODE_OPERATOR_VALIDATED",
+		"OPCODE_OPERATOR_VALIDATED_ASSIGN",
+		"OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT",
+		"OPCODE_TYPE_TEST_BUILTIN",
+		"OPCODE_TYPE_TEST_ARRAY",
+		"OPCODE_TYPE_TEST_NATIVE",
+		"OPCODE_TYPE_TEST_SCRIPT",
+		"OPCODE_SET_KEYED",
+		"OPCODE_SET_KEYED_VALIDATED",
+		"OPCODE_SET_INDEXED_VALIDATED",
+		"OPCODE_GET_KEYED",
+		"OPCODE_GET_KEYED_VALIDATED",
+		"OPCODE_GET_INDEXED_VALIDATED",
+		"OPCODE_SET_INDEXED_TYPED_ARRAY",
+		"OPCODE_GET_INDEXED_TYPED_ARRAY",
+		"OPCODE_SET_NAMED",
+		"OPCODE_SET_NAMED_VALIDATED",
+		"OPCODE_GET_NAMED",
+		"OPCODE_GET_NAMED_VALIDATED",
+		"OPCODE_SET_MEMBER",
+		"OPCODE_GET_MEMBER",
+		"OPCODE_SET_STATIC_VARIABLE, // Only for GDScript.",
+		"OPCODE_GET_STATIC_VARIABLE, // Only for GDScript.",
+		"OPCODE_ASSIGN",
+		"OPCODE_ASSIGN_TRUE",
+		"OPCODE_ASSIGN_FALSE",
+		"OPCODE_ASSIGN_TYPED_BUILTIN",
+		"OPCODE_ASSIGN_TYPED_ARRAY",
+		"OPCODE_ASSIGN_TYPED_NATIVE",
+		"OPCODE_ASSIGN_TYPED_SCRIPT",
+		"OPCODE_CAST_TO_BUILTIN",
+		"OPCODE_CAST_TO_NATIVE",
+		"OPCODE_CAST_TO_SCRIPT",
+		"OPCODE_CONSTRUCT, // Only for basic types!",
+		"OPCODE_CONSTRUCT_VALIDATED, // Only for basic types!",
+		"OPCODE_CONSTRUCT_ARRAY",
+		"OPCODE_CONSTRUCT_TYPED_ARRAY",
+		"OPCODE_CONSTRUCT_DICTIONARY",
+		"OPCODE_CALL",
+		"OPCODE_CALL_RETURN",
+		"OPCODE_CALL_ASYNC",
+		"OPCODE_CALL_UTILITY",
+		"OPCODE_CALL_UTILITY_VALIDATED",
+		"OPCODE_CALL_GDSCRIPT_UTILITY",
+		"OPCODE_CALL_BUILTIN_TYPE_VALIDATED",
+		"OPCODE_CALL_SELF_BASE",
+		"OPCODE_CALL_METHOD_BIND",
+		"OPCODE_CALL_METHOD_BIND_RET",
+		"OPCODE_CALL_BUILTIN_STATIC",
+		"OPCODE_CALL_NATIVE_STATIC",
+		"OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN",
+		"OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN",
+		"OPCODE_AWAIT",
+		"OPCODE_AWAIT_RESUME",
+		"OPCODE_CREATE_LAMBDA",
+		"OPCODE_CREATE_SELF_LAMBDA",
+		"OPCODE_JUMP",
+		"OPCODE_JUMP_IF",
+		"OPCODE_JUMP_IF_NOT",
+		"OPCODE_JUMP_TO_DEF_ARGUMENT",
+		"OPCODE_JUMP_IF_SHARED",
+		"OPCODE_RETURN",
+		"OPCODE_RETURN_TYPED_BUILTIN",
+		"OPCODE_RETURN_TYPED_ARRAY",
+		"OPCODE_RETURN_TYPED_NATIVE",
+		"OPCODE_RETURN_TYPED_SCRIPT",
+		"OPCODE_ITERATE_BEGIN",
+		"OPCODE_ITERATE_BEGIN_INT",
+		"OPCODE_ITERATE_BEGIN_FLOAT",
+		"OPCODE_ITERATE_BEGIN_VECTOR2",
+		"OPCODE_ITERATE_BEGIN_VECTOR2I",
+		"OPCODE_ITERATE_BEGIN_VECTOR3",
+		"OPCODE_ITERATE_BEGIN_VECTOR3I",
+		"OPCODE_ITERATE_BEGIN_STRING",
+		"OPCODE_ITERATE_BEGIN_DICTIONARY",
+		"OPCODE_ITERATE_BEGIN_ARRAY",
+		"OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY",
+		"OPCODE_ITERATE_BEGIN_PACKED_INT32_ARRAY",
+		"OPCODE_ITERATE_BEGIN_PACKED_INT64_ARRAY",
+		"OPCODE_ITERATE_BEGIN_PACKED_FLOAT32_ARRAY",
+		"OPCODE_ITERATE_BEGIN_PACKED_FLOAT64_ARRAY",
+		"OPCODE_ITERATE_BEGIN_PACKED_STRING_ARRAY",
+		"OPCODE_ITERATE_BEGIN_PACKED_VECTOR2_ARRAY",
+		"OPCODE_ITERATE_BEGIN_PACKED_VECTOR3_ARRAY",
+		"OPCODE_ITERATE_BEGIN_PACKED_COLOR_ARRAY",
+		"OPCODE_ITERATE_BEGIN_OBJECT",
+		"OPCODE_ITERATE",
+		"OPCODE_ITERATE_INT",
+		"OPCODE_ITERATE_FLOAT",
+		"OPCODE_ITERATE_VECTOR2",
+		"OPCODE_ITERATE_VECTOR2I",
+		"OPCODE_ITERATE_VECTOR3",
+		"OPCODE_ITERATE_VECTOR3I",
+		"OPCODE_ITERATE_STRING",
+		"OPCODE_ITERATE_DICTIONARY",
+		"OPCODE_ITERATE_ARRAY",
+		"OPCODE_ITERATE_PACKED_BYTE_ARRAY",
+		"OPCODE_ITERATE_PACKED_INT32_ARRAY",
+		"OPCODE_ITERATE_PACKED_INT64_ARRAY",
+		"OPCODE_ITERATE_PACKED_FLOAT32_ARRAY",
+		"OPCODE_ITERATE_PACKED_FLOAT64_ARRAY",
+		"OPCODE_ITERATE_PACKED_STRING_ARRAY",
+		"OPCODE_ITERATE_PACKED_VECTOR2_ARRAY",
+		"OPCODE_ITERATE_PACKED_VECTOR3_ARRAY",
+		"OPCODE_ITERATE_PACKED_COLOR_ARRAY",
+		"OPCODE_ITERATE_OBJECT",
+		"OPCODE_STORE_GLOBAL",
+		"OPCODE_STORE_NAMED_GLOBAL",
+		"OPCODE_TYPE_ADJUST_BOOL",
+		"OPCODE_TYPE_ADJUST_INT",
+		"OPCODE_TYPE_ADJUST_FLOAT",
+		"OPCODE_TYPE_ADJUST_STRING",
+		"OPCODE_TYPE_ADJUST_VECTOR2",
+		"OPCODE_TYPE_ADJUST_VECTOR2I",
+		"OPCODE_TYPE_ADJUST_RECT2",
+		"OPCODE_TYPE_ADJUST_RECT2I",
+		"OPCODE_TYPE_ADJUST_VECTOR3",
+		"OPCODE_TYPE_ADJUST_VECTOR3I",
+		"OPCODE_TYPE_ADJUST_TRANSFORM2D",
+		"OPCODE_TYPE_ADJUST_VECTOR4",
+		"OPCODE_TYPE_ADJUST_VECTOR4I",
+		"OPCODE_TYPE_ADJUST_PLANE",
+		"OPCODE_TYPE_ADJUST_QUATERNION",
+		"OPCODE_TYPE_ADJUST_AABB",
+		"OPCODE_TYPE_ADJUST_BASIS",
+		"OPCODE_TYPE_ADJUST_TRANSFORM3D",
+		"OPCODE_TYPE_ADJUST_PROJECTION",
+		"OPCODE_TYPE_ADJUST_COLOR",
+		"OPCODE_TYPE_ADJUST_STRING_NAME",
+		"OPCODE_TYPE_ADJUST_NODE_PATH",
+		"OPCODE_TYPE_ADJUST_RID",
+		"OPCODE_TYPE_ADJUST_OBJECT",
+		"OPCODE_TYPE_ADJUST_CALLABLE",
+		"OPCODE_TYPE_ADJUST_SIGNAL",
+		"OPCODE_TYPE_ADJUST_DICTIONARY",
+		"OPCODE_TYPE_ADJUST_ARRAY",
+		"OPCODE_TYPE_ADJUST_PACKED_BYTE_ARRAY",
+		"OPCODE_TYPE_ADJUST_PACKED_INT32_ARRAY",
+		"OPCODE_TYPE_ADJUST_PACKED_INT64_ARRAY",
+		"OPCODE_TYPE_ADJUST_PACKED_FLOAT32_ARRAY",
+		"OPCODE_TYPE_ADJUST_PACKED_FLOAT64_ARRAY",
+		"OPCODE_TYPE_ADJUST_PACKED_STRING_ARRAY",
+		"OPCODE_TYPE_ADJUST_PACKED_VECTOR2_ARRAY",
+		"OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY",
+		"OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY",
+		"OPCODE_ASSERT",
+		"OPCODE_BREAKPOINT",
+		"OPCODE_LINE",
+		"OPCODE_END",
+	};
+	static_assert((sizeof(names) / sizeof(names[0]) == (OPCODE_END + 1)), "Opcode names aren't the same as opcodes in enum.");
+
+	ERR_FAIL_INDEX_V(p_opcode, OPCODE_END + 1, "<invalid>");
+	return names[p_opcode];
+}
+
 #endif // DEBUG_ENABLED
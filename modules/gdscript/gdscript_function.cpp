@@ -104,6 +104,8 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+SafeNumeric<uint32_t> GDScriptFunction::call_cache_generation;
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -117,6 +119,12 @@ GDScriptFunction::GDScriptFunction() {
 GDScriptFunction::~GDScriptFunction() {
 	get_script()->member_functions.erase(name);
 
+	// Call caches in other functions may point to this one.
+	call_cache_generation.increment();
+	if (_call_caches_ptr) {
+		memdelete_arr(_call_caches_ptr);
+	}
+
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
 	}
@@ -38,6 +38,7 @@
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
@@ -199,6 +200,8 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_ASSIGN,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_NATIVE,
@@ -209,6 +212,8 @@ public:
 		OPCODE_GET_KEYED,
 		OPCODE_GET_KEYED_VALIDATED,
 		OPCODE_GET_INDEXED_VALIDATED,
+		OPCODE_SET_INDEXED_TYPED_ARRAY,
+		OPCODE_GET_INDEXED_TYPED_ARRAY,
 		OPCODE_SET_NAMED,
 		OPCODE_SET_NAMED_VALIDATED,
 		OPCODE_GET_NAMED,
@@ -372,10 +377,49 @@ public:
 		StringName identifier;
 	};
 
+	// Inline cache of a dynamic call site (`OPCODE_CALL*`). Remembers what the call resolved to for the
+	// last few receivers, keyed by their script and native class, so repeated calls skip the name lookups
+	// in the script inheritance chain and in `ClassDB`.
+	struct CallCache {
+		static constexpr uint32_t MAX_ENTRIES = 4;
+
+		struct Entry {
+			const GDScript *script = nullptr; // Null for objects without a script.
+			const void *native_class = nullptr; // Unique pointer of the native class name.
+			GDScriptFunction *function = nullptr;
+			MethodBind *method = nullptr;
+		};
+
+		// Odd while an entry is being written. Entries are read optimistically and discarded if this changes.
+		std::atomic<uint32_t> version = 0;
+		uint32_t generation = 0;
+		uint32_t entry_count = 0;
+		uint32_t next_eviction = 0;
+		Entry entries[MAX_ENTRIES];
+	};
+
+#ifdef DEBUG_ENABLED
+	// Counts of executed opcodes and of opcodes executed right after each other, gathered while
+	// `GDScriptLanguage::opcode_profiling_start()` is active. Used to pick superinstruction candidates.
+	// Counters are not atomic, so totals are approximate when scripts run on several threads at once.
+	struct OpcodeProfile {
+		uint64_t counts[OPCODE_END + 1] = {};
+		uint64_t pair_counts[OPCODE_END + 1][OPCODE_END + 1] = {};
+
+		_FORCE_INLINE_ void add(int p_previous, int p_opcode) {
+			counts[p_opcode]++;
+			if (p_previous >= 0) {
+				pair_counts[p_previous][p_opcode]++;
+			}
+		}
+	};
+#endif
+
 private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+	friend class GDScriptBytecodeBuffer;
 	friend class GDScriptLanguage;
 
 	StringName name;
@@ -451,6 +495,21 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	CallCache *_call_caches_ptr = nullptr;
+	int _call_caches_count = 0;
+
+#ifdef TOOLS_ENABLED
+	// Positions of the signature slots of `OPCODE_OPERATOR`, which the VM patches on first run.
+	// They are cleared when exporting compiled bytecode.
+	Vector<int> operator_signature_positions;
+#endif
+
+	// Bumped whenever any function is freed, which invalidates every call cache.
+	static SafeNumeric<uint32_t> call_cache_generation;
+
+	static bool _get_cached_call(CallCache &p_cache, Object *p_object, const StringName &p_method, CallCache::Entry &r_entry);
+	static void _call_cached(const CallCache::Entry &p_entry, Object *p_object, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -523,6 +582,7 @@ public:
 #ifdef DEBUG_ENABLED
 	void _profile_native_call(uint64_t p_t_taken, const String &p_function_name, const String &p_instance_class_name = String());
 	void disassemble(const Vector<String> &p_code_lines) const;
+	static const char *get_opcode_name(Opcode p_opcode);
 #endif
 
 	GDScriptFunction();
@@ -110,6 +110,93 @@ void GDScriptFunction::_profile_native_call(uint64_t p_t_taken, const String &p_
 
 #endif // DEBUG_ENABLED
 
+bool GDScriptFunction::_get_cached_call(CallCache &p_cache, Object *p_object, const StringName &p_method, CallCache::Entry &r_entry) {
+	const GDScript *script = nullptr;
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (script_instance) {
+		if (script_instance->get_language() != GDScriptLanguage::get_singleton() || script_instance->is_placeholder()) {
+			return false;
+		}
+		script = static_cast<GDScriptInstance *>(script_instance)->script.ptr();
+	}
+	const void *native_class = p_object->get_class_name().data_unique_pointer();
+	uint32_t generation = call_cache_generation.get();
+
+	uint32_t version = p_cache.version.load(std::memory_order_acquire);
+	if (!(version & 1) && p_cache.generation == generation) {
+		uint32_t entry_count = MIN(p_cache.entry_count, CallCache::MAX_ENTRIES);
+		for (uint32_t i = 0; i < entry_count; i++) {
+			if (p_cache.entries[i].script == script && p_cache.entries[i].native_class == native_class) {
+				r_entry = p_cache.entries[i];
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (p_cache.version.load(std::memory_order_relaxed) == version) {
+					return true;
+				}
+				break;
+			}
+		}
+	}
+
+	// Miss, resolve the call the same way `Object::callp()` does.
+	if (p_method == CoreStringNames::get_singleton()->_free || p_method == SNAME("_ready")) {
+		return false; // Both need the special handling of the regular path.
+	}
+
+	CallCache::Entry entry;
+	entry.script = script;
+	entry.native_class = native_class;
+	for (const GDScript *E = script; E; E = E->_base) {
+		HashMap<StringName, GDScriptFunction *>::ConstIterator function = E->member_functions.find(p_method);
+		if (function) {
+			entry.function = function->value;
+			break;
+		}
+	}
+	if (!entry.function) {
+		MethodBind *method = ClassDB::get_method(p_object->get_class_name(), p_method);
+		if (!method) {
+			return false;
+		}
+		// Extension methods may be freed when their library is unloaded or reloaded.
+		ClassDB::APIType api = ClassDB::get_api_type(method->get_instance_class());
+		if (api != ClassDB::API_CORE && api != ClassDB::API_EDITOR) {
+			return false;
+		}
+		entry.method = method;
+	}
+
+	// Only one thread fills the cache at a time, others just skip it.
+	version = p_cache.version.load(std::memory_order_relaxed);
+	if (!(version & 1) && p_cache.version.compare_exchange_strong(version, version + 1, std::memory_order_acquire)) {
+		if (p_cache.generation != generation) {
+			p_cache.generation = generation;
+			p_cache.entry_count = 0;
+		}
+		uint32_t slot;
+		if (p_cache.entry_count < CallCache::MAX_ENTRIES) {
+			slot = p_cache.entry_count++;
+		} else {
+			slot = p_cache.next_eviction++ % CallCache::MAX_ENTRIES;
+		}
+		p_cache.entries[slot] = entry;
+		p_cache.version.store(version + 2, std::memory_order_release);
+	}
+
+	r_entry = entry;
+	return true;
+}
+
+void GDScriptFunction::_call_cached(const CallCache::Entry &p_entry, Object *p_object, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+#ifdef DEBUG_ENABLED
+	_ObjectDebugLock lock(p_object);
+#endif
+	if (p_entry.function) {
+		r_ret = p_entry.function->call(static_cast<GDScriptInstance *>(p_object->get_script_instance()), p_args, p_argcount, r_err);
+	} else {
+		r_ret = p_entry.method->call(p_object, p_args, p_argcount, r_err);
+	}
+}
+
 Variant GDScriptFunction::_get_default_variant_for_data_type(const GDScriptDataType &p_data_type) {
 	if (p_data_type.kind == GDScriptDataType::BUILTIN) {
 		if (p_data_type.builtin_type == Variant::ARRAY) {
@@ -210,11 +297,22 @@ void (*type_init_function_table[])(Variant *) = {
 	&VariantInitializer<PackedColorArray>::init, // PACKED_COLOR_ARRAY.
 };
 
+#ifdef DEBUG_ENABLED
+// Only counts while opcode profiling is active, see `GDScriptFunction::OpcodeProfile`.
+#define PROFILE_OPCODE(m_opcode)                        \
+	if (unlikely(opcode_profile)) {                     \
+		opcode_profile->add(profiled_opcode, m_opcode); \
+		profiled_opcode = m_opcode;                     \
+	}
+#endif
+
 #if defined(__GNUC__)
 #define OPCODES_TABLE                                  \
 	static const void *switch_table_ops[] = {          \
 		&&OPCODE_OPERATOR,                             \
 		&&OPCODE_OPERATOR_VALIDATED,                   \
+		&&OPCODE_OPERATOR_VALIDATED_ASSIGN,            \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,       \
 		&&OPCODE_TYPE_TEST_BUILTIN,                    \
 		&&OPCODE_TYPE_TEST_ARRAY,                      \
 		&&OPCODE_TYPE_TEST_NATIVE,                     \
@@ -225,6 +323,8 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_GET_KEYED,                            \
 		&&OPCODE_GET_KEYED_VALIDATED,                  \
 		&&OPCODE_GET_INDEXED_VALIDATED,                \
+		&&OPCODE_SET_INDEXED_TYPED_ARRAY,              \
+		&&OPCODE_GET_INDEXED_TYPED_ARRAY,              \
 		&&OPCODE_SET_NAMED,                            \
 		&&OPCODE_SET_NAMED_VALIDATED,                  \
 		&&OPCODE_GET_NAMED,                            \
@@ -373,6 +473,7 @@ void (*type_init_function_table[])(Variant *) = {
 #ifdef DEBUG_ENABLED
 #define DISPATCH_OPCODE          \
 	last_opcode = _code_ptr[ip]; \
+	PROFILE_OPCODE(last_opcode); \
 	goto *switch_table_ops[last_opcode]
 #else
 #define DISPATCH_OPCODE goto *switch_table_ops[_code_ptr[ip]]
@@ -656,6 +757,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	bool exit_ok = false;
 	bool awaited = false;
 	int variant_address_limits[ADDR_TYPE_MAX] = { _stack_size, _constant_count, p_instance ? (int)p_instance->members.size() : 0 };
+
+	OpcodeProfile *opcode_profile = GDScriptLanguage::get_singleton()->opcode_profile;
+	int profiled_opcode = -1;
 #endif
 
 	Variant *variant_addresses[ADDR_TYPE_MAX] = { stack, _constants_ptr, p_instance ? p_instance->members.ptrw() : nullptr };
@@ -663,6 +767,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
+		PROFILE_OPCODE(last_opcode);
 #else
 	OPCODE_WHILE(true) {
 #endif
@@ -772,6 +877,51 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_ASSIGN) {
+				// Fused by the peephole pass: the operator writes straight into the target of the
+				// following assignment, which is left in place as padding and skipped.
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				ip += 8;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				// Fused by the peephole pass: evaluates the condition and tests it in one dispatch.
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				bool result = dst->get_type() == Variant::BOOL ? *VariantInternal::get_bool(dst) : dst->booleanize();
+
+				if (!result) {
+					int to = _code_ptr[ip + 7];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 8;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1073,6 +1223,85 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_SET_INDEXED_TYPED_ARRAY) {
+				CHECK_SPACE(4);
+
+				GET_VARIANT_PTR(dst, 0);
+				GET_VARIANT_PTR(index, 1);
+				GET_VARIANT_PTR(value, 2);
+
+				Array *array = VariantInternal::get_array(dst);
+				int64_t int_index = *VariantInternal::get_int(index);
+				int64_t size = array->size();
+				if (int_index < 0) {
+					int_index += size;
+				}
+
+				bool oob = int_index < 0 || int_index >= size;
+				bool valid = true;
+				if (likely(!oob && !array->is_read_only() && array->get_typed_builtin() == (uint32_t)value->get_type())) {
+					// The compiler proved the element type, so the container doesn't need to validate it again.
+					(*array)[int_index] = *value;
+				} else if (!oob) {
+					// Read-only, or not typed as the compiler expected; take the generic path.
+					dst->set(*index, *value, &valid);
+				}
+
+#ifdef DEBUG_ENABLED
+				if (oob || !valid) {
+					String v = index->operator String();
+					if (!v.is_empty()) {
+						v = "'" + v + "'";
+					} else {
+						v = "of type '" + _get_var_type(index) + "'";
+					}
+					if (oob) {
+						err_text = "Out of bounds set index " + v + " (on base: '" + _get_var_type(dst) + "')";
+					} else {
+						err_text = "Invalid assignment of property or key " + v + " with value of type '" + _get_var_type(value) + "' on a base object of type '" + _get_var_type(dst) + "'.";
+					}
+					OPCODE_BREAK;
+				}
+#endif
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_GET_INDEXED_TYPED_ARRAY) {
+				CHECK_SPACE(4);
+
+				GET_VARIANT_PTR(src, 0);
+				GET_VARIANT_PTR(index, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				const Array *array = VariantInternal::get_array(src);
+				int64_t int_index = *VariantInternal::get_int(index);
+				int64_t size = array->size();
+				if (int_index < 0) {
+					int_index += size;
+				}
+
+				bool oob = int_index < 0 || int_index >= size;
+				if (likely(!oob)) {
+					*dst = (*array)[int_index];
+				}
+
+#ifdef DEBUG_ENABLED
+				if (oob) {
+					String v = index->operator String();
+					if (!v.is_empty()) {
+						v = "'" + v + "'";
+					} else {
+						v = "of type '" + _get_var_type(index) + "'";
+					}
+					err_text = "Out of bounds get index " + v + " (on base: '" + _get_var_type(src) + "')";
+					OPCODE_BREAK;
+				}
+#endif
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_SET_NAMED) {
 				CHECK_SPACE(3);
 
@@ -1673,7 +1902,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1684,9 +1913,20 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int call_cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(call_cache_idx < 0 || call_cache_idx >= _call_caches_count);
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
+				CallCache::Entry cached;
+#ifdef DEBUG_ENABLED
+				Object *cached_obj = base->get_type() == Variant::OBJECT ? base->get_validated_object() : nullptr;
+#else
+				Object *cached_obj = base->get_type() == Variant::OBJECT ? base->operator Object *() : nullptr;
+#endif
+				bool is_cached = cached_obj && _get_cached_call(_call_caches_ptr[call_cache_idx], cached_obj, *methodname, cached);
+
 #ifdef DEBUG_ENABLED
 				uint64_t call_time = 0;
 
@@ -1701,7 +1941,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					if (is_cached) {
+						_call_cached(cached, cached_obj, (const Variant **)argptrs, argc, *ret, err);
+					} else {
+						base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					}
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
 						if (base_type == Variant::OBJECT) {
@@ -1731,7 +1975,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				} else {
 					Variant ret;
-					base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					if (is_cached) {
+						_call_cached(cached, cached_obj, (const Variant **)argptrs, argc, ret, err);
+					} else {
+						base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					}
 				}
 #ifdef DEBUG_ENABLED
 
@@ -1781,7 +2029,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
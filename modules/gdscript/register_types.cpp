@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_buffer.h"
 #include "gdscript_cache.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_tokenizer_buffer.h"
@@ -82,7 +83,13 @@ Ref<GDScriptEditorTranslationParserPlugin> gdscript_translation_parser_plugin;
 class EditorExportGDScript : public EditorExportPlugin {
 	GDCLASS(EditorExportGDScript, EditorExportPlugin);
 
+	bool debug_export = false;
+
 public:
+	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
+		debug_export = p_debug;
+	}
+
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
 		int script_mode = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 
@@ -103,12 +110,26 @@ public:
 
 		String source;
 		source.parse_utf8(reinterpret_cast<const char *>(file.ptr()), file.size());
-		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
+		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS ? GDScriptTokenizerBuffer::COMPRESS_NONE : GDScriptTokenizerBuffer::COMPRESS_ZSTD;
 		file = GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
 		if (file.is_empty()) {
 			return;
 		}
 
+		// The editor compiles with debug code (asserts, breakpoints), which release templates refuse to load,
+		// so release exports only get the tokens.
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_COMPILED_BYTECODE && debug_export) {
+			// The tokens stay embedded, for scripts that can't be saved or builds that can't load the bytecode.
+			Error err = OK;
+			Ref<GDScript> scr = GDScriptCache::get_full_script(p_path, err);
+			if (err == OK && scr.is_valid() && scr->is_valid()) {
+				Vector<uint8_t> compiled = GDScriptBytecodeBuffer::serialize(scr.ptr(), file);
+				if (!compiled.is_empty()) {
+					file = compiled;
+				}
+			}
+		}
+
 		add_file(p_path.get_basename() + ".gdc", file, true);
 
 		return;
@@ -217,9 +238,14 @@ void test_bytecode() {
 	GDScriptTests::test(GDScriptTests::TestType::TEST_BYTECODE);
 }
 
+void test_opcode_profile() {
+	GDScriptTests::test(GDScriptTests::TestType::TEST_OPCODE_PROFILE);
+}
+
 REGISTER_TEST_COMMAND("gdscript-tokenizer", &test_tokenizer);
 REGISTER_TEST_COMMAND("gdscript-tokenizer-buffer", &test_tokenizer_buffer);
 REGISTER_TEST_COMMAND("gdscript-parser", &test_parser);
 REGISTER_TEST_COMMAND("gdscript-compiler", &test_compiler);
 REGISTER_TEST_COMMAND("gdscript-bytecode", &test_bytecode);
+REGISTER_TEST_COMMAND("gdscript-opcode-profile", &test_opcode_profile);
 #endif
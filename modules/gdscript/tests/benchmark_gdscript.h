@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*  benchmark_gdscript.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_GDSCRIPT_H
+#define BENCHMARK_GDSCRIPT_H
+
+#include "gdscript_test_runner.h"
+
+#include "../gdscript.h"
+
+#include "tests/test_benchmark.h"
+
+namespace GDScriptTests {
+
+// Compiles `p_code` and calls its static `run()` function once per iteration.
+static void benchmark_script(BenchmarkState &p_state, const String &p_code) {
+	init_language("modules/gdscript/tests/scripts");
+
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(p_code);
+	Error err = script->reload();
+	if (err != OK) {
+		finish_language();
+		ERR_FAIL_MSG("Benchmark script failed to compile.");
+	}
+
+	const StringName run = "run";
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		Variant result = script->call(run);
+		BenchmarkState::do_not_optimize(result);
+	}
+	p_state.stop_timer();
+
+	script.unref();
+	finish_language();
+}
+
+static void gdscript_int_arithmetic(BenchmarkState &p_state) {
+	benchmark_script(p_state, R"(
+static func run() -> int:
+	var sum := 0
+	for i in 1000:
+		sum += i * 3 - (i >> 1)
+	return sum
+)");
+}
+
+static void gdscript_untyped_arithmetic(BenchmarkState &p_state) {
+	benchmark_script(p_state, R"(
+static func run():
+	var sum = 0
+	for i in 1000:
+		sum += i * 3 - (i >> 1)
+	return sum
+)");
+}
+
+static void gdscript_typed_array(BenchmarkState &p_state) {
+	benchmark_script(p_state, R"(
+static func run() -> float:
+	var values: Array[float] = []
+	values.resize(1000)
+	for i in 1000:
+		values[i] = i * 0.5
+	var sum := 0.0
+	for i in 1000:
+		sum += values[i]
+	return sum
+)");
+}
+
+static void gdscript_function_calls(BenchmarkState &p_state) {
+	benchmark_script(p_state, R"(
+static func add(a: int, b: int) -> int:
+	return a + b
+
+static func run() -> int:
+	var sum := 0
+	for i in 1000:
+		sum = add(sum, i)
+	return sum
+)");
+}
+
+static void gdscript_dynamic_calls(BenchmarkState &p_state) {
+	benchmark_script(p_state, R"(
+class Walker:
+	func step(n):
+		return n + 1
+
+class Runner:
+	func step(n):
+		return n + 2
+
+static func run() -> int:
+	var entities = [Walker.new(), Runner.new()]
+	var sum = 0
+	for i in 500:
+		for entity in entities:
+			sum = entity.step(sum)
+	return sum
+)");
+}
+
+static void gdscript_builtin_methods(BenchmarkState &p_state) {
+	benchmark_script(p_state, R"(
+static func run() -> float:
+	var sum := 0.0
+	var v := Vector3(1, 2, 3)
+	for i in 1000:
+		sum += v.dot(Vector3(i, i, i)) + v.length()
+	return sum
+)");
+}
+
+REGISTER_BENCHMARK("gdscript/int_arithmetic_1000", &gdscript_int_arithmetic);
+REGISTER_BENCHMARK("gdscript/untyped_arithmetic_1000", &gdscript_untyped_arithmetic);
+REGISTER_BENCHMARK("gdscript/typed_array_1000", &gdscript_typed_array);
+REGISTER_BENCHMARK("gdscript/function_calls_1000", &gdscript_function_calls);
+REGISTER_BENCHMARK("gdscript/dynamic_calls_1000", &gdscript_dynamic_calls);
+REGISTER_BENCHMARK("gdscript/builtin_methods_1000", &gdscript_builtin_methods);
+
+} // namespace GDScriptTests
+
+#endif // BENCHMARK_GDSCRIPT_H
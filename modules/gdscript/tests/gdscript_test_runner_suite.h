@@ -33,6 +33,10 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_bytecode_buffer.h"
+#include "../gdscript_cache.h"
+
+#include "core/io/marshalls.h"
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -69,6 +73,109 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+#ifdef TOOLS_ENABLED
+TEST_CASE("[Modules][GDScript] Save compiled bytecode and load it back") {
+	const String path = "res://bytecode_buffer_test.gd";
+
+	Ref<GDScript> source_script = memnew(GDScript);
+	source_script->set_source_code(R"(
+extends RefCounted
+
+const VALUES = [1, 2, 3]
+
+class Counter:
+	var total: int = 0
+
+	func add(value: int) -> void:
+		total += value
+
+func _init():
+	var counter := Counter.new()
+	for value in VALUES:
+		counter.add(value * 2)
+	var doubled := func(x): return x * 2
+	set_meta("result", [counter.total, doubled.call(21), "abc".to_upper(), absi(-5), Vector2(3, 4).length()])
+)");
+	source_script->set_path(path, true);
+	ERR_PRINT_OFF;
+	Error error = source_script->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	Array expected;
+	expected.push_back(12);
+	expected.push_back(42);
+	expected.push_back("ABC");
+	expected.push_back(5);
+	expected.push_back(5.0);
+
+	SUBCASE("Load without parsing") {
+		// Without tokens to fall back on, this only succeeds if the compiled data is used.
+		Vector<uint8_t> buffer = GDScriptBytecodeBuffer::serialize(source_script.ptr(), Vector<uint8_t>());
+		REQUIRE_MESSAGE(GDScriptBytecodeBuffer::is_compiled_buffer(buffer), "The script should be saved as compiled bytecode.");
+
+		GDScriptCache::remove_script(path);
+		Ref<GDScript> loaded_script = memnew(GDScript);
+		loaded_script->set_path(path, true);
+		loaded_script->set_compiled_bytecode_source(buffer);
+		CHECK_MESSAGE(loaded_script->reload() == OK, "The compiled bytecode should load successfully.");
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(loaded_script);
+		CHECK_MESSAGE(Array(ref_counted->get_meta("result")) == expected, "The loaded bytecode should run like the compiled script.");
+	}
+
+	SUBCASE("Failing to load leaves the script untouched") {
+		Vector<uint8_t> buffer = GDScriptBytecodeBuffer::serialize(source_script.ptr(), Vector<uint8_t>());
+		REQUIRE(GDScriptBytecodeBuffer::is_compiled_buffer(buffer));
+
+		GDScriptCache::remove_script(path);
+		Ref<GDScript> loaded_script = memnew(GDScript);
+		loaded_script->set_path(path, true);
+		loaded_script->set_compiled_bytecode_source(buffer);
+		REQUIRE(loaded_script->reload() == OK);
+
+		// Cut the end of the data, so reading fails after most of the classes and functions were read.
+		Vector<uint8_t> truncated = buffer;
+		truncated.resize(buffer.size() - 8);
+		encode_uint32(decode_uint32(&buffer.ptr()[32]) - 8, &truncated.write[32]);
+		REQUIRE(GDScriptBytecodeBuffer::is_compiled_buffer(truncated));
+		CHECK(GDScriptBytecodeBuffer::load_script(loaded_script.ptr(), truncated) != OK);
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(loaded_script);
+		CHECK_MESSAGE(Array(ref_counted->get_meta("result")) == expected, "The script should keep the data it had before.");
+	}
+
+	SUBCASE("Fall back to binary tokens") {
+		Vector<uint8_t> buffer = GDScriptBytecodeBuffer::serialize(source_script.ptr(), source_script->get_as_binary_tokens());
+		REQUIRE(GDScriptBytecodeBuffer::is_compiled_buffer(buffer));
+		// Pretend the bytecode was made by another engine build.
+		SUBCASE("Other engine version") {
+			buffer.write[8] ^= 0xFF;
+		}
+		SUBCASE("Debug code in a release build, or the other way around") {
+			buffer.write[36] ^= 1;
+		}
+
+		GDScriptCache::remove_script(path);
+		Ref<GDScript> loaded_script = memnew(GDScript);
+		loaded_script->set_path(path, true);
+		loaded_script->set_compiled_bytecode_source(buffer);
+		ERR_PRINT_OFF;
+		error = loaded_script->reload();
+		ERR_PRINT_ON;
+		CHECK_MESSAGE(error == OK, "The embedded binary tokens should be compiled instead.");
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(loaded_script);
+		CHECK_MESSAGE(Array(ref_counted->get_meta("result")) == expected, "The recompiled script should run.");
+	}
+
+	GDScriptCache::remove_script(path);
+}
+#endif // TOOLS_ENABLED
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
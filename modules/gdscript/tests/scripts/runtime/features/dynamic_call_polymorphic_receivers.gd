@@ -0,0 +1,45 @@
+# Dynamic calls whose receivers change type, more than fit in a call site's inline cache.
+
+class A:
+	func describe():
+		return "A"
+
+class B extends A:
+	func describe():
+		return "B"
+
+class C extends A:
+	pass
+
+class D:
+	func describe():
+		return "D"
+
+class E:
+	var name := "E"
+	func describe():
+		return name
+
+func describe_all(items: Array) -> String:
+	var result := ""
+	for item in items:
+		result += item.describe() + " "
+	return result.strip_edges()
+
+func test():
+	var items := [A.new(), B.new(), C.new(), D.new(), E.new()]
+	# Run twice so the second pass goes through cached entries and evictions.
+	print(describe_all(items))
+	print(describe_all(items))
+
+	# Native methods through an untyped receiver, with and without a script.
+	var objects: Array = [RefCounted.new(), A.new()]
+	for object in objects:
+		var untyped = object
+		print(untyped.get_class(), " ", untyped.is_class("RefCounted"))
+
+	# Methods that only exist on some receivers.
+	var duck = D.new()
+	print(duck.has_method("describe"))
+	duck = RefCounted.new()
+	print(duck.has_method("describe"))
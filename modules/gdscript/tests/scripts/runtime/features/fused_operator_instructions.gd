@@ -0,0 +1,62 @@
+# Exercises operator patterns that the bytecode generator fuses into single instructions.
+
+var member := 0
+
+func test():
+	# Operator result assigned to a typed local.
+	var a := 3
+	var b := 4
+	var c := a * b
+	print(c)
+
+	# Operands that alias the assignment target.
+	c = c + a
+	print(c)
+	c = a - c
+	print(c)
+
+	# Untyped target changing type through the operation.
+	var untyped = 1
+	untyped = untyped + 1.5
+	print(untyped)
+
+	# Untyped target holding a different type than the operator result.
+	var x = "s"
+	x = a + b
+	print(x)
+	print(typeof(x) == TYPE_INT)
+
+	# Unary operator right after a binary one with another result type.
+	var is_less := a < b
+	var negated := -a
+	print(is_less)
+	print(negated)
+
+	# Member target.
+	member = a + b
+	print(member)
+
+	# Comparisons used as conditions.
+	var count := 0
+	while count < 5:
+		count += 1
+	print(count)
+
+	if a < b:
+		print("less")
+	else:
+		print("not less")
+
+	if a == b and b > 0:
+		print("wrong")
+	else:
+		print("and short-circuit")
+
+	print("ternary " + ("yes" if a + 1 == b else "no"))
+
+	# Condition that is not a boolean.
+	var flags := 6
+	if flags & 1:
+		print("wrong")
+	if flags & 2:
+		print("bit set")
@@ -0,0 +1,26 @@
+func test():
+	var ints: Array[int] = [1, 2, 3]
+	for i in ints.size():
+		ints[i] = ints[i] * 10
+	print(ints)
+	ints[-1] = 7
+	print(ints[-1])
+	print(ints.get_typed_builtin())
+
+	var floats: Array[float] = []
+	floats.resize(3)
+	for i in 3:
+		floats[i] = i * 0.5
+	var sum := 0.0
+	for i in 3:
+		sum += floats[i]
+	print(sum)
+
+	var vectors: Array[Vector2] = [Vector2.ZERO]
+	vectors[0] = Vector2(1, 2)
+	vectors[0].x = 3
+	print(vectors)
+
+	var strings: Array[String] = ["a"]
+	strings[0] += "b"
+	print(strings[0])
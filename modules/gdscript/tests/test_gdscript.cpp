@@ -30,6 +30,7 @@
 
 #include "test_gdscript.h"
 
+#include "../gdscript.h"
 #include "../gdscript_analyzer.h"
 #include "../gdscript_compiler.h"
 #include "../gdscript_parser.h"
@@ -252,6 +253,82 @@ static void test_compiler(const String &p_code, const String &p_script_path, con
 	recursively_disassemble_functions(script, p_lines);
 }
 
+static void test_opcode_profile(const String &p_code, const String &p_script_path) {
+#ifdef DEBUG_ENABLED
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_path(p_script_path);
+	script->set_source_code(p_code);
+	Error err = script->reload();
+	if (err != OK) {
+		print_line("Error loading script.");
+		return;
+	}
+	if (!script->get_member_functions().has("test")) {
+		print_line("This test expects the script to have a test() function to run.");
+		return;
+	}
+
+	Object *obj = ClassDB::instantiate(script->get_native()->get_name());
+	Ref<RefCounted> obj_ref;
+	if (obj->is_ref_counted()) {
+		obj_ref = Ref<RefCounted>(Object::cast_to<RefCounted>(obj));
+	}
+	obj->set_script(script);
+
+	GDScriptLanguage::get_singleton()->opcode_profiling_start();
+	Callable::CallError call_err;
+	obj->get_script_instance()->callp("test", nullptr, 0, call_err);
+	GDScriptLanguage::get_singleton()->opcode_profiling_stop();
+
+	if (obj_ref.is_null()) {
+		memdelete(obj);
+	}
+
+	const GDScriptFunction::OpcodeProfile *profile = GDScriptLanguage::get_singleton()->get_opcode_profile();
+	const int opcode_count = GDScriptFunction::OPCODE_END + 1;
+
+	struct Entry {
+		uint64_t count = 0;
+		int first = 0;
+		int second = -1;
+		bool operator<(const Entry &p_other) const { return count > p_other.count; }
+	};
+
+	uint64_t total = 0;
+	LocalVector<Entry> singles;
+	LocalVector<Entry> pairs;
+	for (int i = 0; i < opcode_count; i++) {
+		total += profile->counts[i];
+		if (profile->counts[i]) {
+			singles.push_back({ profile->counts[i], i, -1 });
+		}
+		for (int j = 0; j < opcode_count; j++) {
+			if (profile->pair_counts[i][j]) {
+				pairs.push_back({ profile->pair_counts[i][j], i, j });
+			}
+		}
+	}
+	singles.sort();
+	pairs.sort();
+
+	const uint32_t max_entries = 20;
+	print_line(vformat("Executed %d opcodes.", total));
+	print_line("");
+	print_line("Most executed opcodes:");
+	for (uint32_t i = 0; i < MIN(max_entries, singles.size()); i++) {
+		print_line(vformat("%10d  %5.2f%%  %s", singles[i].count, 100.0 * singles[i].count / total, GDScriptFunction::get_opcode_name(GDScriptFunction::Opcode(singles[i].first))));
+	}
+	print_line("");
+	print_line("Most executed opcode pairs (superinstruction candidates):");
+	for (uint32_t i = 0; i < MIN(max_entries, pairs.size()); i++) {
+		print_line(vformat("%10d  %5.2f%%  %s -> %s", pairs[i].count, 100.0 * pairs[i].count / total, GDScriptFunction::get_opcode_name(GDScriptFunction::Opcode(pairs[i].first)), GDScriptFunction::get_opcode_name(GDScriptFunction::Opcode(pairs[i].second))));
+	}
+#else
+	print_line("Opcode profiling is only available in debug builds.");
+#endif
+}
+
 void test(TestType p_type) {
 	List<String> cmdlargs = OS::get_singleton()->get_cmdline_args();
 
@@ -318,6 +395,10 @@ void test(TestType p_type) {
 			break;
 		case TEST_BYTECODE:
 			print_line("Not implemented.");
+			break;
+		case TEST_OPCODE_PROFILE:
+			test_opcode_profile(code, test);
+			break;
 	}
 
 	finish_language();
@@ -43,6 +43,7 @@ enum TestType {
 	TEST_PARSER,
 	TEST_COMPILER,
 	TEST_BYTECODE,
+	TEST_OPCODE_PROFILE,
 };
 
 void test(TestType p_type);
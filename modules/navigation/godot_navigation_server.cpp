@@ -84,6 +84,8 @@ using namespace NavigationUtilities;
 GodotNavigationServer::GodotNavigationServer() {}
 
 GodotNavigationServer::~GodotNavigationServer() {
+	_finish_path_query_batches();
+	_finish_flow_field_updates();
 	flush_queries();
 }
 
@@ -236,6 +238,34 @@ real_t GodotNavigationServer::map_get_link_connection_radius(RID p_map) const {
 	return map->get_link_connection_radius();
 }
 
+COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled) {
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_use_hierarchical_pathfinding(p_enabled);
+}
+
+bool GodotNavigationServer::map_get_use_hierarchical_pathfinding(RID p_map) const {
+	const NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, false);
+
+	return map->get_use_hierarchical_pathfinding();
+}
+
+COMMAND_2(map_set_hierarchical_path_tolerance, RID, p_map, real_t, p_tolerance) {
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_hierarchical_path_tolerance(p_tolerance);
+}
+
+real_t GodotNavigationServer::map_get_hierarchical_path_tolerance(RID p_map) const {
+	const NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, 0);
+
+	return map->get_hierarchical_path_tolerance();
+}
+
 Vector<Vector3> GodotNavigationServer::map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers) const {
 	const NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL_V(map, Vector<Vector3>());
@@ -1098,6 +1128,77 @@ uint32_t GodotNavigationServer::obstacle_get_avoidance_layers(RID p_obstacle) co
 	return obstacle->get_avoidance_layers();
 }
 
+RID GodotNavigationServer::flow_field_create() {
+	MutexLock lock(operations_mutex);
+
+	RID rid = flow_field_owner.make_rid();
+	NavFlowField *flow_field = flow_field_owner.get_or_null(rid);
+	flow_field->set_self(rid);
+	flow_fields.push_back(flow_field);
+
+	return rid;
+}
+
+COMMAND_2(flow_field_set_map, RID, p_flow_field, RID, p_map) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL(flow_field);
+
+	NavMap *map = map_owner.get_or_null(p_map);
+
+	flow_field->set_map(map);
+}
+
+RID GodotNavigationServer::flow_field_get_map(RID p_flow_field) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, RID());
+	if (flow_field->get_map()) {
+		return flow_field->get_map()->get_self();
+	}
+	return RID();
+}
+
+COMMAND_2(flow_field_set_target_position, RID, p_flow_field, Vector3, p_position) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL(flow_field);
+
+	flow_field->set_target_position(p_position);
+}
+
+Vector3 GodotNavigationServer::flow_field_get_target_position(RID p_flow_field) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, Vector3());
+
+	return flow_field->get_target_position();
+}
+
+COMMAND_2(flow_field_set_navigation_layers, RID, p_flow_field, uint32_t, p_navigation_layers) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL(flow_field);
+
+	flow_field->set_navigation_layers(p_navigation_layers);
+}
+
+uint32_t GodotNavigationServer::flow_field_get_navigation_layers(RID p_flow_field) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, 0);
+
+	return flow_field->get_navigation_layers();
+}
+
+Vector3 GodotNavigationServer::flow_field_get_direction(RID p_flow_field, const Vector3 &p_position) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, Vector3());
+
+	return flow_field->get_direction(p_position);
+}
+
+real_t GodotNavigationServer::flow_field_get_distance(RID p_flow_field, const Vector3 &p_position) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_NULL_V(flow_field, 0);
+
+	return flow_field->get_distance(p_position);
+}
+
 void GodotNavigationServer::parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback) {
 #ifndef _3D_DISABLED
 	ERR_FAIL_COND_MSG(!Thread::is_main_thread(), "The SceneTree can only be parsed on the main thread. Call this function from the main thread or use call_deferred().");
@@ -1162,6 +1263,13 @@ COMMAND_1(free, RID, p_object) {
 			obstacle->set_map(nullptr);
 		}
 
+		// Remove any assigned flow fields
+		for (NavFlowField *flow_field : flow_fields) {
+			if (flow_field->get_map() == map) {
+				flow_field->set_map(nullptr);
+			}
+		}
+
 		int map_index = active_maps.find(map);
 		if (map_index >= 0) {
 			active_maps.remove_at(map_index);
@@ -1197,6 +1305,13 @@ COMMAND_1(free, RID, p_object) {
 	} else if (obstacle_owner.owns(p_object)) {
 		internal_free_obstacle(p_object);
 
+	} else if (flow_field_owner.owns(p_object)) {
+		NavFlowField *flow_field = flow_field_owner.get_or_null(p_object);
+
+		flow_field->finish_update();
+		flow_fields.erase(flow_field);
+		flow_field_owner.free(p_object);
+
 	} else {
 		ERR_PRINT("Attempted to free a NavigationServer RID that did not exist (or was already freed).");
 	}
@@ -1253,9 +1368,13 @@ void GodotNavigationServer::map_force_update(RID p_map) {
 	NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL(map);
 
-	flush_queries();
+	_finish_path_query_batches();
+	_finish_flow_field_updates();
 
+	_begin_maps_sync();
+	flush_queries();
 	map->sync();
+	_end_maps_sync();
 }
 
 void GodotNavigationServer::sync() {
@@ -1267,9 +1386,15 @@ void GodotNavigationServer::sync() {
 }
 
 void GodotNavigationServer::process(real_t p_delta_time) {
+	_finish_path_query_batches();
+	_finish_flow_field_updates();
+
+	// Batched path queries are solved against the maps of the previous sync, new batches wait for this one.
+	_begin_maps_sync();
 	flush_queries();
 
 	if (!active) {
+		_end_maps_sync();
 		return;
 	}
 
@@ -1285,8 +1410,12 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 	// In c++ we can't be sure that this is performed in the main thread
 	// even with mutable functions.
 	MutexLock lock(operations_mutex);
+	for (NavMap *active_map : active_maps) {
+		active_map->sync();
+	}
+	_end_maps_sync();
+
 	for (uint32_t i(0); i < active_maps.size(); i++) {
-		active_maps[i]->sync();
 		active_maps[i]->step(p_delta_time);
 		active_maps[i]->dispatch_callbacks();
 
@@ -1307,6 +1436,11 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 		}
 	}
 
+	// Update the flow fields of the changed maps until the next sync.
+	for (NavFlowField *flow_field : flow_fields) {
+		flow_field->update();
+	}
+
 	pm_region_count = _new_pm_region_count;
 	pm_agent_count = _new_pm_agent_count;
 	pm_link_count = _new_pm_link_count;
@@ -1324,6 +1458,8 @@ void GodotNavigationServer::init() {
 }
 
 void GodotNavigationServer::finish() {
+	_finish_path_query_batches();
+	_finish_flow_field_updates();
 	flush_queries();
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
@@ -1334,18 +1470,15 @@ void GodotNavigationServer::finish() {
 #endif // _3D_DISABLED
 }
 
-PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_parameters) const {
+static PathQueryResult _query_map_path(const NavMap *p_map, const PathQueryParameters &p_parameters) {
 	PathQueryResult r_query_result;
 
-	const NavMap *map = map_owner.get_or_null(p_parameters.map);
-	ERR_FAIL_NULL_V(map, r_query_result);
-
 	// run the pathfinding
 
 	if (p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR) {
 		// while postprocessing is still part of map.get_path() need to check and route it here for the correct "optimize" post-processing
 		if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					true,
@@ -1354,7 +1487,7 @@ PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
 		} else if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					false,
@@ -1374,6 +1507,203 @@ PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_
 	return r_query_result;
 }
 
+PathQueryResult GodotNavigationServer::_query_path(const PathQueryParameters &p_parameters) const {
+	const NavMap *map = map_owner.get_or_null(p_parameters.map);
+	ERR_FAIL_NULL_V(map, PathQueryResult());
+
+	return _query_map_path(map, p_parameters);
+}
+
+int64_t GodotNavigationServer::query_paths_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_V_MSG(p_query_parameters.size() != p_query_results.size(), -1, "The number of path query parameters and results must match.");
+
+	PathQueryBatch *batch = memnew(PathQueryBatch);
+	batch->callback = p_callback;
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		ERR_CONTINUE(query_parameters.is_null() || query_result.is_null());
+
+		batch->parameters.push_back(query_parameters->get_parameters());
+		batch->results.push_back(query_result);
+	}
+
+	MutexLock lock(path_query_batches_mutex);
+
+	int64_t batch_id = ++last_path_query_batch_id;
+	path_query_batches.insert(batch_id, batch);
+	if (maps_syncing) {
+		pending_path_query_batches.push_back(batch);
+	} else {
+		_start_path_query_batch(batch);
+	}
+	return batch_id;
+}
+
+bool GodotNavigationServer::is_path_query_batch_completed(int64_t p_batch_id) const {
+	MutexLock lock(path_query_batches_mutex);
+
+	// Batches are forgotten once finished.
+	HashMap<int64_t, PathQueryBatch *>::ConstIterator E = path_query_batches.find(p_batch_id);
+	if (!E) {
+		return true;
+	}
+	const PathQueryBatch *batch = E->value;
+	if (batch->solved) {
+		return true;
+	}
+	if (batch->group_id == -1 || batch->waiting) {
+		// Not started yet, or the group may be gone any moment.
+		return false;
+	}
+	return WorkerThreadPool::get_singleton()->is_group_task_completed(batch->group_id);
+}
+
+void GodotNavigationServer::wait_for_path_query_batch(int64_t p_batch_id) {
+	PathQueryBatch *batch = nullptr;
+	LocalVector<PathQueryBatch *> waited_batches;
+	{
+		MutexLock lock(path_query_batches_mutex);
+
+		HashMap<int64_t, PathQueryBatch *>::Iterator E = path_query_batches.find(p_batch_id);
+		if (!E) {
+			return;
+		}
+		batch = E->value;
+		path_query_batches.remove(E);
+
+		// Either the batch is started when the maps are synced, or another thread already waits for it.
+		while (batch->group_id == -1 || (batch->waiting && !batch->solved)) {
+			path_query_batches_condition.wait(lock);
+		}
+		if (!batch->waiting) {
+			batch->waiting = true;
+			path_query_batches_solving++;
+			waited_batches.push_back(batch);
+		}
+	}
+	_wait_for_path_query_batches(waited_batches);
+
+	if (batch->callback.is_valid()) {
+		batch->callback.call();
+	}
+	memdelete(batch);
+}
+
+void GodotNavigationServer::_start_path_query_batch(PathQueryBatch *p_batch) {
+	// Maps are looked up now, they can only be freed once the batch is solved.
+	p_batch->maps.resize(p_batch->parameters.size());
+	for (uint32_t i = 0; i < p_batch->parameters.size(); i++) {
+		p_batch->maps[i] = map_owner.get_or_null(p_batch->parameters[i].map);
+		ERR_CONTINUE_MSG(p_batch->maps[i] == nullptr, "Path query made on a map that doesn't exist.");
+	}
+
+	p_batch->group_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer::_solve_batched_path_query, p_batch, p_batch->parameters.size(), -1, true, SNAME("NavigationServerPathQueries"));
+}
+
+void GodotNavigationServer::_solve_batched_path_query(uint32_t p_index, PathQueryBatch *p_batch) {
+	const NavMap *map = p_batch->maps[p_index];
+	if (map == nullptr) {
+		return;
+	}
+	const PathQueryResult query_result = _query_map_path(map, p_batch->parameters[p_index]);
+
+	// Every result object belongs to a single query, so they can be set from any thread.
+	const Ref<NavigationPathQueryResult3D> &result = p_batch->results[p_index];
+	result->set_path(query_result.path);
+	result->set_path_types(query_result.path_types);
+	result->set_path_rids(query_result.path_rids);
+	result->set_path_owner_ids(query_result.path_owner_ids);
+}
+
+void GodotNavigationServer::_wait_for_path_query_batches(const LocalVector<PathQueryBatch *> &p_batches) {
+	if (p_batches.is_empty()) {
+		return;
+	}
+
+	for (PathQueryBatch *batch : p_batches) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(batch->group_id);
+	}
+
+	MutexLock lock(path_query_batches_mutex);
+	for (PathQueryBatch *batch : p_batches) {
+		batch->solved = true;
+	}
+	path_query_batches_solving -= p_batches.size();
+	path_query_batches_condition.notify_all();
+}
+
+void GodotNavigationServer::_finish_path_query_batches() {
+	LocalVector<PathQueryBatch *> finished_batches;
+	LocalVector<PathQueryBatch *> waited_batches;
+	{
+		MutexLock lock(path_query_batches_mutex);
+
+		for (const KeyValue<int64_t, PathQueryBatch *> &E : path_query_batches) {
+			PathQueryBatch *batch = E.value;
+			finished_batches.push_back(batch);
+			if (!batch->waiting) {
+				batch->waiting = true;
+				waited_batches.push_back(batch);
+			}
+		}
+		path_query_batches_solving += waited_batches.size();
+		path_query_batches.clear();
+	}
+	_wait_for_path_query_batches(waited_batches);
+
+	// Callbacks may start new batches.
+	for (PathQueryBatch *batch : finished_batches) {
+		if (batch->callback.is_valid()) {
+			batch->callback.call();
+		}
+		memdelete(batch);
+	}
+}
+
+void GodotNavigationServer::_begin_maps_sync() {
+	LocalVector<PathQueryBatch *> waited_batches;
+	{
+		MutexLock lock(path_query_batches_mutex);
+
+		maps_syncing = true;
+		for (const KeyValue<int64_t, PathQueryBatch *> &E : path_query_batches) {
+			PathQueryBatch *batch = E.value;
+			if (batch->group_id != -1 && !batch->waiting) {
+				batch->waiting = true;
+				waited_batches.push_back(batch);
+			}
+		}
+		path_query_batches_solving += waited_batches.size();
+	}
+	// These batches stay around, their callbacks are called after the next sync.
+	_wait_for_path_query_batches(waited_batches);
+
+	MutexLock lock(path_query_batches_mutex);
+	while (path_query_batches_solving > 0) {
+		path_query_batches_condition.wait(lock);
+	}
+}
+
+void GodotNavigationServer::_end_maps_sync() {
+	MutexLock lock(path_query_batches_mutex);
+
+	maps_syncing = false;
+	for (PathQueryBatch *batch : pending_path_query_batches) {
+		_start_path_query_batch(batch);
+	}
+	pending_path_query_batches.clear();
+	path_query_batches_condition.notify_all();
+}
+
+void GodotNavigationServer::_finish_flow_field_updates() {
+	MutexLock lock(operations_mutex);
+
+	for (NavFlowField *flow_field : flow_fields) {
+		flow_field->finish_update();
+	}
+}
+
 int GodotNavigationServer::get_process_info(ProcessInfo p_info) const {
 	switch (p_info) {
 		case INFO_ACTIVE_MAPS: {
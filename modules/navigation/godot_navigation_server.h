@@ -32,11 +32,14 @@
 #define GODOT_NAVIGATION_SERVER_H
 
 #include "nav_agent.h"
+#include "nav_flow_field.h"
 #include "nav_link.h"
 #include "nav_map.h"
 #include "nav_obstacle.h"
 #include "nav_region.h"
 
+#include "core/os/condition_variable.h"
+#include "core/os/mutex.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
@@ -77,15 +80,51 @@ class GodotNavigationServer : public NavigationServer3D {
 	mutable RID_Owner<NavRegion> region_owner;
 	mutable RID_Owner<NavAgent> agent_owner;
 	mutable RID_Owner<NavObstacle> obstacle_owner;
+	mutable RID_Owner<NavFlowField> flow_field_owner;
 
 	bool active = true;
 	LocalVector<NavMap *> active_maps;
 	LocalVector<uint32_t> active_maps_update_id;
+	/// Guarded by `operations_mutex`.
+	LocalVector<NavFlowField *> flow_fields;
 
 #ifndef _3D_DISABLED
 	NavMeshGenerator3D *navmesh_generator_3d = nullptr;
 #endif // _3D_DISABLED
 
+	struct PathQueryBatch {
+		LocalVector<const NavMap *> maps;
+		LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+		LocalVector<Ref<NavigationPathQueryResult3D>> results;
+		Callable callback;
+		/// `-1` until the batch is started, batches made while the maps sync wait for it to end.
+		WorkerThreadPool::GroupID group_id = -1;
+		/// Set once a thread took it upon itself to wait for the group, only that thread may do it.
+		bool waiting = false;
+		bool solved = false;
+	};
+
+	/// Guards the batches, but is never held while waiting for their tasks or calling their callbacks.
+	mutable BinaryMutex path_query_batches_mutex;
+	ConditionVariable path_query_batches_condition;
+	HashMap<int64_t, PathQueryBatch *> path_query_batches;
+	LocalVector<PathQueryBatch *> pending_path_query_batches;
+	int64_t last_path_query_batch_id = 0;
+	/// Batches whose tasks may still run, the maps can only be synced once there are none.
+	uint32_t path_query_batches_solving = 0;
+	bool maps_syncing = false;
+
+	void _start_path_query_batch(PathQueryBatch *p_batch);
+	void _solve_batched_path_query(uint32_t p_index, PathQueryBatch *p_batch);
+	void _wait_for_path_query_batches(const LocalVector<PathQueryBatch *> &p_batches);
+	void _finish_path_query_batches();
+	/// Keeps path query batches from running while the maps are synced and freed.
+	void _begin_maps_sync();
+	void _end_maps_sync();
+	/// Flow fields are computed in the background between the syncs, the maps must not change meanwhile.
+	/// Waits for the updates that aren't done yet.
+	void _finish_flow_field_updates();
+
 	// Performance Monitor
 	int pm_region_count = 0;
 	int pm_agent_count = 0;
@@ -129,6 +168,12 @@ public:
 	COMMAND_2(map_set_link_connection_radius, RID, p_map, real_t, p_connection_radius);
 	virtual real_t map_get_link_connection_radius(RID p_map) const override;
 
+	COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled);
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const override;
+
+	COMMAND_2(map_set_hierarchical_path_tolerance, RID, p_map, real_t, p_tolerance);
+	virtual real_t map_get_hierarchical_path_tolerance(RID p_map) const override;
+
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const override;
 
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const override;
@@ -258,6 +303,16 @@ public:
 	COMMAND_2(obstacle_set_avoidance_layers, RID, p_obstacle, uint32_t, p_layers);
 	virtual uint32_t obstacle_get_avoidance_layers(RID p_obstacle) const override;
 
+	virtual RID flow_field_create() override;
+	COMMAND_2(flow_field_set_map, RID, p_flow_field, RID, p_map);
+	virtual RID flow_field_get_map(RID p_flow_field) const override;
+	COMMAND_2(flow_field_set_target_position, RID, p_flow_field, Vector3, p_position);
+	virtual Vector3 flow_field_get_target_position(RID p_flow_field) const override;
+	COMMAND_2(flow_field_set_navigation_layers, RID, p_flow_field, uint32_t, p_navigation_layers);
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const override;
+	virtual Vector3 flow_field_get_direction(RID p_flow_field, const Vector3 &p_position) const override;
+	virtual real_t flow_field_get_distance(RID p_flow_field, const Vector3 &p_position) const override;
+
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
@@ -275,6 +330,10 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
 
+	virtual int64_t query_paths_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable()) override;
+	virtual bool is_path_query_batch_completed(int64_t p_batch_id) const override;
+	virtual void wait_for_path_query_batch(int64_t p_batch_id) override;
+
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
@@ -0,0 +1,480 @@
+/**************************************************************************/
+/*  nav_flow_field.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_flow_field.h"
+
+#include "nav_base.h"
+#include "nav_map.h"
+#include "nav_obstacle.h"
+
+#include "core/math/face3.h"
+#include "core/math/geometry_2d.h"
+#include "core/math/geometry_3d.h"
+
+namespace {
+struct FlowFieldNode {
+	/// Cost to reach the target from the anchor of the polygon.
+	real_t distance = FLT_MAX;
+	/// Index in the heap of polygons to visit, `UINT32_MAX` when not in it.
+	uint32_t heap_index = UINT32_MAX;
+	bool blocked = false;
+	Vector3 anchor;
+};
+
+struct FlowFieldNodeGreaterThan {
+	bool operator()(const FlowFieldNode *p_node_a, const FlowFieldNode *p_node_b) const {
+		return p_node_a->distance > p_node_b->distance;
+	}
+};
+
+struct FlowFieldNodeHeapIndexer {
+	void operator()(FlowFieldNode *p_node, uint32_t p_heap_index) const {
+		p_node->heap_index = p_heap_index;
+	}
+};
+
+struct FlowFieldConnection {
+	/// The polygon that has a connection to the one this connection is listed for.
+	uint32_t polygon = 0;
+	Vector3 pathway_start;
+	Vector3 pathway_end;
+};
+} //namespace
+
+bool NavFlowField::ObstacleOutline::operator==(const ObstacleOutline &p_other) const {
+	return bottom == p_other.bottom && top == p_other.top && vertices == p_other.vertices;
+}
+
+void NavFlowField::Field::clear() {
+	valid = false;
+	target_polygon = UINT32_MAX;
+	polygons.clear();
+	points.clear();
+	buckets.clear();
+	bucket_offsets.clear();
+	bucket_polygons.clear();
+}
+
+NavFlowField::NavFlowField() {}
+
+NavFlowField::~NavFlowField() {
+	finish_update();
+}
+
+void NavFlowField::set_map(NavMap *p_map) {
+	if (map == p_map) {
+		return;
+	}
+
+	finish_update();
+	map = p_map;
+	flow_field_dirty = true;
+
+	if (map == nullptr) {
+		RWLockWrite write_lock(field_rwlock);
+		fields[sampled_field].clear();
+	}
+}
+
+void NavFlowField::set_target_position(const Vector3 &p_position) {
+	if (target_position == p_position) {
+		return;
+	}
+	finish_update();
+	target_position = p_position;
+	flow_field_dirty = true;
+}
+
+void NavFlowField::set_navigation_layers(uint32_t p_navigation_layers) {
+	if (navigation_layers == p_navigation_layers) {
+		return;
+	}
+	finish_update();
+	navigation_layers = p_navigation_layers;
+	flow_field_dirty = true;
+}
+
+Vector2i NavFlowField::_get_bucket(real_t p_bucket_size, const Vector3 &p_position) {
+	return Vector2i(Math::floor(p_position.x / p_bucket_size), Math::floor(p_position.z / p_bucket_size));
+}
+
+bool NavFlowField::_is_blocked(const gd::Polygon &p_polygon) const {
+	if (p_polygon.points.is_empty() || (navigation_layers & p_polygon.owner->get_navigation_layers()) == 0) {
+		return true;
+	}
+	if (p_polygon.points.size() < 3) {
+		// Link polygon.
+		return false;
+	}
+
+	const Vector2 center(p_polygon.center.x, p_polygon.center.z);
+	for (const ObstacleOutline &outline : obstacle_outlines) {
+		if (outline.top > outline.bottom && (p_polygon.center.y < outline.bottom || p_polygon.center.y > outline.top)) {
+			continue;
+		}
+		if (Geometry2D::is_point_in_polygon(center, outline.vertices)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void NavFlowField::update() {
+	if (map == nullptr || map->get_map_update_id() == 0 || update_task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		return;
+	}
+
+	// Only the static obstacles change the field, the avoidance takes care of the moving ones.
+	LocalVector<ObstacleOutline> new_obstacle_outlines;
+	for (const NavObstacle *obstacle : map->get_obstacles()) {
+		const Vector<Vector3> &vertices = obstacle->get_vertices();
+		if (vertices.size() < 3 || obstacle->get_paused()) {
+			continue;
+		}
+
+		const Vector3 &position = obstacle->get_position();
+		ObstacleOutline outline;
+		outline.vertices.resize(vertices.size());
+		for (int i = 0; i < vertices.size(); i++) {
+			outline.vertices.write[i] = Vector2(vertices[i].x + position.x, vertices[i].z + position.z);
+		}
+		outline.bottom = position.y;
+		outline.top = position.y + obstacle->get_height();
+		new_obstacle_outlines.push_back(outline);
+	}
+
+	bool obstacles_changed = new_obstacle_outlines.size() != obstacle_outlines.size();
+	for (uint32_t i = 0; i < new_obstacle_outlines.size() && !obstacles_changed; i++) {
+		obstacles_changed = !(new_obstacle_outlines[i] == obstacle_outlines[i]);
+	}
+
+	if (!flow_field_dirty && !obstacles_changed && map_update_id == map->get_map_update_id()) {
+		return;
+	}
+
+	flow_field_dirty = false;
+	map_update_id = map->get_map_update_id();
+	obstacle_outlines = new_obstacle_outlines;
+
+	update_task_id = WorkerThreadPool::get_singleton()->add_template_task(this, &NavFlowField::_update_task, nullptr, false, "NavFlowFieldUpdate");
+}
+
+void NavFlowField::finish_update() {
+	if (update_task_id == WorkerThreadPool::INVALID_TASK_ID) {
+		return;
+	}
+
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(update_task_id);
+	update_task_id = WorkerThreadPool::INVALID_TASK_ID;
+
+	RWLockWrite write_lock(field_rwlock);
+	sampled_field = 1 - sampled_field;
+}
+
+void NavFlowField::_update_task(void *p_userdata) {
+	// The field that isn't sampled, the map isn't synced while this runs.
+	Field &r_field = fields[1 - sampled_field];
+	r_field.clear();
+
+	const LocalVector<gd::Polygon *> &polygons = map->get_polygons();
+	const LocalVector<gd::Polygon> &link_polygons = map->get_link_polygons();
+	const uint32_t region_polygon_count = polygons.size();
+	const uint32_t polygon_count = region_polygon_count + link_polygons.size();
+
+	LocalVector<FlowFieldNode> nodes;
+	nodes.resize(polygon_count);
+
+	// Copy the region polygons, so the field doesn't depend on the map once computed, and find the target polygon.
+	r_field.polygons.resize(region_polygon_count);
+	real_t target_d = FLT_MAX;
+	real_t polygon_extents = 0.0;
+	for (uint32_t polygon_id = 0; polygon_id < region_polygon_count; polygon_id++) {
+		const gd::Polygon &p = *polygons[polygon_id];
+		FlowFieldNode &node = nodes[polygon_id];
+		node.blocked = _is_blocked(p);
+		node.anchor = p.center;
+
+		FieldPolygon &field_polygon = r_field.polygons[polygon_id];
+		field_polygon.points_offset = r_field.points.size();
+		field_polygon.point_count = p.points.size();
+		field_polygon.travel_cost = p.owner->get_travel_cost();
+
+		Rect2 bounds(p.points[0].pos.x, p.points[0].pos.z, 0.0, 0.0);
+		for (const gd::Point &point : p.points) {
+			r_field.points.push_back(point.pos);
+			bounds.expand_to(Vector2(point.pos.x, point.pos.z));
+		}
+		polygon_extents += MAX(bounds.size.x, bounds.size.y);
+
+		if (node.blocked) {
+			continue;
+		}
+
+		for (uint32_t point_id = 2; point_id < p.points.size(); point_id++) {
+			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+			const Vector3 point = face.get_closest_point_to(target_position);
+			const real_t distance_to_point = point.distance_to(target_position);
+			if (distance_to_point < target_d) {
+				target_d = distance_to_point;
+				r_field.target_polygon = polygon_id;
+				r_field.target_point = point;
+			}
+		}
+	}
+
+	for (uint32_t link_index = 0; link_index < link_polygons.size(); link_index++) {
+		const gd::Polygon &p = link_polygons[link_index];
+		FlowFieldNode &node = nodes[region_polygon_count + link_index];
+		node.blocked = _is_blocked(p);
+		if (!node.blocked) {
+			node.anchor = (p.points[0].pos + p.points[p.points.size() - 1].pos) * 0.5;
+		}
+	}
+
+	// Bucket the polygons, with buckets a few polygons wide.
+	r_field.bucket_size = region_polygon_count > 0 ? MAX(polygon_extents / region_polygon_count * 4.0, (real_t)CMP_EPSILON) : 1.0;
+	LocalVector<uint32_t> bucket_counts;
+	for (int pass = 0; pass < 2; pass++) {
+		for (uint32_t polygon_id = 0; polygon_id < region_polygon_count; polygon_id++) {
+			const FieldPolygon &field_polygon = r_field.polygons[polygon_id];
+			Vector2i bucket_begin = _get_bucket(r_field.bucket_size, r_field.points[field_polygon.points_offset]);
+			Vector2i bucket_end = bucket_begin;
+			for (uint32_t point_id = 1; point_id < field_polygon.point_count; point_id++) {
+				const Vector2i bucket = _get_bucket(r_field.bucket_size, r_field.points[field_polygon.points_offset + point_id]);
+				bucket_begin = bucket_begin.min(bucket);
+				bucket_end = bucket_end.max(bucket);
+			}
+
+			for (int x = bucket_begin.x; x <= bucket_end.x; x++) {
+				for (int y = bucket_begin.y; y <= bucket_end.y; y++) {
+					if (pass == 0) {
+						HashMap<Vector2i, uint32_t>::Iterator E = r_field.buckets.find(Vector2i(x, y));
+						if (E) {
+							bucket_counts[E->value]++;
+						} else {
+							r_field.buckets.insert(Vector2i(x, y), bucket_counts.size());
+							bucket_counts.push_back(1);
+						}
+					} else {
+						const uint32_t bucket_index = r_field.buckets[Vector2i(x, y)];
+						r_field.bucket_polygons[r_field.bucket_offsets[bucket_index] + --bucket_counts[bucket_index]] = polygon_id;
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			r_field.bucket_offsets.resize(bucket_counts.size() + 1);
+			r_field.bucket_offsets[0] = 0;
+			for (uint32_t bucket_index = 0; bucket_index < bucket_counts.size(); bucket_index++) {
+				r_field.bucket_offsets[bucket_index + 1] = r_field.bucket_offsets[bucket_index] + bucket_counts[bucket_index];
+			}
+			r_field.bucket_polygons.resize(r_field.bucket_offsets[bucket_counts.size()]);
+		}
+	}
+
+	if (r_field.target_polygon == UINT32_MAX) {
+		// Nothing is reachable, the field is valid so every point samples as unreachable.
+		r_field.valid = true;
+		return;
+	}
+
+	// The search goes from the target to the polygons that lead to it, against the connections.
+	LocalVector<uint32_t> reverse_offsets;
+	reverse_offsets.resize(polygon_count + 1);
+	for (uint32_t &offset : reverse_offsets) {
+		offset = 0;
+	}
+	LocalVector<FlowFieldConnection> reverse_connections;
+	LocalVector<uint32_t> insert_positions;
+	for (int pass = 0; pass < 2; pass++) {
+		for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+			if (nodes[polygon_id].blocked) {
+				continue;
+			}
+			const gd::Polygon &p = polygon_id < region_polygon_count ? *polygons[polygon_id] : link_polygons[polygon_id - region_polygon_count];
+			for (const gd::Edge &edge : p.edges) {
+				for (const gd::Edge::Connection &connection : edge.connections) {
+					const uint32_t to_polygon_id = connection.polygon->id;
+					if (nodes[to_polygon_id].blocked) {
+						continue;
+					}
+					if (pass == 0) {
+						reverse_offsets[to_polygon_id + 1]++;
+					} else {
+						FlowFieldConnection &reverse_connection = reverse_connections[insert_positions[to_polygon_id]++];
+						reverse_connection.polygon = polygon_id;
+						reverse_connection.pathway_start = connection.pathway_start;
+						reverse_connection.pathway_end = connection.pathway_end;
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			for (uint32_t polygon_id = 1; polygon_id <= polygon_count; polygon_id++) {
+				reverse_offsets[polygon_id] += reverse_offsets[polygon_id - 1];
+			}
+			reverse_connections.resize(reverse_offsets[polygon_count]);
+			insert_positions = reverse_offsets;
+		}
+	}
+
+	// Dijkstra from the target, each polygon keeps the gateway of its cheapest way to the target.
+	gd::Heap<FlowFieldNode *, FlowFieldNodeGreaterThan, FlowFieldNodeHeapIndexer> traversable_nodes;
+	traversable_nodes.reserve(polygon_count);
+
+	FlowFieldNode &target_node = nodes[r_field.target_polygon];
+	target_node.distance = target_node.anchor.distance_to(r_field.target_point) * r_field.polygons[r_field.target_polygon].travel_cost;
+	r_field.polygons[r_field.target_polygon].pathway_distance = 0.0;
+	traversable_nodes.push(&target_node);
+
+	while (!traversable_nodes.is_empty()) {
+		const FlowFieldNode *node = traversable_nodes.pop();
+		const uint32_t polygon_id = node - nodes.ptr();
+		const gd::Polygon &p = polygon_id < region_polygon_count ? *polygons[polygon_id] : link_polygons[polygon_id - region_polygon_count];
+		const real_t travel_cost = p.owner->get_travel_cost();
+
+		for (uint32_t connection_index = reverse_offsets[polygon_id]; connection_index < reverse_offsets[polygon_id + 1]; connection_index++) {
+			const FlowFieldConnection &connection = reverse_connections[connection_index];
+			const gd::Polygon &from_p = connection.polygon < region_polygon_count ? *polygons[connection.polygon] : link_polygons[connection.polygon - region_polygon_count];
+
+			// The cost from the gateway, through this polygon, to the target.
+			const Vector3 pathway_center = (connection.pathway_start + connection.pathway_end) * 0.5;
+			real_t pathway_distance;
+			if (polygon_id == r_field.target_polygon) {
+				pathway_distance = pathway_center.distance_to(r_field.target_point) * travel_cost;
+			} else {
+				pathway_distance = pathway_center.distance_to(node->anchor) * travel_cost + node->distance;
+			}
+			if (from_p.owner->get_self() != p.owner->get_self()) {
+				pathway_distance += p.owner->get_enter_cost();
+			}
+
+			FlowFieldNode &from_node = nodes[connection.polygon];
+			const real_t distance = from_node.anchor.distance_to(pathway_center) * from_p.owner->get_travel_cost() + pathway_distance;
+			if (distance >= from_node.distance) {
+				continue;
+			}
+
+			const bool reached = from_node.distance != FLT_MAX;
+			from_node.distance = distance;
+			if (connection.polygon < region_polygon_count) {
+				FieldPolygon &field_polygon = r_field.polygons[connection.polygon];
+				field_polygon.pathway_distance = pathway_distance;
+				field_polygon.pathway_start = connection.pathway_start;
+				field_polygon.pathway_end = connection.pathway_end;
+			}
+
+			if (!reached) {
+				traversable_nodes.push(&from_node);
+			} else if (from_node.heap_index != UINT32_MAX) {
+				traversable_nodes.shift(from_node.heap_index);
+			}
+		}
+	}
+
+	r_field.valid = true;
+}
+
+uint32_t NavFlowField::_get_closest_polygon(const Field &p_field, const Vector3 &p_position, Vector3 &r_closest_point) {
+	const uint32_t *bucket_index = p_field.buckets.getptr(_get_bucket(p_field.bucket_size, p_position));
+	if (bucket_index == nullptr) {
+		return UINT32_MAX;
+	}
+
+	uint32_t closest_polygon = UINT32_MAX;
+	real_t closest_d = FLT_MAX;
+	for (uint32_t i = p_field.bucket_offsets[*bucket_index]; i < p_field.bucket_offsets[*bucket_index + 1]; i++) {
+		const uint32_t polygon_id = p_field.bucket_polygons[i];
+		const FieldPolygon &field_polygon = p_field.polygons[polygon_id];
+		const Vector3 *points = &p_field.points[field_polygon.points_offset];
+
+		for (uint32_t point_id = 2; point_id < field_polygon.point_count; point_id++) {
+			const Face3 face(points[0], points[point_id - 1], points[point_id]);
+			const Vector3 point = face.get_closest_point_to(p_position);
+			const real_t distance_to_point = point.distance_to(p_position);
+			if (distance_to_point < closest_d) {
+				closest_d = distance_to_point;
+				closest_polygon = polygon_id;
+				r_closest_point = point;
+			}
+		}
+	}
+	return closest_polygon;
+}
+
+Vector3 NavFlowField::get_direction(const Vector3 &p_position) const {
+	RWLockRead read_lock(field_rwlock);
+	const Field &sampled = fields[sampled_field];
+	if (!sampled.valid) {
+		return Vector3();
+	}
+
+	Vector3 closest_point;
+	const uint32_t polygon_id = _get_closest_polygon(sampled, p_position, closest_point);
+	if (polygon_id == UINT32_MAX) {
+		return Vector3();
+	}
+	if (polygon_id == sampled.target_polygon) {
+		return (sampled.target_point - closest_point).normalized();
+	}
+
+	const FieldPolygon &field_polygon = sampled.polygons[polygon_id];
+	if (field_polygon.pathway_distance == FLT_MAX) {
+		return Vector3();
+	}
+	Vector3 pathway[2] = { field_polygon.pathway_start, field_polygon.pathway_end };
+	return (Geometry3D::get_closest_point_to_segment(closest_point, pathway) - closest_point).normalized();
+}
+
+real_t NavFlowField::get_distance(const Vector3 &p_position) const {
+	RWLockRead read_lock(field_rwlock);
+	const Field &sampled = fields[sampled_field];
+	if (!sampled.valid) {
+		return INFINITY;
+	}
+
+	Vector3 closest_point;
+	const uint32_t polygon_id = _get_closest_polygon(sampled, p_position, closest_point);
+	if (polygon_id == UINT32_MAX) {
+		return INFINITY;
+	}
+
+	const FieldPolygon &field_polygon = sampled.polygons[polygon_id];
+	if (polygon_id == sampled.target_polygon) {
+		return closest_point.distance_to(sampled.target_point) * field_polygon.travel_cost;
+	}
+	if (field_polygon.pathway_distance == FLT_MAX) {
+		return INFINITY;
+	}
+	Vector3 pathway[2] = { field_polygon.pathway_start, field_polygon.pathway_end };
+	return closest_point.distance_to(Geometry3D::get_closest_point_to_segment(closest_point, pathway)) * field_polygon.travel_cost + field_polygon.pathway_distance;
+}
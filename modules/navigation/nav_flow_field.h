@@ -0,0 +1,136 @@
+/**************************************************************************/
+/*  nav_flow_field.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_FLOW_FIELD_H
+#define NAV_FLOW_FIELD_H
+
+#include "nav_rid.h"
+#include "nav_utils.h"
+
+#include "core/math/vector2i.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/rw_lock.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+class NavMap;
+
+/// A flow field is the answer to the path queries of every point of a map toward the same target.
+/// The cost to reach the target is integrated over the map polygons once, on a worker thread, and each
+/// polygon stores the gateway to the next one on the way, so sampling the direction at a point is a lookup.
+/// The field is computed again after the map changes, or after the static obstacles changed,
+/// the polygons whose center is inside a static obstacle can't be crossed.
+class NavFlowField : public NavRid {
+	NavMap *map = nullptr;
+	Vector3 target_position;
+	uint32_t navigation_layers = 1;
+
+	bool flow_field_dirty = true;
+	uint32_t map_update_id = 0;
+
+	struct ObstacleOutline {
+		Vector<Vector2> vertices;
+		real_t bottom = 0.0;
+		real_t top = 0.0;
+
+		bool operator==(const ObstacleOutline &p_other) const;
+	};
+	/// Outlines of the static obstacles of the map, as they were when the last update started.
+	LocalVector<ObstacleOutline> obstacle_outlines;
+
+	struct FieldPolygon {
+		/// Points of this polygon in `Field::points`.
+		uint32_t points_offset = 0;
+		uint32_t point_count = 0;
+
+		real_t travel_cost = 1.0;
+		/// Cost to reach the target from the gateway, `FLT_MAX` when the target can't be reached from this polygon.
+		real_t pathway_distance = FLT_MAX;
+		/// The gateway to the next polygon on the way to the target, unused in the target polygon.
+		Vector3 pathway_start;
+		Vector3 pathway_end;
+	};
+
+	struct Field {
+		bool valid = false;
+		uint32_t target_polygon = UINT32_MAX;
+		Vector3 target_point;
+
+		/// The map region polygons, in the order of the map.
+		LocalVector<FieldPolygon> polygons;
+		LocalVector<Vector3> points;
+
+		/// The polygons overlapping each cell of a grid on the XZ plane, to find the polygon under a point without testing all of them.
+		real_t bucket_size = 1.0;
+		HashMap<Vector2i, uint32_t> buckets;
+		/// The polygons of the bucket `i` are `bucket_polygons[bucket_offsets[i]]` to `bucket_polygons[bucket_offsets[i + 1]]`.
+		LocalVector<uint32_t> bucket_offsets;
+		LocalVector<uint32_t> bucket_polygons;
+
+		void clear();
+	};
+
+	/// The field at `sampled_field` is the one that is sampled, the other one is computed by the running update.
+	Field fields[2];
+	uint32_t sampled_field = 0;
+	mutable RWLock field_rwlock;
+
+	WorkerThreadPool::TaskID update_task_id = WorkerThreadPool::INVALID_TASK_ID;
+
+	static Vector2i _get_bucket(real_t p_bucket_size, const Vector3 &p_position);
+	bool _is_blocked(const gd::Polygon &p_polygon) const;
+	void _update_task(void *p_userdata);
+	static uint32_t _get_closest_polygon(const Field &p_field, const Vector3 &p_position, Vector3 &r_closest_point);
+
+public:
+	NavFlowField();
+	~NavFlowField();
+
+	void set_map(NavMap *p_map);
+	NavMap *get_map() const { return map; }
+
+	void set_target_position(const Vector3 &p_position);
+	const Vector3 &get_target_position() const { return target_position; }
+
+	void set_navigation_layers(uint32_t p_navigation_layers);
+	uint32_t get_navigation_layers() const { return navigation_layers; }
+
+	/// Starts computing the field again if its map or its settings changed since the last time.
+	/// The map must not be synced until the update is finished.
+	void update();
+	/// Makes the field of the running update the one that is sampled.
+	/// Blocks until the update is done, the map can only change after this returns.
+	void finish_update();
+
+	Vector3 get_direction(const Vector3 &p_position) const;
+	real_t get_distance(const Vector3 &p_position) const;
+};
+
+#endif // NAV_FLOW_FIELD_H
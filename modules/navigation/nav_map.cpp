@@ -113,6 +113,18 @@ void NavMap::set_link_connection_radius(real_t p_link_connection_radius) {
 	regenerate_links = true;
 }
 
+void NavMap::set_use_hierarchical_pathfinding(bool p_enabled) {
+	if (use_hierarchical_pathfinding == p_enabled) {
+		return;
+	}
+	use_hierarchical_pathfinding = p_enabled;
+	sectors_dirty = true;
+}
+
+void NavMap::set_hierarchical_path_tolerance(real_t p_tolerance) {
+	hierarchical_path_tolerance = MAX(p_tolerance, 0.0);
+}
+
 gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	const int x = static_cast<int>(Math::floor(p_pos.x / merge_rasterizer_cell_size));
 	const int y = static_cast<int>(Math::floor(p_pos.y / merge_rasterizer_cell_height));
@@ -151,7 +163,9 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
 	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
+	for (const gd::Polygon *polygon : polygons) {
+		const gd::Polygon &p = *polygon;
+
 		// Only consider the polygon if it in a region with compatible layers.
 		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
 			continue;
@@ -209,24 +223,50 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
-	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
+	// State of all reachable navigation polys, indexed by polygon id.
+	struct QueryStateLease {
+		const NavMap *map;
+		PathQueryState *state;
+		~QueryStateLease() { map->_release_path_query_state(state); }
+	} query_state_lease = { this, _acquire_path_query_state() };
+	PathQueryState &query_state = *query_state_lease.state;
+	query_state.begin_query(polygons.size() + link_polygons.size());
+	LocalVector<gd::NavigationPoly> &navigation_polys = query_state.navigation_polys;
+
+	// Polygons to visit, cheapest first.
+	gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer> &traversable_polys = query_state.traversable_polys;
+
+	// With hierarchical pathfinding, only the polygons of the sectors in the corridor are searched.
+	// The sectors don't know about navigation layers, so the queries that can't use every region search the whole map.
+	bool use_corridor = false;
+	real_t corridor_cost = 0.0;
+	// Lowest estimated cost of the routes leaving the corridor, a lower bound of the cost of routes the search skipped.
+	real_t corridor_exit_cost = FLT_MAX;
+	bool search_whole_map = false;
+	if (use_hierarchical_pathfinding && !sectors.is_empty() && polygon_sectors[begin_poly->id] != polygon_sectors[end_poly->id]) {
+		uint32_t navigation_layers = 0;
+		for (const NavRegion *region : regions) {
+			navigation_layers |= region->get_navigation_layers();
+		}
+		for (const NavLink *link : links) {
+			navigation_layers |= link->get_navigation_layers();
+		}
+		if ((p_navigation_layers & navigation_layers) == navigation_layers) {
+			use_corridor = _find_sector_corridor(query_state, polygon_sectors[begin_poly->id], polygon_sectors[end_poly->id], corridor_cost);
+		}
+	}
+	const LocalVector<gd::NavigationSector> &navigation_sectors = query_state.navigation_sectors;
 
-	// Add the start polygon to the reachable navigation polygons.
-	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
-	begin_navigation_poly.self_id = 0;
+	// Add the start polygon to the reachable navigation polygons, it is visited first.
+	gd::NavigationPoly &begin_navigation_poly = navigation_polys[begin_poly->id];
+	begin_navigation_poly = gd::NavigationPoly(begin_poly);
+	begin_navigation_poly.query_id = query_state.query_id;
 	begin_navigation_poly.entry = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
-	navigation_polys.push_back(begin_navigation_poly);
-
-	// List of polygon IDs to visit.
-	List<uint32_t> to_visit;
-	to_visit.push_back(0);
 
 	// This is an implementation of the A* algorithm.
-	int least_cost_id = 0;
+	int least_cost_id = begin_poly->id;
 	int prev_least_cost_id = -1;
 	bool found_route = false;
 
@@ -235,6 +275,22 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	bool is_reachable = true;
 
 	while (true) {
+		if (search_whole_map) {
+			// The corridor doesn't lead to the end, or its route costs more than the tolerance allows.
+			search_whole_map = false;
+			use_corridor = false;
+
+			gd::NavigationPoly np = navigation_polys[begin_poly->id];
+			query_state.begin_query(polygons.size() + link_polygons.size());
+			np.query_id = query_state.query_id;
+			navigation_polys[begin_poly->id] = np;
+			least_cost_id = begin_poly->id;
+			prev_least_cost_id = -1;
+
+			reachable_end = nullptr;
+			reachable_d = FLT_MAX;
+		}
+
 		// Takes the current least_cost_poly neighbors (iterating over its edges) and compute the traveled_distance.
 		for (const gd::Edge &edge : navigation_polys[least_cost_id].poly->edges) {
 			// Iterate over connections in this edge, then compute the new optimized travel distance assigned to this polygon.
@@ -259,42 +315,57 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly.entry, pathway);
 				const real_t new_distance = (least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost) + poly_enter_cost + least_cost_poly.traveled_distance;
 
-				int64_t already_visited_polygon_index = navigation_polys.find(gd::NavigationPoly(connection.polygon));
+				if (use_corridor) {
+					const gd::NavigationSector &sector = navigation_sectors[polygon_sectors[connection.polygon->id]];
+					if (sector.query_id != query_state.sector_query_id || sector.cost_from_begin + sector.cost_to_end > corridor_cost) {
+						corridor_exit_cost = MIN(corridor_exit_cost, new_distance + new_entry.distance_to(end_point) * connection.polygon->owner->get_travel_cost());
+						continue;
+					}
+				}
+
+				gd::NavigationPoly &neighbor_poly = navigation_polys[connection.polygon->id];
 
-				if (already_visited_polygon_index != -1) {
+				if (neighbor_poly.query_id == query_state.query_id) {
 					// Polygon already visited, check if we can reduce the travel cost.
-					gd::NavigationPoly &avp = navigation_polys[already_visited_polygon_index];
-					if (new_distance < avp.traveled_distance) {
-						avp.back_navigation_poly_id = least_cost_id;
-						avp.back_navigation_edge = connection.edge;
-						avp.back_navigation_edge_pathway_start = connection.pathway_start;
-						avp.back_navigation_edge_pathway_end = connection.pathway_end;
-						avp.traveled_distance = new_distance;
-						avp.entry = new_entry;
+					if (new_distance < neighbor_poly.traveled_distance) {
+						neighbor_poly.back_navigation_poly_id = least_cost_id;
+						neighbor_poly.back_navigation_edge = connection.edge;
+						neighbor_poly.back_navigation_edge_pathway_start = connection.pathway_start;
+						neighbor_poly.back_navigation_edge_pathway_end = connection.pathway_end;
+						neighbor_poly.traveled_distance = new_distance;
+						neighbor_poly.entry = new_entry;
+						neighbor_poly.distance_to_destination = new_entry.distance_to(end_point) * neighbor_poly.poly->owner->get_travel_cost();
+
+						if (neighbor_poly.traversable_poly_index != UINT32_MAX) {
+							traversable_polys.shift(neighbor_poly.traversable_poly_index);
+						}
 					}
 				} else {
 					// Add the neighbor polygon to the reachable ones.
-					gd::NavigationPoly new_navigation_poly = gd::NavigationPoly(connection.polygon);
-					new_navigation_poly.self_id = navigation_polys.size();
-					new_navigation_poly.back_navigation_poly_id = least_cost_id;
-					new_navigation_poly.back_navigation_edge = connection.edge;
-					new_navigation_poly.back_navigation_edge_pathway_start = connection.pathway_start;
-					new_navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
-					new_navigation_poly.traveled_distance = new_distance;
-					new_navigation_poly.entry = new_entry;
-					navigation_polys.push_back(new_navigation_poly);
+					neighbor_poly = gd::NavigationPoly(connection.polygon);
+					neighbor_poly.query_id = query_state.query_id;
+					neighbor_poly.back_navigation_poly_id = least_cost_id;
+					neighbor_poly.back_navigation_edge = connection.edge;
+					neighbor_poly.back_navigation_edge_pathway_start = connection.pathway_start;
+					neighbor_poly.back_navigation_edge_pathway_end = connection.pathway_end;
+					neighbor_poly.traveled_distance = new_distance;
+					neighbor_poly.entry = new_entry;
+					neighbor_poly.distance_to_destination = new_entry.distance_to(end_point) * neighbor_poly.poly->owner->get_travel_cost();
 
 					// Add the neighbor polygon to the polygons to visit.
-					to_visit.push_back(navigation_polys.size() - 1);
+					traversable_polys.push(&neighbor_poly);
+					query_state.reached_polygon_count++;
 				}
 			}
 		}
 
-		// Removes the least cost polygon from the list of polygons to visit so we can advance.
-		to_visit.erase(least_cost_id);
-
-		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
-		if (to_visit.size() == 0) {
+		// When there are no more polygons to visit at this point it means the End Polygon is not reachable
+		if (traversable_polys.is_empty() && use_corridor) {
+			// Not through the corridor at least, search the whole map.
+			search_whole_map = true;
+			continue;
+		}
+		if (traversable_polys.is_empty()) {
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -356,13 +427,12 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				return path;
 			}
 
-			// Reset open and navigation_polys
-			gd::NavigationPoly np = navigation_polys[0];
-			navigation_polys.clear();
-			navigation_polys.push_back(np);
-			to_visit.clear();
-			to_visit.push_back(0);
-			least_cost_id = 0;
+			// Reset the reachable polygons, keeping only the start one.
+			gd::NavigationPoly np = navigation_polys[begin_poly->id];
+			query_state.begin_query(polygons.size() + link_polygons.size());
+			np.query_id = query_state.query_id;
+			navigation_polys[begin_poly->id] = np;
+			least_cost_id = begin_poly->id;
 			prev_least_cost_id = -1;
 
 			reachable_end = nullptr;
@@ -370,20 +440,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			continue;
 		}
 
-		// Find the polygon with the minimum cost from the list of polygons to visit.
-		least_cost_id = -1;
-		real_t least_cost = FLT_MAX;
-		for (List<uint32_t>::Element *element = to_visit.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
-			real_t cost = np->traveled_distance;
-			cost += (np->entry.distance_to(end_point) * np->poly->owner->get_travel_cost());
-			if (cost < least_cost) {
-				least_cost_id = np->self_id;
-				least_cost = cost;
-			}
-		}
-
-		ERR_BREAK(least_cost_id == -1);
+		// Take the polygon with the minimum cost from the polygons to visit.
+		least_cost_id = traversable_polys.pop()->poly->id;
 
 		// Stores the further reachable end polygon, in case our goal is not reachable.
 		if (is_reachable) {
@@ -396,6 +454,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 		// Check if we reached the end
 		if (navigation_polys[least_cost_id].poly == end_poly) {
+			if (use_corridor && navigation_polys[least_cost_id].traveled_distance > corridor_exit_cost * (1.0 + hierarchical_path_tolerance) + CMP_EPSILON) {
+				// A route leaving the corridor could be more than the tolerance cheaper.
+				search_whole_map = true;
+				continue;
+			}
 			found_route = true;
 			break;
 		}
@@ -600,7 +663,9 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 	Vector3 closest_point;
 	real_t closest_point_d = FLT_MAX;
 
-	for (const gd::Polygon &p : polygons) {
+	for (const gd::Polygon *polygon : polygons) {
+		const gd::Polygon &p = *polygon;
+
 		// For each face check the distance to the segment
 		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
 			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
@@ -675,7 +740,9 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 	gd::ClosestPointQueryResult result;
 	real_t closest_point_ds = FLT_MAX;
 
-	for (const gd::Polygon &p : polygons) {
+	for (const gd::Polygon *polygon : polygons) {
+		const gd::Polygon &p = *polygon;
+
 		// For each face check the distance to the point
 		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
 			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
@@ -694,28 +761,30 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 }
 
 void NavMap::add_region(NavRegion *p_region) {
+	// The polygons of a region added to a map are dirty, it is connected during the next sync.
 	regions.push_back(p_region);
-	regenerate_links = true;
 }
 
 void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index >= 0) {
+		RWLockWrite write_lock(map_rwlock);
+		// The region polygons are freed or rebuilt before the next sync, nothing can keep pointing to them.
+		_disconnect_region(p_region);
 		regions.remove_at_unordered(region_index);
-		regenerate_links = true;
 	}
 }
 
 void NavMap::add_link(NavLink *p_link) {
 	links.push_back(p_link);
-	regenerate_links = true;
+	links_dirty = true;
 }
 
 void NavMap::remove_link(NavLink *p_link) {
 	int64_t link_index = links.find(p_link);
 	if (link_index >= 0) {
 		links.remove_at_unordered(link_index);
-		regenerate_links = true;
+		links_dirty = true;
 	}
 }
 
@@ -865,300 +934,612 @@ Vector3 NavMap::get_random_point(uint32_t p_navigation_layers, bool p_uniformly)
 	}
 }
 
-void NavMap::sync() {
-	RWLockWrite write_lock(map_rwlock);
+bool NavMap::_get_edge_connection_pathway(const gd::Edge::Connection &p_edge, const gd::Edge::Connection &p_other_edge, Vector3 &r_pathway_start, Vector3 &r_pathway_end) const {
+	Vector3 edge_p1 = p_edge.polygon->points[p_edge.edge].pos;
+	Vector3 edge_p2 = p_edge.polygon->points[(p_edge.edge + 1) % p_edge.polygon->points.size()].pos;
 
-	// Performance Monitor
-	int _new_pm_region_count = regions.size();
-	int _new_pm_agent_count = agents.size();
-	int _new_pm_link_count = links.size();
-	int _new_pm_polygon_count = pm_polygon_count;
-	int _new_pm_edge_count = pm_edge_count;
-	int _new_pm_edge_merge_count = pm_edge_merge_count;
-	int _new_pm_edge_connection_count = pm_edge_connection_count;
-	int _new_pm_edge_free_count = pm_edge_free_count;
+	Vector3 other_edge_p1 = p_other_edge.polygon->points[p_other_edge.edge].pos;
+	Vector3 other_edge_p2 = p_other_edge.polygon->points[(p_other_edge.edge + 1) % p_other_edge.polygon->points.size()].pos;
 
-	// Check if we need to update the links.
-	if (regenerate_polygons) {
-		for (NavRegion *region : regions) {
-			region->scratch_polygons();
+	// Compute the projection of the opposite edge on the current one
+	Vector3 edge_vector = edge_p2 - edge_p1;
+	real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+	real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+	if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+		return false;
+	}
+
+	// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+	Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other1;
+	if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+		other1 = other_edge_p1;
+	} else {
+		other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other1.distance_to(self1) > edge_connection_margin) {
+		return false;
+	}
+
+	Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other2;
+	if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+		other2 = other_edge_p2;
+	} else {
+		other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other2.distance_to(self2) > edge_connection_margin) {
+		return false;
+	}
+
+	r_pathway_start = (self1 + other1) / 2.0;
+	r_pathway_end = (self2 + other2) / 2.0;
+	return true;
+}
+
+void NavMap::_remove_free_edge(const gd::Edge::Connection &p_edge) {
+	NavRegion *owner = (NavRegion *)p_edge.polygon->owner;
+	RegionConnectivity *connectivity = connected_regions.getptr(owner);
+	if (!connectivity) {
+		return;
+	}
+
+	int64_t free_edge_index = -1;
+	for (uint32_t i = 0; i < connectivity->free_edges.size(); i++) {
+		if (connectivity->free_edges[i].polygon == p_edge.polygon && connectivity->free_edges[i].edge == p_edge.edge) {
+			free_edge_index = i;
+			break;
 		}
-		regenerate_links = true;
 	}
+	if (free_edge_index < 0) {
+		// Not a free edge, it has no connections to near edges.
+		return;
+	}
+	connectivity->free_edges.remove_at_unordered(free_edge_index);
 
-	for (NavRegion *region : regions) {
-		if (region->sync()) {
-			regenerate_links = true;
+	// Remove the connections to near edges in both directions, the link connections are kept.
+	Vector<gd::Edge::Connection> &edge_connections_list = p_edge.polygon->edges[p_edge.edge].connections;
+	for (int i = edge_connections_list.size() - 1; i >= 0; i--) {
+		if (edge_connections_list[i].edge != -1) {
+			edge_connections_list.remove_at(i);
 		}
 	}
+	regions_with_changed_connections.insert(owner);
 
-	for (NavLink *link : links) {
-		if (link->check_dirty()) {
-			regenerate_links = true;
+	const AABB search_bounds = connectivity->bounds.grow(edge_connection_margin);
+	for (KeyValue<NavRegion *, RegionConnectivity> &E : connected_regions) {
+		if (E.key == owner || !E.value.bounds.intersects(search_bounds)) {
+			continue;
+		}
+		for (const gd::Edge::Connection &other_edge : E.value.free_edges) {
+			Vector<gd::Edge::Connection> &other_connections = other_edge.polygon->edges[other_edge.edge].connections;
+			for (int i = other_connections.size() - 1; i >= 0; i--) {
+				if (other_connections[i].polygon == p_edge.polygon && other_connections[i].edge == p_edge.edge) {
+					other_connections.remove_at(i);
+					regions_with_changed_connections.insert(E.key);
+				}
+			}
 		}
 	}
+}
 
-	if (regenerate_links) {
-		_new_pm_polygon_count = 0;
-		_new_pm_edge_count = 0;
-		_new_pm_edge_merge_count = 0;
-		_new_pm_edge_connection_count = 0;
-		_new_pm_edge_free_count = 0;
+void NavMap::_connect_region(NavRegion *p_region) {
+	RegionConnectivity &connectivity = connected_regions.insert(p_region, RegionConnectivity())->value;
+	bool has_bounds = false;
+	sector_dirty_owners.insert(p_region);
 
-		// Remove regions connections.
-		for (NavRegion *region : regions) {
-			region->get_connections().clear();
-		}
+	// Group all edges per key.
+	for (gd::Polygon &poly : p_region->get_polygons()) {
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			if (has_bounds) {
+				connectivity.bounds.expand_to(poly.points[p].pos);
+			} else {
+				connectivity.bounds.position = poly.points[p].pos;
+				has_bounds = true;
+			}
 
-		// Resize the polygon count.
-		int count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
+			int next_point = (p + 1) % poly.points.size();
+			gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			LocalVector<gd::Edge::Connection> *connections = edge_connections.getptr(ek);
+			if (!connections) {
+				connections = &edge_connections.insert(ek, LocalVector<gd::Edge::Connection>())->value;
+			}
+			if (connections->size() > 1) {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
 				continue;
 			}
-			count += region->get_polygons().size();
+
+			// Add the polygon/edge tuple to this key.
+			gd::Edge::Connection new_connection;
+			new_connection.polygon = &poly;
+			new_connection.edge = p;
+			new_connection.pathway_start = poly.points[p].pos;
+			new_connection.pathway_end = poly.points[next_point].pos;
+
+			if (connections->size() == 1) {
+				// Connect edge that are shared in different polygons.
+				gd::Edge::Connection &other_connection = (*connections)[0];
+				_remove_free_edge(other_connection);
+				other_connection.polygon->edges[other_connection.edge].connections.push_back(new_connection);
+				sector_dirty_polygons.insert(other_connection.polygon);
+				poly.edges[p].connections.push_back(other_connection);
+				// Note: The pathway_start/end are full for those connection and do not need to be modified.
+				edge_merge_count += 1;
+			} else {
+				free_edge_candidates.insert(ek);
+			}
+			connections->push_back(new_connection);
 		}
-		polygons.resize(count);
+	}
 
-		// Copy all region polygons in the map.
-		count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
+	map_polygons_dirty = true;
+}
+
+void NavMap::_disconnect_region(NavRegion *p_region) {
+	RegionConnectivity *connectivity = connected_regions.getptr(p_region);
+	if (!connectivity) {
+		return;
+	}
+	sector_dirty_owners.insert(p_region);
+
+	for (uint32_t link_index = 0; link_index < link_connections.size(); link_index++) {
+		const LinkConnection &link_connection = link_connections[link_index];
+		if ((link_connection.start_polygon && link_connection.start_polygon->owner == p_region) || (link_connection.end_polygon && link_connection.end_polygon->owner == p_region)) {
+			_disconnect_link(link_index);
+		}
+	}
+
+	// Remove the connections that near edges of other regions have to this region.
+	if (!connectivity->free_edges.is_empty()) {
+		const AABB search_bounds = connectivity->bounds.grow(edge_connection_margin);
+		for (KeyValue<NavRegion *, RegionConnectivity> &E : connected_regions) {
+			if (E.key == p_region || !E.value.bounds.intersects(search_bounds)) {
 				continue;
 			}
-			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[count + n] = polygons_source[n];
+			for (const gd::Edge::Connection &other_edge : E.value.free_edges) {
+				Vector<gd::Edge::Connection> &other_connections = other_edge.polygon->edges[other_edge.edge].connections;
+				for (int i = other_connections.size() - 1; i >= 0; i--) {
+					if (other_connections[i].polygon->owner == p_region) {
+						other_connections.remove_at(i);
+						regions_with_changed_connections.insert(E.key);
+						sector_dirty_polygons.insert(other_edge.polygon);
+					}
+				}
 			}
-			count += region->get_polygons().size();
 		}
+	}
 
-		_new_pm_polygon_count = polygons.size();
+	// Unmerge the edges, the edges of other regions left alone at their key become free.
+	for (gd::Polygon &poly : p_region->get_polygons()) {
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			gd::EdgeKey ek(poly.points[p].key, poly.points[(p + 1) % poly.points.size()].key);
 
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
-
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
-					_new_pm_edge_count += 1;
-				}
-				if (connections[ek].size() <= 1) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+			LocalVector<gd::Edge::Connection> *connections = edge_connections.getptr(ek);
+			if (!connections) {
+				continue;
+			}
+			const uint32_t connection_count = connections->size();
+			for (uint32_t i = 0; i < connections->size(); i++) {
+				if ((*connections)[i].polygon == &poly && (*connections)[i].edge == int(p)) {
+					connections->remove_at(i);
+					break;
 				}
 			}
-		}
+			if (connections->size() == connection_count) {
+				continue;
+			}
 
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
+			if (connections->is_empty()) {
+				edge_connections.erase(ek);
 			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				if (use_edge_connections && E.value[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(E.value[0]);
+				edge_merge_count -= 1;
+				const gd::Edge::Connection &other_connection = (*connections)[0];
+				if (other_connection.polygon->owner != p_region) {
+					Vector<gd::Edge::Connection> &other_connections = other_connection.polygon->edges[other_connection.edge].connections;
+					for (int i = other_connections.size() - 1; i >= 0; i--) {
+						if (other_connections[i].polygon == &poly) {
+							other_connections.remove_at(i);
+						}
+					}
+					free_edge_candidates.insert(ek);
+					sector_dirty_polygons.insert(other_connection.polygon);
 				}
 			}
 		}
 
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
+		for (gd::Edge &edge : poly.edges) {
+			edge.connections.clear();
+		}
+	}
 
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+	p_region->get_connections().clear();
+	connected_regions.erase(p_region);
+	regions_with_changed_connections.erase(p_region);
+	map_polygons_dirty = true;
+}
 
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
-				}
+void NavMap::_disconnect_all() {
+	for (NavRegion *region : regions) {
+		for (gd::Polygon &poly : region->get_polygons()) {
+			for (gd::Edge &edge : poly.edges) {
+				edge.connections.clear();
+			}
+		}
+		region->get_connections().clear();
+	}
 
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+	for (uint32_t link_index = 0; link_index < link_connections.size(); link_index++) {
+		link_connections[link_index].start_polygon = nullptr;
+		link_connections[link_index].end_polygon = nullptr;
+		_disconnect_link(link_index);
+	}
 
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-					continue;
-				}
+	edge_connections.clear();
+	edge_merge_count = 0;
+	connected_regions.clear();
+	free_edge_candidates.clear();
+	regions_with_changed_connections.clear();
+	map_polygons_dirty = true;
+}
 
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_to(self1) > edge_connection_margin) {
-					continue;
-				}
+void NavMap::_connect_free_edges() {
+	if (free_edge_candidates.is_empty()) {
+		return;
+	}
 
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	// The candidates still alone at their key are free edges, all of them are listed before
+	// connecting them so the connections between two new free edges are found once per direction.
+	LocalVector<gd::Edge::Connection> new_free_edges;
+	for (const gd::EdgeKey &ek : free_edge_candidates) {
+		const LocalVector<gd::Edge::Connection> *connections = edge_connections.getptr(ek);
+		if (!connections || connections->size() != 1) {
+			continue;
+		}
+		const gd::Edge::Connection &free_edge = (*connections)[0];
+		NavRegion *owner = (NavRegion *)free_edge.polygon->owner;
+		if (!use_edge_connections || !owner->get_use_edge_connections()) {
+			continue;
+		}
+		RegionConnectivity *connectivity = connected_regions.getptr(owner);
+		ERR_CONTINUE(!connectivity);
+		connectivity->free_edges.push_back(free_edge);
+		new_free_edges.push_back(free_edge);
+	}
+
+	// Find the compatible near edges.
+	//
+	// Note:
+	// Considering that the edges must be compatible (for obvious reasons)
+	// to be connected, create new polygons to remove that small gap is
+	// not really useful and would result in wasteful computation during
+	// connection, integration and path finding.
+	for (const gd::Edge::Connection &free_edge : new_free_edges) {
+		NavRegion *owner = (NavRegion *)free_edge.polygon->owner;
+
+		AABB search_bounds(free_edge.pathway_start, Vector3());
+		search_bounds.expand_to(free_edge.pathway_end);
+		search_bounds = search_bounds.grow(edge_connection_margin);
+
+		for (KeyValue<NavRegion *, RegionConnectivity> &E : connected_regions) {
+			if (E.key == owner || !E.value.bounds.intersects(search_bounds)) {
+				continue;
+			}
+
+			for (const gd::Edge::Connection &other_edge : E.value.free_edges) {
+				Vector3 pathway_start;
+				Vector3 pathway_end;
+
+				if (_get_edge_connection_pathway(free_edge, other_edge, pathway_start, pathway_end)) {
+					gd::Edge::Connection new_connection = other_edge;
+					new_connection.pathway_start = pathway_start;
+					new_connection.pathway_end = pathway_end;
+					free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+					regions_with_changed_connections.insert(owner);
+					sector_dirty_polygons.insert(free_edge.polygon);
 				}
-				if (other2.distance_to(self2) > edge_connection_margin) {
-					continue;
+
+				// Connections from the other new free edges are made when it is their turn.
+				const gd::EdgeKey other_ek(other_edge.polygon->points[other_edge.edge].key, other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].key);
+				if (!free_edge_candidates.has(other_ek) && _get_edge_connection_pathway(other_edge, free_edge, pathway_start, pathway_end)) {
+					gd::Edge::Connection new_connection = free_edge;
+					new_connection.pathway_start = pathway_start;
+					new_connection.pathway_end = pathway_end;
+					other_edge.polygon->edges[other_edge.edge].connections.push_back(new_connection);
+					regions_with_changed_connections.insert(E.key);
+					sector_dirty_polygons.insert(other_edge.polygon);
 				}
+			}
+		}
+	}
+
+	free_edge_candidates.clear();
+}
 
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+void NavMap::_connect_link(uint32_t p_index) {
+	const NavLink *link = links[p_index];
+	LinkConnection &link_connection = link_connections[p_index];
+	link_connection.dirty = false;
 
-				// Add the connection to the region_connection map.
-				((NavRegion *)free_edge.polygon->owner)->get_connections().push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
+	if (!link->get_enabled()) {
+		return;
+	}
+	const Vector3 start = link->get_start_position();
+	const Vector3 end = link->get_end_position();
+
+	gd::Polygon *closest_start_polygon = nullptr;
+	real_t closest_start_distance = link_connection_radius;
+	Vector3 closest_start_point;
+
+	gd::Polygon *closest_end_polygon = nullptr;
+	real_t closest_end_distance = link_connection_radius;
+	Vector3 closest_end_point;
+
+	// Create link to any polygons within the search radius of the start point.
+	for (gd::Polygon *start_poly : polygons) {
+		// For each face check the distance to the start
+		for (uint32_t start_point_id = 2; start_point_id < start_poly->points.size(); start_point_id += 1) {
+			const Face3 start_face(start_poly->points[0].pos, start_poly->points[start_point_id - 1].pos, start_poly->points[start_point_id].pos);
+			const Vector3 start_point = start_face.get_closest_point_to(start);
+			const real_t start_distance = start_point.distance_to(start);
+
+			// Pick the polygon that is within our radius and is closer than anything we've seen yet.
+			if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
+				closest_start_distance = start_distance;
+				closest_start_point = start_point;
+				closest_start_polygon = start_poly;
+			}
+		}
+	}
+
+	// Find any polygons within the search radius of the end point.
+	for (gd::Polygon *end_poly : polygons) {
+		// For each face check the distance to the end
+		for (uint32_t end_point_id = 2; end_point_id < end_poly->points.size(); end_point_id += 1) {
+			const Face3 end_face(end_poly->points[0].pos, end_poly->points[end_point_id - 1].pos, end_poly->points[end_point_id].pos);
+			const Vector3 end_point = end_face.get_closest_point_to(end);
+			const real_t end_distance = end_point.distance_to(end);
+
+			// Pick the polygon that is within our radius and is closer than anything we've seen yet.
+			if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
+				closest_end_distance = end_distance;
+				closest_end_point = end_point;
+				closest_end_polygon = end_poly;
+			}
+		}
+	}
+
+	// If we have both a start and end point, then create a synthetic polygon to route through.
+	if (closest_start_polygon && closest_end_polygon) {
+		gd::Polygon &new_polygon = link_polygons[p_index];
+		new_polygon.owner = link;
+
+		new_polygon.edges.clear();
+		new_polygon.edges.resize(4);
+		new_polygon.points.clear();
+		new_polygon.points.reserve(4);
+
+		// Build a set of vertices that create a thin polygon going from the start to the end point.
+		new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+		new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+		new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+		new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+
+		Vector3 center;
+		for (int p = 0; p < 4; ++p) {
+			center += new_polygon.points[p].pos;
+		}
+		new_polygon.center = center / real_t(new_polygon.points.size());
+		new_polygon.clockwise = true;
+
+		// Setup connections to go forward in the link.
+		{
+			gd::Edge::Connection entry_connection;
+			entry_connection.polygon = &new_polygon;
+			entry_connection.edge = -1;
+			entry_connection.pathway_start = new_polygon.points[0].pos;
+			entry_connection.pathway_end = new_polygon.points[1].pos;
+			closest_start_polygon->edges[0].connections.push_back(entry_connection);
+
+			gd::Edge::Connection exit_connection;
+			exit_connection.polygon = closest_end_polygon;
+			exit_connection.edge = -1;
+			exit_connection.pathway_start = new_polygon.points[2].pos;
+			exit_connection.pathway_end = new_polygon.points[3].pos;
+			new_polygon.edges[2].connections.push_back(exit_connection);
+		}
+
+		// If the link is bi-directional, create connections from the end to the start.
+		if (link->is_bidirectional()) {
+			gd::Edge::Connection entry_connection;
+			entry_connection.polygon = &new_polygon;
+			entry_connection.edge = -1;
+			entry_connection.pathway_start = new_polygon.points[2].pos;
+			entry_connection.pathway_end = new_polygon.points[3].pos;
+			closest_end_polygon->edges[0].connections.push_back(entry_connection);
+
+			gd::Edge::Connection exit_connection;
+			exit_connection.polygon = closest_start_polygon;
+			exit_connection.edge = -1;
+			exit_connection.pathway_start = new_polygon.points[0].pos;
+			exit_connection.pathway_end = new_polygon.points[1].pos;
+			new_polygon.edges[0].connections.push_back(exit_connection);
+		}
+
+		link_connection.start_polygon = closest_start_polygon;
+		link_connection.end_polygon = closest_end_polygon;
+		sector_dirty_owners.insert(link);
+		sector_dirty_polygons.insert(closest_start_polygon);
+		sector_dirty_polygons.insert(closest_end_polygon);
+	}
+}
+
+void NavMap::_disconnect_link(uint32_t p_index) {
+	LinkConnection &link_connection = link_connections[p_index];
+	gd::Polygon &link_polygon = link_polygons[p_index];
+
+	gd::Polygon *connected_polygons[2] = { link_connection.start_polygon, link_connection.end_polygon };
+	for (gd::Polygon *connected_polygon : connected_polygons) {
+		if (!connected_polygon) {
+			continue;
+		}
+		Vector<gd::Edge::Connection> &entry_connections = connected_polygon->edges[0].connections;
+		for (int i = entry_connections.size() - 1; i >= 0; i--) {
+			if (entry_connections[i].polygon == &link_polygon) {
+				entry_connections.remove_at(i);
 			}
 		}
+		sector_dirty_polygons.insert(connected_polygon);
+	}
+	if (link_polygon.owner) {
+		sector_dirty_owners.insert(link_polygon.owner);
+	}
+
+	link_connection.start_polygon = nullptr;
+	link_connection.end_polygon = nullptr;
+	link_connection.dirty = true;
+	link_polygon.edges.clear();
+	link_polygon.points.clear();
+}
+
+void NavMap::sync() {
+	RWLockWrite write_lock(map_rwlock);
+
+	// Performance Monitor
+	int _new_pm_region_count = regions.size();
+	int _new_pm_agent_count = agents.size();
+	int _new_pm_link_count = links.size();
+	int _new_pm_polygon_count = pm_polygon_count;
+	int _new_pm_edge_count = pm_edge_count;
+	int _new_pm_edge_merge_count = pm_edge_merge_count;
+	int _new_pm_edge_connection_count = pm_edge_connection_count;
+	int _new_pm_edge_free_count = pm_edge_free_count;
+
+	// Check if we need to update the links.
+	if (regenerate_polygons) {
+		for (NavRegion *region : regions) {
+			region->scratch_polygons();
+		}
+		regenerate_links = true;
+	}
+
+	// Connecting is incremental: only the regions that changed are disconnected and connected again,
+	// along with the edges and links near them. Map settings changes connect everything again.
+	bool connections_changed = regenerate_links;
+	if (regenerate_links) {
+		_disconnect_all();
+	}
 
-		uint32_t link_poly_idx = 0;
+	if (links_dirty) {
+		for (uint32_t link_index = 0; link_index < link_connections.size(); link_index++) {
+			_disconnect_link(link_index);
+		}
 		link_polygons.resize(links.size());
+		link_connections.resize(links.size());
+		connections_changed = true;
+	}
 
-		// Search for polygons within range of a nav link.
-		for (const NavLink *link : links) {
-			if (!link->get_enabled()) {
+	for (uint32_t link_index = 0; link_index < links.size(); link_index++) {
+		if (links[link_index]->check_dirty()) {
+			_disconnect_link(link_index);
+		}
+	}
+
+	// Disconnect the regions before rebuilding their polygons, the polygons of other regions point to them.
+	LocalVector<NavRegion *> regions_to_connect;
+	for (NavRegion *region : regions) {
+		if (region->has_dirty_polygons()) {
+			_disconnect_region(region);
+			regions_to_connect.push_back(region);
+		} else if (regenerate_links) {
+			regions_to_connect.push_back(region);
+		}
+	}
+
+	for (NavRegion *region : regions_to_connect) {
+		region->sync();
+		if (region->get_enabled()) {
+			_connect_region(region);
+		}
+	}
+
+	_connect_free_edges();
+
+	if (map_polygons_dirty) {
+		polygons.clear();
+		for (NavRegion *region : regions) {
+			if (!connected_regions.has(region)) {
 				continue;
 			}
-			const Vector3 start = link->get_start_position();
-			const Vector3 end = link->get_end_position();
-
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
-			Vector3 closest_start_point;
-
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
-			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
+			for (gd::Polygon &polygon : region->get_polygons()) {
+				polygon.id = polygons.size();
+				polygons.push_back(&polygon);
 			}
+		}
+		map_polygons_dirty = false;
+		connections_changed = true;
+	}
 
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
+	// The new region polygons may be closer to the links than the polygons they're connected to.
+	for (NavRegion *region : regions_to_connect) {
+		const RegionConnectivity *connectivity = connected_regions.getptr(region);
+		if (!connectivity) {
+			continue;
+		}
+		const AABB link_search_bounds = connectivity->bounds.grow(link_connection_radius);
+		for (uint32_t link_index = 0; link_index < links.size(); link_index++) {
+			if (link_connections[link_index].dirty) {
+				continue;
+			}
+			if (link_search_bounds.has_point(links[link_index]->get_start_position()) || link_search_bounds.has_point(links[link_index]->get_end_position())) {
+				_disconnect_link(link_index);
 			}
+		}
+	}
 
-			// If we have both a start and end point, then create a synthetic polygon to route through.
-			if (closest_start_polygon && closest_end_polygon) {
-				gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
-				new_polygon.owner = link;
-
-				new_polygon.edges.clear();
-				new_polygon.edges.resize(4);
-				new_polygon.points.clear();
-				new_polygon.points.reserve(4);
-
-				// Build a set of vertices that create a thin polygon going from the start to the end point.
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-
-				Vector3 center;
-				for (int p = 0; p < 4; ++p) {
-					center += new_polygon.points[p].pos;
-				}
-				new_polygon.center = center / real_t(new_polygon.points.size());
-				new_polygon.clockwise = true;
-
-				// Setup connections to go forward in the link.
-				{
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[0].pos;
-					entry_connection.pathway_end = new_polygon.points[1].pos;
-					closest_start_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_end_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[2].pos;
-					exit_connection.pathway_end = new_polygon.points[3].pos;
-					new_polygon.edges[2].connections.push_back(exit_connection);
-				}
+	for (uint32_t link_index = 0; link_index < links.size(); link_index++) {
+		link_polygons[link_index].id = polygons.size() + link_index;
+		if (link_connections[link_index].dirty) {
+			_connect_link(link_index);
+			connections_changed = true;
+		}
+	}
+
+	if (connections_changed || sectors_dirty) {
+		// Map settings and link list changes move every polygon, the sectors are all built again.
+		_update_sectors(sectors_dirty || regenerate_links || links_dirty);
+		sectors_dirty = false;
+	}
 
-				// If the link is bi-directional, create connections from the end to the start.
-				if (link->is_bidirectional()) {
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[2].pos;
-					entry_connection.pathway_end = new_polygon.points[3].pos;
-					closest_end_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_start_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[0].pos;
-					exit_connection.pathway_end = new_polygon.points[1].pos;
-					new_polygon.edges[0].connections.push_back(exit_connection);
+	// Update the connection list of the regions, made of the connections of their free edges.
+	for (NavRegion *region : regions_with_changed_connections) {
+		Vector<gd::Edge::Connection> &region_connections = region->get_connections();
+		region_connections.clear();
+		const RegionConnectivity *connectivity = connected_regions.getptr(region);
+		if (!connectivity) {
+			continue;
+		}
+		for (const gd::Edge::Connection &free_edge : connectivity->free_edges) {
+			for (const gd::Edge::Connection &connection : free_edge.polygon->edges[free_edge.edge].connections) {
+				if (connection.edge != -1) {
+					region_connections.push_back(connection);
 				}
 			}
 		}
+	}
+	regions_with_changed_connections.clear();
+
+	if (connections_changed) {
+		_new_pm_polygon_count = polygons.size();
+		_new_pm_edge_count = edge_connections.size();
+		_new_pm_edge_merge_count = edge_merge_count;
+		_new_pm_edge_connection_count = 0;
+		_new_pm_edge_free_count = 0;
+		for (const KeyValue<NavRegion *, RegionConnectivity> &E : connected_regions) {
+			_new_pm_edge_connection_count += E.key->get_connections().size();
+			_new_pm_edge_free_count += E.value.free_edges.size();
+		}
 
 		// Update the update ID.
 		// Some code treats 0 as a failure case, so we avoid returning 0.
@@ -1185,6 +1566,7 @@ void NavMap::sync() {
 
 	regenerate_polygons = false;
 	regenerate_links = false;
+	links_dirty = false;
 	obstacles_dirty = false;
 	agents_dirty = false;
 
@@ -1399,6 +1781,303 @@ void NavMap::clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys
 	}
 }
 
+NavMap::PathQueryState *NavMap::_acquire_path_query_state() const {
+	MutexLock lock(path_query_state_pool_mutex);
+	if (path_query_state_pool.is_empty()) {
+		return memnew(PathQueryState);
+	}
+	PathQueryState *query_state = path_query_state_pool[path_query_state_pool.size() - 1];
+	path_query_state_pool.resize(path_query_state_pool.size() - 1);
+	return query_state;
+}
+
+void NavMap::_release_path_query_state(PathQueryState *p_query_state) const {
+	reached_polygon_count.add(p_query_state->reached_polygon_count);
+	p_query_state->reached_polygon_count = 0;
+
+	MutexLock lock(path_query_state_pool_mutex);
+	path_query_state_pool.push_back(p_query_state);
+}
+
+void NavMap::PathQueryState::begin_query(uint32_t p_polygon_count) {
+	traversable_polys.clear();
+	if (navigation_polys.size() < p_polygon_count) {
+		navigation_polys.resize(p_polygon_count);
+	}
+
+	query_id++;
+	if (query_id == 0) {
+		// Wrapped around, old states could pass for current ones.
+		for (gd::NavigationPoly &navigation_poly : navigation_polys) {
+			navigation_poly.query_id = 0;
+		}
+		query_id = 1;
+	}
+}
+
+void NavMap::PathQueryState::begin_sector_search(uint32_t p_sector_count) {
+	traversable_sectors.clear();
+	if (navigation_sectors.size() < p_sector_count) {
+		navigation_sectors.resize(p_sector_count);
+	}
+
+	sector_query_id++;
+	if (sector_query_id == 0) {
+		// Wrapped around, old states could pass for current ones.
+		for (gd::NavigationSector &navigation_sector : navigation_sectors) {
+			navigation_sector.query_id = 0;
+		}
+		sector_query_id = 1;
+	}
+}
+
+gd::NavigationSector &NavMap::PathQueryState::get_navigation_sector(uint32_t p_sector) {
+	gd::NavigationSector &navigation_sector = navigation_sectors[p_sector];
+	if (navigation_sector.query_id != sector_query_id) {
+		navigation_sector = gd::NavigationSector();
+		navigation_sector.query_id = sector_query_id;
+		navigation_sector.sector = p_sector;
+	}
+	return navigation_sector;
+}
+
+void NavMap::_update_sectors(bool p_rebuild) {
+	if (!use_hierarchical_pathfinding || polygons.is_empty()) {
+		sectors.clear();
+		polygon_sectors.clear();
+		sector_indices.clear();
+		sector_dirty_owners.clear();
+		sector_dirty_polygons.clear();
+		return;
+	}
+
+	if (p_rebuild || sectors.is_empty()) {
+		sectors.clear();
+		polygon_sectors.clear();
+		sector_indices.clear();
+
+		// Size the sectors so they hold about the same number of polygons whatever the scale of the map.
+		const real_t SECTOR_POLYGON_COUNT = 128.0;
+		real_t surface_area = 0.0;
+		for (const gd::Polygon *polygon : polygons) {
+			surface_area += polygon->surface_area;
+		}
+		if (surface_area <= 0.0) {
+			sector_dirty_owners.clear();
+			sector_dirty_polygons.clear();
+			return;
+		}
+		sector_size = Math::sqrt(surface_area / polygons.size() * SECTOR_POLYGON_COUNT);
+	}
+
+	// Only the sectors that have or had polygons of the changed regions and links, or polygons whose
+	// connections changed, are computed again.
+	LocalVector<bool> changed_sectors;
+	changed_sectors.resize(sectors.size());
+	for (uint32_t sector_index = 0; sector_index < sectors.size(); sector_index++) {
+		changed_sectors[sector_index] = false;
+		for (const NavBase *owner : sectors[sector_index].owners) {
+			if (sector_dirty_owners.has(owner)) {
+				changed_sectors[sector_index] = true;
+				break;
+			}
+		}
+	}
+
+	// Polygon ids change whenever a region is connected or disconnected, the sectors of all of them are looked up again.
+	const uint32_t polygon_count = polygons.size() + link_polygons.size();
+	polygon_sectors.resize(polygon_count);
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const gd::Polygon *polygon = polygon_id < polygons.size() ? polygons[polygon_id] : &link_polygons[polygon_id - polygons.size()];
+		if (polygon->points.is_empty()) {
+			// Links that aren't connected, nothing can reach them.
+			polygon_sectors[polygon_id] = UINT32_MAX;
+			continue;
+		}
+
+		const Vector3i cell = (polygon->center / sector_size).floor();
+		HashMap<Vector3i, uint32_t>::Iterator E = sector_indices.find(cell);
+		if (!E) {
+			E = sector_indices.insert(cell, sectors.size());
+			sectors.push_back(Sector());
+			changed_sectors.push_back(true);
+		}
+		polygon_sectors[polygon_id] = E->value;
+		if (sector_dirty_owners.has(polygon->owner) || sector_dirty_polygons.has(polygon)) {
+			changed_sectors[E->value] = true;
+		}
+	}
+	sector_dirty_owners.clear();
+	sector_dirty_polygons.clear();
+
+	// The portals leading to the changed sectors are computed again too, their centers may have moved.
+	LocalVector<bool> updated_sectors = changed_sectors;
+	for (uint32_t sector_index = 0; sector_index < sectors.size(); sector_index++) {
+		if (!changed_sectors[sector_index]) {
+			continue;
+		}
+		for (const SectorPortal &reverse_portal : sectors[sector_index].reverse_portals) {
+			updated_sectors[reverse_portal.sector] = true;
+		}
+	}
+
+	LocalVector<uint32_t> sector_polygon_counts;
+	sector_polygon_counts.resize(sectors.size());
+	for (uint32_t sector_index = 0; sector_index < sectors.size(); sector_index++) {
+		sector_polygon_counts[sector_index] = 0;
+		if (changed_sectors[sector_index]) {
+			sectors[sector_index].center = Vector3();
+			sectors[sector_index].owners.clear();
+		}
+		if (updated_sectors[sector_index]) {
+			sectors[sector_index].portals.clear();
+		}
+	}
+
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const uint32_t sector_index = polygon_sectors[polygon_id];
+		if (sector_index == UINT32_MAX || !changed_sectors[sector_index]) {
+			continue;
+		}
+		const gd::Polygon *polygon = polygon_id < polygons.size() ? polygons[polygon_id] : &link_polygons[polygon_id - polygons.size()];
+		Sector &sector = sectors[sector_index];
+		sector.center += polygon->center;
+		sector_polygon_counts[sector_index] += 1;
+		if (sector.owners.find(polygon->owner) < 0) {
+			sector.owners.push_back(polygon->owner);
+		}
+	}
+
+	for (uint32_t sector_index = 0; sector_index < sectors.size(); sector_index++) {
+		// Sectors left without polygons keep their index, nothing leads to them anymore.
+		if (changed_sectors[sector_index] && sector_polygon_counts[sector_index] > 0) {
+			sectors[sector_index].center /= real_t(sector_polygon_counts[sector_index]);
+		}
+	}
+
+	// The portals between sectors come from the polygon connections that cross them.
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const uint32_t sector_index = polygon_sectors[polygon_id];
+		if (sector_index == UINT32_MAX || !updated_sectors[sector_index]) {
+			continue;
+		}
+		const gd::Polygon *polygon = polygon_id < polygons.size() ? polygons[polygon_id] : &link_polygons[polygon_id - polygons.size()];
+		Sector &sector = sectors[sector_index];
+
+		for (const gd::Edge &edge : polygon->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t other_sector_index = polygon_sectors[connection.polygon->id];
+				if (other_sector_index == sector_index || other_sector_index == UINT32_MAX) {
+					continue;
+				}
+
+				const Vector3 pathway_center = (connection.pathway_start + connection.pathway_end) * 0.5;
+				const real_t cost = sector.center.distance_to(pathway_center) * polygon->owner->get_travel_cost() + pathway_center.distance_to(sectors[other_sector_index].center) * connection.polygon->owner->get_travel_cost();
+
+				bool found = false;
+				for (SectorPortal &portal : sector.portals) {
+					if (portal.sector == other_sector_index) {
+						portal.cost = MIN(portal.cost, cost);
+						found = true;
+						break;
+					}
+				}
+				if (!found) {
+					SectorPortal portal;
+					portal.sector = other_sector_index;
+					portal.cost = cost;
+					sector.portals.push_back(portal);
+				}
+			}
+		}
+	}
+
+	for (Sector &sector : sectors) {
+		sector.reverse_portals.clear();
+	}
+	for (uint32_t sector_index = 0; sector_index < sectors.size(); sector_index++) {
+		for (const SectorPortal &portal : sectors[sector_index].portals) {
+			SectorPortal reverse_portal;
+			reverse_portal.sector = sector_index;
+			reverse_portal.cost = portal.cost;
+			sectors[portal.sector].reverse_portals.push_back(reverse_portal);
+		}
+	}
+}
+
+bool NavMap::_find_sector_corridor(PathQueryState &r_query_state, uint32_t p_begin_sector, uint32_t p_end_sector, real_t &r_corridor_cost) const {
+	r_query_state.begin_sector_search(sectors.size());
+	gd::Heap<gd::NavigationSector *, gd::NavSectorCostGreaterThan, gd::NavSectorHeapIndexer> &traversable_sectors = r_query_state.traversable_sectors;
+
+	// Find the cost of the cheapest coarse route, and the cost to reach the sectors on the way from the start.
+	real_t cost_limit = FLT_MAX;
+	gd::NavigationSector &begin_sector = r_query_state.get_navigation_sector(p_begin_sector);
+	begin_sector.cost_from_begin = 0.0;
+	begin_sector.search_cost = 0.0;
+	traversable_sectors.push(&begin_sector);
+
+	while (!traversable_sectors.is_empty()) {
+		gd::NavigationSector *least_cost_sector = traversable_sectors.pop();
+		if (least_cost_sector->cost_from_begin > cost_limit) {
+			break;
+		}
+		if (least_cost_sector->sector == p_end_sector && cost_limit == FLT_MAX) {
+			cost_limit = least_cost_sector->cost_from_begin * (1.0 + hierarchical_path_tolerance) + CMP_EPSILON;
+		}
+
+		for (const SectorPortal &portal : sectors[least_cost_sector->sector].portals) {
+			gd::NavigationSector &neighbor_sector = r_query_state.get_navigation_sector(portal.sector);
+			const real_t new_cost = least_cost_sector->cost_from_begin + portal.cost;
+			if (new_cost < neighbor_sector.cost_from_begin) {
+				neighbor_sector.cost_from_begin = new_cost;
+				neighbor_sector.search_cost = new_cost;
+				if (neighbor_sector.traversable_sector_index == UINT32_MAX) {
+					traversable_sectors.push(&neighbor_sector);
+				} else {
+					traversable_sectors.shift(neighbor_sector.traversable_sector_index);
+				}
+			}
+		}
+	}
+	traversable_sectors.clear();
+
+	if (cost_limit == FLT_MAX) {
+		// The end sector isn't reachable.
+		return false;
+	}
+
+	// Same backwards from the end, the sectors of the corridor are on routes cheap enough both ways.
+	gd::NavigationSector &end_sector = r_query_state.get_navigation_sector(p_end_sector);
+	end_sector.cost_to_end = 0.0;
+	end_sector.search_cost = 0.0;
+	traversable_sectors.push(&end_sector);
+
+	while (!traversable_sectors.is_empty()) {
+		gd::NavigationSector *least_cost_sector = traversable_sectors.pop();
+		if (least_cost_sector->cost_to_end > cost_limit) {
+			break;
+		}
+
+		for (const SectorPortal &portal : sectors[least_cost_sector->sector].reverse_portals) {
+			gd::NavigationSector &neighbor_sector = r_query_state.get_navigation_sector(portal.sector);
+			const real_t new_cost = least_cost_sector->cost_to_end + portal.cost;
+			if (new_cost < neighbor_sector.cost_to_end) {
+				neighbor_sector.cost_to_end = new_cost;
+				neighbor_sector.search_cost = new_cost;
+				if (neighbor_sector.traversable_sector_index == UINT32_MAX) {
+					traversable_sectors.push(&neighbor_sector);
+				} else {
+					traversable_sectors.shift(neighbor_sector.traversable_sector_index);
+				}
+			}
+		}
+	}
+	traversable_sectors.clear();
+
+	r_corridor_cost = cost_limit;
+	return true;
+}
+
 void NavMap::_update_merge_rasterizer_cell_dimensions() {
 	merge_rasterizer_cell_size = cell_size * merge_rasterizer_cell_scale;
 	merge_rasterizer_cell_height = cell_height * merge_rasterizer_cell_scale;
@@ -1410,4 +2089,7 @@ NavMap::NavMap() {
 }
 
 NavMap::~NavMap() {
+	for (PathQueryState *query_state : path_query_state_pool) {
+		memdelete(query_state);
+	}
 }
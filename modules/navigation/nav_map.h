@@ -36,6 +36,9 @@
 
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/safe_refcount.h"
 
 #include <KdTree2d.h>
 #include <KdTree3d.h>
@@ -73,16 +76,112 @@ class NavMap : public NavRid {
 
 	bool regenerate_polygons = true;
 	bool regenerate_links = true;
+	/// Regions were connected or disconnected, the map polygons must be listed again.
+	bool map_polygons_dirty = true;
+	/// Links were added or removed, all the link polygons must be created again.
+	bool links_dirty = true;
 
 	/// Map regions
 	LocalVector<NavRegion *> regions;
 
+	/// The edges of the connected region polygons, grouped by key.
+	/// The keys are the rasterized edge end points, so they act as a spatial hash of the edges:
+	/// connecting or disconnecting a region only touches the edges at its own keys.
+	HashMap<gd::EdgeKey, LocalVector<gd::Edge::Connection>, gd::EdgeKey> edge_connections;
+	int edge_merge_count = 0;
+
+	struct RegionConnectivity {
+		AABB bounds;
+		/// Edges that aren't merged with another polygon edge, and can be connected to the near free edges of other regions.
+		LocalVector<gd::Edge::Connection> free_edges;
+	};
+	/// The enabled regions whose polygons are connected to the map.
+	HashMap<NavRegion *, RegionConnectivity> connected_regions;
+	/// Edges that may have become free since the last sync, connected to the near edges during the next one.
+	HashSet<gd::EdgeKey, gd::EdgeKey> free_edge_candidates;
+	/// Regions whose edge connections changed, their connection list is updated during the next sync.
+	HashSet<NavRegion *> regions_with_changed_connections;
+
 	/// Map links
 	LocalVector<NavLink *> links;
+	/// The polygon of each link, in the same order as `links`.
 	LocalVector<gd::Polygon> link_polygons;
 
-	/// Map polygons
-	LocalVector<gd::Polygon> polygons;
+	struct LinkConnection {
+		/// The region polygons that have an entry connection to the link polygon.
+		gd::Polygon *start_polygon = nullptr;
+		gd::Polygon *end_polygon = nullptr;
+		bool dirty = true;
+	};
+	LocalVector<LinkConnection> link_connections;
+
+	/// Map polygons, owned by the connected regions.
+	LocalVector<gd::Polygon *> polygons;
+
+	/// Hierarchical pathfinding clusters the polygons in sectors, and restricts the path searches to the
+	/// sectors of the coarse routes that are at most `hierarchical_path_tolerance` more expensive than the
+	/// cheapest one. The search of the whole map is used when the route isn't found that way, or when it
+	/// costs more than `hierarchical_path_tolerance` above the cheapest estimate of the routes it skipped.
+	bool use_hierarchical_pathfinding = false;
+	real_t hierarchical_path_tolerance = 0.2;
+	bool sectors_dirty = true;
+	/// Size of the sector cells, chosen when all the sectors are built and kept by the partial updates.
+	real_t sector_size = 0.0;
+	/// The sector of each cell. Sectors keep their index until all of them are built again.
+	HashMap<Vector3i, uint32_t> sector_indices;
+	/// Regions and links whose polygons changed since the sectors were updated.
+	HashSet<const NavBase *> sector_dirty_owners;
+	/// Polygons of other regions whose connections changed since the sectors were updated.
+	HashSet<const gd::Polygon *> sector_dirty_polygons;
+
+	struct SectorPortal {
+		uint32_t sector = 0;
+		/// Travel cost between the sector centers through the cheapest connection between the sectors.
+		real_t cost = 0.0;
+	};
+
+	struct Sector {
+		Vector3 center;
+		/// The regions and links the polygons of this sector belong to.
+		LocalVector<const NavBase *> owners;
+		/// The sectors reachable from this one.
+		LocalVector<SectorPortal> portals;
+		/// The sectors this one is reachable from.
+		LocalVector<SectorPortal> reverse_portals;
+	};
+	LocalVector<Sector> sectors;
+	/// The sector of each polygon, indexed by polygon id.
+	LocalVector<uint32_t> polygon_sectors;
+
+	/// Search state of path queries, reused across queries so they don't allocate it.
+	struct PathQueryState {
+		/// Indexed by polygon id, entries from other queries are stale.
+		LocalVector<gd::NavigationPoly> navigation_polys;
+		/// Reached polygons that are yet to be visited, cheapest first.
+		gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer> traversable_polys;
+		uint32_t query_id = 0;
+
+		/// Indexed by sector, entries from other searches are stale.
+		LocalVector<gd::NavigationSector> navigation_sectors;
+		/// Reached sectors that are yet to be visited, cheapest first.
+		gd::Heap<gd::NavigationSector *, gd::NavSectorCostGreaterThan, gd::NavSectorHeapIndexer> traversable_sectors;
+		uint32_t sector_query_id = 0;
+
+		/// Polygons reached by the current query, including the searches it started over.
+		uint32_t reached_polygon_count = 0;
+
+		void begin_query(uint32_t p_polygon_count);
+		void begin_sector_search(uint32_t p_sector_count);
+		gd::NavigationSector &get_navigation_sector(uint32_t p_sector);
+	};
+	/// Idle search states, one for each query that ran at the same time. Freed with the map.
+	mutable LocalVector<PathQueryState *> path_query_state_pool;
+	mutable BinaryMutex path_query_state_pool_mutex;
+	/// Polygons reached by all the path queries so far, shows how much of the map the searches cover.
+	mutable SafeNumeric<uint64_t> reached_polygon_count;
+
+	PathQueryState *_acquire_path_query_state() const;
+	void _release_path_query_state(PathQueryState *p_query_state) const;
 
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
@@ -161,6 +260,16 @@ public:
 		return link_connection_radius;
 	}
 
+	void set_use_hierarchical_pathfinding(bool p_enabled);
+	bool get_use_hierarchical_pathfinding() const {
+		return use_hierarchical_pathfinding;
+	}
+
+	void set_hierarchical_path_tolerance(real_t p_tolerance);
+	real_t get_hierarchical_path_tolerance() const {
+		return hierarchical_path_tolerance;
+	}
+
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
 	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
@@ -182,6 +291,14 @@ public:
 		return links;
 	}
 
+	/// The connected region polygons and the link polygons, as they were at the last sync.
+	const LocalVector<gd::Polygon *> &get_polygons() const {
+		return polygons;
+	}
+	const LocalVector<gd::Polygon> &get_link_polygons() const {
+		return link_polygons;
+	}
+
 	bool has_agent(NavAgent *agent) const;
 	void add_agent(NavAgent *agent);
 	void remove_agent(NavAgent *agent);
@@ -219,6 +336,8 @@ public:
 	int get_pm_edge_connection_count() const { return pm_edge_connection_count; }
 	int get_pm_edge_free_count() const { return pm_edge_free_count; }
 
+	uint64_t get_reached_polygon_count() const { return reached_polygon_count.get(); }
+
 private:
 	void compute_single_step(uint32_t index, NavAgent **agent);
 
@@ -232,6 +351,18 @@ private:
 	void _update_rvo_agents_tree_3d();
 
 	void _update_merge_rasterizer_cell_dimensions();
+
+	bool _get_edge_connection_pathway(const gd::Edge::Connection &p_edge, const gd::Edge::Connection &p_other_edge, Vector3 &r_pathway_start, Vector3 &r_pathway_end) const;
+	void _remove_free_edge(const gd::Edge::Connection &p_edge);
+	void _connect_region(NavRegion *p_region);
+	void _disconnect_region(NavRegion *p_region);
+	void _disconnect_all();
+	void _connect_free_edges();
+	void _connect_link(uint32_t p_index);
+	void _disconnect_link(uint32_t p_index);
+
+	void _update_sectors(bool p_rebuild);
+	bool _find_sector_corridor(PathQueryState &r_query_state, uint32_t p_begin_sector, uint32_t p_end_sector, real_t &r_corridor_cost) const;
 };
 
 #endif // NAV_MAP_H
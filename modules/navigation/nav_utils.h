@@ -98,6 +98,9 @@ struct Edge {
 };
 
 struct Polygon {
+	/// Index of this `Polygon` in the map, used to look up its search state when querying paths.
+	uint32_t id = UINT32_MAX;
+
 	/// Navigation region or link that contains this polygon.
 	const NavBase *owner = nullptr;
 
@@ -117,9 +120,13 @@ struct Polygon {
 };
 
 struct NavigationPoly {
-	uint32_t self_id = 0;
+	/// The path query this state belongs to, states of older queries are stale.
+	uint32_t query_id = 0;
 	/// This poly.
-	const Polygon *poly;
+	const Polygon *poly = nullptr;
+
+	/// Index in the heap of polygons to visit, `UINT32_MAX` when not in it.
+	uint32_t traversable_poly_index = UINT32_MAX;
 
 	/// Those 4 variables are used to travel the path backwards.
 	int back_navigation_poly_id = -1;
@@ -129,10 +136,17 @@ struct NavigationPoly {
 
 	/// The entry position of this poly.
 	Vector3 entry;
-	/// The distance to the destination.
+	/// The distance traveled until now.
 	real_t traveled_distance = 0.0;
+	/// The estimated distance to the destination, weighted by the travel cost.
+	real_t distance_to_destination = 0.0;
+
+	/// The estimated cost of a path going through this poly.
+	real_t total_travel_cost() const {
+		return traveled_distance + distance_to_destination;
+	}
 
-	NavigationPoly() { poly = nullptr; }
+	NavigationPoly() {}
 
 	NavigationPoly(const Polygon *p_poly) :
 			poly(p_poly) {}
@@ -146,6 +160,143 @@ struct NavigationPoly {
 	}
 };
 
+struct NavPolyTravelCostGreaterThan {
+	/// Returns `true` if `p_poly_a` is more expensive than `p_poly_b`, ties go to the one closer to the destination.
+	bool operator()(const NavigationPoly *p_poly_a, const NavigationPoly *p_poly_b) const {
+		real_t cost_a = p_poly_a->total_travel_cost();
+		real_t cost_b = p_poly_b->total_travel_cost();
+		if (cost_a != cost_b) {
+			return cost_a > cost_b;
+		}
+		return p_poly_a->distance_to_destination > p_poly_b->distance_to_destination;
+	}
+};
+
+struct NavPolyHeapIndexer {
+	void operator()(NavigationPoly *p_poly, uint32_t p_heap_index) const {
+		p_poly->traversable_poly_index = p_heap_index;
+	}
+};
+
+struct NavigationSector {
+	/// The sector search this state belongs to, states of older searches are stale.
+	uint32_t query_id = 0;
+	/// Index of the sector in the map.
+	uint32_t sector = 0;
+
+	/// Index in the heap of sectors to visit, `UINT32_MAX` when not in it.
+	uint32_t traversable_sector_index = UINT32_MAX;
+
+	/// The cost of the cheapest coarse routes from the start sector to this one, and from this one to the end sector.
+	real_t cost_from_begin = FLT_MAX;
+	real_t cost_to_end = FLT_MAX;
+	/// The cost that orders the sectors to visit, the one of the running search.
+	real_t search_cost = 0.0;
+};
+
+struct NavSectorCostGreaterThan {
+	bool operator()(const NavigationSector *p_sector_a, const NavigationSector *p_sector_b) const {
+		return p_sector_a->search_cost > p_sector_b->search_cost;
+	}
+};
+
+struct NavSectorHeapIndexer {
+	void operator()(NavigationSector *p_sector, uint32_t p_heap_index) const {
+		p_sector->traversable_sector_index = p_heap_index;
+	}
+};
+
+/// Binary heap that keeps the element with the highest priority on top, where `GreaterThan` returns
+/// `true` if its first argument has a lower priority. `Indexer` is told the position of every element
+/// when it moves, so elements whose priority changed can be moved with `shift()`.
+template <typename T, typename GreaterThan, typename Indexer>
+class Heap {
+	LocalVector<T> buffer;
+	GreaterThan greater_than;
+	Indexer indexer;
+
+	void _shift_up(uint32_t p_index) {
+		T value = buffer[p_index];
+		while (p_index > 0) {
+			uint32_t parent = (p_index - 1) / 2;
+			if (!greater_than(buffer[parent], value)) {
+				break;
+			}
+			buffer[p_index] = buffer[parent];
+			indexer(buffer[p_index], p_index);
+			p_index = parent;
+		}
+		buffer[p_index] = value;
+		indexer(value, p_index);
+	}
+
+	void _shift_down(uint32_t p_index) {
+		T value = buffer[p_index];
+		uint32_t size = buffer.size();
+		while (true) {
+			uint32_t child = p_index * 2 + 1;
+			if (child >= size) {
+				break;
+			}
+			if (child + 1 < size && greater_than(buffer[child], buffer[child + 1])) {
+				child++;
+			}
+			if (!greater_than(value, buffer[child])) {
+				break;
+			}
+			buffer[p_index] = buffer[child];
+			indexer(buffer[p_index], p_index);
+			p_index = child;
+		}
+		buffer[p_index] = value;
+		indexer(value, p_index);
+	}
+
+public:
+	void reserve(uint32_t p_size) {
+		buffer.reserve(p_size);
+	}
+
+	uint32_t size() const {
+		return buffer.size();
+	}
+
+	bool is_empty() const {
+		return buffer.is_empty();
+	}
+
+	void push(const T &p_value) {
+		buffer.push_back(p_value);
+		_shift_up(buffer.size() - 1);
+	}
+
+	T pop() {
+		ERR_FAIL_COND_V_MSG(buffer.is_empty(), T(), "Can't pop an empty heap.");
+		T top = buffer[0];
+		indexer(top, UINT32_MAX);
+		T last = buffer[buffer.size() - 1];
+		buffer.resize(buffer.size() - 1);
+		if (!buffer.is_empty()) {
+			buffer[0] = last;
+			_shift_down(0);
+		}
+		return top;
+	}
+
+	/// Restores the order after the priority of the element at `p_index` increased.
+	void shift(uint32_t p_index) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, buffer.size());
+		_shift_up(p_index);
+	}
+
+	void clear() {
+		for (const T &value : buffer) {
+			indexer(value, UINT32_MAX);
+		}
+		buffer.clear();
+	}
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
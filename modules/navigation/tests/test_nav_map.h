@@ -0,0 +1,150 @@
+/**************************************************************************/
+/*  test_nav_map.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NAV_MAP_H
+#define TEST_NAV_MAP_H
+
+#include "../nav_map.h"
+#include "../nav_region.h"
+
+#include "scene/resources/navigation_mesh.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavMap {
+
+const int GRID_SIZE = 120;
+
+// A cup opening towards the start of the paths, the straight line to the target leads into it.
+static bool is_cup_wall(int p_x, int p_z) {
+	return (p_x == 90 && p_z >= 25 && p_z <= 95) || ((p_z == 25 || p_z == 95) && p_x >= 30 && p_x <= 90);
+}
+
+// The cup, and a fence near the target that only has a gap at the near end.
+static bool is_cup_and_fence_wall(int p_x, int p_z) {
+	return is_cup_wall(p_x, p_z) || (p_x == 105 && p_z >= 10);
+}
+
+// Quads for the cells from `p_from_x` to `p_to_x` of the grid, except the walls.
+static Ref<NavigationMesh> make_grid_mesh(int p_from_x, int p_to_x, bool (*p_is_wall)(int, int)) {
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+	const int width = p_to_x - p_from_x;
+	PackedVector3Array vertices;
+	for (int z = 0; z <= GRID_SIZE; z++) {
+		for (int x = p_from_x; x <= p_to_x; x++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+	for (int z = 0; z < GRID_SIZE; z++) {
+		for (int x = 0; x < width; x++) {
+			if (p_is_wall(p_from_x + x, z)) {
+				continue;
+			}
+			Vector<int> polygon;
+			polygon.push_back(z * (width + 1) + x);
+			polygon.push_back(z * (width + 1) + x + 1);
+			polygon.push_back((z + 1) * (width + 1) + x + 1);
+			polygon.push_back((z + 1) * (width + 1) + x);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+	return navigation_mesh;
+}
+
+static real_t get_path_length(const Vector<Vector3> &p_path) {
+	real_t length = 0.0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += p_path[i - 1].distance_to(p_path[i]);
+	}
+	return length;
+}
+
+TEST_CASE("[Navigation] Hierarchical paths skip polygons and stay within the tolerance of the full search") {
+	const Vector3 start = Vector3(5.5, 0, 60.5);
+	const Vector3 target = Vector3(GRID_SIZE - 5.5, 0, 60.5);
+	const real_t TOLERANCE = 0.5;
+
+	// Two regions, so changing one of them only updates the sectors on its side of the map.
+	NavMap map;
+	NavRegion left_region;
+	NavRegion right_region;
+	left_region.set_mesh(make_grid_mesh(0, GRID_SIZE / 2, is_cup_wall));
+	right_region.set_mesh(make_grid_mesh(GRID_SIZE / 2, GRID_SIZE, is_cup_wall));
+	left_region.set_map(&map);
+	right_region.set_map(&map);
+	map.set_hierarchical_path_tolerance(TOLERANCE);
+	map.sync();
+
+	SUBCASE("The corridor leaves the far end of the cup out") {
+		uint64_t reached_polygon_count = map.get_reached_polygon_count();
+		const Vector<Vector3> path = map.get_path(start, target, true, 1, nullptr, nullptr, nullptr);
+		const uint64_t full_search_count = map.get_reached_polygon_count() - reached_polygon_count;
+		REQUIRE_GT(path.size(), 2);
+		CHECK(path[path.size() - 1].is_equal_approx(target));
+
+		map.set_use_hierarchical_pathfinding(true);
+		map.sync();
+		reached_polygon_count = map.get_reached_polygon_count();
+		const Vector<Vector3> hierarchical_path = map.get_path(start, target, true, 1, nullptr, nullptr, nullptr);
+		const uint64_t hierarchical_search_count = map.get_reached_polygon_count() - reached_polygon_count;
+		REQUIRE_GT(hierarchical_path.size(), 2);
+		CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(target));
+
+		CHECK_MESSAGE(hierarchical_search_count < full_search_count, "The polygons outside the corridor shouldn't be searched.");
+		CHECK(get_path_length(hierarchical_path) <= get_path_length(path) * (1.0 + TOLERANCE) + CMP_EPSILON);
+	}
+
+	SUBCASE("Changing a region updates the sectors") {
+		map.set_use_hierarchical_pathfinding(true);
+		map.sync();
+		map.get_path(start, target, true, 1, nullptr, nullptr, nullptr);
+
+		right_region.set_mesh(make_grid_mesh(GRID_SIZE / 2, GRID_SIZE, is_cup_and_fence_wall));
+		map.sync();
+		const Vector<Vector3> hierarchical_path = map.get_path(start, target, true, 1, nullptr, nullptr, nullptr);
+		REQUIRE_GT(hierarchical_path.size(), 2);
+		CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(target));
+
+		map.set_use_hierarchical_pathfinding(false);
+		map.sync();
+		const Vector<Vector3> path = map.get_path(start, target, true, 1, nullptr, nullptr, nullptr);
+		REQUIRE_GT(path.size(), 2);
+		CHECK(get_path_length(hierarchical_path) <= get_path_length(path) * (1.0 + TOLERANCE) + CMP_EPSILON);
+	}
+
+	left_region.set_map(nullptr);
+	right_region.set_map(nullptr);
+}
+
+} // namespace TestNavMap
+
+#endif // TEST_NAV_MAP_H
@@ -90,6 +90,14 @@ public:
 	/// Returns the link connection radius of this map.
 	virtual real_t map_get_link_connection_radius(RID p_map) const = 0;
 
+	/// Set if path queries on this map first search a coarse route between polygon sectors.
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) = 0;
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const = 0;
+
+	/// Set how much more expensive than the cheapest coarse route the routes searched by hierarchical pathfinding can be.
+	virtual void map_set_hierarchical_path_tolerance(RID p_map, real_t p_tolerance) = 0;
+	virtual real_t map_get_hierarchical_path_tolerance(RID p_map) const = 0;
+
 	/// Returns the navigation path to reach the destination from the origin.
 	virtual Vector<Vector2> map_get_path(RID p_map, Vector2 p_origin, Vector2 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const = 0;
 
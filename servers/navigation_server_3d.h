@@ -102,6 +102,14 @@ public:
 	/// Returns the link connection radius of this map.
 	virtual real_t map_get_link_connection_radius(RID p_map) const = 0;
 
+	/// Set if path queries on this map first search a coarse route between polygon sectors.
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) = 0;
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const = 0;
+
+	/// Set how much more expensive than the cheapest coarse route the routes searched by hierarchical pathfinding can be.
+	virtual void map_set_hierarchical_path_tolerance(RID p_map, real_t p_tolerance) = 0;
+	virtual real_t map_get_hierarchical_path_tolerance(RID p_map) const = 0;
+
 	/// Returns the navigation path to reach the destination from the origin.
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) const = 0;
 
@@ -323,6 +331,22 @@ public:
 	virtual void obstacle_set_avoidance_layers(RID p_obstacle, uint32_t p_layers) = 0;
 	virtual uint32_t obstacle_get_avoidance_layers(RID p_obstacle) const = 0;
 
+	/// Creates the flow field, the direction to a target from any point of a map.
+	virtual RID flow_field_create() = 0;
+
+	virtual void flow_field_set_map(RID p_flow_field, RID p_map) = 0;
+	virtual RID flow_field_get_map(RID p_flow_field) const = 0;
+
+	virtual void flow_field_set_target_position(RID p_flow_field, Vector3 p_position) = 0;
+	virtual Vector3 flow_field_get_target_position(RID p_flow_field) const = 0;
+
+	virtual void flow_field_set_navigation_layers(RID p_flow_field, uint32_t p_navigation_layers) = 0;
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const = 0;
+
+	/// Samples the flow field, these are thread safe.
+	virtual Vector3 flow_field_get_direction(RID p_flow_field, const Vector3 &p_position) const = 0;
+	virtual real_t flow_field_get_distance(RID p_flow_field, const Vector3 &p_position) const = 0;
+
 	/// Destroy the `RID`
 	virtual void free(RID p_object) = 0;
 
@@ -341,6 +365,13 @@ public:
 	/// Returns a customized navigation path using a query parameters object
 	virtual void query_path(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result) const;
 
+	/// Solves many path queries at once, possibly in parallel and in the background.
+	/// The result objects are updated before `p_callback` is called, from the main thread.
+	/// Returns an id to poll or wait for the batch, the base implementation solves it right away.
+	virtual int64_t query_paths_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable());
+	virtual bool is_path_query_batch_completed(int64_t p_batch_id) const;
+	virtual void wait_for_path_query_batch(int64_t p_batch_id);
+
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const = 0;
 
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) = 0;
@@ -178,6 +178,8 @@ void GodotBody3D::set_active(bool p_active) {
 	active = p_active;
 
 	if (active) {
+		// A body woken up stays awake for the whole time to sleep again.
+		still_time = 0.0;
 		if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
 			// Static bodies can't be active.
 			active = false;
@@ -789,11 +791,82 @@ bool GodotBody3D::sleep_test(real_t p_step) {
 
 		return still_time > get_space()->get_body_time_to_sleep();
 	} else {
-		still_time = 0; //maybe this should be set to 0 on set_active?
+		still_time = 0;
 		return false;
 	}
 }
 
+void GodotBody3D::get_snapshot_state(LocalVector<real_t> &r_state) const {
+	r_state.resize(MOTION_STATE_SIZE + get_shape_count() * 6);
+	real_t *w = r_state.ptr();
+
+	const Transform3D &transform = get_transform();
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			*w++ = transform.basis.rows[i][j];
+		}
+	}
+	const Vector3 *vectors[] = { &transform.origin, &linear_velocity, &angular_velocity, &prev_linear_velocity, &prev_angular_velocity, &applied_force, &applied_torque };
+	for (const Vector3 *vector : vectors) {
+		for (int i = 0; i < 3; i++) {
+			*w++ = (*vector)[i];
+		}
+	}
+	*w++ = still_time;
+	*w++ = active ? 1.0 : 0.0;
+
+	// The broadphase bounds depend on the motion of the previous step, they decide which pairs exist.
+	for (int i = 0; i < get_shape_count(); i++) {
+		const AABB &aabb = get_shape_aabb(i);
+		for (int j = 0; j < 3; j++) {
+			*w++ = aabb.position[j];
+			*w++ = aabb.size[j];
+		}
+	}
+}
+
+void GodotBody3D::set_snapshot_state(const real_t *p_state, uint32_t p_size) {
+	ERR_FAIL_COND(p_size < MOTION_STATE_SIZE);
+
+	Transform3D transform;
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			transform.basis.rows[i][j] = *p_state++;
+		}
+	}
+	Vector3 *vectors[] = { &transform.origin, &linear_velocity, &angular_velocity, &prev_linear_velocity, &prev_angular_velocity, &applied_force, &applied_torque };
+	for (Vector3 *vector : vectors) {
+		for (int i = 0; i < 3; i++) {
+			(*vector)[i] = *p_state++;
+		}
+	}
+	real_t snapshot_still_time = *p_state++;
+	bool snapshot_active = *p_state++ != 0.0;
+
+	new_transform = transform;
+	if (p_size == MOTION_STATE_SIZE + get_shape_count() * 6) {
+		_set_transform(transform, false);
+		LocalVector<AABB> aabbs;
+		aabbs.resize(get_shape_count());
+		for (AABB &aabb : aabbs) {
+			for (int j = 0; j < 3; j++) {
+				aabb.position[j] = *p_state++;
+				aabb.size[j] = *p_state++;
+			}
+		}
+		_set_shape_aabbs(aabbs.ptr());
+	} else {
+		// The shapes changed since, their bounds are computed again.
+		_set_transform(transform);
+	}
+	_set_inv_transform(transform.inverse());
+	_update_transform_dependent();
+
+	// Waking up resets the time to sleep, so it's restored after.
+	set_active(snapshot_active);
+	still_time = snapshot_still_time;
+}
+
 void GodotBody3D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
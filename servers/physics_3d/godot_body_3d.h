@@ -343,6 +343,14 @@ public:
 
 	bool sleep_test(real_t p_step);
 
+	// The motion state of a rigid body as plain values, saved in the space snapshots.
+	// It's followed by the broadphase bounds of each shape.
+	enum {
+		MOTION_STATE_SIZE = 32,
+	};
+	void get_snapshot_state(LocalVector<real_t> &r_state) const;
+	void set_snapshot_state(const real_t *p_state, uint32_t p_size);
+
 	GodotBody3D();
 	~GodotBody3D();
 };
@@ -66,10 +66,7 @@ void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_ind
 		Contact &c = contacts[i];
 		if (c.local_A.distance_squared_to(local_A) < (contact_recycle_radius * contact_recycle_radius) &&
 				c.local_B.distance_squared_to(local_B) < (contact_recycle_radius * contact_recycle_radius)) {
-			contact.acc_normal_impulse = c.acc_normal_impulse;
-			contact.acc_bias_impulse = c.acc_bias_impulse;
-			contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
-			contact.acc_tangent_impulse = c.acc_tangent_impulse;
+			_warm_start_contact(contact, c);
 			c = contact;
 			return;
 		}
@@ -374,6 +371,8 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 	for (int i = 0; i < contact_count; i++) {
 		Contact &c = contacts[i];
 		c.active = false;
+		c.acc_bias_impulse = 0.0;
+		c.acc_bias_impulse_center_of_mass = 0.0;
 
 		Vector3 global_A = basis_A.xform(c.local_A);
 		Vector3 global_B = basis_B.xform(c.local_B) + offset_B;
@@ -382,6 +381,9 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 		real_t depth = axis.dot(c.normal);
 
 		if (depth <= 0.0) {
+			// Separated, the impulses of the previous steps don't apply anymore.
+			c.acc_normal_impulse = 0.0;
+			c.acc_tangent_impulse = Vector3();
 			continue;
 		}
 
@@ -595,6 +597,78 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+GodotConstraint3D::SortKey GodotBodyPair3D::get_sort_key() const {
+	SortKey key;
+	key.ids[0] = A->get_self().get_id();
+	key.ids[1] = B->get_self().get_id();
+	key.shapes[0] = shape_A;
+	key.shapes[1] = shape_B;
+	return key;
+}
+
+void GodotBodyPair3D::get_cache(LocalVector<real_t> &r_cache) const {
+	r_cache.clear();
+	if (contact_count == 0) {
+		return;
+	}
+
+	r_cache.resize(3 + contact_count * CONTACT_CACHE_SIZE);
+	real_t *w = r_cache.ptr();
+	for (int i = 0; i < 3; i++) {
+		*w++ = sep_axis[i];
+	}
+
+	// Only what the next step starts from, everything else is computed again in setup() and pre_solve().
+	for (int i = 0; i < contact_count; i++) {
+		const Contact &c = contacts[i];
+		for (int j = 0; j < 3; j++) {
+			*w++ = c.normal[j];
+			*w++ = c.local_A[j];
+			*w++ = c.local_B[j];
+			*w++ = c.acc_impulse[j];
+			*w++ = c.acc_tangent_impulse[j];
+		}
+		*w++ = c.acc_normal_impulse;
+		*w++ = c.index_A;
+		*w++ = c.index_B;
+		*w++ = c.used ? 1.0 : 0.0;
+	}
+}
+
+void GodotBodyPair3D::set_cache(const real_t *p_cache, uint32_t p_size) {
+	contact_count = 0;
+	sep_axis = Vector3();
+	if (p_size == 0) {
+		return;
+	}
+
+	ERR_FAIL_COND(p_size < 3 || (p_size - 3) % CONTACT_CACHE_SIZE != 0);
+	int count = (p_size - 3) / CONTACT_CACHE_SIZE;
+	ERR_FAIL_COND(count > MAX_CONTACTS);
+
+	const real_t *r = p_cache;
+	for (int i = 0; i < 3; i++) {
+		sep_axis[i] = *r++;
+	}
+
+	for (int i = 0; i < count; i++) {
+		Contact &c = contacts[i];
+		c = Contact();
+		for (int j = 0; j < 3; j++) {
+			c.normal[j] = *r++;
+			c.local_A[j] = *r++;
+			c.local_B[j] = *r++;
+			c.acc_impulse[j] = *r++;
+			c.acc_tangent_impulse[j] = *r++;
+		}
+		c.acc_normal_impulse = *r++;
+		c.index_A = *r++;
+		c.index_B = *r++;
+		c.used = *r++ != 0.0;
+	}
+	contact_count = count;
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
 		GodotBodyContact3D(_arr, 2) {
 	A = p_A;
@@ -637,10 +711,7 @@ void GodotBodySoftBodyPair3D::contact_added_callback(const Vector3 &p_point_A, i
 		if (c.index_B == p_index_B) {
 			if (c.local_A.distance_squared_to(local_A) < (contact_recycle_radius * contact_recycle_radius) &&
 					c.local_B.distance_squared_to(local_B) < (contact_recycle_radius * contact_recycle_radius)) {
-				contact.acc_normal_impulse = c.acc_normal_impulse;
-				contact.acc_bias_impulse = c.acc_bias_impulse;
-				contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
-				contact.acc_tangent_impulse = c.acc_tangent_impulse;
+				_warm_start_contact(contact, c);
 			}
 			c = contact;
 			return;
@@ -759,6 +830,8 @@ bool GodotBodySoftBodyPair3D::pre_solve(real_t p_step) {
 	for (uint32_t contact_index = 0; contact_index < contact_count; ++contact_index) {
 		Contact &c = contacts[contact_index];
 		c.active = false;
+		c.acc_bias_impulse = 0.0;
+		c.acc_bias_impulse_center_of_mass = 0.0;
 
 		real_t node_inv_mass = soft_body_collides ? soft_body->get_node_inv_mass(c.index_B) : 0.0;
 		if ((node_inv_mass == 0.0) && (body_inv_mass == 0.0)) {
@@ -771,6 +844,9 @@ bool GodotBodySoftBodyPair3D::pre_solve(real_t p_step) {
 		real_t depth = axis.dot(c.normal);
 
 		if (depth <= 0.0) {
+			// Separated, the impulses of the previous steps don't apply anymore.
+			c.acc_normal_impulse = 0.0;
+			c.acc_tangent_impulse = Vector3();
 			continue;
 		}
 
@@ -972,6 +1048,14 @@ void GodotBodySoftBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+GodotConstraint3D::SortKey GodotBodySoftBodyPair3D::get_sort_key() const {
+	SortKey key;
+	key.ids[0] = body->get_self().get_id();
+	key.ids[1] = soft_body->get_self().get_id();
+	key.shapes[0] = body_shape;
+	return key;
+}
+
 GodotBodySoftBodyPair3D::GodotBodySoftBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotSoftBody3D *p_B) :
 		GodotBodyContact3D(&body, 1) {
 	body = p_A;
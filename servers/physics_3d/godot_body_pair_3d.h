@@ -65,6 +65,14 @@ protected:
 
 	GodotSpace3D *space = nullptr;
 
+	// A contact found again keeps the impulses of the previous step, to start solving from them.
+	// The bias impulses only correct the penetration of one step, they aren't kept.
+	_FORCE_INLINE_ static void _warm_start_contact(Contact &r_contact, const Contact &p_previous) {
+		r_contact.acc_normal_impulse = p_previous.acc_normal_impulse;
+		// The normal may have changed slightly, the friction stays in the new tangent plane.
+		r_contact.acc_tangent_impulse = p_previous.acc_tangent_impulse - r_contact.normal * r_contact.normal.dot(p_previous.acc_tangent_impulse);
+	}
+
 	GodotBodyContact3D(GodotBody3D **p_body_ptr = nullptr, int p_body_count = 0) :
 			GodotConstraint3D(p_body_ptr, p_body_count) {
 	}
@@ -72,7 +80,8 @@ protected:
 
 class GodotBodyPair3D : public GodotBodyContact3D {
 	enum {
-		MAX_CONTACTS = 4
+		MAX_CONTACTS = 4,
+		CONTACT_CACHE_SIZE = 19,
 	};
 
 	union {
@@ -108,6 +117,10 @@ public:
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
+	virtual SortKey get_sort_key() const override;
+
+	virtual void get_cache(LocalVector<real_t> &r_cache) const override;
+	virtual void set_cache(const real_t *p_cache, uint32_t p_size) override;
 
 	GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B);
 	~GodotBodyPair3D();
@@ -136,6 +149,7 @@ public:
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
+	virtual SortKey get_sort_key() const override;
 
 	virtual GodotSoftBody3D *get_soft_body_ptr(int p_index) const override { return soft_body; }
 	virtual int get_soft_body_count() const override { return 1; }
@@ -209,6 +209,28 @@ void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion)
 	}
 }
 
+void GodotCollisionObject3D::_set_shape_aabbs(const AABB *p_aabbs) {
+	if (!space) {
+		return;
+	}
+
+	for (int i = 0; i < shapes.size(); i++) {
+		Shape &s = shapes.write[i];
+		if (s.disabled) {
+			continue;
+		}
+
+		s.aabb_cache = p_aabbs[i];
+
+		if (s.bpid == 0) {
+			s.bpid = space->get_broadphase()->create(this, i, s.aabb_cache, _static);
+			space->get_broadphase()->set_static(s.bpid, _static);
+		}
+
+		space->get_broadphase()->move(s.bpid, s.aabb_cache);
+	}
+}
+
 void GodotCollisionObject3D::_set_space(GodotSpace3D *p_space) {
 	GodotSpace3D *old_space = space;
 	space = p_space;
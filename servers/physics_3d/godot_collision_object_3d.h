@@ -83,6 +83,8 @@ private:
 
 protected:
 	void _update_shapes_with_motion(const Vector3 &p_motion);
+	// Moves the shapes in the broadphase to bounds computed before, one per shape.
+	void _set_shape_aabbs(const AABB *p_aabbs);
 	void _unregister_shapes();
 
 	_FORCE_INLINE_ void _set_transform(const Transform3D &p_transform, bool p_update_shapes = true) {
@@ -107,6 +109,13 @@ protected:
 	GodotCollisionObject3D(Type p_type);
 
 public:
+	// Orders objects by RID, which doesn't depend on the memory layout nor on the activation order.
+	struct SelfComparator {
+		_FORCE_INLINE_ bool operator()(const GodotCollisionObject3D *p_a, const GodotCollisionObject3D *p_b) const {
+			return p_a->self.get_id() < p_b->self.get_id();
+		}
+	};
+
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
@@ -31,6 +31,8 @@
 #ifndef GODOT_CONSTRAINT_3D_H
 #define GODOT_CONSTRAINT_3D_H
 
+#include "core/templates/local_vector.h"
+
 class GodotBody3D;
 class GodotSoftBody3D;
 
@@ -53,6 +55,53 @@ protected:
 	}
 
 public:
+	// Identifies a constraint from the objects it connects, so it doesn't depend on the memory layout.
+	// Used to solve the constraints in the same order on every run in deterministic mode.
+	struct SortKey {
+		uint64_t ids[2] = { 0, 0 };
+		int shapes[2] = { 0, 0 };
+		// Tells apart constraints between the same objects, like several joints between two bodies.
+		uint64_t id = 0;
+
+		_FORCE_INLINE_ bool operator<(const SortKey &p_other) const {
+			if (ids[0] != p_other.ids[0]) {
+				return ids[0] < p_other.ids[0];
+			}
+			if (ids[1] != p_other.ids[1]) {
+				return ids[1] < p_other.ids[1];
+			}
+			if (shapes[0] != p_other.shapes[0]) {
+				return shapes[0] < p_other.shapes[0];
+			}
+			if (shapes[1] != p_other.shapes[1]) {
+				return shapes[1] < p_other.shapes[1];
+			}
+			return id < p_other.id;
+		}
+		_FORCE_INLINE_ bool operator==(const SortKey &p_other) const {
+			return ids[0] == p_other.ids[0] && ids[1] == p_other.ids[1] && shapes[0] == p_other.shapes[0] && shapes[1] == p_other.shapes[1] && id == p_other.id;
+		}
+	};
+
+	struct SortKeyComparator {
+		_FORCE_INLINE_ bool operator()(const GodotConstraint3D *p_a, const GodotConstraint3D *p_b) const {
+			return p_a->get_sort_key() < p_b->get_sort_key();
+		}
+	};
+
+	// Constraints are identified by their own RID, joints and pairs override this.
+	virtual SortKey get_sort_key() const {
+		SortKey key;
+		key.id = self.get_id();
+		return key;
+	}
+
+	// The state carried from one step to the next, as plain values, saved in the space snapshots.
+	// Constraints without any leave it empty.
+	virtual void get_cache(LocalVector<real_t> &r_cache) const {}
+	// Restores the state saved by get_cache(), or clears it when empty.
+	virtual void set_cache(const real_t *p_cache, uint32_t p_size) {}
+
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
@@ -77,6 +77,19 @@ public:
 	virtual bool pre_solve(real_t p_step) override { return true; }
 	virtual void solve(real_t p_step) override {}
 
+	// Identified by the bodies they connect, then by their own RID.
+	virtual SortKey get_sort_key() const override {
+		SortKey key;
+		for (int i = 0; i < MIN(get_body_count(), 2); i++) {
+			const GodotBody3D *body = get_body_ptr()[i];
+			if (body) {
+				key.ids[i] = body->get_self().get_id();
+			}
+		}
+		key.id = get_self().get_id();
+		return key;
+	}
+
 	void copy_settings_from(GodotJoint3D *p_joint) {
 		set_self(p_joint->get_self());
 		set_priority(p_joint->get_priority());
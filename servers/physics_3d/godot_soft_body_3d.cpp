@@ -154,10 +154,9 @@ void GodotSoftBody3D::update_rendering_server(PhysicsServer3DRenderingServerHand
 	const uint32_t vertex_count = map_visual_to_physics.size();
 	for (uint32_t i = 0; i < vertex_count; ++i) {
 		const uint32_t node_index = map_visual_to_physics[i];
-		const Node &node = nodes[node_index];
 
-		p_rendering_server_handler->set_vertex(i, node.x);
-		p_rendering_server_handler->set_normal(i, node.n);
+		p_rendering_server_handler->set_vertex(i, node_positions[node_index]);
+		p_rendering_server_handler->set_normal(i, nodes[node_index].n);
 	}
 
 	p_rendering_server_handler->set_aabb(bounds);
@@ -169,13 +168,16 @@ void GodotSoftBody3D::update_normals_and_centroids() {
 	}
 
 	for (Face &face : faces) {
-		const Vector3 n = vec3_cross(face.n[0]->x - face.n[2]->x, face.n[0]->x - face.n[1]->x);
-		face.n[0]->n += n;
-		face.n[1]->n += n;
-		face.n[2]->n += n;
+		const Vector3 &x0 = node_positions[face.n[0]];
+		const Vector3 &x1 = node_positions[face.n[1]];
+		const Vector3 &x2 = node_positions[face.n[2]];
+		const Vector3 n = vec3_cross(x0 - x2, x0 - x1);
+		nodes[face.n[0]].n += n;
+		nodes[face.n[1]].n += n;
+		nodes[face.n[2]].n += n;
 		face.normal = n;
 		face.normal.normalize();
-		face.centroid = 0.33333333333 * (face.n[0]->x + face.n[1]->x + face.n[2]->x);
+		face.centroid = 0.33333333333 * (x0 + x1 + x2);
 	}
 
 	for (Node &node : nodes) {
@@ -186,7 +188,7 @@ void GodotSoftBody3D::update_normals_and_centroids() {
 	}
 }
 
-void GodotSoftBody3D::update_bounds() {
+bool GodotSoftBody3D::compute_bounds() {
 	AABB prev_bounds = bounds;
 	prev_bounds.grow_by(collision_margin);
 
@@ -194,27 +196,35 @@ void GodotSoftBody3D::update_bounds() {
 
 	const uint32_t nodes_count = nodes.size();
 	if (nodes_count == 0) {
-		deinitialize_shape();
-		return;
+		return false;
 	}
 
-	bool first = true;
 	bool moved = false;
+	bounds.position = node_positions[0];
 	for (uint32_t node_index = 0; node_index < nodes_count; ++node_index) {
-		const Node &node = nodes[node_index];
-		if (!prev_bounds.has_point(node.x)) {
+		const Vector3 &position = node_positions[node_index];
+		if (!prev_bounds.has_point(position)) {
 			moved = true;
 		}
-		if (first) {
-			bounds.position = node.x;
-			first = false;
-		} else {
-			bounds.expand_to(node.x);
-		}
+		bounds.expand_to(position);
+	}
+
+	return moved;
+}
+
+void GodotSoftBody3D::update_bounds() {
+	bounds_moved = compute_bounds();
+	update_shape();
+}
+
+void GodotSoftBody3D::update_shape() {
+	if (nodes.is_empty()) {
+		deinitialize_shape();
+		return;
 	}
 
 	if (get_space()) {
-		initialize_shape(moved);
+		initialize_shape(bounds_moved);
 	}
 }
 
@@ -229,9 +239,9 @@ void GodotSoftBody3D::update_area() {
 
 	// Face area.
 	for (Face &face : faces) {
-		const Vector3 &x0 = face.n[0]->x;
-		const Vector3 &x1 = face.n[1]->x;
-		const Vector3 &x2 = face.n[2]->x;
+		const Vector3 &x0 = node_positions[face.n[0]];
+		const Vector3 &x1 = node_positions[face.n[1]];
+		const Vector3 &x2 = node_positions[face.n[2]];
 
 		const Vector3 a = x1 - x0;
 		const Vector3 b = x2 - x0;
@@ -252,9 +262,8 @@ void GodotSoftBody3D::update_area() {
 
 	for (const Face &face : faces) {
 		for (int j = 0; j < 3; ++j) {
-			const int index = (int)(face.n[j] - &nodes[0]);
-			counts[index]++;
-			face.n[j]->area += Math::abs(face.ra);
+			counts[face.n[j]]++;
+			nodes[face.n[j]].area += Math::abs(face.ra);
 		}
 	}
 
@@ -269,7 +278,7 @@ void GodotSoftBody3D::update_area() {
 
 void GodotSoftBody3D::reset_link_rest_lengths() {
 	for (Link &link : links) {
-		link.rl = (link.n[0]->x - link.n[1]->x).length();
+		link.rl = (node_positions[link.n[0]] - node_positions[link.n[1]]).length();
 		link.c1 = link.rl * link.rl;
 	}
 }
@@ -277,10 +286,20 @@ void GodotSoftBody3D::reset_link_rest_lengths() {
 void GodotSoftBody3D::update_link_constants() {
 	real_t inv_linear_stiffness = 1.0 / linear_stiffness;
 	for (Link &link : links) {
-		link.c0 = (link.n[0]->im + link.n[1]->im) * inv_linear_stiffness;
+		link.c0 = (node_inv_masses[link.n[0]] + node_inv_masses[link.n[1]]) * inv_linear_stiffness;
 	}
 }
 
+void GodotSoftBody3D::resize_nodes(uint32_t p_node_count) {
+	nodes.resize(p_node_count);
+	node_positions.resize(p_node_count);
+	node_previous_positions.resize(p_node_count);
+	node_forces.resize(p_node_count);
+	node_velocities.resize(p_node_count);
+	node_biased_velocities.resize(p_node_count);
+	node_inv_masses.resize(p_node_count);
+}
+
 void GodotSoftBody3D::apply_nodes_transform(const Transform3D &p_transform) {
 	if (soft_mesh.is_null()) {
 		return;
@@ -289,15 +308,15 @@ void GodotSoftBody3D::apply_nodes_transform(const Transform3D &p_transform) {
 	uint32_t node_count = nodes.size();
 	Vector3 leaf_size = Vector3(collision_margin, collision_margin, collision_margin) * 2.0;
 	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
-		Node &node = nodes[node_index];
+		Vector3 &position = node_positions[node_index];
 
-		node.x = p_transform.xform(node.x);
-		node.q = node.x;
-		node.v = Vector3();
-		node.bv = Vector3();
+		position = p_transform.xform(position);
+		node_previous_positions[node_index] = position;
+		node_velocities[node_index] = Vector3();
+		node_biased_velocities[node_index] = Vector3();
 
-		AABB node_aabb(node.x, leaf_size);
-		node_tree.update(node.leaf, node_aabb);
+		AABB node_aabb(position, leaf_size);
+		node_tree.update(nodes[node_index].leaf, node_aabb);
 	}
 
 	face_tree.clear();
@@ -318,7 +337,7 @@ Vector3 GodotSoftBody3D::get_vertex_position(int p_index) const {
 	uint32_t node_index = map_visual_to_physics[p_index];
 
 	ERR_FAIL_COND_V(node_index >= nodes.size(), Vector3());
-	return nodes[node_index].x;
+	return node_positions[node_index];
 }
 
 void GodotSoftBody3D::set_vertex_position(int p_index, const Vector3 &p_position) {
@@ -332,9 +351,8 @@ void GodotSoftBody3D::set_vertex_position(int p_index, const Vector3 &p_position
 	uint32_t node_index = map_visual_to_physics[p_index];
 
 	ERR_FAIL_COND(node_index >= nodes.size());
-	Node &node = nodes[node_index];
-	node.q = node.x;
-	node.x = p_position;
+	node_previous_positions[node_index] = node_positions[node_index];
+	node_positions[node_index] = p_position;
 }
 
 void GodotSoftBody3D::pin_vertex(int p_index) {
@@ -351,8 +369,7 @@ void GodotSoftBody3D::pin_vertex(int p_index) {
 		uint32_t node_index = map_visual_to_physics[p_index];
 
 		ERR_FAIL_COND(node_index >= nodes.size());
-		Node &node = nodes[node_index];
-		node.im = 0.0;
+		node_inv_masses[node_index] = 0.0;
 	}
 }
 
@@ -369,10 +386,7 @@ void GodotSoftBody3D::unpin_vertex(int p_index) {
 				uint32_t node_index = map_visual_to_physics[p_index];
 
 				ERR_FAIL_COND(node_index >= nodes.size());
-				real_t inv_node_mass = nodes.size() * inv_total_mass;
-
-				Node &node = nodes[node_index];
-				node.im = inv_node_mass;
+				node_inv_masses[node_index] = nodes.size() * inv_total_mass;
 			}
 
 			return;
@@ -391,8 +405,7 @@ void GodotSoftBody3D::unpin_all_vertices() {
 			uint32_t node_index = map_visual_to_physics[pinned_vertex];
 
 			ERR_CONTINUE(node_index >= nodes.size());
-			Node &node = nodes[node_index];
-			node.im = inv_node_mass;
+			node_inv_masses[node_index] = inv_node_mass;
 		}
 	}
 
@@ -418,34 +431,32 @@ uint32_t GodotSoftBody3D::get_node_count() const {
 
 real_t GodotSoftBody3D::get_node_inv_mass(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), 0.0);
-	return nodes[p_node_index].im;
+	return node_inv_masses[p_node_index];
 }
 
 Vector3 GodotSoftBody3D::get_node_position(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), Vector3());
-	return nodes[p_node_index].x;
+	return node_positions[p_node_index];
 }
 
 Vector3 GodotSoftBody3D::get_node_velocity(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), Vector3());
-	return nodes[p_node_index].v;
+	return node_velocities[p_node_index];
 }
 
 Vector3 GodotSoftBody3D::get_node_biased_velocity(uint32_t p_node_index) const {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_node_index, nodes.size(), Vector3());
-	return nodes[p_node_index].bv;
+	return node_biased_velocities[p_node_index];
 }
 
 void GodotSoftBody3D::apply_node_impulse(uint32_t p_node_index, const Vector3 &p_impulse) {
 	ERR_FAIL_UNSIGNED_INDEX(p_node_index, nodes.size());
-	Node &node = nodes[p_node_index];
-	node.v += p_impulse * node.im;
+	node_velocities[p_node_index] += p_impulse * node_inv_masses[p_node_index];
 }
 
 void GodotSoftBody3D::apply_node_bias_impulse(uint32_t p_node_index, const Vector3 &p_impulse) {
 	ERR_FAIL_UNSIGNED_INDEX(p_node_index, nodes.size());
-	Node &node = nodes[p_node_index];
-	node.bv += p_impulse * node.im;
+	node_biased_velocities[p_node_index] += p_impulse * node_inv_masses[p_node_index];
 }
 
 uint32_t GodotSoftBody3D::get_face_count() const {
@@ -455,9 +466,9 @@ uint32_t GodotSoftBody3D::get_face_count() const {
 void GodotSoftBody3D::get_face_points(uint32_t p_face_index, Vector3 &r_point_1, Vector3 &r_point_2, Vector3 &r_point_3) const {
 	ERR_FAIL_UNSIGNED_INDEX(p_face_index, faces.size());
 	const Face &face = faces[p_face_index];
-	r_point_1 = face.n[0]->x;
-	r_point_2 = face.n[1]->x;
-	r_point_3 = face.n[2]->x;
+	r_point_1 = node_positions[face.n[0]];
+	r_point_2 = node_positions[face.n[1]];
+	r_point_3 = node_positions[face.n[2]];
 }
 
 Vector3 GodotSoftBody3D::get_face_normal(uint32_t p_face_index) const {
@@ -524,17 +535,17 @@ bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Ve
 	++node_count;
 
 	// Create nodes from vertices.
-	nodes.resize(node_count);
+	resize_nodes(node_count);
 	real_t inv_node_mass = node_count * inv_total_mass;
 	Vector3 leaf_size = Vector3(collision_margin, collision_margin, collision_margin) * 2.0;
 	for (uint32_t i = 0; i < node_count; ++i) {
 		Node &node = nodes[i];
 		node.s = vertices[i];
-		node.x = node.s;
-		node.q = node.s;
-		node.im = inv_node_mass;
+		node_positions[i] = node.s;
+		node_previous_positions[i] = node.s;
+		node_inv_masses[i] = inv_node_mass;
 
-		AABB node_aabb(node.x, leaf_size);
+		AABB node_aabb(node.s, leaf_size);
 		node.leaf = node_tree.insert(node_aabb, &node);
 
 		node.index = i;
@@ -571,8 +582,7 @@ bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Ve
 		uint32_t node_index = map_visual_to_physics[pinned_vertex];
 
 		ERR_CONTINUE(node_index >= node_count);
-		Node &node = nodes[node_index];
-		node.im = 0.0;
+		node_inv_masses[node_index] = 0.0;
 	}
 
 	generate_bending_constraints(2);
@@ -608,8 +618,8 @@ void GodotSoftBody3D::generate_bending_constraints(int p_distance) {
 			}
 		}
 		for (Link &link : links) {
-			const int ia = (int)(link.n[0] - &nodes[0]);
-			const int ib = (int)(link.n[1] - &nodes[0]);
+			const int ia = link.n[0];
+			const int ib = link.n[1];
 			int idx = ib * n + ia;
 			int idx_inv = ia * n + ib;
 			adj[idx] = 1;
@@ -624,8 +634,8 @@ void GodotSoftBody3D::generate_bending_constraints(int p_distance) {
 			node_links.resize(nodes.size());
 
 			for (Link &link : links) {
-				const int ia = (int)(link.n[0] - &nodes[0]);
-				const int ib = (int)(link.n[1] - &nodes[0]);
+				const int ia = link.n[0];
+				const int ib = link.n[1];
 				if (node_links[ia].find(ib) == -1) {
 					node_links[ia].push_back(ib);
 				}
@@ -719,8 +729,6 @@ void GodotSoftBody3D::reoptimize_link_order() {
 	uint32_t i;
 	Link *lr;
 	int ar, br;
-	Node *node0 = &(nodes[0]);
-	Node *node1 = &(nodes[1]);
 	LinkDepsPtr link_dep;
 	int ready_list_head, ready_list_tail, link_num, link_dep_frees, dep_link;
 
@@ -749,8 +757,8 @@ void GodotSoftBody3D::reoptimize_link_order() {
 	for (i = 0; i < link_count; i++) {
 		// Note which prior link calculations we are dependent upon & build up dependence lists.
 		lr = &(links[i]);
-		ar = (lr->n[0] - node0) / (node1 - node0);
-		br = (lr->n[1] - node0) / (node1 - node0);
+		ar = lr->n[0];
+		br = lr->n[1];
 		if (node_written_at[ar] > reop_not_dependent) {
 			link_dep_A[i] = node_written_at[ar];
 			link_dep = &link_dep_free_list[link_dep_frees++];
@@ -826,13 +834,10 @@ void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
 		return;
 	}
 
-	Node *node1 = &nodes[p_node1];
-	Node *node2 = &nodes[p_node2];
-
 	Link link;
-	link.n[0] = node1;
-	link.n[1] = node2;
-	link.rl = (node1->x - node2->x).length();
+	link.n[0] = p_node1;
+	link.n[1] = p_node2;
+	link.rl = (node_positions[p_node1] - node_positions[p_node2]).length();
 
 	links.push_back(link);
 }
@@ -848,14 +853,10 @@ void GodotSoftBody3D::append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p
 		return;
 	}
 
-	Node *node1 = &nodes[p_node1];
-	Node *node2 = &nodes[p_node2];
-	Node *node3 = &nodes[p_node3];
-
 	Face face;
-	face.n[0] = node1;
-	face.n[1] = node2;
-	face.n[2] = node3;
+	face.n[0] = p_node1;
+	face.n[1] = p_node2;
+	face.n[2] = p_node3;
 
 	face.index = faces.size();
 
@@ -873,10 +874,8 @@ void GodotSoftBody3D::set_total_mass(real_t p_val) {
 	real_t mass_factor = total_mass * inv_total_mass;
 	total_mass = p_val;
 
-	uint32_t node_count = nodes.size();
-	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
-		Node &node = nodes[node_index];
-		node.im *= mass_factor;
+	for (real_t &inv_mass : node_inv_masses) {
+		inv_mass *= mass_factor;
 	}
 
 	update_constants();
@@ -903,9 +902,10 @@ void GodotSoftBody3D::set_drag_coefficient(real_t p_val) {
 }
 
 void GodotSoftBody3D::add_velocity(const Vector3 &p_velocity) {
-	for (Node &node : nodes) {
-		if (node.im > 0) {
-			node.v += p_velocity;
+	const uint32_t node_count = nodes.size();
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		if (node_inv_masses[node_index] > 0) {
+			node_velocities[node_index] += p_velocity;
 		}
 	}
 }
@@ -918,14 +918,14 @@ void GodotSoftBody3D::apply_forces(const LocalVector<GodotArea3D *> &p_wind_area
 	int32_t j;
 
 	real_t volume = 0.0;
-	const Vector3 &org = nodes[0].x;
+	const Vector3 &org = node_positions[0];
 
 	// Iterate over faces (try not to iterate elsewhere if possible).
 	for (const Face &face : faces) {
 		Vector3 wind_force(0, 0, 0);
 
 		// Compute volume.
-		volume += vec3_dot(face.n[0]->x - org, vec3_cross(face.n[1]->x - org, face.n[2]->x - org));
+		volume += vec3_dot(node_positions[face.n[0]] - org, vec3_cross(node_positions[face.n[1]] - org, node_positions[face.n[2]] - org));
 
 		// Compute nodal forces from area winds.
 		if (!p_wind_areas.is_empty()) {
@@ -934,8 +934,7 @@ void GodotSoftBody3D::apply_forces(const LocalVector<GodotArea3D *> &p_wind_area
 			}
 
 			for (j = 0; j < 3; j++) {
-				Node *current_node = face.n[j];
-				current_node->f += wind_force;
+				node_forces[face.n[j]] += wind_force;
 			}
 		}
 	}
@@ -944,9 +943,11 @@ void GodotSoftBody3D::apply_forces(const LocalVector<GodotArea3D *> &p_wind_area
 	// Apply nodal pressure forces.
 	if (pressure_coefficient > CMP_EPSILON) {
 		real_t ivolumetp = 1.0 / Math::abs(volume) * pressure_coefficient;
-		for (Node &node : nodes) {
-			if (node.im > 0) {
-				node.f += node.n * (node.area * ivolumetp);
+		const uint32_t node_count = nodes.size();
+		for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+			if (node_inv_masses[node_index] > 0) {
+				const Node &node = nodes[node_index];
+				node_forces[node_index] += node.n * (node.area * ivolumetp);
 			}
 		}
 	}
@@ -1029,27 +1030,34 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	real_t clamp_delta_v = max_displacement * inv_delta;
 
 	// Integrate.
-	for (Node &node : nodes) {
-		node.q = node.x;
-		Vector3 delta_v = node.f * node.im * p_delta;
-		for (int c = 0; c < 3; c++) {
-			delta_v[c] = CLAMP(delta_v[c], -clamp_delta_v, clamp_delta_v);
-		}
-		node.v += delta_v;
-		node.x += node.v * p_delta;
-		node.f = Vector3();
+	const uint32_t node_count = nodes.size();
+	Vector3 *positions = node_positions.ptr();
+	Vector3 *previous_positions = node_previous_positions.ptr();
+	Vector3 *velocities = node_velocities.ptr();
+	Vector3 *forces = node_forces.ptr();
+	const real_t *inv_masses = node_inv_masses.ptr();
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		previous_positions[node_index] = positions[node_index];
+		const real_t scale = inv_masses[node_index] * p_delta;
+		Vector3 &velocity = velocities[node_index];
+		velocity.x += CLAMP(forces[node_index].x * scale, -clamp_delta_v, clamp_delta_v);
+		velocity.y += CLAMP(forces[node_index].y * scale, -clamp_delta_v, clamp_delta_v);
+		velocity.z += CLAMP(forces[node_index].z * scale, -clamp_delta_v, clamp_delta_v);
+		positions[node_index] += velocity * p_delta;
+		forces[node_index] = Vector3();
 	}
 
-	// Bounds and tree update.
-	update_bounds();
+	// Bounds update, the shape is updated by `update_shape()`.
+	bounds_moved = compute_bounds();
 
 	// Node tree update.
-	for (const Node &node : nodes) {
-		AABB node_aabb(node.x, Vector3());
-		node_aabb.expand_to(node.x + node.v * p_delta);
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		const Vector3 &position = positions[node_index];
+		AABB node_aabb(position, Vector3());
+		node_aabb.expand_to(position + velocities[node_index] * p_delta);
 		node_aabb.grow_by(collision_margin);
 
-		node_tree.update(node.leaf, node_aabb);
+		node_tree.update(nodes[node_index].leaf, node_aabb);
 	}
 
 	// Face tree update.
@@ -1065,14 +1073,15 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 	const real_t inv_delta = 1.0 / p_delta;
 
-	for (Link &link : links) {
-		link.c3 = link.n[1]->q - link.n[0]->q;
-		link.c2 = 1 / (link.c3.length_squared() * link.c0);
-	}
+	const uint32_t node_count = nodes.size();
+	Vector3 *positions = node_positions.ptr();
+	Vector3 *previous_positions = node_previous_positions.ptr();
+	Vector3 *velocities = node_velocities.ptr();
+	Vector3 *biased_velocities = node_biased_velocities.ptr();
 
 	// Solve velocities.
-	for (Node &node : nodes) {
-		node.x = node.q + node.v * p_delta;
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		positions[node_index] = previous_positions[node_index] + velocities[node_index] * p_delta;
 	}
 
 	// Solve positions.
@@ -1081,29 +1090,30 @@ void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 		solve_links(1.0, ti);
 	}
 	const real_t vc = (1.0 - damping_coefficient) * inv_delta;
-	for (Node &node : nodes) {
-		node.x += node.bv * p_delta;
-		node.bv = Vector3();
-
-		node.v = (node.x - node.q) * vc;
-
-		node.q = node.x;
+	for (uint32_t node_index = 0; node_index < node_count; ++node_index) {
+		const Vector3 position = positions[node_index] + biased_velocities[node_index] * p_delta;
+		velocities[node_index] = (position - previous_positions[node_index]) * vc;
+		positions[node_index] = position;
+		previous_positions[node_index] = position;
+		biased_velocities[node_index] = Vector3();
 	}
 
 	update_normals_and_centroids();
 }
 
 void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
-	for (Link &link : links) {
+	Vector3 *positions = node_positions.ptr();
+	const real_t *inv_masses = node_inv_masses.ptr();
+	for (const Link &link : links) {
 		if (link.c0 > 0) {
-			Node &node_a = *link.n[0];
-			Node &node_b = *link.n[1];
-			const Vector3 del = node_b.x - node_a.x;
+			Vector3 &position_a = positions[link.n[0]];
+			Vector3 &position_b = positions[link.n[1]];
+			const Vector3 del = position_b - position_a;
 			const real_t len = del.length_squared();
 			if (link.c1 + len > CMP_EPSILON) {
 				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * kst;
-				node_a.x -= del * (k * node_a.im);
-				node_b.x += del * (k * node_b.im);
+				position_a -= del * (k * inv_masses[link.n[0]]);
+				position_b += del * (k * inv_masses[link.n[1]]);
 			}
 		}
 	}
@@ -1139,9 +1149,7 @@ struct RayQueryResult {
 };
 
 void GodotSoftBody3D::query_ray(const Vector3 &p_from, const Vector3 &p_to, GodotSoftBody3D::QueryResultCallback p_result_callback, void *p_userdata) {
-	if (face_tree.is_empty()) {
-		initialize_face_tree();
-	}
+	initialize_face_tree_if_needed();
 
 	RayQueryResult query_result;
 	query_result.soft_body = this;
@@ -1151,14 +1159,20 @@ void GodotSoftBody3D::query_ray(const Vector3 &p_from, const Vector3 &p_to, Godo
 	face_tree.ray_query(p_from, p_to, query_result);
 }
 
+void GodotSoftBody3D::initialize_face_tree_if_needed() {
+	if (face_tree.is_empty()) {
+		initialize_face_tree();
+	}
+}
+
 void GodotSoftBody3D::initialize_face_tree() {
 	face_tree.clear();
 	for (Face &face : faces) {
 		AABB face_aabb;
 
-		face_aabb.position = face.n[0]->x;
-		face_aabb.expand_to(face.n[1]->x);
-		face_aabb.expand_to(face.n[2]->x);
+		face_aabb.position = node_positions[face.n[0]];
+		face_aabb.expand_to(node_positions[face.n[1]]);
+		face_aabb.expand_to(node_positions[face.n[2]]);
 
 		face_aabb.grow_by(collision_margin);
 
@@ -1170,17 +1184,17 @@ void GodotSoftBody3D::update_face_tree(real_t p_delta) {
 	for (const Face &face : faces) {
 		AABB face_aabb;
 
-		const Node *node0 = face.n[0];
-		face_aabb.position = node0->x;
-		face_aabb.expand_to(node0->x + node0->v * p_delta);
+		const uint32_t node0 = face.n[0];
+		face_aabb.position = node_positions[node0];
+		face_aabb.expand_to(node_positions[node0] + node_velocities[node0] * p_delta);
 
-		const Node *node1 = face.n[1];
-		face_aabb.expand_to(node1->x);
-		face_aabb.expand_to(node1->x + node1->v * p_delta);
+		const uint32_t node1 = face.n[1];
+		face_aabb.expand_to(node_positions[node1]);
+		face_aabb.expand_to(node_positions[node1] + node_velocities[node1] * p_delta);
 
-		const Node *node2 = face.n[2];
-		face_aabb.expand_to(node2->x);
-		face_aabb.expand_to(node2->x + node2->v * p_delta);
+		const uint32_t node2 = face.n[2];
+		face_aabb.expand_to(node_positions[node2]);
+		face_aabb.expand_to(node_positions[node2] + node_velocities[node2] * p_delta);
 
 		face_aabb.grow_by(collision_margin);
 
@@ -1214,7 +1228,7 @@ void GodotSoftBody3D::destroy() {
 	node_tree.clear();
 	face_tree.clear();
 
-	nodes.clear();
+	resize_nodes(0);
 	links.clear();
 	faces.clear();
 
@@ -46,32 +46,26 @@ class GodotConstraint3D;
 class GodotSoftBody3D : public GodotCollisionObject3D {
 	RID soft_mesh;
 
+	// The node data used by every step is stored in one array per field rather than in `Node`,
+	// so the integration loops stream through contiguous memory and can be vectorized.
 	struct Node {
 		Vector3 s; // Source position
-		Vector3 x; // Position
-		Vector3 q; // Previous step position/Test position
-		Vector3 f; // Force accumulator
-		Vector3 v; // Velocity
-		Vector3 bv; // Biased Velocity
 		Vector3 n; // Normal
 		real_t area = 0.0; // Area
-		real_t im = 0.0; // 1/mass
 		DynamicBVH::ID leaf; // Leaf data
 		uint32_t index = 0;
 	};
 
 	struct Link {
-		Vector3 c3; // gradient
-		Node *n[2] = { nullptr, nullptr }; // Node pointers
+		uint32_t n[2] = { 0, 0 }; // Node indices
 		real_t rl = 0.0; // Rest length
 		real_t c0 = 0.0; // (ima+imb)*kLST
 		real_t c1 = 0.0; // rl^2
-		real_t c2 = 0.0; // |gradient|^2/c0
 	};
 
 	struct Face {
 		Vector3 centroid;
-		Node *n[3] = { nullptr, nullptr, nullptr }; // Node pointers
+		uint32_t n[3] = { 0, 0, 0 }; // Node indices
 		Vector3 normal; // Normal
 		real_t ra = 0.0; // Rest area
 		DynamicBVH::ID leaf; // Leaf data
@@ -79,6 +73,12 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 	};
 
 	LocalVector<Node> nodes;
+	LocalVector<Vector3> node_positions; // x
+	LocalVector<Vector3> node_previous_positions; // q, previous step position/test position
+	LocalVector<Vector3> node_forces; // f, force accumulator
+	LocalVector<Vector3> node_velocities; // v
+	LocalVector<Vector3> node_biased_velocities; // bv
+	LocalVector<real_t> node_inv_masses; // im, 1/mass
 	LocalVector<Link> links;
 	LocalVector<Face> faces;
 
@@ -101,6 +101,9 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 	real_t drag_coefficient = 0.0; // [0,1]
 	LocalVector<int> pinned_vertices;
 
+	// Whether the nodes left the bounds grown by the margin, during the last `predict_motion()`.
+	bool bounds_moved = false;
+
 	SelfList<GodotSoftBody3D> active_list;
 
 	HashSet<GodotConstraint3D *> constraints;
@@ -201,7 +204,10 @@ public:
 	void set_drag_coefficient(real_t p_val);
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
+	// `predict_motion()` and `solve_constraints()` only access the data of this body, so several soft bodies can run them at the same time.
+	// `update_shape()` must be called after `predict_motion()`, on the thread that steps the space.
 	void predict_motion(real_t p_delta);
+	void update_shape();
 	void solve_constraints(real_t p_delta);
 
 	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
@@ -213,12 +219,15 @@ public:
 
 	void query_aabb(const AABB &p_aabb, QueryResultCallback p_result_callback, void *p_userdata);
 	void query_ray(const Vector3 &p_from, const Vector3 &p_to, QueryResultCallback p_result_callback, void *p_userdata);
+	// The face tree is built by the first ray query, this builds it beforehand when ray queries are about to run on several threads.
+	void initialize_face_tree_if_needed();
 
 protected:
 	virtual void _shapes_changed() override;
 
 private:
 	void update_normals_and_centroids();
+	bool compute_bounds();
 	void update_bounds();
 	void update_constants();
 	void update_area();
@@ -237,6 +246,8 @@ private:
 	void append_link(uint32_t p_node1, uint32_t p_node2);
 	void append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3);
 
+	void resize_nodes(uint32_t p_node_count);
+
 	void solve_links(real_t kst, real_t ti);
 
 	void initialize_face_tree();
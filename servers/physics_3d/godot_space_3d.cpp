@@ -34,6 +34,8 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
@@ -108,13 +110,20 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
 	ERR_FAIL_COND_V(space->locked, false);
 
+	CullBuffers cull;
+	cull.results = space->intersection_query_results;
+	cull.subindex_results = space->intersection_query_subindex_results;
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, r_result, cull);
+}
+
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const CullBuffers &p_cull) const {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_segment(begin, end, p_cull.results, GodotSpace3D::INTERSECTION_QUERY_MAX, p_cull.subindex_results, p_cull.hits);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -126,21 +135,21 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(p_cull.results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(p_cull.results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_cull.results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = p_cull.results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_cull.subindex_results[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -213,9 +222,16 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, 0);
 
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+	CullBuffers cull;
+	cull.results = space->intersection_query_results;
+	cull.subindex_results = space->intersection_query_subindex_results;
+	return _intersect_shape(p_parameters, shape, p_parameters.transform, r_results, p_result_max, cull);
+}
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+int GodotPhysicsDirectSpaceState3D::_intersect_shape(const ShapeParameters &p_parameters, const GodotShape3D *p_shape, const Transform3D &p_transform, ShapeResult *r_results, int p_result_max, const CullBuffers &p_cull) const {
+	AABB aabb = p_transform.xform(p_shape->get_aabb());
+
+	int amount = space->broadphase->cull_aabb(aabb, p_cull.results, GodotSpace3D::INTERSECTION_QUERY_MAX, p_cull.subindex_results, p_cull.hits);
 
 	int cc = 0;
 
@@ -226,20 +242,20 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(p_cull.results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
 		//area can't be picked by ray (default)
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_cull.results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = p_cull.results[i];
+		int shape_idx = p_cull.subindex_results[i];
 
-		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+		if (!GodotCollisionSolver3D::solve_static(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
 			continue;
 		}
 
@@ -260,6 +276,108 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
+void GodotPhysicsDirectSpaceState3D::_intersect_rays_chunk(uint32_t p_chunk, RayBatch *p_batch) {
+	LocalVector<GodotCollisionObject3D *> cull_results;
+	LocalVector<int> cull_subindex_results;
+	GodotBroadPhase3D::CullHits cull_hits;
+	cull_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	cull_subindex_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	CullBuffers cull;
+	cull.results = cull_results.ptr();
+	cull.subindex_results = cull_subindex_results.ptr();
+	cull.hits = &cull_hits;
+
+	const int end = MIN(p_batch->ray_count, (int)(p_chunk + 1) * BATCH_CHUNK_SIZE);
+	for (int i = p_chunk * BATCH_CHUNK_SIZE; i < end; i++) {
+		p_batch->hits[i] = _intersect_ray(*p_batch->parameters, p_batch->from[i], p_batch->to[i], p_batch->results[i], cull);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+
+	if (p_ray_count <= 0) {
+		return;
+	}
+
+	// The face trees of the soft bodies are built by their first ray query, it can't happen on several threads at once.
+	for (const SelfList<GodotSoftBody3D> *sb = space->get_active_soft_body_list().first(); sb; sb = sb->next()) {
+		sb->self()->initialize_face_tree_if_needed();
+	}
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.ray_count = p_ray_count;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	const uint32_t chunk_count = (p_ray_count + BATCH_CHUNK_SIZE - 1) / BATCH_CHUNK_SIZE;
+	if (chunk_count == 1) {
+		_intersect_rays_chunk(0, &batch);
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_rays_chunk, &batch, chunk_count, -1, true, SNAME("Physics3DIntersectRays"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_shapes_chunk(uint32_t p_chunk, ShapeBatch *p_batch) {
+	LocalVector<GodotCollisionObject3D *> cull_results;
+	LocalVector<int> cull_subindex_results;
+	GodotBroadPhase3D::CullHits cull_hits;
+	cull_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	cull_subindex_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	CullBuffers cull;
+	cull.results = cull_results.ptr();
+	cull.subindex_results = cull_subindex_results.ptr();
+	cull.hits = &cull_hits;
+
+	const int end = MIN(p_batch->shape_count, (int)(p_chunk + 1) * BATCH_CHUNK_SIZE);
+	for (int i = p_chunk * BATCH_CHUNK_SIZE; i < end; i++) {
+		p_batch->result_counts[i] = _intersect_shape(*p_batch->parameters, p_batch->shape, p_batch->transforms[i], p_batch->results + i * p_batch->result_max, p_batch->result_max, cull);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_shape_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	ERR_FAIL_COND(space->locked);
+
+	if (p_shape_count <= 0) {
+		return;
+	}
+
+	for (int i = 0; i < p_shape_count; i++) {
+		r_result_counts[i] = 0;
+	}
+	if (p_result_max <= 0) {
+		return;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	ShapeBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.shape_count = p_shape_count;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+
+	const uint32_t chunk_count = (p_shape_count + BATCH_CHUNK_SIZE - 1) / BATCH_CHUNK_SIZE;
+	if (chunk_count == 1) {
+		_intersect_shapes_chunk(0, &batch);
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_shapes_chunk, &batch, chunk_count, -1, true, SNAME("Physics3DIntersectShapes"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
@@ -1039,6 +1157,13 @@ void *GodotSpace3D::_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A
 
 	GodotSpace3D *self = static_cast<GodotSpace3D *>(p_self);
 
+	// The broadphase passes objects in the order of their handles, which follows the order they were added.
+	// Contacts are solved from A's side, so deterministic spaces put the lower RID first instead.
+	if (type_A == type_B && self->is_deterministic() && B->get_self() < A->get_self()) {
+		SWAP(A, B);
+		SWAP(p_subindex_A, p_subindex_B);
+	}
+
 	self->collision_pairs++;
 
 	if (type_A == GodotCollisionObject3D::TYPE_AREA) {
@@ -1237,6 +1362,197 @@ real_t GodotSpace3D::get_param(PhysicsServer3D::SpaceParameter p_param) const {
 	return 0;
 }
 
+void GodotSpace3D::_get_snapshot_bodies(LocalVector<GodotBody3D *> &r_bodies) const {
+	r_bodies.clear();
+	for (GodotCollisionObject3D *object : objects) {
+		if (object->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		GodotBody3D *body = static_cast<GodotBody3D *>(object);
+		if (body->get_mode() >= PhysicsServer3D::BODY_MODE_RIGID) {
+			r_bodies.push_back(body);
+		}
+	}
+	r_bodies.sort_custom<GodotCollisionObject3D::SelfComparator>();
+}
+
+void GodotSpace3D::_get_snapshot_constraints(const LocalVector<GodotBody3D *> &p_bodies, LocalVector<GodotConstraint3D *> &r_constraints) const {
+	HashSet<GodotConstraint3D *> constraints;
+	for (const GodotBody3D *body : p_bodies) {
+		for (const KeyValue<GodotConstraint3D *, int> &E : body->get_constraint_map()) {
+			constraints.insert(E.key);
+		}
+	}
+
+	r_constraints.clear();
+	for (GodotConstraint3D *constraint : constraints) {
+		r_constraints.push_back(constraint);
+	}
+	r_constraints.sort_custom<GodotConstraint3D::SortKeyComparator>();
+}
+
+static uint8_t *_encode_snapshot_entry(const GodotConstraint3D::SortKey &p_key, const LocalVector<real_t> &p_values, uint8_t *r_buffer) {
+	r_buffer += encode_uint64(p_key.ids[0], r_buffer);
+	r_buffer += encode_uint64(p_key.ids[1], r_buffer);
+	r_buffer += encode_uint32(p_key.shapes[0], r_buffer);
+	r_buffer += encode_uint32(p_key.shapes[1], r_buffer);
+	r_buffer += encode_uint64(p_key.id, r_buffer);
+	r_buffer += encode_uint32(p_values.size(), r_buffer);
+	for (const real_t value : p_values) {
+		r_buffer += encode_real(value, r_buffer);
+	}
+	return r_buffer;
+}
+
+// Returns nullptr if the entries don't fit in the buffer.
+static const uint8_t *_decode_snapshot_entries(const uint8_t *p_buffer, const uint8_t *p_end, LocalVector<GodotConstraint3D::SortKey> &r_keys, LocalVector<LocalVector<real_t>> &r_values) {
+	ERR_FAIL_COND_V(p_end - p_buffer < (int64_t)sizeof(uint32_t), nullptr);
+	uint32_t count = decode_uint32(p_buffer);
+	p_buffer += sizeof(uint32_t);
+
+	r_keys.resize(count);
+	r_values.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		ERR_FAIL_COND_V(p_end - p_buffer < (int64_t)(sizeof(uint64_t) * 3 + sizeof(uint32_t) * 3), nullptr);
+		GodotConstraint3D::SortKey &key = r_keys[i];
+		key.ids[0] = decode_uint64(p_buffer);
+		key.ids[1] = decode_uint64(p_buffer + 8);
+		key.shapes[0] = decode_uint32(p_buffer + 16);
+		key.shapes[1] = decode_uint32(p_buffer + 20);
+		key.id = decode_uint64(p_buffer + 24);
+		uint32_t size = decode_uint32(p_buffer + 32);
+		p_buffer += sizeof(uint64_t) * 3 + sizeof(uint32_t) * 3;
+
+		ERR_FAIL_COND_V((uint64_t)(p_end - p_buffer) < (uint64_t)size * sizeof(real_t), nullptr);
+		r_values[i].resize(size);
+		for (real_t &value : r_values[i]) {
+#ifdef REAL_T_IS_DOUBLE
+			value = decode_double(p_buffer);
+#else
+			value = decode_float(p_buffer);
+#endif
+			p_buffer += sizeof(real_t);
+		}
+	}
+	return p_buffer;
+}
+
+Vector<uint8_t> GodotSpace3D::get_snapshot() const {
+	ERR_FAIL_COND_V_MSG(locked, Vector<uint8_t>(), "Space snapshots can't be taken while the space is being stepped.");
+
+	LocalVector<GodotBody3D *> bodies;
+	_get_snapshot_bodies(bodies);
+
+	LocalVector<GodotConstraint3D *> constraints;
+	_get_snapshot_constraints(bodies, constraints);
+
+	// Bodies and constraints are both saved as a key and an array of values.
+	const uint32_t entry_size = sizeof(uint64_t) * 3 + sizeof(uint32_t) * 3;
+
+	LocalVector<LocalVector<real_t>> states;
+	states.resize(bodies.size());
+	uint32_t size = sizeof(uint32_t) * 4 + bodies.size() * entry_size;
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		bodies[i]->get_snapshot_state(states[i]);
+		size += states[i].size() * sizeof(real_t);
+	}
+
+	LocalVector<LocalVector<real_t>> caches;
+	caches.resize(constraints.size());
+	uint32_t cache_count = 0;
+	for (uint32_t i = 0; i < constraints.size(); i++) {
+		constraints[i]->get_cache(caches[i]);
+		if (!caches[i].is_empty()) {
+			cache_count++;
+			size += entry_size + caches[i].size() * sizeof(real_t);
+		}
+	}
+
+	Vector<uint8_t> snapshot;
+	snapshot.resize(size);
+	uint8_t *w = snapshot.ptrw();
+
+	w += encode_uint32(SNAPSHOT_VERSION, w);
+	w += encode_uint32(sizeof(real_t), w);
+
+	// In a stable order, so snapshots of the same state are identical.
+	w += encode_uint32(bodies.size(), w);
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		GodotConstraint3D::SortKey key;
+		key.ids[0] = bodies[i]->get_self().get_id();
+		w = _encode_snapshot_entry(key, states[i], w);
+	}
+
+	w += encode_uint32(cache_count, w);
+	for (uint32_t i = 0; i < constraints.size(); i++) {
+		if (!caches[i].is_empty()) {
+			w = _encode_snapshot_entry(constraints[i]->get_sort_key(), caches[i], w);
+		}
+	}
+
+	DEV_ASSERT(w == snapshot.ptrw() + snapshot.size());
+	return snapshot;
+}
+
+Error GodotSpace3D::restore_snapshot(const Vector<uint8_t> &p_snapshot) {
+	ERR_FAIL_COND_V_MSG(locked, ERR_LOCKED, "Space snapshots can't be restored while the space is being stepped.");
+
+	const uint8_t *r = p_snapshot.ptr();
+	const uint8_t *end = r + p_snapshot.size();
+
+	ERR_FAIL_COND_V_MSG(p_snapshot.size() < (int64_t)sizeof(uint32_t) * 3, ERR_INVALID_DATA, "Invalid space snapshot.");
+	ERR_FAIL_COND_V_MSG(decode_uint32(r) != SNAPSHOT_VERSION, ERR_INVALID_DATA, "Unsupported space snapshot version.");
+	ERR_FAIL_COND_V_MSG(decode_uint32(r + 4) != sizeof(real_t), ERR_INVALID_DATA, "The space snapshot was taken with a different floating-point precision.");
+
+	// Decoded fully before anything is changed, so an invalid snapshot leaves the space as it is.
+	LocalVector<GodotConstraint3D::SortKey> body_keys;
+	LocalVector<LocalVector<real_t>> states;
+	LocalVector<GodotConstraint3D::SortKey> cache_keys;
+	LocalVector<LocalVector<real_t>> caches;
+	r += sizeof(uint32_t) * 2;
+	r = _decode_snapshot_entries(r, end, body_keys, states);
+	ERR_FAIL_NULL_V_MSG(r, ERR_INVALID_DATA, "Invalid space snapshot.");
+	r = _decode_snapshot_entries(r, end, cache_keys, caches);
+	ERR_FAIL_COND_V_MSG(r != end, ERR_INVALID_DATA, "Invalid space snapshot.");
+
+	LocalVector<GodotBody3D *> bodies;
+	_get_snapshot_bodies(bodies);
+
+	// Both lists are sorted by RID. The bodies freed since are skipped, the ones created since are left as they are.
+	uint32_t body_index = 0;
+	for (uint32_t i = 0; i < body_keys.size(); i++) {
+		const uint64_t id = body_keys[i].ids[0];
+		while (body_index < bodies.size() && bodies[body_index]->get_self().get_id() < id) {
+			body_index++;
+		}
+		if (body_index < bodies.size() && bodies[body_index]->get_self().get_id() == id) {
+			bodies[body_index]->set_snapshot_state(states[i].ptr(), states[i].size());
+		}
+	}
+
+	// Pair the bodies at their restored bounds, so the contacts can be restored on their pairs.
+	update();
+
+	LocalVector<GodotConstraint3D *> constraints;
+	_get_snapshot_constraints(bodies, constraints);
+
+	// Constraints without contacts in the snapshot start from scratch, like new pairs would.
+	uint32_t cache_index = 0;
+	for (GodotConstraint3D *constraint : constraints) {
+		const GodotConstraint3D::SortKey key = constraint->get_sort_key();
+		while (cache_index < cache_keys.size() && cache_keys[cache_index] < key) {
+			cache_index++;
+		}
+		if (cache_index < cache_keys.size() && cache_keys[cache_index] == key) {
+			constraint->set_cache(caches[cache_index].ptr(), caches[cache_index].size());
+		} else {
+			constraint->set_cache(nullptr, 0);
+		}
+	}
+
+	return OK;
+}
+
 void GodotSpace3D::lock() {
 	locked = true;
 }
@@ -1262,10 +1578,15 @@ GodotSpace3D::GodotSpace3D() {
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/3d/solver/default_contact_bias");
+	deterministic = GLOBAL_GET("physics/3d/solver/deterministic");
 
 	broadphase = GodotBroadPhase3D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
 	broadphase->set_unpair_callback(_broadphase_unpair, this);
+	if (deterministic) {
+		// The pairs link bodies into islands, they must not depend on the previous steps for snapshots to be replayed exactly.
+		broadphase->set_pairing_expansion(0.0);
+	}
 
 	direct_access = memnew(GodotPhysicsDirectSpaceState3D);
 	direct_access->space = this;
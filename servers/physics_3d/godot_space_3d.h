@@ -46,6 +46,42 @@
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	enum {
+		// Queries of a batch made together by one task.
+		BATCH_CHUNK_SIZE = 64,
+	};
+
+	// Where the broadphase culls of a query store their results.
+	struct CullBuffers {
+		GodotCollisionObject3D **results = nullptr;
+		int *subindex_results = nullptr;
+		GodotBroadPhase3D::CullHits *hits = nullptr;
+	};
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		int ray_count = 0;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+	};
+
+	struct ShapeBatch {
+		const ShapeParameters *parameters = nullptr;
+		const GodotShape3D *shape = nullptr;
+		const Transform3D *transforms = nullptr;
+		int shape_count = 0;
+		ShapeResult *results = nullptr;
+		int result_max = 0;
+		int *result_counts = nullptr;
+	};
+
+	bool _intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const CullBuffers &p_cull) const;
+	int _intersect_shape(const ShapeParameters &p_parameters, const GodotShape3D *p_shape, const Transform3D &p_transform, ShapeResult *r_results, int p_result_max, const CullBuffers &p_cull) const;
+	void _intersect_rays_chunk(uint32_t p_chunk, RayBatch *p_batch);
+	void _intersect_shapes_chunk(uint32_t p_chunk, ShapeBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
@@ -55,6 +91,8 @@ public:
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_hits) override;
+	virtual void intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_shape_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
 
 	GodotPhysicsDirectSpaceState3D();
@@ -112,6 +150,7 @@ private:
 	real_t body_time_to_sleep = 0.0;
 
 	bool locked = false;
+	bool deterministic = false;
 
 	real_t last_step = 0.001;
 
@@ -128,6 +167,13 @@ private:
 
 	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb);
 
+	enum {
+		SNAPSHOT_VERSION = 1,
+	};
+
+	void _get_snapshot_bodies(LocalVector<GodotBody3D *> &r_bodies) const;
+	void _get_snapshot_constraints(const LocalVector<GodotBody3D *> &p_bodies, LocalVector<GodotConstraint3D *> &r_constraints) const;
+
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
@@ -177,6 +223,13 @@ public:
 	void lock();
 	void unlock();
 
+	// Islands and constraints are solved in an order that only depends on the RIDs of the objects.
+	bool is_deterministic() const { return deterministic; }
+
+	// The motion state of the rigid bodies and the contacts the next step starts from, to roll the space back.
+	Vector<uint8_t> get_snapshot() const;
+	Error restore_snapshot(const Vector<uint8_t> &p_snapshot);
+
 	real_t get_last_step() const { return last_step; }
 	void set_last_step(real_t p_step) { last_step = p_step; }
 
@@ -118,6 +118,11 @@ void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdat
 }
 
 void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
+	if (deterministic) {
+		// The island was gathered in the order of the constraint maps, which depends on the memory layout.
+		p_constraint_island.sort_custom<GodotConstraint3D::SortKeyComparator>();
+	}
+
 	uint32_t constraint_count = p_constraint_island.size();
 	uint32_t valid_constraint_count = 0;
 	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
@@ -179,9 +184,24 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 		if (active == can_sleep) {
 			body->set_active(!can_sleep);
 		}
+
+		if (can_sleep && body->get_mode() >= PhysicsServer3D::BODY_MODE_RIGID) {
+			// The residual motion below the thresholds isn't kept, the island doesn't drift when woken up.
+			// The contacts keep their impulses, so the island starts from its resting state.
+			body->set_linear_velocity(Vector3());
+			body->set_angular_velocity(Vector3());
+		}
 	}
 }
 
+void GodotStep3D::_predict_soft_body_motion(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->predict_motion(delta);
+}
+
+void GodotStep3D::_solve_soft_body_constraints(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->solve_constraints(delta);
+}
+
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
@@ -191,6 +211,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	iterations = p_space->get_solver_iterations();
 	delta = p_delta;
+	deterministic = p_space->is_deterministic();
 
 	const SelfList<GodotBody3D>::List *body_list = &p_space->get_active_body_list();
 
@@ -212,13 +233,23 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* UPDATE SOFT BODY MOTION */
 
+	active_soft_bodies.clear();
 	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
 	while (sb) {
-		sb->self()->predict_motion(p_delta);
+		active_soft_bodies.push_back(sb->self());
 		sb = sb->next();
 		active_count++;
 	}
 
+	// Soft bodies don't share any data while they move, each one is processed on its own thread.
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_predict_soft_body_motion, nullptr, active_soft_bodies.size(), -1, true, SNAME("Physics3DSoftBodyPredictMotion"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Warning: This doesn't run on threads, because it updates the broadphase.
+	for (GodotSoftBody3D *soft_body : active_soft_bodies) {
+		soft_body->update_shape();
+	}
+
 	p_space->set_active_objects(active_count);
 
 	// Update the broadphase to register collision pairs.
@@ -236,6 +267,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	const SelfList<GodotArea3D>::List &aml = p_space->get_moved_area_list();
 
+	area_constraints.clear();
 	while (aml.first()) {
 		for (GodotConstraint3D *E : aml.first()->self()->get_constraints()) {
 			GodotConstraint3D *constraint = E;
@@ -243,30 +275,47 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 				continue;
 			}
 			constraint->set_island_step(_step);
+			area_constraints.push_back(constraint);
+		}
+		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
+	}
 
-			// Each constraint can be on a separate island for areas as there's no solving phase.
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
+	if (deterministic) {
+		area_constraints.sort_custom<GodotConstraint3D::SortKeyComparator>();
+	}
 
-			all_constraints.push_back(constraint);
-			constraint_island.push_back(constraint);
+	for (GodotConstraint3D *constraint : area_constraints) {
+		// Each constraint can be on a separate island for areas as there's no solving phase.
+		++island_count;
+		if (constraint_islands.size() < island_count) {
+			constraint_islands.resize(island_count);
 		}
-		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
+		LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
+		constraint_island.clear();
+
+		all_constraints.push_back(constraint);
+		constraint_island.push_back(constraint);
 	}
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
+	// The broadphase update may have activated more bodies.
+	active_bodies.clear();
 	b = body_list->first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
 
-	uint32_t body_island_count = 0;
+	if (deterministic) {
+		// Islands are built from the bodies in the order of their RIDs rather than in the order they were activated,
+		// so islands, contact reports and sleeping happen in the same order on every run.
+		active_bodies.sort_custom<GodotCollisionObject3D::SelfComparator>();
+	}
 
-	while (b) {
-		GodotBody3D *body = b->self();
+	uint32_t body_island_count = 0;
 
+	for (GodotBody3D *body : active_bodies) {
 		if (body->get_island_step() != _step) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
@@ -294,15 +343,22 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 				--island_count;
 			}
 		}
-		b = b->next();
 	}
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
 
+	active_soft_bodies.clear();
 	sb = soft_body_list->first();
 	while (sb) {
-		GodotSoftBody3D *soft_body = sb->self();
+		active_soft_bodies.push_back(sb->self());
+		sb = sb->next();
+	}
 
+	if (deterministic) {
+		active_soft_bodies.sort_custom<GodotCollisionObject3D::SelfComparator>();
+	}
+
+	for (GodotSoftBody3D *soft_body : active_soft_bodies) {
 		if (soft_body->get_island_step() != _step) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
@@ -330,7 +386,6 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 				--island_count;
 			}
 		}
-		sb = sb->next();
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -344,7 +399,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -390,11 +445,8 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
 
-	sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->solve_constraints(p_delta);
-		sb = sb->next();
-	}
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_soft_body_constraints, nullptr, active_soft_bodies.size(), -1, true, SNAME("Physics3DSoftBodySolveConstraints"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -31,6 +31,7 @@
 #ifndef UTILITIES_DUMMY_H
 #define UTILITIES_DUMMY_H
 
+#include "light_storage.h"
 #include "material_storage.h"
 #include "mesh_storage.h"
 #include "servers/rendering/storage/utilities.h"
@@ -55,6 +56,8 @@ public:
 			return RS::INSTANCE_MESH;
 		} else if (RendererDummy::MeshStorage::get_singleton()->owns_multimesh(p_rid)) {
 			return RS::INSTANCE_MULTIMESH;
+		} else if (RendererDummy::LightStorage::get_singleton()->owns_light(p_rid)) {
+			return RS::INSTANCE_LIGHT;
 		}
 		return RS::INSTANCE_NONE;
 	}
@@ -69,6 +72,9 @@ public:
 		} else if (RendererDummy::MeshStorage::get_singleton()->owns_multimesh(p_rid)) {
 			RendererDummy::MeshStorage::get_singleton()->multimesh_free(p_rid);
 			return true;
+		} else if (RendererDummy::LightStorage::get_singleton()->owns_light(p_rid)) {
+			RendererDummy::LightStorage::get_singleton()->light_free(p_rid);
+			return true;
 		} else if (RendererDummy::MaterialStorage::get_singleton()->owns_shader(p_rid)) {
 			RendererDummy::MaterialStorage::get_singleton()->shader_free(p_rid);
 			return true;
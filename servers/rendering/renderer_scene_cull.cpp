@@ -1558,7 +1558,7 @@ void RendererSceneCull::instance_geometry_get_shader_parameter_list(RID p_instan
 	}
 }
 
-void RendererSceneCull::_update_instance(Instance *p_instance) {
+bool RendererSceneCull::_update_instance(Instance *p_instance, const AABB *p_indexer_aabb) {
 	p_instance->version++;
 
 	if (p_instance->base_type == RS::INSTANCE_LIGHT) {
@@ -1626,7 +1626,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 	}
 
 	if (!p_instance->aabb.has_surface()) {
-		return;
+		return false;
 	}
 
 	if (p_instance->base_type == RS::INSTANCE_LIGHTMAP) {
@@ -1640,9 +1640,9 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		}
 	}
 
-	AABB new_aabb;
-	new_aabb = p_instance->transform.xform(p_instance->aabb);
-	p_instance->transformed_aabb = new_aabb;
+	if (!p_indexer_aabb) {
+		p_instance->transformed_aabb = p_instance->transform.xform(p_instance->aabb);
+	}
 
 	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
 		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
@@ -1662,36 +1662,22 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 			if (!p_instance->lightmap_sh.is_empty()) {
 				p_instance->lightmap_sh.clear(); //don't need SH
 				p_instance->lightmap_target_sh.clear(); //don't need SH
-				ERR_FAIL_NULL(geom->geometry_instance);
+				ERR_FAIL_NULL_V(geom->geometry_instance, false);
 				geom->geometry_instance->set_lightmap_capture(nullptr);
 			}
 		}
 
-		ERR_FAIL_NULL(geom->geometry_instance);
+		ERR_FAIL_NULL_V(geom->geometry_instance, false);
 		geom->geometry_instance->set_transform(p_instance->transform, p_instance->aabb, p_instance->transformed_aabb);
 	}
 
 	// note: we had to remove is equal approx check here, it meant that det == 0.000004 won't work, which is the case for some of our scenes.
 	if (p_instance->scenario == nullptr || !p_instance->visible || p_instance->transform.basis.determinant() == 0) {
 		p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
-		return;
+		return false;
 	}
 
-	//quantize to improve moving object performance
-	AABB bvh_aabb = p_instance->transformed_aabb;
-
-	if (p_instance->indexer_id.is_valid() && bvh_aabb != p_instance->prev_transformed_aabb) {
-		//assume motion, see if bounds need to be quantized
-		AABB motion_aabb = bvh_aabb.merge(p_instance->prev_transformed_aabb);
-		float motion_longest_axis = motion_aabb.get_longest_axis_size();
-		float longest_axis = p_instance->transformed_aabb.get_longest_axis_size();
-
-		if (motion_longest_axis < longest_axis * 2) {
-			//moved but not a lot, use motion aabb quantizing
-			float quantize_size = Math::pow(2.0, Math::ceil(Math::log(motion_longest_axis) / Math::log(2.0))) * 0.5; //one fifth
-			bvh_aabb.quantize(quantize_size);
-		}
-	}
+	AABB bvh_aabb = p_indexer_aabb ? *p_indexer_aabb : _get_instance_indexer_aabb(p_instance);
 
 	if (!p_instance->indexer_id.is_valid()) {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
@@ -1795,14 +1781,35 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		p_instance->scenario->instance_visibility[p_instance->visibility_index].position = p_instance->transformed_aabb.get_center();
 	}
 
-	//move instance and repair
-	pair_pass++;
+	p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
 
-	PairInstances pair;
+	return true;
+}
+
+AABB RendererSceneCull::_get_instance_indexer_aabb(const Instance *p_instance) const {
+	//quantize to improve moving object performance
+	AABB bvh_aabb = p_instance->transformed_aabb;
+
+	if (p_instance->indexer_id.is_valid() && bvh_aabb != p_instance->prev_transformed_aabb) {
+		//assume motion, see if bounds need to be quantized
+		AABB motion_aabb = bvh_aabb.merge(p_instance->prev_transformed_aabb);
+		float motion_longest_axis = motion_aabb.get_longest_axis_size();
+		float longest_axis = p_instance->transformed_aabb.get_longest_axis_size();
+
+		if (motion_longest_axis < longest_axis * 2) {
+			//moved but not a lot, use motion aabb quantizing
+			float quantize_size = Math::pow(2.0, Math::ceil(Math::log(motion_longest_axis) / Math::log(2.0))) * 0.5; //one fifth
+			bvh_aabb.quantize(quantize_size);
+		}
+	}
+
+	return bvh_aabb;
+}
+
+void RendererSceneCull::_setup_instance_pair(Instance *p_instance, PairInstances &r_pair) {
+	PairInstances &pair = r_pair;
 
 	pair.instance = p_instance;
-	pair.pair_allocator = &pair_allocator;
-	pair.pair_pass = pair_pass;
 	pair.pair_mask = 0;
 	pair.cull_mask = 0xFFFFFFFF;
 
@@ -1843,10 +1850,26 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		pair.bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
 		pair.bvh2 = &p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES];
 	}
+}
 
-	pair.pair();
+void RendererSceneCull::_update_instance_pairs(Instance *p_instance, const LocalVector<Instance *> *p_candidates) {
+	//move instance and repair
+	pair_pass++;
 
-	p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
+	PairInstances pair;
+	_setup_instance_pair(p_instance, pair);
+	pair.pair_allocator = &pair_allocator;
+	pair.pair_pass = pair_pass;
+
+	if (p_candidates) {
+		// Query was already done on another thread.
+		for (Instance *candidate : *p_candidates) {
+			pair(candidate);
+		}
+		pair.resolve();
+	} else {
+		pair.pair();
+	}
 }
 
 void RendererSceneCull::_unpair_instance(Instance *p_instance) {
@@ -3834,7 +3857,7 @@ void RendererSceneCull::_update_instance_shader_uniforms_from_material(HashMap<S
 	}
 }
 
-void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
+void RendererSceneCull::_update_dirty_instance_dependencies(Instance *p_instance) {
 	if (p_instance->update_aabb) {
 		_update_instance_aabb(p_instance);
 	}
@@ -4062,13 +4085,103 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
 
 	_instance_update_list.remove(&p_instance->update_item);
 
-	_update_instance(p_instance);
-
 	p_instance->update_aabb = false;
 	p_instance->update_dependencies = false;
 }
 
+void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
+	_update_dirty_instance_dependencies(p_instance);
+
+	if (_update_instance(p_instance)) {
+		_update_instance_pairs(p_instance);
+	}
+}
+
+void RendererSceneCull::_update_dirty_instance_bounds_threaded(uint32_t p_thread, DirtyInstanceUpdateData *p_data) {
+	uint32_t total_threads = WorkerThreadPool::get_singleton()->get_thread_count();
+	uint32_t count = p_data->instances.size();
+	uint32_t from = p_thread * count / total_threads;
+	uint32_t to = (p_thread + 1 == total_threads) ? count : ((p_thread + 1) * count / total_threads);
+
+	for (uint32_t i = from; i < to; i++) {
+		Instance *instance = p_data->instances[i];
+		if (instance->aabb.has_surface()) {
+			instance->transformed_aabb = instance->transform.xform(instance->aabb);
+			p_data->indexer_aabbs[i] = _get_instance_indexer_aabb(instance);
+		}
+	}
+}
+
+void RendererSceneCull::_pair_dirty_instances_threaded(uint32_t p_thread, DirtyInstanceUpdateData *p_data) {
+	uint32_t total_threads = WorkerThreadPool::get_singleton()->get_thread_count();
+	uint32_t count = p_data->instances.size();
+	uint32_t from = p_thread * count / total_threads;
+	uint32_t to = (p_thread + 1 == total_threads) ? count : ((p_thread + 1) * count / total_threads);
+
+	for (uint32_t i = from; i < to; i++) {
+		if (!p_data->needs_pairing[i]) {
+			continue;
+		}
+
+		PairInstances pair;
+		_setup_instance_pair(p_data->instances[i], pair);
+
+		PairCandidates candidates;
+		candidates.pair = &pair;
+		candidates.candidates = &p_data->pair_candidates[i];
+		pair.query(candidates);
+	}
+}
+
+void RendererSceneCull::_update_dirty_instances_threaded() {
+	DirtyInstanceUpdateData &data = dirty_instance_update_data;
+
+	// Dependencies and local AABBs go through the storages, which are not thread safe.
+	data.instances.clear();
+	while (_instance_update_list.first()) {
+		Instance *instance = _instance_update_list.first()->self();
+		_update_dirty_instance_dependencies(instance);
+		data.instances.push_back(instance);
+	}
+
+	uint32_t count = data.instances.size();
+	data.indexer_aabbs.resize(count);
+	data.needs_pairing.resize(count);
+	if (data.pair_candidates.size() < count) {
+		data.pair_candidates.resize(count);
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_update_dirty_instance_bounds_threaded, &data, WorkerThreadPool::get_singleton()->get_thread_count(), -1, true, SNAME("UpdateInstanceBounds"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Indexer insertion and updates are merged on this thread, in queue order.
+	for (uint32_t i = 0; i < count; i++) {
+		data.needs_pairing[i] = _update_instance(data.instances[i], &data.indexer_aabbs[i]);
+	}
+
+	// With all the indexers up to date, the queries can run in parallel.
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_pair_dirty_instances_threaded, &data, WorkerThreadPool::get_singleton()->get_thread_count(), -1, true, SNAME("PairInstances"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (uint32_t i = 0; i < count; i++) {
+		if (data.needs_pairing[i]) {
+			_update_instance_pairs(data.instances[i], &data.pair_candidates[i]);
+			data.pair_candidates[i].clear();
+		}
+	}
+}
+
 void RendererSceneCull::update_dirty_instances() {
+	uint32_t dirty_count = 0;
+	for (SelfList<Instance> *E = _instance_update_list.first(); E && dirty_count <= thread_cull_threshold; E = E->next()) {
+		dirty_count++;
+	}
+
+	if (dirty_count > thread_cull_threshold) {
+		_update_dirty_instances_threaded();
+	}
+
+	// Instances queued again while updating (e.g. geometry captured by a moved lightmap) are handled here.
 	while (_instance_update_list.first()) {
 		_update_dirty_instance(_instance_update_list.first()->self());
 	}
@@ -810,11 +810,15 @@ public:
 		uint64_t pair_pass;
 		uint32_t cull_mask = 0xFFFFFFFF; // Needed for decals and lights in the mobile and compatibility renderers.
 
+		_FORCE_INLINE_ bool accepts(const Instance *p_instance) const {
+			//test is more coarse in indexer
+			return instance != p_instance && instance->transformed_aabb.intersects(p_instance->transformed_aabb) && (pair_mask & (1 << p_instance->base_type)) && (cull_mask & p_instance->layer_mask);
+		}
+
 		_FORCE_INLINE_ bool operator()(void *p_data) {
 			Instance *p_instance = (Instance *)p_data;
 
-			if (instance != p_instance && instance->transformed_aabb.intersects(p_instance->transformed_aabb) && (pair_mask & (1 << p_instance->base_type)) && (cull_mask & p_instance->layer_mask)) {
-				//test is more coarse in indexer
+			if (accepts(p_instance)) {
 				p_instance->pair_check = pair_pass;
 				InstancePair *pair = pair_allocator->alloc();
 				pair->a = instance;
@@ -824,13 +828,23 @@ public:
 			return false;
 		}
 
-		void pair() {
+		template <class QueryResult>
+		_FORCE_INLINE_ void query(QueryResult &r_result) {
 			if (bvh) {
-				bvh->aabb_query(instance->transformed_aabb, *this);
+				bvh->aabb_query(instance->transformed_aabb, r_result);
 			}
 			if (bvh2) {
-				bvh2->aabb_query(instance->transformed_aabb, *this);
+				bvh2->aabb_query(instance->transformed_aabb, r_result);
 			}
+		}
+
+		void pair() {
+			query(*this);
+			resolve();
+		}
+
+		// Pairs with the instances found by the query, and unpairs the ones that are no longer found.
+		void resolve() {
 			while (instance->pairs.first()) {
 				InstancePair *pair = instance->pairs.first()->self();
 				Instance *other_instance = instance == pair->a ? pair->b : pair->a;
@@ -858,6 +872,30 @@ public:
 		}
 	};
 
+	// Collects what PairInstances would pair with, without touching any instance.
+	// Used to run the indexer queries of many instances on multiple threads.
+	struct PairCandidates {
+		const PairInstances *pair = nullptr;
+		LocalVector<Instance *> *candidates = nullptr;
+
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *p_instance = (Instance *)p_data;
+			if (pair->accepts(p_instance)) {
+				candidates->push_back(p_instance);
+			}
+			return false;
+		}
+	};
+
+	struct DirtyInstanceUpdateData {
+		LocalVector<Instance *> instances;
+		LocalVector<AABB> indexer_aabbs;
+		LocalVector<uint8_t> needs_pairing;
+		LocalVector<LocalVector<Instance *>> pair_candidates;
+	};
+
+	DirtyInstanceUpdateData dirty_instance_update_data;
+
 	HashSet<Instance *> heightfield_particle_colliders_update_list;
 
 	PagedArrayPool<Instance *> instance_cull_page_pool;
@@ -1054,9 +1092,16 @@ public:
 	virtual Variant instance_geometry_get_shader_parameter(RID p_instance, const StringName &p_parameter) const;
 	virtual Variant instance_geometry_get_shader_parameter_default_value(RID p_instance, const StringName &p_parameter) const;
 
-	_FORCE_INLINE_ void _update_instance(Instance *p_instance);
+	_FORCE_INLINE_ bool _update_instance(Instance *p_instance, const AABB *p_indexer_aabb = nullptr);
+	_FORCE_INLINE_ AABB _get_instance_indexer_aabb(const Instance *p_instance) const;
+	_FORCE_INLINE_ void _setup_instance_pair(Instance *p_instance, PairInstances &r_pair);
+	_FORCE_INLINE_ void _update_instance_pairs(Instance *p_instance, const LocalVector<Instance *> *p_candidates = nullptr);
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance);
+	_FORCE_INLINE_ void _update_dirty_instance_dependencies(Instance *p_instance);
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
+	void _update_dirty_instances_threaded();
+	void _update_dirty_instance_bounds_threaded(uint32_t p_thread, DirtyInstanceUpdateData *p_data);
+	void _pair_dirty_instances_threaded(uint32_t p_thread, DirtyInstanceUpdateData *p_data);
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
 	void _unpair_instance(Instance *p_instance);
 
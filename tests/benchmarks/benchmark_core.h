@@ -0,0 +1,710 @@
+/**************************************************************************/
+/*  benchmark_core.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_CORE_H
+#define BENCHMARK_CORE_H
+
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/math/a_star_grid_2d.h"
+#include "core/math/bvh.h"
+#include "core/math/projection.h"
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/string/string_name.h"
+#include "core/templates/flat_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/oa_hash_map.h"
+#include "core/templates/rid_owner.h"
+#include "core/templates/vector.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_benchmark.h"
+
+namespace BenchmarkCore {
+
+static const uint32_t HASH_MAP_SIZE = 10000;
+
+static void hash_map_insert(BenchmarkState &p_state) {
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		HashMap<uint32_t, uint32_t> map;
+		for (uint32_t j = 0; j < HASH_MAP_SIZE; j++) {
+			map.insert(j * 2654435761u, j);
+		}
+		BenchmarkState::do_not_optimize(map.size());
+	}
+}
+
+static void hash_map_lookup(BenchmarkState &p_state) {
+	HashMap<uint32_t, uint32_t> map;
+	for (uint32_t j = 0; j < HASH_MAP_SIZE; j++) {
+		map.insert(j * 2654435761u, j);
+	}
+	p_state.restart_timer();
+
+	uint32_t found = 0;
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		// Half of the lookups miss.
+		for (uint32_t j = 0; j < HASH_MAP_SIZE; j++) {
+			found += map.has((j + (i & 1) * HASH_MAP_SIZE) * 2654435761u);
+		}
+	}
+	BenchmarkState::do_not_optimize(found);
+}
+
+// Same workloads as above, on the flat and the open addressing maps.
+static void flat_hash_map_insert(BenchmarkState &p_state) {
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		FlatHashMap<uint32_t, uint32_t> map;
+		for (uint32_t j = 0; j < HASH_MAP_SIZE; j++) {
+			map.insert(j * 2654435761u, j);
+		}
+		BenchmarkState::do_not_optimize(map.size());
+	}
+}
+
+static void flat_hash_map_lookup(BenchmarkState &p_state) {
+	FlatHashMap<uint32_t, uint32_t> map;
+	for (uint32_t j = 0; j < HASH_MAP_SIZE; j++) {
+		map.insert(j * 2654435761u, j);
+	}
+	p_state.restart_timer();
+
+	uint32_t found = 0;
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		for (uint32_t j = 0; j < HASH_MAP_SIZE; j++) {
+			found += map.has((j + (i & 1) * HASH_MAP_SIZE) * 2654435761u);
+		}
+	}
+	BenchmarkState::do_not_optimize(found);
+}
+
+static void oa_hash_map_insert(BenchmarkState &p_state) {
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		OAHashMap<uint32_t, uint32_t> map;
+		for (uint32_t j = 0; j < HASH_MAP_SIZE; j++) {
+			map.insert(j * 2654435761u, j);
+		}
+		BenchmarkState::do_not_optimize(map.get_num_elements());
+	}
+}
+
+static void oa_hash_map_lookup(BenchmarkState &p_state) {
+	OAHashMap<uint32_t, uint32_t> map;
+	for (uint32_t j = 0; j < HASH_MAP_SIZE; j++) {
+		map.insert(j * 2654435761u, j);
+	}
+	p_state.restart_timer();
+
+	uint32_t found = 0;
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		for (uint32_t j = 0; j < HASH_MAP_SIZE; j++) {
+			found += map.has((j + (i & 1) * HASH_MAP_SIZE) * 2654435761u);
+		}
+	}
+	BenchmarkState::do_not_optimize(found);
+}
+
+static void hash_map_string_lookup(BenchmarkState &p_state) {
+	HashMap<String, int> map;
+	LocalVector<String> keys;
+	for (uint32_t j = 0; j < 1000; j++) {
+		keys.push_back("key_" + itos(j));
+		map.insert(keys[j], j);
+	}
+	p_state.restart_timer();
+
+	int sum = 0;
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		for (const String &key : keys) {
+			sum += map[key];
+		}
+	}
+	BenchmarkState::do_not_optimize(sum);
+}
+
+static void flat_hash_map_string_lookup(BenchmarkState &p_state) {
+	FlatHashMap<String, int> map;
+	LocalVector<String> keys;
+	for (uint32_t j = 0; j < 1000; j++) {
+		keys.push_back("key_" + itos(j));
+		map.insert(keys[j], j);
+	}
+	p_state.restart_timer();
+
+	int sum = 0;
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		for (const String &key : keys) {
+			sum += map[key];
+		}
+	}
+	BenchmarkState::do_not_optimize(sum);
+}
+
+static void vector_push_back(BenchmarkState &p_state) {
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		Vector<int> vector;
+		for (int j = 0; j < 10000; j++) {
+			vector.push_back(j);
+		}
+		BenchmarkState::do_not_optimize(vector.size());
+	}
+}
+
+static void vector_copy_on_write(BenchmarkState &p_state) {
+	Vector<int> source;
+	source.resize(10000);
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		// Sharing is free, the first write has to copy the whole buffer.
+		Vector<int> copy = source;
+		copy.write[0] = i;
+		BenchmarkState::do_not_optimize(copy.ptr());
+	}
+}
+
+static void string_name_intern(BenchmarkState &p_state) {
+	LocalVector<String> names;
+	for (uint32_t j = 0; j < 1000; j++) {
+		names.push_back("benchmark_name_" + itos(j));
+	}
+	// Keep them alive, so lookups find existing entries.
+	LocalVector<StringName> interned;
+	for (const String &name : names) {
+		interned.push_back(StringName(name));
+	}
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		for (const String &name : names) {
+			StringName string_name(name);
+			BenchmarkState::do_not_optimize(string_name.data_unique_pointer());
+		}
+	}
+}
+
+static void string_name_create_unique(BenchmarkState &p_state) {
+	uint64_t counter = 0;
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		// Each name is new, then released again, which also measures removal.
+		for (uint32_t j = 0; j < 100; j++) {
+			StringName string_name("unique_name_" + itos(counter++));
+			BenchmarkState::do_not_optimize(string_name.data_unique_pointer());
+		}
+	}
+}
+
+// Runs the worker body as four tasks per pool thread in each iteration, so all threads hit the shared state at once.
+template <typename C>
+static void run_contended(BenchmarkState &p_state, C *p_instance, void (C::*p_method)(uint32_t, void *), const String &p_description) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const int tasks = MAX(pool->get_thread_count(), 1) * 4;
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(p_instance, p_method, nullptr, tasks, -1, true, p_description);
+		pool->wait_for_group_task_completion(group);
+	}
+	p_state.stop_timer();
+}
+
+struct SmallAllocationChurn {
+	// Short lived allocations of List node and HashMapElement sizes, from every worker.
+	void allocate_and_free(uint32_t p_index, void *p_userdata) {
+		void *blocks[64];
+		for (uint32_t j = 0; j < 1000; j++) {
+			for (uint32_t k = 0; k < 64; k++) {
+				blocks[k] = memalloc(16 + ((j + k) % 8) * 16);
+			}
+			for (uint32_t k = 0; k < 64; k++) {
+				memfree(blocks[k]);
+			}
+		}
+	}
+};
+
+static void memory_small_allocations(BenchmarkState &p_state) {
+	SmallAllocationChurn churn;
+	run_contended(p_state, &churn, &SmallAllocationChurn::allocate_and_free, "SmallAllocationChurn");
+}
+
+struct StringNameContention {
+	LocalVector<String> shared_names;
+
+	// Every worker interns the same shared names and names of its own,
+	// releasing all of them again, like threaded loaders and scripts do.
+	void intern_and_release(uint32_t p_index, void *p_userdata) {
+		for (uint32_t j = 0; j < 1000; j++) {
+			StringName shared(shared_names[j % shared_names.size()]);
+			StringName own(shared_names[j % shared_names.size()] + "_" + itos(p_index));
+			BenchmarkState::do_not_optimize(shared.data_unique_pointer());
+			BenchmarkState::do_not_optimize(own.data_unique_pointer());
+		}
+	}
+};
+
+static void string_name_contention(BenchmarkState &p_state) {
+	StringNameContention contention;
+	for (uint32_t j = 0; j < 64; j++) {
+		contention.shared_names.push_back("contended_name_" + itos(j));
+	}
+	run_contended(p_state, &contention, &StringNameContention::intern_and_release, "StringNameContention");
+}
+
+static SafeNumeric<uint64_t> worker_thread_pool_sink;
+
+static void worker_thread_pool_element(void *p_arg, uint32_t p_index) {
+	// Small amount of work per element, so scheduling overhead dominates.
+	uint64_t h = p_index;
+	for (int i = 0; i < 64; i++) {
+		h = h * 6364136223846793005ULL + 1442695040888963407ULL;
+	}
+	worker_thread_pool_sink.add(h & 1);
+}
+
+static void worker_thread_pool_task(void *p_arg) {
+	worker_thread_pool_element(nullptr, (uintptr_t)p_arg);
+}
+
+static void worker_thread_pool_nested_task(void *p_arg) {
+	WorkerThreadPool::TaskID tasks[64];
+	for (int i = 0; i < 64; i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(worker_thread_pool_task, (void *)(uintptr_t)i, true);
+	}
+	for (int i = 0; i < 64; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+}
+
+static void worker_thread_pool_groups(BenchmarkState &p_state, WorkerThreadPool::SchedulerMode p_mode) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const int thread_count = pool->get_thread_count();
+	const WorkerThreadPool::SchedulerMode previous_mode = pool->get_scheduler_mode();
+	pool->finish();
+	pool->init(thread_count, 0.3, p_mode);
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		for (int j = 0; j < 100; j++) {
+			WorkerThreadPool::GroupID group = pool->add_native_group_task(worker_thread_pool_element, nullptr, 256, -1, true);
+			pool->wait_for_group_task_completion(group);
+		}
+	}
+
+	p_state.stop_timer();
+	pool->finish();
+	pool->init(thread_count, 0.3, previous_mode);
+}
+
+// Tasks that post more tasks from pool threads, which is where per-thread deques help the most.
+static void worker_thread_pool_nested_tasks(BenchmarkState &p_state, WorkerThreadPool::SchedulerMode p_mode) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const int thread_count = pool->get_thread_count();
+	const WorkerThreadPool::SchedulerMode previous_mode = pool->get_scheduler_mode();
+	pool->finish();
+	pool->init(thread_count, 0.3, p_mode);
+	WorkerThreadPool::TaskID tasks[256];
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		for (int j = 0; j < 256; j++) {
+			tasks[j] = pool->add_native_task(worker_thread_pool_nested_task, nullptr, true);
+		}
+		for (int j = 0; j < 256; j++) {
+			pool->wait_for_task_completion(tasks[j]);
+		}
+	}
+
+	p_state.stop_timer();
+	pool->finish();
+	pool->init(thread_count, 0.3, previous_mode);
+}
+
+static void worker_thread_pool_groups_shared_queue(BenchmarkState &p_state) {
+	worker_thread_pool_groups(p_state, WorkerThreadPool::SCHEDULER_MODE_SHARED_QUEUE);
+}
+
+static void worker_thread_pool_groups_work_stealing(BenchmarkState &p_state) {
+	worker_thread_pool_groups(p_state, WorkerThreadPool::SCHEDULER_MODE_WORK_STEALING);
+}
+
+static void worker_thread_pool_nested_tasks_shared_queue(BenchmarkState &p_state) {
+	worker_thread_pool_nested_tasks(p_state, WorkerThreadPool::SCHEDULER_MODE_SHARED_QUEUE);
+}
+
+static void worker_thread_pool_nested_tasks_work_stealing(BenchmarkState &p_state) {
+	worker_thread_pool_nested_tasks(p_state, WorkerThreadPool::SCHEDULER_MODE_WORK_STEALING);
+}
+
+struct RIDContention {
+	RID_Owner<uint64_t, true> owner;
+	LocalVector<RID> rids;
+
+	// Every worker resolves the same RIDs, like render and physics threads
+	// looking up resources owned by the servers.
+	void get_or_null(uint32_t p_index, void *p_userdata) {
+		uint64_t sum = 0;
+		for (uint32_t j = 0; j < 10000; j++) {
+			sum += *owner.get_or_null(rids[(j + p_index * 7) % rids.size()]);
+		}
+		BenchmarkState::do_not_optimize(sum);
+	}
+};
+
+static void rid_get_or_null_contended(BenchmarkState &p_state) {
+	RIDContention contention;
+	for (uint64_t j = 0; j < 1000; j++) {
+		contention.rids.push_back(contention.owner.make_rid(j));
+	}
+	run_contended(p_state, &contention, &RIDContention::get_or_null, "RIDContention");
+
+	for (const RID &rid : contention.rids) {
+		contention.owner.free(rid);
+	}
+}
+
+static void dictionary_create_small(BenchmarkState &p_state) {
+	const StringName keys[] = { SNAME("position"), SNAME("normal"), SNAME("collider_id"), SNAME("collider"), SNAME("shape"), SNAME("rid") };
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		// Built and dropped like the result of a ray query.
+		for (uint32_t j = 0; j < 1000; j++) {
+			Dictionary d;
+			for (uint32_t k = 0; k < 6; k++) {
+				d[keys[k]] = j + k;
+			}
+			BenchmarkState::do_not_optimize(d.size());
+		}
+	}
+}
+
+static void variant_evaluate_add(BenchmarkState &p_state) {
+	Variant a = 1;
+	Variant b = 2.5;
+	Variant c = Vector3(1, 2, 3);
+	Variant d = Vector3(4, 5, 6);
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		bool valid = true;
+		Variant r_int_float;
+		Variant r_vector;
+		Variant::evaluate(Variant::OP_ADD, a, b, r_int_float, valid);
+		Variant::evaluate(Variant::OP_ADD, c, d, r_vector, valid);
+		BenchmarkState::do_not_optimize(r_int_float);
+		BenchmarkState::do_not_optimize(r_vector);
+	}
+}
+
+static void variant_validated_operator(BenchmarkState &p_state) {
+	Variant a = 1;
+	Variant b = 2;
+	Variant result = 0;
+	Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::OP_MULTIPLY, Variant::INT, Variant::INT);
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		evaluator(&a, &b, &result);
+		BenchmarkState::do_not_optimize(result);
+	}
+}
+
+static void variant_call_method(BenchmarkState &p_state) {
+	Variant vector = Vector3(1, 2, 3);
+	Variant other = Vector3(4, 5, 6);
+	const Variant *args[1] = { &other };
+	StringName method = "dot";
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		Callable::CallError ce;
+		Variant result;
+		vector.callp(method, args, 1, result, ce);
+		BenchmarkState::do_not_optimize(result);
+	}
+}
+
+static Ref<Resource> create_benchmark_resource() {
+	RandomPCG rng(0);
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Benchmark");
+
+	PackedVector3Array points;
+	points.resize(10000);
+	for (int i = 0; i < points.size(); i++) {
+		points.write[i] = Vector3(rng.randf(), rng.randf(), rng.randf());
+	}
+	resource->set_meta("points", points);
+
+	Dictionary dictionary;
+	for (int i = 0; i < 1000; i++) {
+		dictionary["key_" + itos(i)] = i;
+	}
+	resource->set_meta("dictionary", dictionary);
+
+	for (int i = 0; i < 16; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name("Child " + itos(i));
+		resource->set_meta("child_" + itos(i), child);
+	}
+	return resource;
+}
+
+static void resource_save(BenchmarkState &p_state, const String &p_extension) {
+	Ref<Resource> resource = create_benchmark_resource();
+	const String path = OS::get_singleton()->get_cache_path().path_join("benchmark_resource." + p_extension);
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		ResourceSaver::save(resource, path);
+	}
+}
+
+static void resource_load(BenchmarkState &p_state, const String &p_extension) {
+	const String path = OS::get_singleton()->get_cache_path().path_join("benchmark_resource." + p_extension);
+	ResourceSaver::save(create_benchmark_resource(), path);
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		Ref<Resource> loaded = ResourceLoader::load(path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		BenchmarkState::do_not_optimize(loaded.ptr());
+	}
+}
+
+static void resource_save_binary(BenchmarkState &p_state) {
+	resource_save(p_state, "res");
+}
+
+static void resource_save_text(BenchmarkState &p_state) {
+	resource_save(p_state, "tres");
+}
+
+static void resource_load_binary(BenchmarkState &p_state) {
+	resource_load(p_state, "res");
+}
+
+static void resource_load_text(BenchmarkState &p_state) {
+	resource_load(p_state, "tres");
+}
+
+// A large tile map with scattered walls, and many queries per frame.
+struct BVHBenchmarkItem {
+	uint32_t index = 0;
+};
+
+// Every item passes the pair and cull checks of the user.
+struct BVHBenchmarkUserChecks {
+	static bool user_pair_check(const BVHBenchmarkItem *p_a, const BVHBenchmarkItem *p_b) {
+		return true;
+	}
+	static bool user_cull_check(const BVHBenchmarkItem *p_a, const BVHBenchmarkItem *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<BVHBenchmarkItem, 1, false, 128, BVHBenchmarkUserChecks, BVHBenchmarkUserChecks> BenchmarkBVH3D;
+
+enum BVHBenchmarkQuery {
+	BVH_QUERY_AABB,
+	BVH_QUERY_POINT,
+	BVH_QUERY_SEGMENT,
+	BVH_QUERY_CONVEX,
+};
+
+static void bvh_cull(BenchmarkState &p_state, BVHBenchmarkQuery p_query, bool p_simd) {
+	const uint32_t ITEM_COUNT = 20000;
+	const int QUERY_COUNT = 256;
+	const int MAX_RESULTS = 4096;
+	const real_t EXTENT = 500.0;
+
+	RandomPCG rng(0);
+	BenchmarkBVH3D bvh;
+	LocalVector<BVHBenchmarkItem> items;
+	items.resize(ITEM_COUNT);
+	for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+		items[i].index = i;
+		const Vector3 position(rng.random(-EXTENT, EXTENT), rng.random(-EXTENT, EXTENT), rng.random(-EXTENT, EXTENT));
+		bvh.create(&items[i], true, 0, 1, AABB(position, Vector3(rng.random(0.5, 10.0), rng.random(0.5, 10.0), rng.random(0.5, 10.0))));
+	}
+	bvh.update();
+	bvh.params_set_simd_culling(p_simd);
+
+	Projection projection;
+	projection.set_perspective(60.0, 1.5, 0.1, 200.0);
+	LocalVector<AABB> boxes;
+	LocalVector<Vector3> points;
+	LocalVector<Vector<Plane>> frustums;
+	for (int i = 0; i < QUERY_COUNT; i++) {
+		const Vector3 a(rng.random(-EXTENT, EXTENT), rng.random(-EXTENT, EXTENT), rng.random(-EXTENT, EXTENT));
+		const Vector3 b(rng.random(-EXTENT, EXTENT), rng.random(-EXTENT, EXTENT), rng.random(-EXTENT, EXTENT));
+		boxes.push_back(AABB(a, Vector3(rng.random(10.0, 100.0), rng.random(10.0, 100.0), rng.random(10.0, 100.0))));
+		points.push_back(a);
+		points.push_back(b);
+		frustums.push_back(projection.get_projection_planes(Transform3D(Basis(), a).looking_at(b, Vector3(0, 1, 0))));
+	}
+	LocalVector<BVHBenchmarkItem *> results;
+	results.resize(MAX_RESULTS);
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		int hits = 0;
+		for (int j = 0; j < QUERY_COUNT; j++) {
+			switch (p_query) {
+				case BVH_QUERY_AABB:
+					hits += bvh.cull_aabb(boxes[j], results.ptr(), MAX_RESULTS, nullptr);
+					break;
+				case BVH_QUERY_POINT:
+					hits += bvh.cull_point(points[j * 2], results.ptr(), MAX_RESULTS, nullptr);
+					break;
+				case BVH_QUERY_SEGMENT:
+					hits += bvh.cull_segment(points[j * 2], points[j * 2 + 1], results.ptr(), MAX_RESULTS, nullptr);
+					break;
+				case BVH_QUERY_CONVEX:
+					hits += bvh.cull_convex(frustums[j], results.ptr(), MAX_RESULTS, nullptr);
+					break;
+			}
+		}
+		BenchmarkState::do_not_optimize(hits);
+	}
+	p_state.stop_timer();
+}
+
+static void bvh_cull_aabb_simd(BenchmarkState &p_state) {
+	bvh_cull(p_state, BVH_QUERY_AABB, true);
+}
+
+static void bvh_cull_aabb_scalar(BenchmarkState &p_state) {
+	bvh_cull(p_state, BVH_QUERY_AABB, false);
+}
+
+static void bvh_cull_point_simd(BenchmarkState &p_state) {
+	bvh_cull(p_state, BVH_QUERY_POINT, true);
+}
+
+static void bvh_cull_point_scalar(BenchmarkState &p_state) {
+	bvh_cull(p_state, BVH_QUERY_POINT, false);
+}
+
+static void bvh_cull_segment_simd(BenchmarkState &p_state) {
+	bvh_cull(p_state, BVH_QUERY_SEGMENT, true);
+}
+
+static void bvh_cull_segment_scalar(BenchmarkState &p_state) {
+	bvh_cull(p_state, BVH_QUERY_SEGMENT, false);
+}
+
+static void bvh_cull_convex_simd(BenchmarkState &p_state) {
+	bvh_cull(p_state, BVH_QUERY_CONVEX, true);
+}
+
+static void bvh_cull_convex_scalar(BenchmarkState &p_state) {
+	bvh_cull(p_state, BVH_QUERY_CONVEX, false);
+}
+
+static void astar_grid_2d_paths(BenchmarkState &p_state, bool p_jumping_enabled) {
+	const int GRID_SIZE = 1000;
+	const int QUERY_COUNT = 128;
+
+	Ref<AStarGrid2D> astar;
+	astar.instantiate();
+	astar->set_region(Rect2i(0, 0, GRID_SIZE, GRID_SIZE));
+	astar->set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES);
+	astar->set_jumping_enabled(p_jumping_enabled);
+	astar->update();
+
+	RandomPCG rng(0);
+	for (int i = 0; i < GRID_SIZE * GRID_SIZE / 10; i++) {
+		astar->set_point_solid(Vector2i(rng.rand() % GRID_SIZE, rng.rand() % GRID_SIZE));
+	}
+	TypedArray<Vector2i> from_ids;
+	TypedArray<Vector2i> to_ids;
+	for (int i = 0; i < QUERY_COUNT; i++) {
+		from_ids.push_back(Vector2i(rng.rand() % GRID_SIZE, rng.rand() % GRID_SIZE));
+		to_ids.push_back(Vector2i(rng.rand() % GRID_SIZE, rng.rand() % GRID_SIZE));
+	}
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		BenchmarkState::do_not_optimize(astar->get_point_paths(from_ids, to_ids).size());
+	}
+	p_state.stop_timer();
+}
+
+static void astar_grid_2d_paths_astar(BenchmarkState &p_state) {
+	astar_grid_2d_paths(p_state, false);
+}
+
+static void astar_grid_2d_paths_jumping(BenchmarkState &p_state) {
+	astar_grid_2d_paths(p_state, true);
+}
+
+REGISTER_BENCHMARK("hash_map/insert_10000", &hash_map_insert);
+REGISTER_BENCHMARK("hash_map/lookup_10000", &hash_map_lookup);
+REGISTER_BENCHMARK("hash_map/string_lookup_1000", &hash_map_string_lookup);
+REGISTER_BENCHMARK("flat_hash_map/insert_10000", &flat_hash_map_insert);
+REGISTER_BENCHMARK("flat_hash_map/lookup_10000", &flat_hash_map_lookup);
+REGISTER_BENCHMARK("flat_hash_map/string_lookup_1000", &flat_hash_map_string_lookup);
+REGISTER_BENCHMARK("oa_hash_map/insert_10000", &oa_hash_map_insert);
+REGISTER_BENCHMARK("oa_hash_map/lookup_10000", &oa_hash_map_lookup);
+REGISTER_BENCHMARK("vector/push_back_10000", &vector_push_back);
+REGISTER_BENCHMARK("vector/copy_on_write_10000", &vector_copy_on_write);
+REGISTER_BENCHMARK("string_name/intern_existing_1000", &string_name_intern);
+REGISTER_BENCHMARK("string_name/create_unique_100", &string_name_create_unique);
+REGISTER_BENCHMARK("string_name/contended_intern_release", &string_name_contention);
+REGISTER_BENCHMARK("worker_thread_pool/groups_100x256_shared_queue", &worker_thread_pool_groups_shared_queue);
+REGISTER_BENCHMARK("worker_thread_pool/groups_100x256_work_stealing", &worker_thread_pool_groups_work_stealing);
+REGISTER_BENCHMARK("worker_thread_pool/nested_tasks_256x64_shared_queue", &worker_thread_pool_nested_tasks_shared_queue);
+REGISTER_BENCHMARK("worker_thread_pool/nested_tasks_256x64_work_stealing", &worker_thread_pool_nested_tasks_work_stealing);
+REGISTER_BENCHMARK("rid/get_or_null_contended", &rid_get_or_null_contended);
+REGISTER_BENCHMARK("memory/small_allocations_threaded", &memory_small_allocations);
+REGISTER_BENCHMARK("dictionary/create_small_1000", &dictionary_create_small);
+REGISTER_BENCHMARK("variant/evaluate_add", &variant_evaluate_add);
+REGISTER_BENCHMARK("variant/validated_operator", &variant_validated_operator);
+REGISTER_BENCHMARK("variant/call_method", &variant_call_method);
+REGISTER_BENCHMARK("resource/save_binary", &resource_save_binary);
+REGISTER_BENCHMARK("resource/save_text", &resource_save_text);
+REGISTER_BENCHMARK("resource/load_binary", &resource_load_binary);
+REGISTER_BENCHMARK("resource/load_text", &resource_load_text);
+REGISTER_BENCHMARK("bvh/cull_aabb_256_simd", &bvh_cull_aabb_simd);
+REGISTER_BENCHMARK("bvh/cull_aabb_256_scalar", &bvh_cull_aabb_scalar);
+REGISTER_BENCHMARK("bvh/cull_point_256_simd", &bvh_cull_point_simd);
+REGISTER_BENCHMARK("bvh/cull_point_256_scalar", &bvh_cull_point_scalar);
+REGISTER_BENCHMARK("bvh/cull_segment_256_simd", &bvh_cull_segment_simd);
+REGISTER_BENCHMARK("bvh/cull_segment_256_scalar", &bvh_cull_segment_scalar);
+REGISTER_BENCHMARK("bvh/cull_convex_256_simd", &bvh_cull_convex_simd);
+REGISTER_BENCHMARK("bvh/cull_convex_256_scalar", &bvh_cull_convex_scalar);
+REGISTER_BENCHMARK("astar_grid_2d/paths_1000x1000_128_queries", &astar_grid_2d_paths_astar);
+REGISTER_BENCHMARK("astar_grid_2d/paths_1000x1000_128_queries_jumping", &astar_grid_2d_paths_jumping);
+
+} // namespace BenchmarkCore
+
+#endif // BENCHMARK_CORE_H
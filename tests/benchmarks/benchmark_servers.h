@@ -0,0 +1,485 @@
+/**************************************************************************/
+/*  benchmark_servers.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_SERVERS_H
+#define BENCHMARK_SERVERS_H
+
+#include "core/math/random_pcg.h"
+#include "scene/resources/navigation_mesh.h"
+#include "servers/navigation_server_3d.h"
+#include "servers/physics_server_3d.h"
+#include "servers/rendering/dummy/rasterizer_dummy.h"
+#include "servers/rendering/rendering_server_default.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_benchmark.h"
+
+namespace BenchmarkServers {
+
+// A pile of boxes on the floor, stepped from the given number of steps after they were dropped.
+static void _physics_3d_step_box_pile(BenchmarkState &p_state, int p_size, real_t p_half_extent, int p_settle_steps) {
+	PhysicsServer3D *physics_server = PhysicsServer3DManager::get_singleton()->new_default_server();
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID floor_shape = physics_server->world_boundary_shape_create();
+	physics_server->shape_set_data(floor_shape, Plane(Vector3(0, 1, 0), 0));
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape);
+	physics_server->body_set_space(floor, space);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(p_half_extent, p_half_extent, p_half_extent));
+
+	const real_t spacing = p_half_extent * 2.2;
+	LocalVector<RID> bodies;
+	for (int x = 0; x < p_size; x++) {
+		for (int y = 0; y < p_size; y++) {
+			for (int z = 0; z < p_size; z++) {
+				RID body = physics_server->body_create();
+				physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+				physics_server->body_add_shape(body, box_shape);
+				physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * spacing, p_half_extent + y * spacing, z * spacing)));
+				physics_server->body_set_space(body, space);
+				bodies.push_back(body);
+			}
+		}
+	}
+
+	for (int i = 0; i < p_settle_steps; i++) {
+		physics_server->sync();
+		physics_server->flush_queries();
+		physics_server->end_sync();
+		physics_server->step(1.0 / 60.0);
+	}
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		physics_server->sync();
+		physics_server->flush_queries();
+		physics_server->end_sync();
+		physics_server->step(1.0 / 60.0);
+	}
+	p_state.stop_timer();
+
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(floor);
+	physics_server->free(box_shape);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+// Boxes falling on the floor, so there are plenty of contacts to solve.
+static void physics_3d_step(BenchmarkState &p_state) {
+	_physics_3d_step_box_pile(p_state, 10, 0.5, 0);
+}
+
+// Small boxes that already came to rest, mostly asleep with a few islands still settling.
+static void physics_3d_step_resting_debris(BenchmarkState &p_state) {
+	_physics_3d_step_box_pile(p_state, 12, 0.1, 300);
+}
+
+// Rays cast down on a field of boxes, in one batch.
+static void physics_3d_intersect_rays(BenchmarkState &p_state) {
+	const int RAY_COUNT = 4096;
+
+	PhysicsServer3D *physics_server = PhysicsServer3DManager::get_singleton()->new_default_server();
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	LocalVector<RID> bodies;
+	for (int x = 0; x < 32; x++) {
+		for (int z = 0; z < 32; z++) {
+			RID body = physics_server->body_create();
+			physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+			physics_server->body_add_shape(body, box_shape);
+			physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 2.0, 0, z * 2.0)));
+			physics_server->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+	}
+
+	RandomPCG rng(0);
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	for (int i = 0; i < RAY_COUNT; i++) {
+		const Vector3 position(rng.randf() * 64.0, 0, rng.randf() * 64.0);
+		from.push_back(position + Vector3(0, 10, 0));
+		to.push_back(position - Vector3(0, 10, 0));
+	}
+
+	PhysicsDirectSpaceState3D *space_state = physics_server->space_get_direct_state(space);
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	LocalVector<bool> hits;
+	results.resize(RAY_COUNT);
+	hits.resize(RAY_COUNT);
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		space_state->intersect_rays(parameters, from.ptr(), to.ptr(), RAY_COUNT, results.ptr(), hits.ptr());
+	}
+	p_state.stop_timer();
+
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(box_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+// Cloths pinned by one edge, each one is solved on its own thread.
+static void physics_3d_step_soft_bodies(BenchmarkState &p_state) {
+	const int SOFT_BODY_COUNT = 16;
+	const int CLOTH_SIZE = 24;
+
+	RasterizerDummy::make_current();
+	RenderingServerDefault *rendering_server = memnew(RenderingServerDefault());
+	rendering_server->init();
+	rendering_server->set_render_loop_enabled(false);
+
+	PackedVector3Array vertices;
+	for (int z = 0; z <= CLOTH_SIZE; z++) {
+		for (int x = 0; x <= CLOTH_SIZE; x++) {
+			vertices.push_back(Vector3(x, 0, z) * 0.1);
+		}
+	}
+	PackedInt32Array indices;
+	for (int z = 0; z < CLOTH_SIZE; z++) {
+		for (int x = 0; x < CLOTH_SIZE; x++) {
+			const int corner = z * (CLOTH_SIZE + 1) + x;
+			indices.push_back(corner);
+			indices.push_back(corner + 1);
+			indices.push_back(corner + CLOTH_SIZE + 1);
+			indices.push_back(corner + 1);
+			indices.push_back(corner + CLOTH_SIZE + 2);
+			indices.push_back(corner + CLOTH_SIZE + 1);
+		}
+	}
+	Array arrays;
+	arrays.resize(RS::ARRAY_MAX);
+	arrays[RS::ARRAY_VERTEX] = vertices;
+	arrays[RS::ARRAY_INDEX] = indices;
+	RID mesh = rendering_server->mesh_create();
+	rendering_server->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+
+	PhysicsServer3D *physics_server = PhysicsServer3DManager::get_singleton()->new_default_server();
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	LocalVector<RID> soft_bodies;
+	for (int i = 0; i < SOFT_BODY_COUNT; i++) {
+		RID soft_body = physics_server->soft_body_create();
+		physics_server->soft_body_set_mesh(soft_body, mesh);
+		for (int x = 0; x <= CLOTH_SIZE; x++) {
+			physics_server->soft_body_pin_point(soft_body, x, true);
+		}
+		physics_server->soft_body_set_transform(soft_body, Transform3D(Basis(), Vector3(i * 3.0, 0, 0)));
+		physics_server->soft_body_set_space(soft_body, space);
+		soft_bodies.push_back(soft_body);
+	}
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		physics_server->sync();
+		physics_server->flush_queries();
+		physics_server->end_sync();
+		physics_server->step(1.0 / 60.0);
+	}
+	p_state.stop_timer();
+
+	for (const RID &soft_body : soft_bodies) {
+		physics_server->free(soft_body);
+	}
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+
+	rendering_server->free(mesh);
+	rendering_server->sync();
+	rendering_server->finish();
+	memdelete(rendering_server);
+}
+
+// A flat grid of quads.
+static Ref<NavigationMesh> _make_nav_grid(int p_grid_size) {
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+	PackedVector3Array vertices;
+	for (int z = 0; z <= p_grid_size; z++) {
+		for (int x = 0; x <= p_grid_size; x++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+	for (int z = 0; z < p_grid_size; z++) {
+		for (int x = 0; x < p_grid_size; x++) {
+			Vector<int> polygon;
+			polygon.push_back(z * (p_grid_size + 1) + x);
+			polygon.push_back(z * (p_grid_size + 1) + x + 1);
+			polygon.push_back((z + 1) * (p_grid_size + 1) + x + 1);
+			polygon.push_back((z + 1) * (p_grid_size + 1) + x);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+	return navigation_mesh;
+}
+
+// Random queries across a grid.
+static void _nav_map_get_path(BenchmarkState &p_state, int p_grid_size, bool p_hierarchical) {
+	const int GRID_SIZE = p_grid_size;
+	const int QUERY_COUNT = 64;
+
+	ERR_PRINT_OFF;
+	NavigationServer3D *navigation_server = NavigationServer3DManager::new_default_server();
+	ERR_PRINT_ON;
+
+	RID map = navigation_server->map_create();
+	navigation_server->map_set_active(map, true);
+	navigation_server->map_set_use_hierarchical_pathfinding(map, p_hierarchical);
+
+	Ref<NavigationMesh> navigation_mesh = _make_nav_grid(GRID_SIZE);
+
+	RID region = navigation_server->region_create();
+	navigation_server->region_set_map(region, map);
+	navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+	navigation_server->process(0.0); // Give server some cycles to commit.
+
+	RandomPCG rng(0);
+	LocalVector<Vector3> queries;
+	for (int i = 0; i < QUERY_COUNT * 2; i++) {
+		queries.push_back(Vector3(rng.randf() * GRID_SIZE, 0, rng.randf() * GRID_SIZE));
+	}
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		int query = (i % QUERY_COUNT) * 2;
+		Vector<Vector3> path = navigation_server->map_get_path(map, queries[query], queries[query + 1], true);
+		BenchmarkState::do_not_optimize(path.size());
+	}
+	p_state.stop_timer();
+
+	navigation_server->free(region);
+	navigation_server->free(map);
+	navigation_server->process(0.0); // Give server some cycles to actually remove map.
+	memdelete(navigation_server);
+}
+
+static void nav_map_get_path(BenchmarkState &p_state) {
+	_nav_map_get_path(p_state, 100, false);
+}
+
+// About 200k polygons, the size of a large open world map.
+static void nav_map_get_path_large(BenchmarkState &p_state) {
+	_nav_map_get_path(p_state, 450, false);
+}
+
+static void nav_map_get_path_large_hierarchical(BenchmarkState &p_state) {
+	_nav_map_get_path(p_state, 450, true);
+}
+
+// A flow field computed again for a new target each iteration, then sampled by a crowd.
+static void nav_flow_field_update(BenchmarkState &p_state) {
+	const int GRID_SIZE = 450;
+	const int AGENT_COUNT = 10000;
+
+	ERR_PRINT_OFF;
+	NavigationServer3D *navigation_server = NavigationServer3DManager::new_default_server();
+	ERR_PRINT_ON;
+
+	RID map = navigation_server->map_create();
+	navigation_server->map_set_active(map, true);
+	RID region = navigation_server->region_create();
+	navigation_server->region_set_map(region, map);
+	navigation_server->region_set_navigation_mesh(region, _make_nav_grid(GRID_SIZE));
+	RID flow_field = navigation_server->flow_field_create();
+	navigation_server->flow_field_set_map(flow_field, map);
+	navigation_server->process(0.0); // Give server some cycles to commit.
+
+	RandomPCG rng(0);
+	LocalVector<Vector3> agent_positions;
+	for (int i = 0; i < AGENT_COUNT; i++) {
+		agent_positions.push_back(Vector3(rng.randf() * GRID_SIZE, 0, rng.randf() * GRID_SIZE));
+	}
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		navigation_server->flow_field_set_target_position(flow_field, Vector3(rng.randf() * GRID_SIZE, 0, rng.randf() * GRID_SIZE));
+		navigation_server->process(0.0); // Starts the update.
+		navigation_server->process(0.0); // Waits for it.
+		for (const Vector3 &position : agent_positions) {
+			BenchmarkState::do_not_optimize(navigation_server->flow_field_get_direction(flow_field, position).x);
+		}
+	}
+	p_state.stop_timer();
+
+	navigation_server->free(flow_field);
+	navigation_server->free(region);
+	navigation_server->free(map);
+	navigation_server->process(0.0); // Give server some cycles to actually remove map.
+	memdelete(navigation_server);
+}
+
+// A map made of many tiles, where one tile is moved away and back each iteration, like streaming does.
+static void nav_map_sync_region_swap(BenchmarkState &p_state) {
+	const int TILE_COUNT = 16;
+	const int TILE_SIZE = 20;
+
+	ERR_PRINT_OFF;
+	NavigationServer3D *navigation_server = NavigationServer3DManager::new_default_server();
+	ERR_PRINT_ON;
+
+	RID map = navigation_server->map_create();
+	navigation_server->map_set_active(map, true);
+
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+	PackedVector3Array vertices;
+	for (int z = 0; z <= TILE_SIZE; z++) {
+		for (int x = 0; x <= TILE_SIZE; x++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+	for (int z = 0; z < TILE_SIZE; z++) {
+		for (int x = 0; x < TILE_SIZE; x++) {
+			Vector<int> polygon;
+			polygon.push_back(z * (TILE_SIZE + 1) + x);
+			polygon.push_back(z * (TILE_SIZE + 1) + x + 1);
+			polygon.push_back((z + 1) * (TILE_SIZE + 1) + x + 1);
+			polygon.push_back((z + 1) * (TILE_SIZE + 1) + x);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+
+	LocalVector<RID> regions;
+	for (int z = 0; z < TILE_COUNT; z++) {
+		for (int x = 0; x < TILE_COUNT; x++) {
+			RID region = navigation_server->region_create();
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(x * TILE_SIZE, 0, z * TILE_SIZE)));
+			regions.push_back(region);
+		}
+	}
+	navigation_server->process(0.0); // Give server some cycles to commit.
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		const int tile = (i / 2) % regions.size();
+		const Vector3 offset = (i % 2) ? Vector3() : Vector3(0, 0, -TILE_SIZE * TILE_COUNT);
+		navigation_server->region_set_transform(regions[tile], Transform3D(Basis(), Vector3((tile % TILE_COUNT) * TILE_SIZE, 0, (tile / TILE_COUNT) * TILE_SIZE) + offset));
+		navigation_server->process(0.0);
+	}
+	p_state.stop_timer();
+
+	for (const RID &region : regions) {
+		navigation_server->free(region);
+	}
+	navigation_server->free(map);
+	navigation_server->process(0.0); // Give server some cycles to actually remove map.
+	memdelete(navigation_server);
+}
+
+// Many moving instances, updated the way RenderingServer does it every frame.
+static void renderer_scene_cull_update(BenchmarkState &p_state) {
+	const int INSTANCE_COUNT = 10000;
+
+	RasterizerDummy::make_current();
+	RenderingServerDefault *rendering_server = memnew(RenderingServerDefault());
+	rendering_server->init();
+	rendering_server->set_render_loop_enabled(false);
+
+	RID scenario = rendering_server->scenario_create();
+	RID mesh = rendering_server->mesh_create();
+
+	RandomPCG rng(0);
+	LocalVector<RID> instances;
+	LocalVector<Vector3> positions;
+	for (int i = 0; i < INSTANCE_COUNT; i++) {
+		RID instance = rendering_server->instance_create2(mesh, scenario);
+		// The dummy storage has no mesh bounds.
+		rendering_server->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+		positions.push_back(Vector3(rng.randf(), rng.randf(), rng.randf()) * 200.0);
+		rendering_server->instance_set_transform(instance, Transform3D(Basis(), positions[i]));
+		instances.push_back(instance);
+	}
+	RSG::scene->update();
+	p_state.restart_timer();
+
+	for (uint64_t i = 0; i < p_state.get_iterations(); i++) {
+		Vector3 offset(Math::sin(i * 0.1), 0, Math::cos(i * 0.1));
+		for (int j = 0; j < INSTANCE_COUNT; j++) {
+			rendering_server->instance_set_transform(instances[j], Transform3D(Basis(), positions[j] + offset));
+		}
+		RSG::scene->update();
+	}
+	p_state.stop_timer();
+
+	for (const RID &instance : instances) {
+		rendering_server->free(instance);
+	}
+	rendering_server->free(mesh);
+	rendering_server->free(scenario);
+	rendering_server->sync();
+	rendering_server->finish();
+	memdelete(rendering_server);
+}
+
+REGISTER_BENCHMARK("physics_3d/step_1000_boxes", &physics_3d_step);
+REGISTER_BENCHMARK("physics_3d/step_resting_debris_1728_boxes", &physics_3d_step_resting_debris);
+REGISTER_BENCHMARK("physics_3d/step_16_soft_bodies", &physics_3d_step_soft_bodies);
+REGISTER_BENCHMARK("physics_3d/intersect_rays_4096", &physics_3d_intersect_rays);
+REGISTER_BENCHMARK("navigation/map_get_path_grid_100", &nav_map_get_path);
+REGISTER_BENCHMARK("navigation/map_get_path_grid_450", &nav_map_get_path_large);
+REGISTER_BENCHMARK("navigation/map_get_path_grid_450_hierarchical", &nav_map_get_path_large_hierarchical);
+REGISTER_BENCHMARK("navigation/map_sync_region_swap_256_tiles", &nav_map_sync_region_swap);
+REGISTER_BENCHMARK("navigation/flow_field_update_grid_450", &nav_flow_field_update);
+REGISTER_BENCHMARK("rendering/scene_cull_update_10000", &renderer_scene_cull_update);
+
+} // namespace BenchmarkServers
+
+#endif // BENCHMARK_SERVERS_H
@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*  test_astar_grid_2d.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ASTAR_GRID_2D_H
+#define TEST_ASTAR_GRID_2D_H
+
+#include "core/math/a_star_grid_2d.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAStarGrid2D {
+
+TEST_CASE("[AStarGrid2D] Jumping") {
+	Ref<AStarGrid2D> a;
+	a.instantiate();
+	a->set_region(Rect2i(0, 0, 10, 10));
+	a->set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_NEVER);
+	a->set_jumping_enabled(true);
+	a->update();
+
+	TypedArray<Vector2i> path = a->get_id_path(Vector2i(0, 0), Vector2i(9, 0));
+	REQUIRE_EQ(path.size(), 2);
+	CHECK_EQ(Vector2i(path[0]), Vector2i(0, 0));
+	CHECK_EQ(Vector2i(path[1]), Vector2i(9, 0));
+
+	// A wall with a gap at the bottom, the jump distances must be computed again.
+	a->fill_solid_region(Rect2i(5, 0, 1, 9));
+	path = a->get_id_path(Vector2i(0, 0), Vector2i(9, 0));
+	REQUIRE_GT(path.size(), 2);
+	CHECK_EQ(Vector2i(path[0]), Vector2i(0, 0));
+	CHECK_EQ(Vector2i(path[path.size() - 1]), Vector2i(9, 0));
+	bool through_gap = false;
+	for (int i = 0; i < path.size(); i++) {
+		Vector2i id = path[i];
+		CHECK_FALSE(a->is_point_solid(id));
+		through_gap = through_gap || id.y == 9;
+	}
+	CHECK(through_gap);
+
+	a->fill_solid_region(Rect2i(5, 0, 1, 10));
+	CHECK(a->get_id_path(Vector2i(0, 0), Vector2i(9, 0)).is_empty());
+}
+
+static real_t path_cost(const TypedArray<Vector2i> &p_path) {
+	real_t cost = 0.0;
+	for (int i = 1; i < p_path.size(); i++) {
+		cost += Vector2(Vector2i(p_path[i - 1])).distance_to(Vector2(Vector2i(p_path[i])));
+	}
+	return cost;
+}
+
+TEST_CASE("[AStarGrid2D] Jumping should find paths as short as without jumping") {
+	Ref<AStarGrid2D> a;
+	a.instantiate();
+	a->set_region(Rect2i(0, 0, 32, 32));
+	a->update();
+
+	RandomPCG rng(0);
+	for (int i = 0; i < 32 * 32 / 4; i++) {
+		a->set_point_solid(Vector2i(rng.rand() % 32, rng.rand() % 32));
+	}
+
+	for (int diagonal_mode = 0; diagonal_mode < AStarGrid2D::DIAGONAL_MODE_MAX; diagonal_mode++) {
+		a->set_diagonal_mode(AStarGrid2D::DiagonalMode(diagonal_mode));
+		for (int i = 0; i < 64; i++) {
+			const Vector2i from_id = Vector2i(rng.rand() % 32, rng.rand() % 32);
+			const Vector2i to_id = Vector2i(rng.rand() % 32, rng.rand() % 32);
+
+			a->set_jumping_enabled(false);
+			const TypedArray<Vector2i> path = a->get_id_path(from_id, to_id);
+			a->set_jumping_enabled(true);
+			const TypedArray<Vector2i> jump_path = a->get_id_path(from_id, to_id);
+
+			CHECK_MESSAGE(path.is_empty() == jump_path.is_empty(), vformat("Diagonal mode %d, from %s to %s.", diagonal_mode, from_id, to_id));
+			CHECK_MESSAGE(path_cost(path) == doctest::Approx(path_cost(jump_path)), vformat("Diagonal mode %d, from %s to %s.", diagonal_mode, from_id, to_id));
+		}
+	}
+}
+
+TEST_CASE("[AStarGrid2D] Batched paths should be the same as single paths") {
+	Ref<AStarGrid2D> a;
+	a.instantiate();
+	a->set_region(Rect2i(0, 0, 64, 64));
+	a->update();
+
+	RandomPCG rng(0);
+	for (int i = 0; i < 64 * 64 / 4; i++) {
+		a->set_point_solid(Vector2i(rng.rand() % 64, rng.rand() % 64));
+	}
+
+	TypedArray<Vector2i> from_ids;
+	TypedArray<Vector2i> to_ids;
+	for (int i = 0; i < 32; i++) {
+		from_ids.push_back(Vector2i(rng.rand() % 64, rng.rand() % 64));
+		to_ids.push_back(Vector2i(rng.rand() % 64, rng.rand() % 64));
+	}
+
+	for (bool jumping_enabled : { false, true }) {
+		a->set_jumping_enabled(jumping_enabled);
+		TypedArray<PackedVector2Array> paths = a->get_point_paths(from_ids, to_ids);
+		REQUIRE_EQ(paths.size(), from_ids.size());
+		for (int i = 0; i < paths.size(); i++) {
+			CHECK(PackedVector2Array(paths[i]) == a->get_point_path(from_ids[i], to_ids[i]));
+		}
+	}
+
+	ERR_PRINT_OFF;
+	CHECK(a->get_point_paths(from_ids, TypedArray<Vector2i>()).is_empty());
+	ERR_PRINT_ON;
+}
+
+} // namespace TestAStarGrid2D
+
+#endif // TEST_ASTAR_GRID_2D_H
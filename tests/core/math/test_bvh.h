@@ -0,0 +1,280 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+#include "core/math/geometry_3d.h"
+#include "core/math/projection.h"
+#include "core/object/worker_thread_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+struct Item {
+	uint32_t index = 0;
+};
+
+template <class T>
+class PairTestFunction {
+public:
+	static bool user_pair_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+template <class T>
+class CullTestFunction {
+public:
+	static bool user_cull_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<Item, 1, false, 128, PairTestFunction<Item>, CullTestFunction<Item>> TestBVH3D;
+
+static AABB random_aabb(real_t p_extent, real_t p_min_size, real_t p_max_size) {
+	Vector3 position(Math::random(-p_extent, p_extent), Math::random(-p_extent, p_extent), Math::random(-p_extent, p_extent));
+	Vector3 size(Math::random(p_min_size, p_max_size), Math::random(p_min_size, p_max_size), Math::random(p_min_size, p_max_size));
+	return AABB(position, size);
+}
+
+static void fill_scene(TestBVH3D &r_bvh, LocalVector<Item> &r_items, LocalVector<AABB> &r_aabbs, uint32_t p_count, real_t p_extent) {
+	r_items.resize(p_count);
+	r_aabbs.resize(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_items[i].index = i;
+		r_aabbs[i] = random_aabb(p_extent, 0.5, 10.0);
+		r_bvh.create(&r_items[i], true, 0, 1, r_aabbs[i]);
+	}
+	r_bvh.update();
+}
+
+static LocalVector<uint32_t> sorted_indices(Item **p_results, int p_count) {
+	LocalVector<uint32_t> indices;
+	for (int i = 0; i < p_count; i++) {
+		indices.push_back(p_results[i]->index);
+	}
+	indices.sort();
+	return indices;
+}
+
+TEST_CASE("[BVH] SIMD and scalar culling give the same results") {
+	Math::seed(0);
+
+	const uint32_t ITEM_COUNT = 2000;
+	const int MAX_RESULTS = ITEM_COUNT;
+
+	TestBVH3D bvh;
+	LocalVector<Item> items;
+	LocalVector<AABB> aabbs;
+	fill_scene(bvh, items, aabbs, ITEM_COUNT, 200.0);
+
+	LocalVector<Item *> results;
+	results.resize(MAX_RESULTS);
+
+	Projection projection;
+	projection.set_perspective(60.0, 1.5, 0.1, 150.0);
+
+	bool aabb_match = true;
+	bool point_match = true;
+	bool segment_match = true;
+	bool convex_match = true;
+	bool convex_found_all = true;
+	for (int query = 0; query < 200; query++) {
+		const AABB query_aabb = random_aabb(200.0, 5.0, 50.0);
+		const Vector3 query_point = query_aabb.get_center();
+		const Vector3 segment_from = random_aabb(200.0, 0.0, 0.0).position;
+		Vector3 segment_to = random_aabb(200.0, 0.0, 0.0).position;
+		if (query % 4 == 0) {
+			// Axis aligned segments have slabs that the segment doesn't cross.
+			segment_to.y = segment_from.y;
+		}
+		const Vector<Plane> frustum = projection.get_projection_planes(Transform3D().looking_at(query_point, Vector3(0, 1, 0)));
+		const Vector<Vector3> frustum_points = Geometry3D::compute_convex_mesh_points(frustum.ptr(), frustum.size());
+
+		LocalVector<uint32_t> expected_aabb;
+		LocalVector<uint32_t> expected_point;
+		LocalVector<uint32_t> expected_segment;
+		for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+			if (aabbs[i].intersects_inclusive(query_aabb)) {
+				expected_aabb.push_back(i);
+			}
+			if (aabbs[i].has_point(query_point)) {
+				expected_point.push_back(i);
+			}
+			if (aabbs[i].intersects_segment(segment_from, segment_to)) {
+				expected_segment.push_back(i);
+			}
+		}
+
+		LocalVector<uint32_t> found_convex[2];
+
+		for (int simd = 0; simd < 2; simd++) {
+			bvh.params_set_simd_culling(simd);
+
+			int count = bvh.cull_aabb(query_aabb, results.ptr(), MAX_RESULTS, nullptr);
+			LocalVector<uint32_t> found = sorted_indices(results.ptr(), count);
+			aabb_match &= found.size() == expected_aabb.size();
+			for (uint32_t i = 0; aabb_match && i < found.size(); i++) {
+				aabb_match &= found[i] == expected_aabb[i];
+			}
+
+			count = bvh.cull_point(query_point, results.ptr(), MAX_RESULTS, nullptr);
+			found = sorted_indices(results.ptr(), count);
+			point_match &= found.size() == expected_point.size();
+			for (uint32_t i = 0; point_match && i < found.size(); i++) {
+				point_match &= found[i] == expected_point[i];
+			}
+
+			count = bvh.cull_segment(segment_from, segment_to, results.ptr(), MAX_RESULTS, nullptr);
+			found = sorted_indices(results.ptr(), count);
+			segment_match &= found.size() == expected_segment.size();
+			for (uint32_t i = 0; segment_match && i < found.size(); i++) {
+				segment_match &= found[i] == expected_segment[i];
+			}
+
+			count = bvh.cull_convex(frustum, results.ptr(), MAX_RESULTS, nullptr);
+			found_convex[simd] = sorted_indices(results.ptr(), count);
+		}
+
+		// The leaf test of convex culling is conservative, so it's only compared with brute force one way.
+		convex_match &= found_convex[0].size() == found_convex[1].size();
+		for (uint32_t i = 0; convex_match && i < found_convex[0].size(); i++) {
+			convex_match &= found_convex[0][i] == found_convex[1][i];
+		}
+		for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+			if (aabbs[i].intersects_convex_shape(frustum.ptr(), frustum.size(), frustum_points.ptr(), frustum_points.size()) && found_convex[1].find(i) < 0) {
+				convex_found_all = false;
+			}
+		}
+	}
+
+	CHECK_MESSAGE(aabb_match, "AABB culling should find the same items as brute force, with and without SIMD.");
+	CHECK_MESSAGE(point_match, "Point culling should find the same items as brute force, with and without SIMD.");
+	CHECK_MESSAGE(segment_match, "Segment culling should find the same items as brute force, with and without SIMD.");
+	CHECK_MESSAGE(convex_match, "Convex culling should find the same items with and without SIMD.");
+	CHECK_MESSAGE(convex_found_all, "Convex culling should find every item inside the frustum.");
+}
+
+typedef BVH_Manager<Item, 1, true, 128, PairTestFunction<Item>, CullTestFunction<Item>> TestPairingBVH3D;
+
+// Pair and unpair callbacks, in the order they are received.
+struct PairingLog {
+	LocalVector<uint32_t> events;
+
+	static void *pair_callback(void *p_self, uint32_t p_id_a, Item *p_item_a, int p_subindex_a, uint32_t p_id_b, Item *p_item_b, int p_subindex_b) {
+		PairingLog *self = (PairingLog *)p_self;
+		self->events.push_back(1);
+		self->events.push_back(p_item_a->index);
+		self->events.push_back(p_item_b->index);
+		return nullptr;
+	}
+
+	static void unpair_callback(void *p_self, uint32_t p_id_a, Item *p_item_a, int p_subindex_a, uint32_t p_id_b, Item *p_item_b, int p_subindex_b, void *p_pair_data) {
+		PairingLog *self = (PairingLog *)p_self;
+		self->events.push_back(0);
+		self->events.push_back(p_item_a->index);
+		self->events.push_back(p_item_b->index);
+	}
+};
+
+// Creates items and moves them around for a few updates, logging the callbacks.
+static void run_pairing_scene(bool p_parallel, PairingLog &r_log) {
+	Math::seed(0);
+
+	const uint32_t ITEM_COUNT = 1000;
+
+	LocalVector<Item> items;
+	LocalVector<AABB> aabbs;
+	LocalVector<BVHHandle> handles;
+	items.resize(ITEM_COUNT);
+	aabbs.resize(ITEM_COUNT);
+	handles.resize(ITEM_COUNT);
+
+	TestPairingBVH3D bvh;
+	bvh.set_pair_callback(PairingLog::pair_callback, &r_log);
+	bvh.set_unpair_callback(PairingLog::unpair_callback, &r_log);
+	bvh.params_set_parallel_pairing(p_parallel, 1);
+
+	for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+		items[i].index = i;
+		aabbs[i] = random_aabb(100.0, 0.5, 10.0);
+		handles[i] = bvh.create(&items[i], true, 0, 1, aabbs[i]);
+	}
+	bvh.update();
+
+	for (int step = 0; step < 10; step++) {
+		for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+			aabbs[i].position += Vector3(Math::random(-5.0, 5.0), Math::random(-5.0, 5.0), Math::random(-5.0, 5.0));
+			bvh.move(handles[i], aabbs[i]);
+		}
+		bvh.update();
+	}
+
+	for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+		bvh.erase(handles[i]);
+	}
+}
+
+TEST_CASE("[BVH] Parallel and serial pairing send the same callbacks in the same order") {
+	// Parallel pairing needs more than one pool thread.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const int thread_count = pool->get_thread_count();
+	const WorkerThreadPool::SchedulerMode scheduler_mode = pool->get_scheduler_mode();
+	if (thread_count < 2) {
+		pool->finish();
+		pool->init(4, 0.3, scheduler_mode);
+	}
+
+	PairingLog serial;
+	PairingLog parallel;
+	run_pairing_scene(false, serial);
+	run_pairing_scene(true, parallel);
+
+	CHECK_MESSAGE(serial.events.size() > 0, "The scene should create and remove pairs.");
+	CHECK(serial.events.size() == parallel.events.size());
+	bool same_events = serial.events.size() == parallel.events.size();
+	for (uint32_t i = 0; same_events && i < serial.events.size(); i++) {
+		same_events = serial.events[i] == parallel.events[i];
+	}
+	CHECK_MESSAGE(same_events, "Pair and unpair callbacks should match the serial path exactly.");
+
+	if (thread_count < 2) {
+		pool->finish();
+		pool->init(thread_count, 0.3, scheduler_mode);
+	}
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
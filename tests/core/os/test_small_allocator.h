@@ -0,0 +1,116 @@
+/**************************************************************************/
+/*  test_small_allocator.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SMALL_ALLOCATOR_H
+#define TEST_SMALL_ALLOCATOR_H
+
+#include "core/os/small_allocator.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallAllocator {
+
+TEST_CASE("[SmallAllocator] Size classes") {
+	for (uint32_t i = 1; i < SmallAllocator::CLASS_COUNT; i++) {
+		CHECK(SmallAllocator::get_class_size(i) > SmallAllocator::get_class_size(i - 1));
+		CHECK(SmallAllocator::get_class_size(i) % 16 == 0);
+	}
+	CHECK(SmallAllocator::get_class_size(SmallAllocator::CLASS_COUNT - 1) == SmallAllocator::MAX_SIZE);
+}
+
+TEST_CASE("[SmallAllocator] Allocate and free") {
+	LocalVector<uint8_t *> blocks;
+	for (uint32_t size = 1; size <= SmallAllocator::MAX_SIZE; size += 7) {
+		uint8_t *block = static_cast<uint8_t *>(SmallAllocator::alloc(size));
+		REQUIRE(block != nullptr);
+		CHECK(SmallAllocator::owns(block));
+		CHECK(uintptr_t(block) % 16 == 0);
+		memset(block, size & 0xFF, size);
+		blocks.push_back(block);
+	}
+	for (uint32_t i = 0; i < blocks.size(); i++) {
+		const uint32_t size = 1 + i * 7;
+		CHECK(blocks[i][size - 1] == (size & 0xFF));
+		SmallAllocator::free(blocks[i]);
+	}
+
+	void *large = SmallAllocator::alloc(SmallAllocator::MAX_SIZE + 1);
+	CHECK_FALSE(SmallAllocator::owns(large));
+	SmallAllocator::free(large);
+	CHECK(SmallAllocator::get_reserved_bytes() > 0);
+}
+
+TEST_CASE("[SmallAllocator] Reallocate keeps the contents") {
+	uint8_t *block = static_cast<uint8_t *>(SmallAllocator::alloc(20));
+	for (int i = 0; i < 20; i++) {
+		block[i] = i;
+	}
+
+	// Within the same size class, then to a larger class, then past the largest one.
+	block = static_cast<uint8_t *>(SmallAllocator::realloc(block, 30));
+	block = static_cast<uint8_t *>(SmallAllocator::realloc(block, 200));
+	CHECK(SmallAllocator::owns(block));
+	block = static_cast<uint8_t *>(SmallAllocator::realloc(block, 4096));
+	CHECK_FALSE(SmallAllocator::owns(block));
+	for (int i = 0; i < 20; i++) {
+		CHECK(block[i] == i);
+	}
+	SmallAllocator::free(block);
+}
+
+static void free_blocks(void *p_userdata) {
+	LocalVector<void *> *blocks = static_cast<LocalVector<void *> *>(p_userdata);
+	for (void *block : *blocks) {
+		SmallAllocator::free(block);
+	}
+}
+
+TEST_CASE("[SmallAllocator] Free from another thread") {
+	// More blocks than a thread cache keeps, so some go back to the central list.
+	LocalVector<void *> blocks;
+	for (int i = 0; i < 1000; i++) {
+		blocks.push_back(SmallAllocator::alloc(64));
+	}
+
+	Thread thread;
+	thread.start(free_blocks, &blocks);
+	thread.wait_to_finish();
+
+	CHECK(SmallAllocator::get_class_free_bytes(3) > 0);
+	void *block = SmallAllocator::alloc(64);
+	CHECK(SmallAllocator::owns(block));
+	SmallAllocator::free(block);
+}
+
+} // namespace TestSmallAllocator
+
+#endif // TEST_SMALL_ALLOCATOR_H
@@ -0,0 +1,160 @@
+/**************************************************************************/
+/*  test_flat_hash_map.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FLAT_HASH_MAP_H
+#define TEST_FLAT_HASH_MAP_H
+
+#include "core/templates/flat_hash_map.h"
+#include "core/templates/hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFlatHashMap {
+
+TEST_CASE("[FlatHashMap] Insert element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Overwrite element") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[FlatHashMap] Erase via element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Erase via key") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	CHECK(map.erase(42));
+	CHECK_FALSE(map.erase(42));
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Empty map") {
+	FlatHashMap<int, int> map;
+	CHECK(map.is_empty());
+	CHECK(!map.has(42));
+	CHECK(map.getptr(42) == nullptr);
+	CHECK(map.begin() == map.end());
+
+	map.reserve(100);
+	CHECK(map.get_capacity() >= 100);
+	CHECK(map.begin() == map.end());
+}
+
+TEST_CASE("[FlatHashMap] Matches HashMap with many inserts and erases") {
+	FlatHashMap<uint32_t, uint32_t> map;
+	HashMap<uint32_t, uint32_t> reference;
+
+	// Mixes growing with erasing, which leaves deleted slots behind to be reused or rehashed.
+	for (uint32_t i = 0; i < 20000; i++) {
+		const uint32_t key = (i * 2654435761u) % 5000;
+		if (i % 3 == 0) {
+			CHECK(map.erase(key) == reference.erase(key));
+		} else {
+			map.insert(key, i);
+			reference.insert(key, i);
+		}
+	}
+
+	CHECK(map.size() == reference.size());
+	for (const KeyValue<uint32_t, uint32_t> &E : reference) {
+		const uint32_t *value = map.getptr(E.key);
+		REQUIRE(value != nullptr);
+		CHECK(*value == E.value);
+	}
+
+	uint32_t count = 0;
+	for (const KeyValue<uint32_t, uint32_t> &E : map) {
+		CHECK(reference.has(E.key));
+		count++;
+	}
+	CHECK(count == map.size());
+}
+
+TEST_CASE("[FlatHashMap] Remove while iterating") {
+	FlatHashMap<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, i);
+	}
+
+	for (FlatHashMap<int, int>::Iterator it = map.begin(); it; ++it) {
+		if (it->key % 2) {
+			map.remove(it);
+		}
+	}
+
+	CHECK(map.size() == 50);
+	for (int i = 0; i < 100; i++) {
+		CHECK(map.has(i) == !(i % 2));
+	}
+}
+
+TEST_CASE("[FlatHashMap] String keys and copies") {
+	FlatHashMap<String, int> map;
+	for (int i = 0; i < 1000; i++) {
+		map["key_" + itos(i)] = i;
+	}
+
+	const FlatHashMap<String, int> copy = map;
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(copy.size() == 1000);
+	for (int i = 0; i < 1000; i++) {
+		CHECK(copy["key_" + itos(i)] == i);
+	}
+
+	map = copy;
+	CHECK(map.size() == 1000);
+	CHECK(map.get("key_500") == 500);
+}
+
+} // namespace TestFlatHashMap
+
+#endif // TEST_FLAT_HASH_MAP_H
@@ -31,7 +31,9 @@
 #ifndef TEST_RID_H
 #define TEST_RID_H
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/rid.h"
+#include "core/templates/rid_owner.h"
 
 #include "tests/test_macros.h"
 
@@ -96,6 +98,58 @@ TEST_CASE("[RID] 'get_local_index'") {
 	CHECK(RID::from_uint64(4'294'967'295).get_local_index() == 4'294'967'295);
 	CHECK(RID::from_uint64(4'294'967'297).get_local_index() == 1);
 }
+
+struct RIDOwnerThreads {
+	// Small chunks, so the chunk arrays grow while they're being read.
+	RID_Owner<uint64_t, true> owner = RID_Owner<uint64_t, true>(256);
+	LocalVector<RID> shared_rids;
+	SafeNumeric<uint32_t> failures;
+
+	// Half of the workers look up the shared RIDs while the other half
+	// keep allocating and freeing their own, growing the chunk arrays.
+	void run(uint32_t p_index, void *p_userdata) {
+		if (p_index % 2 == 0) {
+			for (uint32_t i = 0; i < 20000; i++) {
+				const uint32_t j = (i + p_index) % shared_rids.size();
+				const uint64_t *value = owner.get_or_null(shared_rids[j]);
+				if (!value || *value != j || !owner.owns(shared_rids[j])) {
+					failures.increment();
+				}
+			}
+		} else {
+			LocalVector<RID> own_rids;
+			for (uint32_t i = 0; i < 5000; i++) {
+				own_rids.push_back(owner.make_rid(i));
+			}
+			for (uint32_t i = 0; i < own_rids.size(); i++) {
+				const uint64_t *value = owner.get_or_null(own_rids[i]);
+				if (!value || *value != i) {
+					failures.increment();
+				}
+				owner.free(own_rids[i]);
+			}
+		}
+	}
+};
+
+TEST_CASE("[RID_Owner] Thread safe lookups while allocating and freeing") {
+	RIDOwnerThreads threads;
+	for (uint64_t i = 0; i < 100; i++) {
+		threads.shared_rids.push_back(threads.owner.make_rid(i));
+	}
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&threads, &RIDOwnerThreads::run, nullptr, 8, -1, true, SNAME("RIDOwnerThreads"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK(threads.failures.get() == 0);
+	CHECK(threads.owner.get_rid_count() == 100);
+
+	for (const RID &rid : threads.shared_rids) {
+		threads.owner.free(rid);
+	}
+	CHECK_FALSE(threads.owner.owns(threads.shared_rids[0]));
+	CHECK(threads.owner.get_or_null(threads.shared_rids[0]) == nullptr);
+}
 } // namespace TestRID
 
 #endif // TEST_RID_H
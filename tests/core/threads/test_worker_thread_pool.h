@@ -106,6 +106,152 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static void static_increment_test(void *p_arg) {
+	counter[(uint64_t)p_arg].increment();
+}
+static void static_increment_group_test(void *p_arg, uint32_t p_index) {
+	counter[p_index].increment();
+}
+static void static_nested_test(void *p_arg) {
+	// Posted from a pool thread, so in work-stealing mode these go to its own deque.
+	// Waiting on individual tasks lets this thread process them too, so it can't starve the pool.
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(counter.size());
+	for (uint32_t i = 0; i < counter.size(); i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_increment_test, (void *)(uintptr_t)i, true);
+	}
+	for (uint32_t i = 0; i < counter.size(); i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Work-stealing scheduler") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	pool->finish();
+	pool->init(-1, 0.3, WorkerThreadPool::SCHEDULER_MODE_WORK_STEALING);
+	CHECK(pool->get_scheduler_mode() == WorkerThreadPool::SCHEDULER_MODE_WORK_STEALING);
+
+	SUBCASE("Individual tasks") {
+		for (int iterations = 0; iterations < 100; iterations++) {
+			const int count = Math::pow(2.0f, Math::random(0.0f, 8.0f));
+
+			LocalVector<WorkerThreadPool::TaskID> tasks;
+			tasks.resize(count);
+
+			counter.clear();
+			counter.resize(count);
+			for (int i = 0; i < count; i++) {
+				tasks[i] = pool->add_native_task(static_increment_test, (void *)(uintptr_t)i, true);
+			}
+			for (int i = 0; i < count; i++) {
+				pool->wait_for_task_completion(tasks[i]);
+			}
+
+			bool all_run_once = true;
+			for (int i = 0; i < count; i++) {
+				all_run_once &= counter[i].get() == 1;
+			}
+			CHECK(all_run_once);
+		}
+	}
+
+	SUBCASE("Tasks posted from inside and outside the pool") {
+		for (int iterations = 0; iterations < 100; iterations++) {
+			const int count = Math::pow(2.0f, Math::random(0.0f, 8.0f));
+			const int tasks = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+
+			counter.clear();
+			counter.resize(count);
+			WorkerThreadPool::GroupID group = pool->add_native_group_task(static_increment_group_test, nullptr, count, tasks, true);
+			pool->wait_for_group_task_completion(group);
+			WorkerThreadPool::TaskID nested = pool->add_native_task(static_nested_test, nullptr, true);
+			pool->wait_for_task_completion(nested);
+
+			bool all_run_twice = true;
+			for (int i = 0; i < count; i++) {
+				all_run_twice &= counter[i].get() == 2;
+			}
+			CHECK(all_run_twice);
+		}
+	}
+
+	pool->finish();
+	pool->init();
+	CHECK(pool->get_scheduler_mode() == WorkerThreadPool::SCHEDULER_MODE_SHARED_QUEUE);
+}
+
+static SafeNumeric<uint32_t> graph_sequence;
+static uint32_t graph_finish_order[6];
+static SafeNumeric<uint32_t> graph_group_elements;
+
+static void static_graph_node_test(void *p_arg) {
+	graph_finish_order[(uintptr_t)p_arg] = graph_sequence.increment();
+}
+static void static_graph_group_test(void *p_arg, uint32_t p_index) {
+	graph_group_elements.increment();
+	if (p_index == 0) {
+		// Any element is fine to record the order, since successors only run after all of them.
+		graph_finish_order[(uintptr_t)p_arg] = graph_sequence.increment();
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Task graph") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	SUBCASE("Nodes run after their predecessors") {
+		for (int iterations = 0; iterations < 100; iterations++) {
+			graph_sequence.set(0);
+			graph_group_elements.set(0);
+			memset(graph_finish_order, 0, sizeof(graph_finish_order));
+			const int elements = Math::pow(2.0f, Math::random(0.0f, 8.0f));
+
+			// Diamond with a group in one branch: 0 -> (1 -> 3, 2) -> 4 -> 5.
+			WorkerThreadPool::TaskGraph graph;
+			uint32_t n0 = graph.add_native_task(static_graph_node_test, (void *)0);
+			uint32_t n1 = graph.add_native_task(static_graph_node_test, (void *)1, { n0 });
+			uint32_t n2 = graph.add_native_group_task(static_graph_group_test, (void *)2, elements, -1, { n0 });
+			uint32_t n3 = graph.add_native_task(static_graph_node_test, (void *)3, { n1 });
+			uint32_t n4 = graph.add_native_task(static_graph_node_test, (void *)4, { n3, n2 });
+			uint32_t n5 = graph.add_native_task(static_graph_node_test, (void *)5);
+			graph.add_dependency(n5, n4);
+			CHECK(graph.get_node_count() == 6);
+
+			WorkerThreadPool::TaskGraphID id = pool->submit_task_graph(graph, iterations % 2);
+			CHECK(graph.get_node_count() == 0);
+			pool->wait_for_task_graph_completion(id);
+
+			CHECK(graph_sequence.get() == 6);
+			CHECK(graph_group_elements.get() == (uint32_t)elements);
+			CHECK(graph_finish_order[n0] < graph_finish_order[n1]);
+			CHECK(graph_finish_order[n0] < graph_finish_order[n2]);
+			CHECK(graph_finish_order[n1] < graph_finish_order[n3]);
+			CHECK(graph_finish_order[n3] < graph_finish_order[n4]);
+			CHECK(graph_finish_order[n2] < graph_finish_order[n4]);
+			CHECK(graph_finish_order[n4] < graph_finish_order[n5]);
+		}
+	}
+
+	SUBCASE("Empty graph") {
+		WorkerThreadPool::TaskGraph graph;
+		WorkerThreadPool::TaskGraphID id = pool->submit_task_graph(graph);
+		CHECK(pool->is_task_graph_completed(id));
+		pool->wait_for_task_graph_completion(id);
+	}
+
+	SUBCASE("Circular dependencies are rejected") {
+		WorkerThreadPool::TaskGraph graph;
+		uint32_t a = graph.add_native_task(static_graph_node_test, (void *)0);
+		uint32_t b = graph.add_native_task(static_graph_node_test, (void *)1, { a });
+		graph.add_dependency(a, b);
+
+		ERR_PRINT_OFF;
+		CHECK(pool->submit_task_graph(graph) == WorkerThreadPool::INVALID_TASK_ID);
+		ERR_PRINT_ON;
+		// Not submitted, so it's still owned by the caller.
+		CHECK(graph.get_node_count() == 2);
+	}
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
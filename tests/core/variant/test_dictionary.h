@@ -537,6 +537,35 @@ TEST_CASE("[Dictionary] Order and find") {
 	CHECK_EQ(d.find_key("does not exist"), Variant());
 }
 
+TEST_CASE("[Dictionary] Values stay in place while growing and erasing") {
+	Dictionary d;
+	d["first"] = 1;
+	const Variant *first = d.getptr("first");
+
+	// Goes well past the elements allocated together, reusing freed ones in between.
+	for (int i = 0; i < 64; i++) {
+		d[i] = i * 2;
+		if (i % 3 == 0) {
+			d.erase(i);
+		}
+	}
+	CHECK(d.getptr("first") == first);
+	CHECK(int(*first) == 1);
+
+	CHECK(d.size() == 43);
+	for (int i = 0; i < 64; i++) {
+		CHECK(d.has(i) == (i % 3 != 0));
+		if (i % 3 != 0) {
+			CHECK(int(d[i]) == i * 2);
+		}
+	}
+
+	d.clear();
+	d[100] = 200;
+	CHECK(d.size() == 1);
+	CHECK(int(d[100]) == 200);
+}
+
 } // namespace TestDictionary
 
 #endif // TEST_DICTIONARY_H
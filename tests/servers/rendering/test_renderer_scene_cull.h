@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "core/math/random_pcg.h"
+#include "servers/rendering/dummy/rasterizer_dummy.h"
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server_default.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+// What the instance updates leave in the scenario, by instance creation order.
+struct CullState {
+	LocalVector<AABB> indexer_aabbs;
+	LocalVector<AABB> cull_aabbs;
+	LocalVector<Vector<uint32_t>> pairs;
+};
+
+static CullState get_cull_state(RendererSceneCull *p_scene_cull, const LocalVector<RID> &p_instances) {
+	HashMap<const RendererSceneCull::Instance *, uint32_t> indices;
+	for (uint32_t i = 0; i < p_instances.size(); i++) {
+		indices.insert(p_scene_cull->instance_owner.get_or_null(p_instances[i]), i);
+	}
+
+	CullState state;
+	state.pairs.resize(p_instances.size());
+	for (uint32_t i = 0; i < p_instances.size(); i++) {
+		const RendererSceneCull::Instance *instance = p_scene_cull->instance_owner.get_or_null(p_instances[i]);
+		const RendererSceneCull::Scenario *scenario = instance->scenario;
+		const bool is_geometry = (1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK;
+		const DynamicBVH &indexer = scenario->indexers[is_geometry ? RendererSceneCull::Scenario::INDEXER_GEOMETRY : RendererSceneCull::Scenario::INDEXER_VOLUMES];
+		state.indexer_aabbs.push_back(indexer.get_aabb(instance->indexer_id));
+
+		const real_t *bounds = scenario->instance_aabbs[instance->array_index].bounds;
+		state.cull_aabbs.push_back(AABB(Vector3(bounds[0], bounds[1], bounds[2]), Vector3(bounds[3] - bounds[0], bounds[4] - bounds[1], bounds[5] - bounds[2])));
+
+		for (const SelfList<RendererSceneCull::InstancePair> *E = instance->pairs.first(); E; E = E->next()) {
+			const RendererSceneCull::InstancePair *pair = E->self();
+			state.pairs[i].push_back(indices[pair->a == instance ? pair->b : pair->a]);
+		}
+		state.pairs[i].sort();
+	}
+	return state;
+}
+
+// Moving boxes and lights, updated for a few frames with the given threshold for threaded updates.
+static LocalVector<CullState> update_moving_instances(uint32_t p_thread_cull_threshold) {
+	const int GEOMETRY_COUNT = 400;
+	const int LIGHT_COUNT = 40;
+	const int FRAME_COUNT = 4;
+
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+	const uint32_t previous_threshold = scene_cull->thread_cull_threshold;
+	scene_cull->thread_cull_threshold = p_thread_cull_threshold;
+
+	RenderingServer *rendering_server = RenderingServer::get_singleton();
+	RID scenario = rendering_server->scenario_create();
+	RID mesh = rendering_server->mesh_create();
+
+	RandomPCG rng(0);
+	LocalVector<RID> instances;
+	LocalVector<RID> lights;
+	LocalVector<Vector3> positions;
+	for (int i = 0; i < GEOMETRY_COUNT; i++) {
+		RID instance = rendering_server->instance_create2(mesh, scenario);
+		// The dummy storage has no mesh bounds.
+		rendering_server->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+		instances.push_back(instance);
+		positions.push_back(Vector3(rng.randf(), rng.randf(), rng.randf()) * 20.0);
+	}
+	for (int i = 0; i < LIGHT_COUNT; i++) {
+		RID light = i % 2 ? rendering_server->spot_light_create() : rendering_server->omni_light_create();
+		rendering_server->light_set_param(light, RS::LIGHT_PARAM_RANGE, 3.0);
+		lights.push_back(light);
+		instances.push_back(rendering_server->instance_create2(light, scenario));
+		positions.push_back(Vector3(rng.randf(), rng.randf(), rng.randf()) * 20.0);
+	}
+
+	LocalVector<CullState> states;
+	for (int frame = 0; frame < FRAME_COUNT; frame++) {
+		// Small moves are quantized in the indexers, large ones aren't.
+		const Vector3 offset = Vector3(Math::sin(frame * 0.7), 0, Math::cos(frame * 0.7)) * (frame % 2 ? 0.2 : 3.0);
+		for (uint32_t i = 0; i < instances.size(); i++) {
+			const Basis basis = i % 3 ? Basis() : Basis::from_euler(Vector3(0, frame * 0.5, 0));
+			rendering_server->instance_set_transform(instances[i], Transform3D(basis, positions[i] + offset * (i % 2 ? 1.0 : -1.0)));
+		}
+		scene_cull->update();
+		states.push_back(get_cull_state(scene_cull, instances));
+	}
+
+	for (const RID &instance : instances) {
+		rendering_server->free(instance);
+	}
+	for (const RID &light : lights) {
+		rendering_server->free(light);
+	}
+	rendering_server->free(mesh);
+	rendering_server->free(scenario);
+
+	scene_cull->thread_cull_threshold = previous_threshold;
+	return states;
+}
+
+TEST_CASE("[RendererSceneCull] Threaded instance updates match the serial ones") {
+	RasterizerDummy::make_current();
+	RenderingServerDefault *rendering_server = memnew(RenderingServerDefault());
+	rendering_server->init();
+	rendering_server->set_render_loop_enabled(false);
+
+	const LocalVector<CullState> serial_states = update_moving_instances(UINT32_MAX);
+	const LocalVector<CullState> threaded_states = update_moving_instances(0);
+
+	uint32_t pair_count = 0;
+	for (uint32_t frame = 0; frame < serial_states.size(); frame++) {
+		const CullState &serial = serial_states[frame];
+		const CullState &threaded = threaded_states[frame];
+		for (uint32_t i = 0; i < serial.pairs.size(); i++) {
+			CHECK_MESSAGE(threaded.indexer_aabbs[i] == serial.indexer_aabbs[i], vformat("Different indexer AABB for instance %d in frame %d.", i, frame));
+			CHECK_MESSAGE(threaded.cull_aabbs[i] == serial.cull_aabbs[i], vformat("Different cull AABB for instance %d in frame %d.", i, frame));
+			CHECK_MESSAGE(threaded.pairs[i] == serial.pairs[i], vformat("Different pairs for instance %d in frame %d.", i, frame));
+			pair_count += serial.pairs[i].size();
+		}
+	}
+	// The lights must reach some of the boxes for the pairs to be compared.
+	CHECK(pair_count > 0);
+
+	rendering_server->sync();
+	rendering_server->finish();
+	memdelete(rendering_server);
+}
+
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H
@@ -721,6 +721,232 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should find paths around walls") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int GRID_SIZE = 20;
+		const int WALL_X = 10;
+
+		// A grid of quads, with a wall in the middle column that only has a gap at the far end.
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		PackedVector3Array vertices;
+		for (int z = 0; z <= GRID_SIZE; z++) {
+			for (int x = 0; x <= GRID_SIZE; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < GRID_SIZE; z++) {
+			for (int x = 0; x < GRID_SIZE; x++) {
+				if (x == WALL_X && z != GRID_SIZE - 1) {
+					continue;
+				}
+				Vector<int> polygon;
+				polygon.push_back(z * (GRID_SIZE + 1) + x);
+				polygon.push_back(z * (GRID_SIZE + 1) + x + 1);
+				polygon.push_back((z + 1) * (GRID_SIZE + 1) + x + 1);
+				polygon.push_back((z + 1) * (GRID_SIZE + 1) + x);
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_edge_connections(map, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 start = Vector3(0.5, 0, 0.5);
+		const Vector3 target = Vector3(GRID_SIZE - 0.5, 0, 0.5);
+
+		SUBCASE("Path should go through the gap in the wall") {
+			Vector<Vector3> path = navigation_server->map_get_path(map, start, target, false);
+			REQUIRE_GT(path.size(), 2);
+			CHECK(path[0].is_equal_approx(start));
+			CHECK(path[path.size() - 1].is_equal_approx(target));
+			real_t max_z = 0.0;
+			for (const Vector3 &point : path) {
+				max_z = MAX(max_z, point.z);
+			}
+			CHECK_GE(max_z, GRID_SIZE - 1);
+		}
+
+		SUBCASE("Hierarchical pathfinding should find the same path") {
+			Vector<Vector3> path = navigation_server->map_get_path(map, start, target, true);
+			Vector<Vector3> reverse_path = navigation_server->map_get_path(map, target, start, true);
+			navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK(navigation_server->map_get_use_hierarchical_pathfinding(map));
+			CHECK(navigation_server->map_get_path(map, start, target, true) == path);
+			CHECK(navigation_server->map_get_path(map, target, start, true) == reverse_path);
+			navigation_server->map_set_use_hierarchical_pathfinding(map, false);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+		}
+
+		SUBCASE("Repeated queries should return the same path") {
+			Vector<Vector3> path = navigation_server->map_get_path(map, start, target, true);
+			CHECK_GT(path.size(), 2);
+			navigation_server->map_get_path(map, target, start, true);
+			CHECK(navigation_server->map_get_path(map, start, target, true) == path);
+		}
+
+		SUBCASE("Batched queries should return the same paths as single queries") {
+			TypedArray<NavigationPathQueryParameters3D> query_parameters;
+			TypedArray<NavigationPathQueryResult3D> query_results;
+			for (int i = 0; i < 16; i++) {
+				Ref<NavigationPathQueryParameters3D> parameters = memnew(NavigationPathQueryParameters3D);
+				parameters->set_map(map);
+				parameters->set_start_position(Vector3(0.5, 0, 0.5 + i));
+				parameters->set_target_position(Vector3(GRID_SIZE - 0.5, 0, GRID_SIZE - 0.5 - i));
+				query_parameters.push_back(parameters);
+				query_results.push_back(memnew(NavigationPathQueryResult3D));
+			}
+
+			CallableMock batch_callback_mock;
+			const int64_t batch_id = navigation_server->query_paths_async(query_parameters, query_results, callable_mp(&batch_callback_mock, &CallableMock::function1).bind(0));
+			navigation_server->wait_for_path_query_batch(batch_id);
+			CHECK(navigation_server->is_path_query_batch_completed(batch_id));
+			CHECK_EQ(batch_callback_mock.function1_calls, 1);
+
+			for (int i = 0; i < query_parameters.size(); i++) {
+				Ref<NavigationPathQueryParameters3D> parameters = query_parameters[i];
+				Ref<NavigationPathQueryResult3D> result = query_results[i];
+				CHECK(result->get_path() == navigation_server->map_get_path(map, parameters->get_start_position(), parameters->get_target_position(), true));
+			}
+		}
+
+		SUBCASE("Flow field should lead through the gap in the wall") {
+			RID flow_field = navigation_server->flow_field_create();
+			navigation_server->flow_field_set_map(flow_field, map);
+			navigation_server->flow_field_set_target_position(flow_field, target);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			navigation_server->process(0.0); // Wait for the flow field to be computed.
+			CHECK_EQ(navigation_server->flow_field_get_map(flow_field), map);
+			CHECK_EQ(navigation_server->flow_field_get_target_position(flow_field), target);
+
+			const Vector3 along_wall = Vector3(WALL_X - 0.5, 0, 0.5);
+			CHECK(navigation_server->flow_field_get_direction(flow_field, along_wall).is_equal_approx(Vector3(0, 0, 1)));
+			CHECK(navigation_server->flow_field_get_direction(flow_field, Vector3(-5, 0, -5)) == Vector3());
+			CHECK_GT(navigation_server->flow_field_get_distance(flow_field, along_wall), 2 * (GRID_SIZE - 2));
+			CHECK_LT(navigation_server->flow_field_get_distance(flow_field, target), CMP_EPSILON);
+
+			// Blocking the gap leaves no way to the target from the other side of the wall.
+			RID obstacle = navigation_server->obstacle_create();
+			Vector<Vector3> obstacle_vertices;
+			obstacle_vertices.push_back(Vector3(WALL_X, 0, GRID_SIZE - 1));
+			obstacle_vertices.push_back(Vector3(WALL_X + 1, 0, GRID_SIZE - 1));
+			obstacle_vertices.push_back(Vector3(WALL_X + 1, 0, GRID_SIZE));
+			obstacle_vertices.push_back(Vector3(WALL_X, 0, GRID_SIZE));
+			navigation_server->obstacle_set_vertices(obstacle, obstacle_vertices);
+			navigation_server->obstacle_set_map(obstacle, map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			navigation_server->process(0.0); // Wait for the flow field to be computed.
+			CHECK(navigation_server->flow_field_get_direction(flow_field, along_wall) == Vector3());
+			CHECK(Math::is_inf(navigation_server->flow_field_get_distance(flow_field, along_wall)));
+			CHECK_GT(navigation_server->flow_field_get_direction(flow_field, Vector3(GRID_SIZE - 0.5, 0, 5.5)).dot(Vector3(0, 0, -1)), 0.5);
+
+			navigation_server->free(obstacle);
+			navigation_server->free(flow_field);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should reconnect only the regions that changed") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		PackedVector3Array vertices;
+		vertices.push_back(Vector3(0, 0, 0));
+		vertices.push_back(Vector3(10, 0, 0));
+		vertices.push_back(Vector3(10, 0, 10));
+		vertices.push_back(Vector3(0, 0, 10));
+		navigation_mesh->set_vertices(vertices);
+		Vector<int> polygon;
+		polygon.push_back(0);
+		polygon.push_back(1);
+		polygon.push_back(2);
+		polygon.push_back(3);
+		navigation_mesh->add_polygon(polygon);
+
+		RID map = navigation_server->map_create();
+		RID region_a = navigation_server->region_create();
+		RID region_b = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region_a, map);
+		navigation_server->region_set_navigation_mesh(region_a, navigation_mesh);
+		navigation_server->region_set_map(region_b, map);
+		navigation_server->region_set_navigation_mesh(region_b, navigation_mesh);
+		navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(10, 0, 0)));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 start = Vector3(5, 0, 5);
+		const Vector3 target = Vector3(15, 0, 5);
+
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 2);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), 7);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 1);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT), 6);
+		Vector<Vector3> path = navigation_server->map_get_path(map, start, target, true);
+		REQUIRE_FALSE(path.is_empty());
+		CHECK(path[path.size() - 1].is_equal_approx(target));
+
+		SUBCASE("Moving a region should unmerge and merge its edges") {
+			navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(30, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), 8);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 0);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT), 8);
+			path = navigation_server->map_get_path(map, start, Vector3(35, 0, 5), true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK_LE(path[path.size() - 1].x, 10.0);
+
+			navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(10, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 1);
+			path = navigation_server->map_get_path(map, start, target, true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].is_equal_approx(target));
+		}
+
+		SUBCASE("Regions close to each other should be connected through their free edges") {
+			navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(10.1, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 0);
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+			CHECK_EQ(navigation_server->region_get_connections_count(region_b), 1);
+			path = navigation_server->map_get_path(map, start, target, true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].is_equal_approx(target));
+
+			navigation_server->region_set_enabled(region_b, false);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 1);
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 0);
+		}
+
+		SUBCASE("Removing a region should free the edges merged with it") {
+			navigation_server->free(region_b);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			region_b = RID();
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 1);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), 4);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 0);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT), 4);
+		}
+
+		if (region_b.is_valid()) {
+			navigation_server->free(region_b);
+		}
+		navigation_server->free(region_a);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
 		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
@@ -0,0 +1,598 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "servers/physics_server_3d.h"
+#include "servers/rendering/dummy/rasterizer_dummy.h"
+#include "servers/rendering/rendering_server_default.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+// Bit-exact hash of the motion state of the bodies, in the order they are given.
+static uint32_t hash_body_states(PhysicsServer3D *p_physics_server, const LocalVector<RID> &p_bodies) {
+	uint32_t hash = HASH_MURMUR3_SEED;
+	for (const RID &body : p_bodies) {
+		const Transform3D transform = p_physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		const Vector3 linear_velocity = p_physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		const Vector3 angular_velocity = p_physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY);
+		for (int i = 0; i < 3; i++) {
+			hash = hash_murmur3_one_real(transform.basis.rows[i].x, hash);
+			hash = hash_murmur3_one_real(transform.basis.rows[i].y, hash);
+			hash = hash_murmur3_one_real(transform.basis.rows[i].z, hash);
+			hash = hash_murmur3_one_real(transform.origin[i], hash);
+			hash = hash_murmur3_one_real(linear_velocity[i], hash);
+			hash = hash_murmur3_one_real(angular_velocity[i], hash);
+		}
+	}
+	return hash_fmix32(hash);
+}
+
+static bool are_bodies_sleeping(PhysicsServer3D *p_physics_server, const LocalVector<RID> &p_bodies) {
+	for (const RID &body : p_bodies) {
+		if (!p_physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_SLEEPING)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void step_physics_server(PhysicsServer3D *p_physics_server, int p_steps) {
+	for (int i = 0; i < p_steps; i++) {
+		p_physics_server->sync();
+		p_physics_server->flush_queries();
+		p_physics_server->end_sync();
+		p_physics_server->step(1.0 / 60.0);
+	}
+}
+
+struct Scene {
+	PhysicsServer3D *physics_server = nullptr;
+	RID space;
+	RID floor_shape;
+	RID box_shape;
+	RID sphere_shape;
+	RID floor;
+	LocalVector<RID> bodies;
+
+	// Boxes and spheres falling on each other, so the islands and the contacts change along the steps.
+	// The RIDs are always allocated in the same order, but the bodies can be added to the space in reverse.
+	Scene(bool p_reversed = false) {
+		physics_server = PhysicsServer3DManager::get_singleton()->new_default_server();
+		physics_server->init();
+
+		space = physics_server->space_create();
+		physics_server->space_set_active(space, true);
+
+		floor_shape = physics_server->world_boundary_shape_create();
+		physics_server->shape_set_data(floor_shape, Plane(Vector3(0, 1, 0), 0));
+		floor = physics_server->body_create();
+		physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		physics_server->body_add_shape(floor, floor_shape);
+
+		box_shape = physics_server->box_shape_create();
+		physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+		sphere_shape = physics_server->sphere_shape_create();
+		physics_server->shape_set_data(sphere_shape, 0.4);
+
+		for (int x = 0; x < 4; x++) {
+			for (int y = 0; y < 4; y++) {
+				for (int z = 0; z < 4; z++) {
+					RID body = physics_server->body_create();
+					physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+					physics_server->body_add_shape(body, (x + y + z) % 2 ? box_shape : sphere_shape);
+					const Basis basis = Basis::from_euler(Vector3(x * 0.3, y * 0.2, z * 0.1));
+					physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(basis, Vector3(x * 0.9 + y * 0.1, 0.6 + y * 1.2, z * 0.9 - y * 0.1)));
+					physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(z - 1.5, 0, x - 1.5));
+					bodies.push_back(body);
+				}
+			}
+		}
+
+		LocalVector<RID> added;
+		added.push_back(floor);
+		for (const RID &body : bodies) {
+			added.push_back(body);
+		}
+		if (p_reversed) {
+			added.invert();
+		}
+		for (const RID &body : added) {
+			physics_server->body_set_space(body, space);
+		}
+	}
+
+	void step(int p_steps) {
+		step_physics_server(physics_server, p_steps);
+	}
+
+	uint32_t hash_state() const {
+		return hash_body_states(physics_server, bodies);
+	}
+
+	~Scene() {
+		for (const RID &body : bodies) {
+			physics_server->free(body);
+		}
+		physics_server->free(floor);
+		physics_server->free(sphere_shape);
+		physics_server->free(box_shape);
+		physics_server->free(floor_shape);
+		physics_server->free(space);
+		physics_server->finish();
+		memdelete(physics_server);
+	}
+};
+
+// A chain of boxes swinging down on the floor, each link held by two pin joints.
+// The RIDs are always allocated in the same order, they are what the deterministic order is based on,
+// but the bodies are added to the space, the joints are made and the bodies are woken up in the given order.
+struct JointChain {
+	PhysicsServer3D *physics_server = nullptr;
+	RID space;
+	RID floor_shape;
+	RID box_shape;
+	RID floor;
+	RID anchor;
+	LocalVector<RID> bodies;
+	LocalVector<RID> joints;
+
+	JointChain(bool p_reversed) {
+		const int LINK_COUNT = 6;
+
+		physics_server = PhysicsServer3DManager::get_singleton()->new_default_server();
+		physics_server->init();
+
+		space = physics_server->space_create();
+		physics_server->space_set_active(space, true);
+		floor_shape = physics_server->world_boundary_shape_create();
+		physics_server->shape_set_data(floor_shape, Plane(Vector3(0, 1, 0), 0));
+		box_shape = physics_server->box_shape_create();
+		physics_server->shape_set_data(box_shape, Vector3(0.4, 0.4, 0.4));
+		floor = physics_server->body_create();
+		anchor = physics_server->body_create();
+		for (int i = 0; i < LINK_COUNT; i++) {
+			bodies.push_back(physics_server->body_create());
+		}
+		for (int i = 0; i < LINK_COUNT * 2; i++) {
+			joints.push_back(physics_server->joint_create());
+		}
+
+		physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		physics_server->body_add_shape(floor, floor_shape);
+		physics_server->body_set_space(floor, space);
+		physics_server->body_set_mode(anchor, PhysicsServer3D::BODY_MODE_STATIC);
+		physics_server->body_set_state(anchor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 4, 0)));
+		physics_server->body_set_space(anchor, space);
+
+		for (int i = 0; i < LINK_COUNT; i++) {
+			const RID body = bodies[p_reversed ? LINK_COUNT - 1 - i : i];
+			physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+			physics_server->body_add_shape(body, box_shape);
+			physics_server->body_set_space(body, space);
+		}
+		for (int i = 0; i < LINK_COUNT; i++) {
+			physics_server->body_set_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3((i + 1) * 1.1, 4, 0)));
+			physics_server->body_set_state(bodies[i], PhysicsServer3D::BODY_STATE_SLEEPING, true);
+		}
+
+		for (int i = 0; i < LINK_COUNT * 2; i++) {
+			const int joint_index = p_reversed ? LINK_COUNT * 2 - 1 - i : i;
+			const int link = joint_index / 2;
+			const RID body_a = link == 0 ? anchor : bodies[link - 1];
+			const Vector3 position_a = Vector3(link * 1.1, 4, 0);
+			const Vector3 position_b = Vector3((link + 1) * 1.1, 4, 0);
+			const Vector3 pin = (position_a + position_b) * 0.5 + Vector3(0, 0, joint_index % 2 ? 0.3 : -0.3);
+			physics_server->joint_make_pin(joints[joint_index], body_a, pin - position_a, bodies[link], pin - position_b);
+		}
+
+		for (int i = 0; i < LINK_COUNT; i++) {
+			physics_server->body_set_state(bodies[p_reversed ? LINK_COUNT - 1 - i : i], PhysicsServer3D::BODY_STATE_SLEEPING, false);
+		}
+	}
+
+	void step(int p_steps) {
+		step_physics_server(physics_server, p_steps);
+	}
+
+	~JointChain() {
+		for (const RID &joint : joints) {
+			physics_server->free(joint);
+		}
+		for (const RID &body : bodies) {
+			physics_server->free(body);
+		}
+		physics_server->free(anchor);
+		physics_server->free(floor);
+		physics_server->free(box_shape);
+		physics_server->free(floor_shape);
+		physics_server->free(space);
+		physics_server->finish();
+		memdelete(physics_server);
+	}
+};
+
+TEST_CASE("[PhysicsServer3D] Deterministic steps don't depend on the thread count") {
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", true);
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const int previous_thread_count = pool->get_thread_count();
+	const WorkerThreadPool::SchedulerMode previous_scheduler_mode = pool->get_scheduler_mode();
+
+	const int thread_counts[] = { 1, 2, 4, 8 };
+	uint32_t first_hash = 0;
+	for (int thread_count : thread_counts) {
+		pool->finish();
+		pool->init(thread_count);
+
+		Scene scene;
+		scene.step(120);
+		const uint32_t hash = scene.hash_state();
+		if (thread_count == thread_counts[0]) {
+			first_hash = hash;
+		} else {
+			CHECK_MESSAGE(hash == first_hash, vformat("Different state with %d threads.", thread_count));
+		}
+	}
+
+	pool->finish();
+	pool->init(previous_thread_count, 0.3, previous_scheduler_mode);
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", false);
+}
+
+TEST_CASE("[PhysicsServer3D] Deterministic steps don't depend on the order bodies and joints are added") {
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", true);
+
+	uint32_t hashes[2];
+	for (int i = 0; i < 2; i++) {
+		JointChain chain(i == 1);
+		chain.step(120);
+		hashes[i] = hash_body_states(chain.physics_server, chain.bodies);
+	}
+	CHECK_MESSAGE(hashes[0] == hashes[1], "Different state when the bodies and joints are added in reverse order.");
+
+	// The chain only touches the floor, these bodies also touch each other.
+	for (int i = 0; i < 2; i++) {
+		Scene scene(i == 1);
+		scene.step(120);
+		hashes[i] = scene.hash_state();
+	}
+	CHECK_MESSAGE(hashes[0] == hashes[1], "Different state when the bodies are added in reverse order.");
+
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", false);
+}
+
+TEST_CASE("[PhysicsServer3D] Restoring a snapshot replays the same steps") {
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", true);
+
+	Scene scene;
+	scene.step(30);
+	const uint32_t snapshot_hash = scene.hash_state();
+	const Vector<uint8_t> snapshot = scene.physics_server->space_get_snapshot(scene.space);
+	CHECK_FALSE(snapshot.is_empty());
+
+	scene.step(60);
+	const uint32_t hash = scene.hash_state();
+
+	scene.physics_server->space_restore_snapshot(scene.space, snapshot);
+	CHECK(scene.hash_state() == snapshot_hash);
+
+	scene.step(60);
+	CHECK_MESSAGE(scene.hash_state() == hash, "Different state after rolling back.");
+
+	ERR_PRINT_OFF;
+	scene.physics_server->space_restore_snapshot(scene.space, Vector<uint8_t>());
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(scene.hash_state() == hash, "Invalid snapshots must be ignored.");
+
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", false);
+}
+
+TEST_CASE("[PhysicsServer3D] A stack of boxes falls asleep and doesn't drift when woken up") {
+	const int BOX_COUNT = 4;
+	const int MAX_SETTLE_STEPS = 600;
+
+	PhysicsServer3D *physics_server = PhysicsServer3DManager::get_singleton()->new_default_server();
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID floor_shape = physics_server->world_boundary_shape_create();
+	physics_server->shape_set_data(floor_shape, Plane(Vector3(0, 1, 0), 0));
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape);
+	physics_server->body_set_space(floor, space);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	LocalVector<RID> boxes;
+	for (int i = 0; i < BOX_COUNT; i++) {
+		RID box = physics_server->body_create();
+		physics_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+		physics_server->body_add_shape(box, box_shape);
+		physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 0.55 + i * 1.05, 0)));
+		physics_server->body_set_space(box, space);
+		boxes.push_back(box);
+	}
+
+	int steps = 0;
+	while (steps < MAX_SETTLE_STEPS && !are_bodies_sleeping(physics_server, boxes)) {
+		step_physics_server(physics_server, 1);
+		steps++;
+	}
+	REQUIRE_MESSAGE(are_bodies_sleeping(physics_server, boxes), "The stack should fall asleep within ", MAX_SETTLE_STEPS, " steps.");
+
+	LocalVector<Vector3> resting_positions;
+	for (const RID &box : boxes) {
+		const Vector3 position = Transform3D(physics_server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+		CHECK_MESSAGE(position.y > 0.0, "The boxes should stay above the floor.");
+		resting_positions.push_back(position);
+	}
+
+	for (const RID &box : boxes) {
+		physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_SLEEPING, false);
+	}
+	step_physics_server(physics_server, 60);
+
+	for (uint32_t i = 0; i < boxes.size(); i++) {
+		const Vector3 position = Transform3D(physics_server->body_get_state(boxes[i], PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+		CHECK_MESSAGE(position.distance_to(resting_positions[i]) < 0.01, "The stack shouldn't move after being woken up.");
+	}
+
+	for (const RID &box : boxes) {
+		physics_server->free(box);
+	}
+	physics_server->free(floor);
+	physics_server->free(box_shape);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+TEST_CASE("[PhysicsServer3D] Soft body steps match the results of the per node solver") {
+	// A cloth pinned by one edge, swinging down for a third of a second.
+	// The expected positions were computed with the solver that stored the node state per node.
+	const int CLOTH_SIZE = 3;
+	const Vector3 expected_positions[] = {
+		Vector3(0.000000, 2.000000, 0.000000),
+		Vector3(0.250000, 2.000000, 0.000000),
+		Vector3(0.500000, 2.000000, 0.000000),
+		Vector3(0.750000, 2.000000, 0.000000),
+		Vector3(0.000675, 1.778056, 0.119154),
+		Vector3(0.250134, 1.780421, 0.120983),
+		Vector3(0.500047, 1.778838, 0.118659),
+		Vector3(0.748958, 1.775997, 0.114232),
+		Vector3(0.000629, 1.591441, 0.288920),
+		Vector3(0.250119, 1.593117, 0.290313),
+		Vector3(0.500144, 1.593129, 0.289870),
+		Vector3(0.749640, 1.592486, 0.288572),
+		Vector3(0.000666, 1.448276, 0.495008),
+		Vector3(0.250471, 1.452281, 0.497558),
+		Vector3(0.500537, 1.456888, 0.500179),
+		Vector3(0.750177, 1.466249, 0.505809),
+	};
+
+	RasterizerDummy::make_current();
+	RenderingServerDefault *rendering_server = memnew(RenderingServerDefault());
+	rendering_server->init();
+	rendering_server->set_render_loop_enabled(false);
+
+	PackedVector3Array vertices;
+	for (int z = 0; z <= CLOTH_SIZE; z++) {
+		for (int x = 0; x <= CLOTH_SIZE; x++) {
+			vertices.push_back(Vector3(x, 0, z) * 0.25);
+		}
+	}
+	PackedInt32Array indices;
+	for (int z = 0; z < CLOTH_SIZE; z++) {
+		for (int x = 0; x < CLOTH_SIZE; x++) {
+			const int corner = z * (CLOTH_SIZE + 1) + x;
+			indices.push_back(corner);
+			indices.push_back(corner + 1);
+			indices.push_back(corner + CLOTH_SIZE + 1);
+			indices.push_back(corner + 1);
+			indices.push_back(corner + CLOTH_SIZE + 2);
+			indices.push_back(corner + CLOTH_SIZE + 1);
+		}
+	}
+	Array arrays;
+	arrays.resize(RS::ARRAY_MAX);
+	arrays[RS::ARRAY_VERTEX] = vertices;
+	arrays[RS::ARRAY_INDEX] = indices;
+	RID mesh = rendering_server->mesh_create();
+	rendering_server->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+
+	PhysicsServer3D *physics_server = PhysicsServer3DManager::get_singleton()->new_default_server();
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 9.8);
+	physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+
+	RID soft_body = physics_server->soft_body_create();
+	physics_server->soft_body_set_mesh(soft_body, mesh);
+	for (int x = 0; x <= CLOTH_SIZE; x++) {
+		physics_server->soft_body_pin_point(soft_body, x, true);
+	}
+	physics_server->soft_body_set_transform(soft_body, Transform3D(Basis(), Vector3(0, 2, 0)));
+	physics_server->soft_body_set_space(soft_body, space);
+
+	for (int i = 0; i < 20; i++) {
+		physics_server->sync();
+		physics_server->flush_queries();
+		physics_server->end_sync();
+		physics_server->step(1.0 / 60.0);
+	}
+
+	for (int i = 0; i < vertices.size(); i++) {
+		const Vector3 position = physics_server->soft_body_get_point_global_position(soft_body, i);
+		CHECK_MESSAGE(position.distance_to(expected_positions[i]) < 0.001, vformat("Point %d is at %s instead of %s.", i, position, expected_positions[i]));
+	}
+
+	physics_server->free(soft_body);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+
+	rendering_server->free(mesh);
+	rendering_server->sync();
+	rendering_server->finish();
+	memdelete(rendering_server);
+}
+
+TEST_CASE("[PhysicsServer3D] Batched queries match the queries made one by one") {
+	PhysicsServer3D *physics_server = PhysicsServer3DManager::get_singleton()->new_default_server();
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID sphere_shape = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(sphere_shape, 1.5);
+
+	LocalVector<RID> bodies;
+	for (int x = 0; x < 8; x++) {
+		for (int z = 0; z < 8; z++) {
+			RID body = physics_server->body_create();
+			physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+			physics_server->body_add_shape(body, box_shape);
+			physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 2.0, 0, z * 2.0)));
+			physics_server->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+	}
+
+	physics_server->sync();
+	physics_server->flush_queries();
+	physics_server->end_sync();
+	physics_server->step(1.0 / 60.0);
+
+	// More queries than a single chunk of a batch, some of them between the boxes or outside of the field.
+	const int QUERY_COUNT = 256;
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	LocalVector<Transform3D> transforms;
+	for (int i = 0; i < 16; i++) {
+		for (int j = 0; j < 16; j++) {
+			const Vector3 position(i * 1.1 - 1.5, 0, j * 1.1 - 1.5);
+			from.push_back(position + Vector3(0, 10, 0));
+			to.push_back(position - Vector3(0, 10, 0));
+			transforms.push_back(Transform3D(Basis(), position + Vector3(0, 1.2, 0)));
+		}
+	}
+
+	PhysicsDirectSpaceState3D *space_state = physics_server->space_get_direct_state(space);
+
+	SUBCASE("Rays") {
+		PhysicsDirectSpaceState3D::RayParameters parameters;
+		LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+		LocalVector<bool> hits;
+		results.resize(QUERY_COUNT);
+		hits.resize(QUERY_COUNT);
+		space_state->intersect_rays(parameters, from.ptr(), to.ptr(), QUERY_COUNT, results.ptr(), hits.ptr());
+
+		int hit_count = 0;
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			parameters.from = from[i];
+			parameters.to = to[i];
+			PhysicsDirectSpaceState3D::RayResult result;
+			const bool hit = space_state->intersect_ray(parameters, result);
+			CHECK_MESSAGE(hits[i] == hit, vformat("Ray %d doesn't hit the same.", i));
+			if (hit && hits[i]) {
+				CHECK(results[i].position == result.position);
+				CHECK(results[i].normal == result.normal);
+				CHECK(results[i].rid == result.rid);
+				CHECK(results[i].shape == result.shape);
+				hit_count++;
+			}
+		}
+		CHECK(hit_count > 0);
+		CHECK(hit_count < QUERY_COUNT);
+	}
+
+	SUBCASE("Shapes") {
+		// The spheres overlap up to four boxes, more than the results kept for each one of them.
+		const int RESULT_MAX = 3;
+		PhysicsDirectSpaceState3D::ShapeParameters parameters;
+		parameters.shape_rid = sphere_shape;
+		LocalVector<PhysicsDirectSpaceState3D::ShapeResult> results;
+		LocalVector<int> result_counts;
+		results.resize(QUERY_COUNT * RESULT_MAX);
+		result_counts.resize(QUERY_COUNT);
+		space_state->intersect_shapes(parameters, transforms.ptr(), QUERY_COUNT, results.ptr(), RESULT_MAX, result_counts.ptr());
+
+		int empty_count = 0;
+		int full_count = 0;
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			parameters.transform = transforms[i];
+			PhysicsDirectSpaceState3D::ShapeResult expected_results[RESULT_MAX];
+			const int expected_count = space_state->intersect_shape(parameters, expected_results, RESULT_MAX);
+			CHECK_MESSAGE(result_counts[i] == expected_count, vformat("Shape %d doesn't overlap the same number of bodies.", i));
+			for (int j = 0; j < MIN(result_counts[i], expected_count); j++) {
+				CHECK(results[i * RESULT_MAX + j].rid == expected_results[j].rid);
+				CHECK(results[i * RESULT_MAX + j].shape == expected_results[j].shape);
+			}
+			empty_count += expected_count == 0;
+			full_count += expected_count == RESULT_MAX;
+		}
+		CHECK(empty_count > 0);
+		CHECK(full_count > 0);
+
+		// Without room for results, no query reports any.
+		space_state->intersect_shapes(parameters, transforms.ptr(), QUERY_COUNT, results.ptr(), 0, result_counts.ptr());
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			CHECK(result_counts[i] == 0);
+		}
+	}
+
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(sphere_shape);
+	physics_server->free(box_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H
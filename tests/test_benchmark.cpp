@@ -0,0 +1,199 @@
+/**************************************************************************/
+/*  test_benchmark.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "test_benchmark.h"
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/sort_array.h"
+#include "core/version.h"
+
+const void *volatile BenchmarkState::_sink = nullptr;
+
+void BenchmarkState::restart_timer() {
+	elapsed_usec = 0;
+	timer_start = OS::get_singleton()->get_ticks_usec();
+	timer_running = true;
+}
+
+void BenchmarkState::stop_timer() {
+	if (timer_running) {
+		elapsed_usec += OS::get_singleton()->get_ticks_usec() - timer_start;
+		timer_running = false;
+	}
+}
+
+struct Benchmark {
+	String name;
+	BenchmarkFunc function = nullptr;
+};
+
+static LocalVector<Benchmark> *benchmarks = nullptr;
+
+int register_benchmark(const String &p_name, BenchmarkFunc p_function) {
+	if (!benchmarks) {
+		benchmarks = new LocalVector<Benchmark>;
+	}
+	Benchmark benchmark;
+	benchmark.name = p_name;
+	benchmark.function = p_function;
+	benchmarks->push_back(benchmark);
+	return 0;
+}
+
+struct BenchmarkNameSort {
+	bool operator()(const Benchmark &p_a, const Benchmark &p_b) const {
+		return p_a.name < p_b.name;
+	}
+};
+
+class BenchmarkRunner {
+public:
+	String filter = "*";
+	String output_path;
+	uint32_t samples = 10;
+	uint64_t min_sample_usec = 20000;
+
+	// Returns the time taken per iteration, in nanoseconds.
+	double run_sample(BenchmarkFunc p_function, uint64_t p_iterations) {
+		BenchmarkState state;
+		state.iterations = p_iterations;
+		state.restart_timer();
+		p_function(state);
+		state.stop_timer();
+		return state.elapsed_usec * 1000.0 / p_iterations;
+	}
+
+	Dictionary run(const Benchmark &p_benchmark) {
+		// Find an iteration count that makes a sample last long enough to be measured reliably.
+		uint64_t iterations = 1;
+		while (true) {
+			double nsec = run_sample(p_benchmark.function, iterations);
+			double sample_usec = nsec * iterations / 1000.0;
+			if (sample_usec >= min_sample_usec || iterations >= (1ULL << 40)) {
+				break;
+			}
+			double scale = sample_usec > 0 ? (min_sample_usec * 1.2 / sample_usec) : 10.0;
+			iterations = MAX(iterations + 1, (uint64_t)(iterations * CLAMP(scale, 1.5, 10.0)));
+		}
+
+		LocalVector<double> times;
+		times.resize(samples);
+		double sum = 0;
+		for (uint32_t i = 0; i < samples; i++) {
+			times[i] = run_sample(p_benchmark.function, iterations);
+			sum += times[i];
+		}
+		times.sort();
+
+		double mean = sum / samples;
+		double variance = 0;
+		for (double time : times) {
+			variance += (time - mean) * (time - mean);
+		}
+		variance /= MAX(samples - 1, 1u);
+
+		double median = (samples % 2) ? times[samples / 2] : (times[samples / 2 - 1] + times[samples / 2]) * 0.5;
+
+		Dictionary result;
+		result["name"] = p_benchmark.name;
+		result["iterations"] = iterations;
+		result["samples"] = samples;
+		result["min_ns"] = times[0];
+		result["median_ns"] = median;
+		result["mean_ns"] = mean;
+		result["max_ns"] = times[samples - 1];
+		result["stddev_ns"] = Math::sqrt(variance);
+		return result;
+	}
+
+	int run_all() {
+		if (!benchmarks) {
+			print_line("No benchmarks registered.");
+			return 0;
+		}
+
+		SortArray<Benchmark, BenchmarkNameSort> sorter;
+		sorter.sort(benchmarks->ptr(), benchmarks->size());
+
+		print_line(vformat("%-48s %14s %14s %14s %10s", "Benchmark", "Median (ns)", "Min (ns)", "Stddev (ns)", "Iterations"));
+
+		Array results;
+		for (const Benchmark &benchmark : *benchmarks) {
+			if (!benchmark.name.match(filter)) {
+				continue;
+			}
+			Dictionary result = run(benchmark);
+			results.push_back(result);
+			print_line(vformat("%-48s %14.1f %14.1f %14.1f %10d", benchmark.name, result["median_ns"], result["min_ns"], result["stddev_ns"], result["iterations"]));
+		}
+
+		if (!output_path.is_empty()) {
+			Dictionary report;
+			report["version"] = VERSION_FULL_BUILD;
+			report["hash"] = VERSION_HASH;
+			report["processor"] = OS::get_singleton()->get_processor_name();
+			report["processor_count"] = OS::get_singleton()->get_processor_count();
+			report["benchmarks"] = results;
+
+			Ref<FileAccess> f = FileAccess::open(output_path, FileAccess::WRITE);
+			ERR_FAIL_COND_V_MSG(f.is_null(), 1, "Can't write benchmark results to: " + output_path);
+			f->store_string(JSON::stringify(report, "\t", false, true));
+			print_line("Benchmark results saved to: " + output_path);
+		}
+
+		return 0;
+	}
+};
+
+int run_benchmarks(const List<String> &p_args) {
+	BenchmarkRunner runner;
+
+	for (const String &arg : p_args) {
+		if (arg.begins_with("--benchmark-filter=")) {
+			runner.filter = arg.substr(arg.find("=") + 1);
+		} else if (arg.begins_with("--benchmark-samples=")) {
+			runner.samples = MAX(arg.substr(arg.find("=") + 1).to_int(), 1);
+		} else if (arg.begins_with("--benchmark-min-time=")) {
+			runner.min_sample_usec = MAX(arg.substr(arg.find("=") + 1).to_int(), 1) * 1000;
+		} else if (arg.begins_with("--benchmark-output=")) {
+			runner.output_path = arg.substr(arg.find("=") + 1);
+		}
+	}
+
+	int status = runner.run_all();
+
+	delete benchmarks;
+	benchmarks = nullptr;
+
+	return status;
+}
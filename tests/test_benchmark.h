@@ -0,0 +1,89 @@
+/**************************************************************************/
+/*  test_benchmark.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BENCHMARK_H
+#define TEST_BENCHMARK_H
+
+#include "core/string/ustring.h"
+#include "core/templates/list.h"
+
+#include "tests/test_macros.h"
+
+// Timed benchmarks, run from the command-line with `godot --test --benchmark`.
+//
+// Options:
+//   --benchmark-filter=<pattern>  Only run benchmarks whose name matches the wildcard pattern.
+//   --benchmark-samples=<count>   Number of timed samples per benchmark (default: 10).
+//   --benchmark-min-time=<msec>   Minimum duration of a sample (default: 20).
+//   --benchmark-output=<path>     Also write the results to a JSON file, for comparison across commits.
+//
+// The benchmark function is called once per sample and must run its workload
+// `get_iterations()` times. The timer is running when the function is called;
+// call `restart_timer()` after any setup and `stop_timer()` before any teardown
+// so they are not measured.
+
+class BenchmarkState {
+	friend class BenchmarkRunner;
+
+	uint64_t iterations = 1;
+	uint64_t timer_start = 0;
+	uint64_t elapsed_usec = 0;
+	bool timer_running = false;
+
+public:
+	_FORCE_INLINE_ uint64_t get_iterations() const { return iterations; }
+
+	void restart_timer();
+	void stop_timer();
+
+	// Keeps the compiler from optimizing away a value that is otherwise unused.
+	template <class T>
+	static _FORCE_INLINE_ void do_not_optimize(const T &p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "g"(&p_value) : "memory");
+#else
+		_sink = (const void *)&p_value;
+#endif
+	}
+
+private:
+	static const void *volatile _sink;
+};
+
+typedef void (*BenchmarkFunc)(BenchmarkState &p_state);
+int register_benchmark(const String &p_name, BenchmarkFunc p_function);
+int run_benchmarks(const List<String> &p_args);
+
+// Benchmark names are grouped by area, e.g. "hash_map/insert".
+#define REGISTER_BENCHMARK(m_name, m_function)                       \
+	DOCTEST_GLOBAL_NO_WARNINGS(DOCTEST_ANONYMOUS(DOCTEST_ANON_VAR_), \
+			register_benchmark(m_name, m_function))
+
+#endif // TEST_BENCHMARK_H